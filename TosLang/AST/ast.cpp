@@ -0,0 +1,40 @@
+#include "ast.h"
+
+#include <vector>
+
+using namespace TosLang::FrontEnd;
+
+ASTNode::~ASTNode()
+{
+    DestroyChildren();
+}
+
+/*
+* \fn       DestroyChildren
+* \brief    Destroys the subtrees rooted at the children of the node. The subtrees are taken apart with an explicit
+*           stack, so that destroying a deep tree doesn't recurse once per level and can't overflow the native stack.
+*/
+void ASTNode::DestroyChildren()
+{
+    std::vector<std::unique_ptr<ASTNode>> pendingNodes;
+    for (auto& child : mChildren)
+    {
+        if (child != nullptr)
+            pendingNodes.push_back(std::move(child));
+    }
+    mChildren.clear();
+
+    while (!pendingNodes.empty())
+    {
+        std::unique_ptr<ASTNode> node = std::move(pendingNodes.back());
+        pendingNodes.pop_back();
+
+        // The children are detached before the node goes away, leaving nothing for its destructor to recurse on
+        for (auto& child : node->mChildren)
+        {
+            if (child != nullptr)
+                pendingNodes.push_back(std::move(child));
+        }
+        node->mChildren.clear();
+    }
+}
@@ -1,6 +1,9 @@
 #ifndef AST_H__TOSLANG
 #define AST_H__TOSLANG
 
+#include "astarena.h"
+
+#include "../Common/internedstring.h"
 #include "../Utils/sourceloc.h"
 
 #include <cassert>
@@ -14,7 +17,8 @@ namespace TosLang
     {
         class ASTNode;
 
-        using ChildrenNodes = std::vector<std::unique_ptr<ASTNode>>;
+        // Children are stored in the arena of their parent, next to the nodes themselves
+        using ChildrenNodes = std::vector<std::unique_ptr<ASTNode>, ArenaAllocator<std::unique_ptr<ASTNode>>>;
 
         /*
         * \class ASTNode
@@ -57,14 +61,17 @@ namespace TosLang
             };
 
         public:
-            explicit ASTNode(NodeKind kind = NodeKind::ERROR) : mKind{ kind }, mName{ "" } { }
-            virtual ~ASTNode() = default;
+            explicit ASTNode(NodeKind kind = NodeKind::ERROR) : mKind{ kind }, mName{ } { }
+            virtual ~ASTNode();
 
             ASTNode(const ASTNode&) = default;
             ASTNode(ASTNode&&) = default;
             ASTNode& operator=(const ASTNode&) = default;
             ASTNode& operator=(ASTNode&&) = default;
 
+            static void* operator new(size_t size);
+            static void operator delete(void* ptr);
+
         public:
             /*
             * \fn       GetChildrenNodes
@@ -85,7 +92,14 @@ namespace TosLang
             * \brief    Gets the name of the AST node
             * \return   Name of the AST node
             */
-            const std::string& GetName() const { return mName; }
+            const std::string& GetName() const { return mName.GetStr(); }
+
+            /*
+            * \fn       GetNameID
+            * \brief    Gets the name of the AST node as it is stored in the string pool
+            * \return   Interned name of the AST node
+            */
+            Common::InternedString GetNameID() const { return mName; }
 
             /*
             * \fn       GetSourceLocation
@@ -101,6 +115,8 @@ namespace TosLang
             */
             void AddChildNode(std::unique_ptr<ASTNode>&& node) { mChildren.push_back(std::move(node)); }
 
+            void DestroyChildren();
+
             /*
             * \fn               GetChildNodeAs
             * \brief            Gets pointer of the specified type to a child node 
@@ -116,7 +132,7 @@ namespace TosLang
 
         protected:
             NodeKind mKind;                 /*!< Kind of the AST node */
-            std::string mName;              /*!< Name of the AST node. In the case of the IdentifierExpr node, it is also the name of the identifier. */
+            Common::InternedString mName;   /*!< Name of the AST node. In the case of the IdentifierExpr node, it is also the name of the identifier. */
             ChildrenNodes mChildren;        /*!< List of children nodes linked to this AST node */
             Utils::SourceLocation mSrcLoc;  /*!< Location in the source code from which the node was created */
         };
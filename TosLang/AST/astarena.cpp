@@ -0,0 +1,103 @@
+#include "astarena.h"
+
+#include "ast.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+using namespace TosLang::FrontEnd;
+
+namespace
+{
+    thread_local ASTArena* tCurrentArena = nullptr;
+
+    // Nodes are preceded by the arena they were allocated in, so that deleting one knows where its memory comes from
+    const size_t NODE_HEADER_SIZE = alignof(std::max_align_t);
+    static_assert(NODE_HEADER_SIZE >= sizeof(ASTArena*), "The node header must be able to hold an arena");
+}
+
+ASTArena::ASTArena(size_t blockSize) : mBlockIt{ nullptr }, mBlockEnd{ nullptr }, mBlockSize{ blockSize }, mNbBytesAllocated{ 0 } { }
+
+ASTArena::Scope::Scope(ASTArena* arena) : mPreviousArena{ tCurrentArena }
+{
+    tCurrentArena = arena;
+}
+
+ASTArena::Scope::~Scope()
+{
+    tCurrentArena = mPreviousArena;
+}
+
+ASTArena* ASTArena::GetCurrent()
+{
+    return tCurrentArena;
+}
+
+/*
+* \fn               Allocate
+* \brief            Hands out memory from the arena
+* \param size       Number of bytes needed
+* \param alignment  Alignment of the memory (a power of two, at most that of std::max_align_t)
+* \return           Pointer to the memory
+*/
+void* ASTArena::Allocate(size_t size, size_t alignment)
+{
+    assert((alignment != 0) && ((alignment & (alignment - 1)) == 0) && (alignment <= alignof(std::max_align_t)));
+
+    uintptr_t address = (reinterpret_cast<uintptr_t>(mBlockIt) + alignment - 1) & ~(alignment - 1);
+    if ((mBlockIt == nullptr) || (address + size > reinterpret_cast<uintptr_t>(mBlockEnd)))
+    {
+        AddBlock(size);
+        address = reinterpret_cast<uintptr_t>(mBlockIt);
+    }
+
+    mBlockIt = reinterpret_cast<char*>(address + size);
+    mNbBytesAllocated += size;
+    return reinterpret_cast<void*>(address);
+}
+
+/*
+* \fn               AddBlock
+* \brief            Starts a new block of memory
+* \param minSize    Number of bytes the block must be able to hold
+*/
+void ASTArena::AddBlock(size_t minSize)
+{
+    // Blocks come from new[], which aligns them for any type
+    const size_t blockSize = std::max(mBlockSize, minSize);
+    mBlocks.emplace_back(new char[blockSize]);
+    mBlockIt = mBlocks.back().get();
+    mBlockEnd = mBlockIt + blockSize;
+}
+
+/*
+* \fn           operator new
+* \brief        Allocates an AST node in the current arena, or on the heap if there is none
+* \param size   Size of the node
+* \return       Memory of the node
+*/
+void* ASTNode::operator new(size_t size)
+{
+    ASTArena* arena = ASTArena::GetCurrent();
+    char* memory = arena != nullptr ? static_cast<char*>(arena->Allocate(NODE_HEADER_SIZE + size, alignof(std::max_align_t)))
+                                    : static_cast<char*>(::operator new(NODE_HEADER_SIZE + size));
+
+    *reinterpret_cast<ASTArena**>(memory) = arena;
+    return memory + NODE_HEADER_SIZE;
+}
+
+/*
+* \fn           operator delete
+* \brief        Gives back the memory of an AST node. Memory coming from an arena is reclaimed with the arena.
+* \param ptr    Memory of the node
+*/
+void ASTNode::operator delete(void* ptr)
+{
+    if (ptr == nullptr)
+        return;
+
+    char* memory = static_cast<char*>(ptr) - NODE_HEADER_SIZE;
+    if (*reinterpret_cast<ASTArena**>(memory) == nullptr)
+        ::operator delete(memory);
+}
@@ -0,0 +1,133 @@
+#ifndef AST_ARENA_H__TOSLANG
+#define AST_ARENA_H__TOSLANG
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace TosLang
+{
+    namespace FrontEnd
+    {
+        /*
+        * \class ASTArena
+        * \brief Bump allocator holding the memory of the nodes of an AST and of their lists of children.
+        *        Memory is carved out of large blocks and is only given back when the arena is destroyed,
+        *        all at once. Nodes are allocated in the arena installed on the current thread by an
+        *        ASTArena::Scope, or on the heap when there is none.
+        */
+        class ASTArena
+        {
+        public:
+            explicit ASTArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+            ~ASTArena() = default;
+
+            ASTArena(const ASTArena&) = delete;
+            ASTArena& operator=(const ASTArena&) = delete;
+
+        public:
+            /*
+            * \class Scope
+            * \brief Installs an arena on the current thread for its lifetime
+            */
+            class Scope
+            {
+            public:
+                explicit Scope(ASTArena* arena);
+                ~Scope();
+
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+
+            private:
+                ASTArena* mPreviousArena;   /*!< Arena installed before this scope */
+            };
+
+        public:
+            static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+            /*
+            * \fn       GetCurrent
+            * \brief    Gives the arena installed on the current thread
+            * \return   Current arena. Nullptr if nodes are allocated on the heap.
+            */
+            static ASTArena* GetCurrent();
+
+            void* Allocate(size_t size, size_t alignment);
+
+            /*
+            * \fn       GetNbBlocks
+            * \brief    Gives the number of blocks the arena is made of
+            * \return   Number of blocks
+            */
+            size_t GetNbBlocks() const { return mBlocks.size(); }
+
+            /*
+            * \fn       GetNbBytesAllocated
+            * \brief    Gives the number of bytes handed out by the arena
+            * \return   Number of bytes
+            */
+            size_t GetNbBytesAllocated() const { return mNbBytesAllocated; }
+
+        private:
+            void AddBlock(size_t minSize);
+
+        private:
+            std::vector<std::unique_ptr<char[]>> mBlocks;   /*!< Memory owned by the arena */
+            char* mBlockIt;                                 /*!< Next free byte of the current block */
+            char* mBlockEnd;                                /*!< End of the current block */
+            size_t mBlockSize;                              /*!< Size of a regular block */
+            size_t mNbBytesAllocated;                       /*!< Bytes handed out so far */
+        };
+
+        /*
+        * \class ArenaAllocator
+        * \brief Standard allocator taking its memory from the arena that was current when it was created.
+        *        Deallocations are ignored: the memory is reclaimed with the arena.
+        */
+        template <class T>
+        class ArenaAllocator
+        {
+        public:
+            using value_type = T;
+            using propagate_on_container_move_assignment = std::true_type;
+            using propagate_on_container_swap = std::true_type;
+
+        public:
+            ArenaAllocator() : mArena{ ASTArena::GetCurrent() } { }
+
+            template <class U>
+            ArenaAllocator(const ArenaAllocator<U>& other) : mArena{ other.GetArena() } { }
+
+        public:
+            T* allocate(size_t n)
+            {
+                if (mArena == nullptr)
+                    return static_cast<T*>(::operator new(n * sizeof(T)));
+
+                return static_cast<T*>(mArena->Allocate(n * sizeof(T), alignof(T)));
+            }
+
+            void deallocate(T* ptr, size_t)
+            {
+                if (mArena == nullptr)
+                    ::operator delete(ptr);
+            }
+
+            ASTArena* GetArena() const { return mArena; }
+
+        public:
+            template <class U>
+            friend bool operator==(const ArenaAllocator& lhs, const ArenaAllocator<U>& rhs) { return lhs.mArena == rhs.GetArena(); }
+
+            template <class U>
+            friend bool operator!=(const ArenaAllocator& lhs, const ArenaAllocator<U>& rhs) { return lhs.mArena != rhs.GetArena(); }
+
+        private:
+            ASTArena* mArena;   /*!< Arena providing the memory. Nullptr to use the heap. */
+        };
+    }
+}
+
+#endif // AST_ARENA_H__TOSLANG
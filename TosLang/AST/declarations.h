@@ -8,6 +8,7 @@
 #include "../Common/type.h"
 
 #include <string>
+#include <vector>
 
 namespace TosLang
 {
@@ -33,7 +34,9 @@ namespace TosLang
         {
         public:
             ProgramDecl() : Decl{ NodeKind::PROGRAM_DECL } { }
-            virtual ~ProgramDecl() = default;
+
+            // The declarations must be destroyed before the arenas holding them
+            virtual ~ProgramDecl() { DestroyChildren(); }
 
         public:
             /*
@@ -49,6 +52,40 @@ namespace TosLang
             * \return   Sequence of declarations
             */
             ChildrenNodes& GetProgramDecls() { return mChildren; }
+
+            /*
+            * \fn           AddArena
+            * \brief        Gives the program the ownership of an arena some of its nodes are allocated in.
+            *               The program itself must not be allocated in that arena.
+            * \param arena  Arena holding nodes of the program
+            */
+            void AddArena(std::unique_ptr<ASTArena>&& arena) { mArenas.push_back(std::move(arena)); }
+
+            /*
+            * \fn       GetArenas
+            * \brief    Gets the arenas the nodes of the program are allocated in
+            * \return   Arenas of the program. Empty if its nodes are allocated on the heap.
+            */
+            const std::vector<std::unique_ptr<ASTArena>>& GetArenas() const { return mArenas; }
+
+            /*
+            * \fn           MergeProgram
+            * \brief        Moves the declarations of another program, and the arenas holding them, at the end of this program
+            * \param other  Program to merge. It is left empty.
+            */
+            void MergeProgram(ProgramDecl& other)
+            {
+                for (auto& decl : other.mChildren)
+                    mChildren.push_back(std::move(decl));
+                other.mChildren.clear();
+
+                for (auto& arena : other.mArenas)
+                    mArenas.push_back(std::move(arena));
+                other.mArenas.clear();
+            }
+
+        private:
+            std::vector<std::unique_ptr<ASTArena>> mArenas;   /*!< Memory of every node of the program */
         };
 
         /*
@@ -61,7 +98,7 @@ namespace TosLang
         {
         public:
             VarDecl() : Decl{ NodeKind::ERROR }, mType{ Common::Type::ERROR }, mIsFunctionParameter{ false }, mVarSize{ 0 } { }
-            VarDecl(const std::string& varName, Common::Type type, bool isFuncParam, int varSize, const Utils::SourceLocation& srcLoc)
+            VarDecl(Common::InternedString varName, Common::Type type, bool isFuncParam, int varSize, const Utils::SourceLocation& srcLoc)
                 : Decl{ NodeKind::VAR_DECL }, mType{ type }, mIsFunctionParameter{ isFuncParam }, mVarSize{ varSize }
             {
                 mName = varName; 
@@ -101,7 +138,7 @@ namespace TosLang
             * \brief    Gets the name of the variable
             * \return   Name of the variable
             */
-            const std::string& GetVarName() const { return mName; }
+            const std::string& GetVarName() const { return mName.GetStr(); }
 
             /*
             * \fn       GetVarSize
@@ -165,7 +202,7 @@ namespace TosLang
         {
         public:
             FunctionDecl() : Decl{ NodeKind::ERROR }, mReturnType{ Common::Type::ERROR } { }
-            FunctionDecl(const std::string& fnName, Common::Type type, 
+            FunctionDecl(Common::InternedString fnName, Common::Type type, 
                          std::unique_ptr<ParamVarDecls>&& params, std::unique_ptr<CompoundStmt>&& body,
                          const Utils::SourceLocation& srcLoc)
                 : Decl{ NodeKind::FUNCTION_DECL }, mReturnType{ type }
@@ -184,7 +221,7 @@ namespace TosLang
             * \brief    Gets the name of the function
             * \return   Name of the function
             */
-            const std::string& GetFunctionName() const { return mName; }
+            const std::string& GetFunctionName() const { return mName.GetStr(); }
 
             /*
             * \fn       GetReturnType
@@ -125,7 +125,7 @@ namespace TosLang
         class CallExpr : public Expr
         {
         public:
-            CallExpr(const std::string& fnName, std::vector<std::unique_ptr<Expr>>&& args, const Utils::SourceLocation srcLoc)
+            CallExpr(Common::InternedString fnName, std::vector<std::unique_ptr<Expr>>&& args, const Utils::SourceLocation srcLoc)
                 : Expr{ NodeKind::CALL_EXPR }
             { 
                 mName = fnName; 
@@ -141,14 +141,14 @@ namespace TosLang
             * \brief    Gets the name of the function being called
             * \return   Name of the callee
             */
-            const std::string& GetCalleeName() const { return mName; }
+            const std::string& GetCalleeName() const { return mName.GetStr(); }
 
             /*
             * \fn       GetArgs
             * \brief    Gets the arguments used to call a function
             * \return   List of argument expressions
             */
-            const std::vector<std::unique_ptr<ASTNode>>& GetArgs() const { return mChildren; }
+            const ChildrenNodes& GetArgs() const { return mChildren; }
         };
 
         /*
@@ -158,7 +158,7 @@ namespace TosLang
         class IdentifierExpr : public Expr
         {
         public:
-            IdentifierExpr(const std::string& value, const Utils::SourceLocation& srcLoc)
+            IdentifierExpr(Common::InternedString value, const Utils::SourceLocation& srcLoc)
                 : Expr{ NodeKind::IDENTIFIER_EXPR }, mType{ }
             {
                 mName = value; 
@@ -187,7 +187,7 @@ namespace TosLang
             {
                 assert(arrayIdentifier->GetKind() == ASTNode::NodeKind::IDENTIFIER_EXPR);
 
-                mName = arrayIdentifier->GetName();
+                mName = arrayIdentifier->GetNameID();
                 mSrcLoc = srcLoc;
 
                 AddChildNode(std::move(arrayIdentifier));
@@ -250,7 +250,7 @@ namespace TosLang
                 : Expr{ NodeKind::SPAWN_EXPR }
             {
                 assert(call->GetKind() == ASTNode::NodeKind::CALL_EXPR);
-                mName = call->GetName();
+                mName = call->GetNameID();
                 AddChildNode(std::move(call));
                 mSrcLoc = srcLoc;
             }
@@ -266,20 +266,31 @@ namespace TosLang
         };
 
         /*
-        * \class IdentifierExpr
-        * \brief Node of the AST representing a string literal
+        * \class StringExpr
+        * \brief Node of the AST representing a string literal. Unlike names, literals are seldom repeated, 
+        *        so their content is kept by the node instead of going to the string pool.
         */
         class StringExpr : public Expr
         {
         public:
-            StringExpr(const std::string& value, const Utils::SourceLocation& srcLoc)
-                : Expr{ NodeKind::STRING_EXPR }
+            StringExpr(std::string value, const Utils::SourceLocation& srcLoc)
+                : Expr{ NodeKind::STRING_EXPR }, mValue{ std::move(value) }
             {
-                mName = value;
                 mSrcLoc = srcLoc;
             }
 
             virtual ~StringExpr() = default;
+
+        public:
+            /*
+            * \fn       GetValue
+            * \brief    Gets the content of the string literal
+            * \return   Content of the string literal
+            */
+            const std::string& GetValue() const { return mValue; }
+
+        private:
+            std::string mValue;     /*!< Content of the string literal */
         };
     }
 }
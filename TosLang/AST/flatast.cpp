@@ -0,0 +1,105 @@
+#include "flatast.h"
+
+#include "declarations.h"
+#include "expressions.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace TosLang::Common;
+using namespace TosLang::FrontEnd;
+
+FlatAST::FlatAST(const ASTNode* root)
+{
+    Build(root);
+}
+
+/*
+* \fn           Build
+* \brief        Copies an AST in the flat AST, replacing what it held before
+* \param root   Root of the AST. The flat AST is empty if it is null.
+*/
+void FlatAST::Build(const ASTNode* root)
+{
+    mKinds.clear();
+    mParents.clear();
+    mSubtreeEnds.clear();
+    mNbChildren.clear();
+    mNames.clear();
+    mTypes.clear();
+    mValues.clear();
+    mSrcLocs.clear();
+    mNodes.clear();
+
+    if (root == nullptr)
+        return;
+
+    // The tree is walked with an explicit stack, so that deep trees don't overflow the native stack.
+    // Children are pushed in reverse so that they come out, and get their IDs, in order.
+    std::vector<std::pair<const ASTNode*, NodeID>> pendingNodes{ { root, INVALID_NODE } };
+    while (!pendingNodes.empty())
+    {
+        const ASTNode* node = pendingNodes.back().first;
+        const NodeID parent = pendingNodes.back().second;
+        pendingNodes.pop_back();
+
+        assert(mKinds.size() < INVALID_NODE);
+        const NodeID id = static_cast<NodeID>(mKinds.size());
+        mParents.push_back(parent);
+        mSubtreeEnds.push_back(id + 1);
+        mNodes.push_back(node);
+
+        if (node == nullptr)
+        {
+            mKinds.push_back(ASTNode::NodeKind::ERROR);
+            mNbChildren.push_back(0);
+            mNames.emplace_back();
+            mTypes.push_back(Type::ERROR);
+            mValues.push_back(0);
+            mSrcLocs.emplace_back();
+            continue;
+        }
+
+        const ChildrenNodes& children = node->GetChildrenNodes();
+        mKinds.push_back(node->GetKind());
+        mNbChildren.push_back(static_cast<uint32_t>(children.size()));
+        mNames.push_back(node->GetNameID());
+        mSrcLocs.push_back(node->GetSourceLocation());
+
+        Type type = Type::ERROR;
+        int64_t value = 0;
+        switch (node->GetKind())
+        {
+        case ASTNode::NodeKind::FUNCTION_DECL:
+            type = static_cast<const FunctionDecl*>(node)->GetReturnType();
+            break;
+        case ASTNode::NodeKind::VAR_DECL:
+            type = static_cast<const VarDecl*>(node)->GetVarType();
+            value = static_cast<const VarDecl*>(node)->GetVarSize();
+            break;
+        case ASTNode::NodeKind::IDENTIFIER_EXPR:
+            type = static_cast<const IdentifierExpr*>(node)->GetType();
+            break;
+        case ASTNode::NodeKind::BINARY_EXPR:
+            value = static_cast<int64_t>(static_cast<const BinaryOpExpr*>(node)->GetOperation());
+            break;
+        case ASTNode::NodeKind::BOOLEAN_EXPR:
+            value = static_cast<const BooleanExpr*>(node)->GetValue() ? 1 : 0;
+            break;
+        case ASTNode::NodeKind::NUMBER_EXPR:
+            value = static_cast<const NumberExpr*>(node)->GetValue();
+            break;
+        default:
+            break;
+        }
+        mTypes.push_back(type);
+        mValues.push_back(value);
+
+        for (auto childIt = children.rbegin(); childIt != children.rend(); ++childIt)
+            pendingNodes.emplace_back(childIt->get(), id);
+    }
+
+    // A parent comes before its descendants, so the subtrees are closed from the last node to the first
+    for (NodeID id = static_cast<NodeID>(mKinds.size()) - 1; id > 0; --id)
+        mSubtreeEnds[mParents[id]] = std::max(mSubtreeEnds[mParents[id]], mSubtreeEnds[id]);
+}
@@ -0,0 +1,162 @@
+#ifndef FLAT_AST_H__TOSLANG
+#define FLAT_AST_H__TOSLANG
+
+#include "ast.h"
+
+#include "../Common/type.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace TosLang
+{
+    namespace FrontEnd
+    {
+        /*
+        * \class FlatAST
+        * \brief Flat copy of an AST, stored as a structure of arrays. Nodes are numbered in pre-order with 32-bit IDs,
+        *        and each of their properties lives in its own contiguous column. A pass scanning the nodes in order
+        *        reads the columns linearly instead of chasing the pointers of the tree.
+        *        The subtree of a node is the range of IDs [node, GetSubtreeEnd(node)): its first child comes right
+        *        after it and the next sibling of a node comes right after its subtree.
+        *        A null child of the tree keeps its position as a node without properties nor children.
+        */
+        class FlatAST
+        {
+        public:
+            using NodeID = uint32_t;
+
+            static constexpr NodeID INVALID_NODE = UINT32_MAX;
+
+        public:
+            FlatAST() = default;
+            explicit FlatAST(const ASTNode* root);
+            ~FlatAST() = default;
+
+        public:
+            void Build(const ASTNode* root);
+
+            /*
+            * \fn       GetNbNodes
+            * \brief    Gives the number of nodes of the flat AST, null children included
+            * \return   Number of nodes
+            */
+            size_t GetNbNodes() const { return mKinds.size(); }
+
+            /*
+            * \fn       GetKinds
+            * \brief    Gives the column holding the kind of every node
+            * \return   Kinds of the nodes, indexed by node ID
+            */
+            const std::vector<ASTNode::NodeKind>& GetKinds() const { return mKinds; }
+
+            /*
+            * \fn       GetKind
+            * \brief    Gives the kind of a node. A null child is of the ERROR kind.
+            * \param id Node ID
+            * \return   Kind of the node
+            */
+            ASTNode::NodeKind GetKind(NodeID id) const { return mKinds[id]; }
+
+            /*
+            * \fn       GetParent
+            * \brief    Gives the parent of a node
+            * \param id Node ID
+            * \return   Parent of the node. INVALID_NODE for the root.
+            */
+            NodeID GetParent(NodeID id) const { return mParents[id]; }
+
+            /*
+            * \fn       GetSubtreeEnd
+            * \brief    Gives the end of the subtree rooted at a node
+            * \param id Node ID
+            * \return   ID following the last node of the subtree
+            */
+            NodeID GetSubtreeEnd(NodeID id) const { return mSubtreeEnds[id]; }
+
+            /*
+            * \fn       GetNbChildren
+            * \brief    Gives the number of children of a node
+            * \param id Node ID
+            * \return   Number of children
+            */
+            uint32_t GetNbChildren(NodeID id) const { return mNbChildren[id]; }
+
+            /*
+            * \fn       GetFirstChild
+            * \brief    Gives the first child of a node
+            * \param id Node ID
+            * \return   First child of the node. INVALID_NODE if the node doesn't have any.
+            */
+            NodeID GetFirstChild(NodeID id) const { return mNbChildren[id] != 0 ? id + 1 : INVALID_NODE; }
+
+            /*
+            * \fn       GetNextSibling
+            * \brief    Gives the child of the same parent coming after a node
+            * \param id Node ID
+            * \return   Next sibling of the node. INVALID_NODE if the node is the last child of its parent.
+            */
+            NodeID GetNextSibling(NodeID id) const
+            {
+                const NodeID parent = mParents[id];
+                return (parent != INVALID_NODE) && (mSubtreeEnds[id] != mSubtreeEnds[parent]) ? mSubtreeEnds[id] : INVALID_NODE;
+            }
+
+            /*
+            * \fn       GetName
+            * \brief    Gives the name of a node, as it is stored in the string pool
+            * \param id Node ID
+            * \return   Name of the node
+            */
+            Common::InternedString GetName(NodeID id) const { return mNames[id]; }
+
+            /*
+            * \fn       GetType
+            * \brief    Gives the type of a node: the return type of a function, the type of a variable
+            *           or the type of an identifier. Other nodes are of the ERROR type.
+            * \param id Node ID
+            * \return   Type of the node
+            */
+            Common::Type GetType(NodeID id) const { return mTypes[id]; }
+
+            /*
+            * \fn       GetValue
+            * \brief    Gives the value of a node: the value of a number or of a boolean, the operation of a binary
+            *           expression or the size of a variable. Other nodes have a value of 0.
+            * \param id Node ID
+            * \return   Value of the node
+            */
+            int64_t GetValue(NodeID id) const { return mValues[id]; }
+
+            /*
+            * \fn       GetSourceLocation
+            * \brief    Gives the location in the source code of a node
+            * \param id Node ID
+            * \return   Source location
+            */
+            const Utils::SourceLocation& GetSourceLocation(NodeID id) const { return mSrcLocs[id]; }
+
+            /*
+            * \fn       GetNode
+            * \brief    Gives the node of the tree a node of the flat AST was copied from
+            * \param id Node ID
+            * \return   Node of the tree. Nullptr for a null child.
+            */
+            const ASTNode* GetNode(NodeID id) const { return mNodes[id]; }
+
+        private:
+            std::vector<ASTNode::NodeKind> mKinds;          /*!< Kind of every node */
+            std::vector<NodeID> mParents;                   /*!< Parent of every node */
+            std::vector<NodeID> mSubtreeEnds;               /*!< End of the subtree of every node */
+            std::vector<uint32_t> mNbChildren;              /*!< Number of children of every node */
+            std::vector<Common::InternedString> mNames;     /*!< Name of every node */
+            std::vector<Common::Type> mTypes;               /*!< Type of every node */
+            std::vector<int64_t> mValues;                   /*!< Value of every node */
+            std::vector<Utils::SourceLocation> mSrcLocs;    /*!< Source location of every node */
+            std::vector<const ASTNode*> mNodes;             /*!< Node of the tree every node was copied from */
+        };
+    }
+}
+
+#endif // FLAT_AST_H__TOSLANG
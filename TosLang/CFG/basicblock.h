@@ -13,6 +13,9 @@ namespace TosLang
         template <class InstT>
         class BasicBlock;
 
+        template <class InstT>
+        class ControlFlowGraph;
+
         template <class InstT>
         using BlockPtr = std::shared_ptr<BasicBlock<InstT>>;
         
@@ -28,29 +31,20 @@ namespace TosLang
         *        - The last instruction in a basic block is either a jump or a return
         */
         template <class InstT>
-        class BasicBlock
+        class BasicBlock : public std::enable_shared_from_this<BasicBlock<InstT>>
         {
         public:
             /*
             * \fn           BasicBlock
             * \brief        Ctor
-            * \param name   Name of the basic block. If none is given, the block will be named 'BlockN' 
-            *               where N is a monotonically increasing number
+            * \param name   Name of the basic block. Blocks created by a control flow graph are
+            *               named 'BlockN' where N is the number of blocks created before it in the graph.
             */
-            BasicBlock(const std::string& name = "") : mInstructions{}
-            {
-                // OK since we won't create multiple blocks in parallel
-                static size_t blockNumber = 0;
-
-                if (name.empty())
-                    mName = "Block" + std::to_string(blockNumber++);
-                else
-                    mName = name;
-            }
+            explicit BasicBlock(const std::string& name) : mInstructions{}, mName{ name }, mGraphVersion{ nullptr } { }
 
         public:
             using inst_iterator = typename std::vector<std::unique_ptr<InstT>>::iterator;
-            using inst_const_iterator = typename std::vector<std::shared_ptr<InstT>>::const_iterator;
+            using inst_const_iterator = typename std::vector<std::unique_ptr<InstT>>::const_iterator;
 
             using bb_iterator = typename BlockList<InstT>::iterator;
             using bb_const_iterator = typename BlockList<InstT>::const_iterator;
@@ -76,9 +70,9 @@ namespace TosLang
             * \fn           InsertBranch
             * \brief        Adds a branch to a basic block. Note that this function 
             *               is not responsible for adding machine instructions to the basic block.
-            * \param block  Basic block to branch to 
+            * \param block  Basic block to branch to. It must be owned by a BlockPtr.
             */
-            void InsertBranch(BasicBlock<InstT>* block) { mSuccBlocks.emplace_back(std::shared_ptr<BasicBlock<InstT>>(block)); }
+            void InsertBranch(BasicBlock<InstT>* block) { InsertBranch(block->shared_from_this()); }
 
             /*
             * \fn           InsertBranch
@@ -86,7 +80,63 @@ namespace TosLang
             *               is not responsible for adding machine instructions to the basic block.
             * \param block  Basic block to branch to
             */
-            void InsertBranch(const BlockPtr<InstT>& block) { mSuccBlocks.push_back(block); }
+            void InsertBranch(const BlockPtr<InstT>& block)
+            {
+                mSuccBlocks.push_back(block);
+                block->mPredBlocks.push_back(this->shared_from_this());
+                NotifyGraphChanged();
+            }
+
+            /*
+            * \fn           RemoveBranch
+            * \brief        Removes one of the branches of the block. Note that this function
+            *               is not responsible for removing machine instructions from the basic block.
+            * \param succIdx Index of the branch among the successors of the block
+            * \return       Index the block had among the predecessors of the block it branched to
+            */
+            size_t RemoveBranch(const size_t succIdx)
+            {
+                BlockPtr<InstT> succBlock = mSuccBlocks[succIdx];
+                mSuccBlocks.erase(mSuccBlocks.begin() + succIdx);
+
+                auto predIt = std::find_if(succBlock->mPredBlocks.begin(), succBlock->mPredBlocks.end(),
+                                           [this](const BlockPtr<InstT>& pred) { return pred.get() == this; });
+                const size_t predIdx = std::distance(succBlock->mPredBlocks.begin(), predIt);
+                succBlock->mPredBlocks.erase(predIt);
+                NotifyGraphChanged();
+                return predIdx;
+            }
+
+            /*
+            * \fn           ReplaceBranch
+            * \brief        Makes one of the branches of the block go to another block. The branch keeps its place among 
+            *               the successors of the block, so that the branch instruction of the block is still correct.
+            * \param succIdx Index of the branch among the successors of the block
+            * \param block  Basic block to branch to instead
+            */
+            void ReplaceBranch(const size_t succIdx, const BlockPtr<InstT>& block)
+            {
+                BlockPtr<InstT> succBlock = mSuccBlocks[succIdx];
+                auto predIt = std::find_if(succBlock->mPredBlocks.begin(), succBlock->mPredBlocks.end(),
+                                           [this](const BlockPtr<InstT>& pred) { return pred.get() == this; });
+                succBlock->mPredBlocks.erase(predIt);
+
+                mSuccBlocks[succIdx] = block;
+                block->mPredBlocks.push_back(this->shared_from_this());
+                NotifyGraphChanged();
+            }
+
+            /*
+            * \fn       RemoveBranches
+            * \brief    Forgets the predecessors and successors of the block. Blocks refer to each other,
+            *           so this is what allows a graph containing cycles to be destroyed.
+            */
+            void RemoveBranches()
+            {
+                mSuccBlocks.clear();
+                mPredBlocks.clear();
+                NotifyGraphChanged();
+            }
 
             /*
             * \fn           InsertInstruction
@@ -102,6 +152,17 @@ namespace TosLang
             */
             void InsertInstruction(const InstT& inst) { mInstructions.emplace_back(std::make_unique<InstT>(inst)); }
 
+            /*
+            * \fn           InsertInstruction
+            * \brief        Inserts a virtual instruction in the basic block, before the instruction at a given position
+            * \param instIdx    Position of the instruction in the block
+            * \param inst   Instruction to be added
+            */
+            void InsertInstruction(const size_t instIdx, const InstT& inst) 
+            { 
+                mInstructions.insert(mInstructions.begin() + instIdx, std::make_unique<InstT>(inst)); 
+            }
+
             /*
             * \fn               ReplaceInstruction
             * \brief            Replaces an instruction in the block
@@ -123,6 +184,22 @@ namespace TosLang
                 }
             }
 
+            /*
+            * \fn           RemoveInstructions
+            * \brief        Removes the instructions of the block satisfying a predicate. The others keep their order.
+            * \param pred   Predicate taking an instruction, true if the instruction must be removed
+            * \return       Number of instructions removed
+            */
+            template <class Pred>
+            size_t RemoveInstructions(Pred pred)
+            {
+                auto newEnd = std::remove_if(mInstructions.begin(), mInstructions.end(),
+                                             [&pred](const std::unique_ptr<InstT>& inst) { return pred(*inst); });
+                const size_t nbRemoved = std::distance(newEnd, mInstructions.end());
+                mInstructions.erase(newEnd, mInstructions.end());
+                return nbRemoved;
+            }
+
         public:
             /*
             * \fn       GetName
@@ -157,11 +234,25 @@ namespace TosLang
             */
             InstT* GetTerminator() const { return mInstructions.back().get(); }
 
+        private:
+            /*
+            * \fn       NotifyGraphChanged
+            * \brief    Tells the graph owning the block that its branches changed, so that it analyzes them again
+            */
+            void NotifyGraphChanged()
+            {
+                if (mGraphVersion != nullptr)
+                    ++*mGraphVersion;
+            }
+
+            friend class ControlFlowGraph<InstT>;
+
         private:
             std::vector<std::unique_ptr<InstT>> mInstructions;  /*!< Instructions making up the basic block */
             BlockList<InstT> mSuccBlocks;                       /*!< List of blocks pointed to by the outgoing edges of the block */
             BlockList<InstT> mPredBlocks;                       /*!< List of blocks that points to the block */
             std::string mName;                                  /*<! Name of the basic block. For printing and debugginf purposes */
+            size_t* mGraphVersion;                              /*!< Version of the branches of the graph owning the block. Nullptr if no graph owns it. */
         };
     }
 }
@@ -0,0 +1,505 @@
+#ifndef CFG_ANALYSIS__TOSLANG
+#define CFG_ANALYSIS__TOSLANG
+
+#include "basicblock.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace TosLang
+{
+    namespace BackEnd
+    {
+        /*
+        * \class CFGAnalysis
+        * \brief Structure of the control flow of a graph: reverse post-order of its blocks, dominator tree,
+        *        dominance frontiers and natural loops. Only the blocks reachable from the entry block are analyzed,
+        *        the other ones are ignored by every query. Nothing is computed recursively, so that the
+        *        deepest graphs can be analyzed, and every computation is close to linear in the size of the graph.
+        */
+        template <class InstT>
+        class CFGAnalysis
+        {
+        public:
+            using Block = BasicBlock<InstT>;
+
+            static constexpr size_t INVALID_INDEX = std::numeric_limits<size_t>::max();
+
+            /*
+            * \struct   Loop
+            * \brief    Natural loop: a header dominating all the blocks of the loop,
+            *           and the blocks branching back to it from inside of the loop
+            */
+            struct Loop
+            {
+                Block* mHeader;                 /*!< Only block of the loop reached from outside of it */
+                std::vector<Block*> mBlocks;    /*!< Blocks of the loop, those of nested loops included, in reverse post-order. The header comes first. */
+                std::vector<Block*> mLatches;   /*!< Blocks of the loop branching back to its header */
+                size_t mParent;                 /*!< Index of the innermost loop containing this one. INVALID_INDEX for an outermost loop. */
+                size_t mDepth;                  /*!< Number of loops containing the blocks of this one, itself included */
+            };
+
+        public:
+            /*
+            * \fn           Compute
+            * \brief        Analyzes a graph, replacing the results of the previous analysis
+            * \param blocks Blocks of the graph. The first one is the entry block.
+            */
+            void Compute(const BlockList<InstT>& blocks)
+            {
+                ComputeRPO(blocks);
+                ComputeDominators();
+                ComputeDominatorTree();
+                ComputeDominanceFrontiers();
+                ComputeLoops();
+            }
+
+        public:
+            /*
+            * \fn           IsReachable
+            * \brief        Indicates if a block can be reached from the entry block
+            * \param block  Block
+            * \return       True if the block is reachable
+            */
+            bool IsReachable(const Block* block) const { return mRPONumbers.find(block) != mRPONumbers.end(); }
+
+            /*
+            * \fn           GetRPONumber
+            * \brief        Gives the position of a block in the reverse post-order of the graph.
+            *               A block comes before all its successors, except the ones it branches back to.
+            * \param block  Block
+            * \return       Position of the block. INVALID_INDEX for an unreachable block.
+            */
+            size_t GetRPONumber(const Block* block) const
+            {
+                auto numIt = mRPONumbers.find(block);
+                return numIt == mRPONumbers.end() ? INVALID_INDEX : numIt->second;
+            }
+
+            /*
+            * \fn       GetRPOBlocks
+            * \brief    Gives access to the reachable blocks, in reverse post-order. The entry block comes first.
+            * \return   Reachable blocks
+            */
+            const std::vector<Block*>& GetRPOBlocks() const { return mRPOBlocks; }
+
+            /*
+            * \fn           GetImmediateDominator
+            * \brief        Gives the closest block through which all the paths going from the entry block to a block pass
+            * \param block  Block
+            * \return       Immediate dominator of the block. Nullptr for the entry block and the unreachable blocks.
+            */
+            Block* GetImmediateDominator(const Block* block) const
+            {
+                const size_t blockIdx = GetRPONumber(block);
+                return (blockIdx == INVALID_INDEX) || (blockIdx == 0) ? nullptr : mRPOBlocks[mIDoms[blockIdx]];
+            }
+
+            /*
+            * \fn           GetDominatedBlocks
+            * \brief        Gives the children of a block in the dominator tree, in reverse post-order
+            * \param block  Block
+            * \return       Blocks immediately dominated by the block
+            */
+            const std::vector<Block*>& GetDominatedBlocks(const Block* block) const
+            {
+                const size_t blockIdx = GetRPONumber(block);
+                return blockIdx == INVALID_INDEX ? mNoBlocks : mDomChildren[blockIdx];
+            }
+
+            /*
+            * \fn               Dominates
+            * \brief            Indicates if all the paths going from the entry block to a block pass through another one.
+            *                   A block dominates itself. Answered in constant time.
+            * \param domBlock   Dominating block
+            * \param block      Dominated block
+            * \return           True if domBlock dominates block
+            */
+            bool Dominates(const Block* domBlock, const Block* block) const
+            {
+                const size_t domIdx = GetRPONumber(domBlock);
+                const size_t blockIdx = GetRPONumber(block);
+                if ((domIdx == INVALID_INDEX) || (blockIdx == INVALID_INDEX))
+                    return false;
+
+                return DominatesIdx(domIdx, blockIdx);
+            }
+
+            /*
+            * \fn           GetDominanceFrontier
+            * \brief        Gives the blocks where the dominance of a block stops: those that aren't strictly
+            *               dominated by the block but have a predecessor that is dominated by it
+            * \param block  Block
+            * \return       Dominance frontier of the block, without duplicates
+            */
+            const std::vector<Block*>& GetDominanceFrontier(const Block* block) const
+            {
+                const size_t blockIdx = GetRPONumber(block);
+                return blockIdx == INVALID_INDEX ? mNoBlocks : mFrontiers[blockIdx];
+            }
+
+            /*
+            * \fn       GetLoops
+            * \brief    Gives access to the natural loops of the graph. A loop comes before the loops containing it.
+            * \return   Loops of the graph
+            */
+            const std::vector<Loop>& GetLoops() const { return mLoops; }
+
+            /*
+            * \fn           GetLoop
+            * \brief        Gives the innermost loop containing a block
+            * \param block  Block
+            * \return       Innermost loop of the block. Nullptr if the block isn't in a loop.
+            */
+            const Loop* GetLoop(const Block* block) const
+            {
+                const size_t blockIdx = GetRPONumber(block);
+                if ((blockIdx == INVALID_INDEX) || (mLoopIndices[blockIdx] == INVALID_INDEX))
+                    return nullptr;
+
+                return &mLoops[mLoopIndices[blockIdx]];
+            }
+
+            /*
+            * \fn           GetLoopDepth
+            * \brief        Gives the number of loops containing a block
+            * \param block  Block
+            * \return       Loop nesting depth of the block. 0 if the block isn't in a loop.
+            */
+            size_t GetLoopDepth(const Block* block) const
+            {
+                const Loop* loop = GetLoop(block);
+                return loop == nullptr ? 0 : loop->mDepth;
+            }
+
+            /*
+            * \fn           IsInLoop
+            * \brief        Indicates if a block is part of a loop, possibly through a loop nested in it
+            * \param block  Block
+            * \param loop   Loop, as given by this analysis
+            * \return       True if the loop contains the block
+            */
+            bool IsInLoop(const Block* block, const Loop& loop) const
+            {
+                const size_t blockIdx = GetRPONumber(block);
+                if (blockIdx == INVALID_INDEX)
+                    return false;
+
+                for (size_t loopIdx = mLoopIndices[blockIdx]; loopIdx != INVALID_INDEX; loopIdx = mLoops[loopIdx].mParent)
+                {
+                    if (&mLoops[loopIdx] == &loop)
+                        return true;
+                }
+
+                return false;
+            }
+
+        private:
+            /*
+            * \fn           ComputeRPO
+            * \brief        Numbers the reachable blocks in reverse post-order, and gathers their reachable predecessors
+            * \param blocks Blocks of the graph
+            */
+            void ComputeRPO(const BlockList<InstT>& blocks)
+            {
+                mRPONumbers.clear();
+                mRPOBlocks.clear();
+                if (blocks.empty())
+                {
+                    mPreds.clear();
+                    return;
+                }
+
+                mRPONumbers.reserve(blocks.size());
+                mRPOBlocks.reserve(blocks.size());
+
+                // Depth-first search keeping, for every block on the path, the index of the next successor to visit.
+                // A block is in mRPONumbers as soon as it is discovered so that it is only visited once.
+                std::vector<std::pair<Block*, size_t>> path;
+                mRPONumbers.emplace(blocks.front().get(), INVALID_INDEX);
+                path.emplace_back(blocks.front().get(), 0);
+                while (!path.empty())
+                {
+                    Block* block = path.back().first;
+                    const size_t succIdx = path.back().second;
+                    if (succIdx < block->GetSuccessors().size())
+                    {
+                        ++path.back().second;
+                        Block* succBlock = block->GetSuccessors()[succIdx].get();
+                        if (mRPONumbers.emplace(succBlock, INVALID_INDEX).second)
+                            path.emplace_back(succBlock, 0);
+                    }
+                    else
+                    {
+                        mRPOBlocks.push_back(block);
+                        path.pop_back();
+                    }
+                }
+
+                std::reverse(mRPOBlocks.begin(), mRPOBlocks.end());
+                for (size_t iBlock = 0; iBlock < mRPOBlocks.size(); ++iBlock)
+                    mRPONumbers[mRPOBlocks[iBlock]] = iBlock;
+
+                // Blocks can branch many times to the same block, but a predecessor is only kept once
+                mPreds.assign(mRPOBlocks.size(), {});
+                for (size_t iBlock = 0; iBlock < mRPOBlocks.size(); ++iBlock)
+                {
+                    std::vector<size_t>& preds = mPreds[iBlock];
+                    for (const BlockPtr<InstT>& predBlock : mRPOBlocks[iBlock]->GetPredecessors())
+                    {
+                        const size_t predIdx = GetRPONumber(predBlock.get());
+                        if (predIdx != INVALID_INDEX)
+                            preds.push_back(predIdx);
+                    }
+
+                    std::sort(preds.begin(), preds.end());
+                    preds.erase(std::unique(preds.begin(), preds.end()), preds.end());
+                }
+            }
+
+            /*
+            * \fn       ComputeDominators
+            * \brief    Finds the immediate dominator of every reachable block with the algorithm of:
+            *           Cooper, Harvey and Kennedy, "A Simple, Fast Dominance Algorithm".
+            *           Blocks are visited in reverse post-order, so graphs without irreducible loops only need two sweeps.
+            */
+            void ComputeDominators()
+            {
+                mIDoms.assign(mRPOBlocks.size(), INVALID_INDEX);
+                if (mRPOBlocks.empty())
+                    return;
+
+                mIDoms[0] = 0;
+
+                bool hasChanged = true;
+                while (hasChanged)
+                {
+                    hasChanged = false;
+                    for (size_t iBlock = 1; iBlock < mRPOBlocks.size(); ++iBlock)
+                    {
+                        // The parent of the block in the depth-first search comes before it, so a predecessor is always processed
+                        size_t newIDom = INVALID_INDEX;
+                        for (const size_t predIdx : mPreds[iBlock])
+                        {
+                            if (mIDoms[predIdx] != INVALID_INDEX)
+                                newIDom = newIDom == INVALID_INDEX ? predIdx : Intersect(predIdx, newIDom);
+                        }
+
+                        if (mIDoms[iBlock] != newIDom)
+                        {
+                            mIDoms[iBlock] = newIDom;
+                            hasChanged = true;
+                        }
+                    }
+                }
+            }
+
+            /*
+            * \fn       ComputeDominatorTree
+            * \brief    Links every block to the blocks it immediately dominates, and numbers the dominator tree
+            *           in pre-order and post-order so that dominance can be checked without walking the tree
+            */
+            void ComputeDominatorTree()
+            {
+                const size_t nbBlocks = mRPOBlocks.size();
+                mDomChildren.assign(nbBlocks, {});
+                mDomChildIndices.assign(nbBlocks, {});
+                for (size_t iBlock = 1; iBlock < nbBlocks; ++iBlock)
+                {
+                    mDomChildren[mIDoms[iBlock]].push_back(mRPOBlocks[iBlock]);
+                    mDomChildIndices[mIDoms[iBlock]].push_back(iBlock);
+                }
+
+                mDomPreNumbers.assign(nbBlocks, 0);
+                mDomPostNumbers.assign(nbBlocks, 0);
+                if (nbBlocks == 0)
+                    return;
+
+                size_t preNumber = 0;
+                size_t postNumber = 0;
+                std::vector<std::pair<size_t, size_t>> path;
+                mDomPreNumbers[0] = preNumber++;
+                path.emplace_back(0, 0);
+                while (!path.empty())
+                {
+                    const size_t blockIdx = path.back().first;
+                    const size_t childPos = path.back().second;
+                    if (childPos < mDomChildIndices[blockIdx].size())
+                    {
+                        ++path.back().second;
+                        const size_t childIdx = mDomChildIndices[blockIdx][childPos];
+                        mDomPreNumbers[childIdx] = preNumber++;
+                        path.emplace_back(childIdx, 0);
+                    }
+                    else
+                    {
+                        mDomPostNumbers[blockIdx] = postNumber++;
+                        path.pop_back();
+                    }
+                }
+            }
+
+            /*
+            * \fn       ComputeDominanceFrontiers
+            * \brief    Computes the dominance frontier of every reachable block with the algorithm of Cooper, Harvey and Kennedy:
+            *           a block with many predecessors is in the frontier of the blocks going from each predecessor up
+            *           the dominator tree, until its immediate dominator is reached.
+            */
+            void ComputeDominanceFrontiers()
+            {
+                mFrontiers.assign(mRPOBlocks.size(), {});
+                for (size_t iBlock = 0; iBlock < mRPOBlocks.size(); ++iBlock)
+                {
+                    if (mPreds[iBlock].size() < 2)
+                        continue;
+
+                    // The entry block has no immediate dominator, so the walk goes up to the root of the tree
+                    const size_t stopIdx = iBlock == 0 ? INVALID_INDEX : mIDoms[iBlock];
+                    for (const size_t predIdx : mPreds[iBlock])
+                    {
+                        for (size_t runnerIdx = predIdx; runnerIdx != stopIdx; runnerIdx = mIDoms[runnerIdx])
+                        {
+                            // The frontiers are filled one block at a time, so a duplicate can only be the last block added
+                            std::vector<Block*>& frontier = mFrontiers[runnerIdx];
+                            if (frontier.empty() || (frontier.back() != mRPOBlocks[iBlock]))
+                                frontier.push_back(mRPOBlocks[iBlock]);
+
+                            if (runnerIdx == 0)
+                                break;
+                        }
+                    }
+                }
+            }
+
+            /*
+            * \fn       ComputeLoops
+            * \brief    Finds the natural loops of the graph and how they nest. A loop has a header dominating the blocks
+            *           branching back to it, and is made of the blocks reaching those without going through the header.
+            *           Headers are visited in post-order, so that inner loops are found first. The blocks of an inner loop are then
+            *           skipped by going straight to its header, which keeps the search linear in the size of the graph.
+            *           Loops whose entry doesn't dominate the rest of the loop (irreducible loops) aren't reported.
+            */
+            void ComputeLoops()
+            {
+                mLoops.clear();
+                mLoopHeaders.clear();
+                mLoopIndices.assign(mRPOBlocks.size(), INVALID_INDEX);
+
+                std::vector<size_t> worklist;
+                for (size_t headerIdx = mRPOBlocks.size(); headerIdx-- > 0;)
+                {
+                    for (const size_t predIdx : mPreds[headerIdx])
+                    {
+                        if (DominatesIdx(headerIdx, predIdx))
+                            worklist.push_back(predIdx);
+                    }
+
+                    if (worklist.empty())
+                        continue;
+
+                    const size_t loopIdx = mLoops.size();
+                    Loop loop{ mRPOBlocks[headerIdx], {}, {}, INVALID_INDEX, 0 };
+                    for (const size_t latchIdx : worklist)
+                        loop.mLatches.push_back(mRPOBlocks[latchIdx]);
+
+                    mLoops.push_back(std::move(loop));
+                    mLoopHeaders.push_back(headerIdx);
+                    mLoopIndices[headerIdx] = loopIdx;
+
+                    while (!worklist.empty())
+                    {
+                        const size_t blockIdx = worklist.back();
+                        worklist.pop_back();
+
+                        if (mLoopIndices[blockIdx] == INVALID_INDEX)
+                        {
+                            mLoopIndices[blockIdx] = loopIdx;
+                            worklist.insert(worklist.end(), mPreds[blockIdx].begin(), mPreds[blockIdx].end());
+                            continue;
+                        }
+
+                        // The block is in a loop found before: the outermost loop containing it is nested in this one
+                        size_t innerIdx = mLoopIndices[blockIdx];
+                        while (mLoops[innerIdx].mParent != INVALID_INDEX)
+                            innerIdx = mLoops[innerIdx].mParent;
+
+                        if (innerIdx != loopIdx)
+                        {
+                            mLoops[innerIdx].mParent = loopIdx;
+                            const size_t innerHeaderIdx = mLoopHeaders[innerIdx];
+                            worklist.insert(worklist.end(), mPreds[innerHeaderIdx].begin(), mPreds[innerHeaderIdx].end());
+                        }
+                    }
+                }
+
+                // A loop is found after the loops nested in it
+                for (size_t loopIdx = mLoops.size(); loopIdx-- > 0;)
+                {
+                    const size_t parentIdx = mLoops[loopIdx].mParent;
+                    mLoops[loopIdx].mDepth = parentIdx == INVALID_INDEX ? 1 : mLoops[parentIdx].mDepth + 1;
+                }
+
+                for (size_t iBlock = 0; iBlock < mRPOBlocks.size(); ++iBlock)
+                {
+                    for (size_t loopIdx = mLoopIndices[iBlock]; loopIdx != INVALID_INDEX; loopIdx = mLoops[loopIdx].mParent)
+                        mLoops[loopIdx].mBlocks.push_back(mRPOBlocks[iBlock]);
+                }
+            }
+
+            /*
+            * \fn           DominatesIdx
+            * \brief        Indicates if a block dominates another one, both given by their reverse post-order number
+            * \param domIdx Dominating block
+            * \param blockIdx   Dominated block
+            * \return       True if the first block dominates the second one
+            */
+            bool DominatesIdx(const size_t domIdx, const size_t blockIdx) const
+            {
+                return (mDomPreNumbers[domIdx] <= mDomPreNumbers[blockIdx]) && (mDomPostNumbers[blockIdx] <= mDomPostNumbers[domIdx]);
+            }
+
+            /*
+            * \fn           Intersect
+            * \brief        Finds the closest common dominator of two blocks, given the dominators known so far
+            * \param lhsIdx Reverse post-order number of the first block
+            * \param rhsIdx Reverse post-order number of the second block
+            * \return       Reverse post-order number of the common dominator
+            */
+            size_t Intersect(size_t lhsIdx, size_t rhsIdx) const
+            {
+                while (lhsIdx != rhsIdx)
+                {
+                    while (lhsIdx > rhsIdx)
+                        lhsIdx = mIDoms[lhsIdx];
+                    while (rhsIdx > lhsIdx)
+                        rhsIdx = mIDoms[rhsIdx];
+                }
+
+                return lhsIdx;
+            }
+
+        private:
+            std::unordered_map<const Block*, size_t> mRPONumbers;  /*!< Position of every reachable block in reverse post-order */
+            std::vector<Block*> mRPOBlocks;                         /*!< Reachable blocks, in reverse post-order */
+            std::vector<std::vector<size_t>> mPreds;                /*!< Distinct reachable predecessors of every block. Everything below is indexed by reverse post-order number. */
+
+            std::vector<size_t> mIDoms;                             /*!< Immediate dominator of every block. The entry block is its own dominator. */
+            std::vector<std::vector<Block*>> mDomChildren;          /*!< Blocks immediately dominated by every block */
+            std::vector<std::vector<size_t>> mDomChildIndices;      /*!< Blocks immediately dominated by every block, by number */
+            std::vector<size_t> mDomPreNumbers;                     /*!< Position of every block in a pre-order walk of the dominator tree */
+            std::vector<size_t> mDomPostNumbers;                    /*!< Position of every block in a post-order walk of the dominator tree */
+            std::vector<std::vector<Block*>> mFrontiers;            /*!< Dominance frontier of every block */
+
+            std::vector<Loop> mLoops;                               /*!< Natural loops of the graph, inner loops first */
+            std::vector<size_t> mLoopHeaders;                       /*!< Number of the header of every loop */
+            std::vector<size_t> mLoopIndices;                       /*!< Innermost loop of every block. INVALID_INDEX for a block outside of any loop. */
+
+            std::vector<Block*> mNoBlocks;                          /*!< Answer to the queries about unreachable blocks */
+        };
+    }
+}
+
+#endif // CFG_ANALYSIS__TOSLANG
@@ -2,6 +2,11 @@
 #define CONTROL_FLOW_GRAPH__TOSLANG
 
 #include "basicblock.h"
+#include "cfganalysis.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
 
 namespace TosLang
 {
@@ -16,7 +21,19 @@ namespace TosLang
         class ControlFlowGraph
         {
         public:
-            virtual ~ControlFlowGraph() = default;
+            ControlFlowGraph() : mNbBlocksCreated{ 0 }, mVersion{ 0 }, mAnalysisVersion{ INVALID_VERSION } { }
+
+            virtual ~ControlFlowGraph()
+            {
+                for (auto& block : mBlocks)
+                {
+                    block->RemoveBranches();
+                    block->mGraphVersion = nullptr;
+                }
+            }
+
+            ControlFlowGraph(const ControlFlowGraph&) = delete;
+            ControlFlowGraph& operator=(const ControlFlowGraph&) = delete;
 
         public:
             /*
@@ -29,6 +46,31 @@ namespace TosLang
                 return mBlocks.front();
             }
 
+            /*
+            * \fn       GetBlocks
+            * \brief    Gives access to the blocks of the graph, in creation order
+            * \return   Blocks of the graph
+            */
+            const BlockList<InstT>& GetBlocks() const { return mBlocks; }
+
+            /*
+            * \fn       GetAnalysis
+            * \brief    Gives access to the dominators, dominance frontiers and loops of the graph. They are computed
+            *           on the first call following a change to the blocks or the branches of the graph, and kept until
+            *           the next change. The returned analysis stays valid, but is updated by a later call.
+            * \return   Analysis of the graph
+            */
+            const CFGAnalysis<InstT>& GetAnalysis() const
+            {
+                if (mAnalysisVersion != mVersion)
+                {
+                    mAnalysis.Compute(mBlocks);
+                    mAnalysisVersion = mVersion;
+                }
+
+                return mAnalysis;
+            }
+
             /*
             * \fn       CreateNewBlock
             * \brief    Creates a new block in the CFG. It is the caller's responsibility 
@@ -37,8 +79,23 @@ namespace TosLang
             */
             BlockPtr<InstT> CreateNewBlock()
             {
-                BlockPtr<InstT> newBlock = std::make_shared<BasicBlock<InstT>>();
+                return CreateNewBlock("Block" + std::to_string(mNbBlocksCreated));
+            }
+
+            /*
+            * \fn           CreateNewBlock
+            * \brief        Creates a new block with a given name in the CFG, e.g. when reading back a graph. 
+            *               It is the caller's responsibility to correctly link the new block with the others in the CFG
+            * \param name   Name of the block
+            * \return       Newly created block
+            */
+            BlockPtr<InstT> CreateNewBlock(const std::string& name)
+            {
+                BlockPtr<InstT> newBlock = std::make_shared<BasicBlock<InstT>>(name);
+                newBlock->mGraphVersion = &mVersion;
                 mBlocks.push_back(newBlock);
+                ++mNbBlocksCreated;
+                ++mVersion;
                 return newBlock;
             }
 
@@ -51,17 +108,53 @@ namespace TosLang
             */
             BlockPtr<InstT> CreateNewBlock(std::vector<InstT>&& insts)
             {
-                BlockPtr<InstT> newBlock = std::make_shared<BasicBlock<InstT>>();
+                BlockPtr<InstT> newBlock = CreateNewBlock();
 
                 for (auto& inst : insts)
                     newBlock->InsertInstruction(inst);
 
-                mBlocks.push_back(newBlock);
                 return newBlock;
             }
 
+            /*
+            * \fn           RemoveBlocks
+            * \brief        Removes the blocks of the graph satisfying a predicate, along with their branches. It is the
+            *               caller's responsibility to first remove the branches going from them to the blocks that remain,
+            *               so that the instructions of those blocks can be updated. The entry block can't be removed.
+            * \param pred   Predicate taking a block, true if the block must be removed
+            * \return       Number of blocks removed
+            */
+            template <class Pred>
+            size_t RemoveBlocks(Pred pred)
+            {
+                assert(mBlocks.empty() || !pred(*mBlocks.front()));
+
+                auto newEnd = std::stable_partition(mBlocks.begin(), mBlocks.end(), 
+                                                    [&pred](const BlockPtr<InstT>& block) { return !pred(*block); });
+
+                for (auto blockIt = newEnd; blockIt != mBlocks.end(); ++blockIt)
+                {
+                    (*blockIt)->RemoveBranches();
+                    (*blockIt)->mGraphVersion = nullptr;
+                }
+
+                const size_t nbRemoved = std::distance(newEnd, mBlocks.end());
+                mBlocks.erase(newEnd, mBlocks.end());
+                ++mVersion;
+                return nbRemoved;
+            }
+
+        private:
+            static constexpr size_t INVALID_VERSION = std::numeric_limits<size_t>::max();
+
         protected:
-            BlockList<InstT> mBlocks;  /*!< Blocks contained in the CFG */
+            BlockList<InstT> mBlocks;   /*!< Blocks contained in the CFG */
+            size_t mNbBlocksCreated;    /*!< Number of blocks created so far, used to name them */
+
+        private:
+            size_t mVersion;                        /*!< Incremented whenever blocks or branches are added to or removed from the graph */
+            mutable CFGAnalysis<InstT> mAnalysis;   /*!< Analysis of the graph, computed on demand */
+            mutable size_t mAnalysisVersion;        /*!< Version of the graph when it was last analyzed */
         };
     }
 }
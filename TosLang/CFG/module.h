@@ -5,7 +5,9 @@
 
 #include "../Utils/cfgprinter.h"
 
-#include <unordered_map>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace TosLang
 {
@@ -15,7 +17,7 @@ namespace TosLang
         using CFGPtr = std::shared_ptr<ControlFlowGraph<InstT>>;
 
         template <class InstT>
-        using FunctionCFGs = std::unordered_map<std::string, CFGPtr<InstT>>;
+        using FunctionCFGs = std::vector<std::pair<std::string, CFGPtr<InstT>>>;
         
         /*
         * \class Module
@@ -77,13 +79,14 @@ namespace TosLang
         public:
             /*
             * \fn           InsertFunction
-            * \brief        Inserts a function in the module
+            * \brief        Inserts a function in the module, after the functions already in it.
+            *               Overloads of a function each get their own control flow graph.
             * \param name   The name of the function
             * \param cfg    The control flow graph associated with the function
             */
             void InsertFunction(const std::string& name, const CFGPtr<InstT>& cfg)
             {
-                mFuncCFGs[name] = cfg;
+                mFuncCFGs.emplace_back(name, cfg);
             }
 
             /*
@@ -98,7 +101,7 @@ namespace TosLang
             }
 
         private:
-            FunctionCFGs<InstT> mFuncCFGs;  /*!< Functions in the translation unit. TODO: First == globals container? */
+            FunctionCFGs<InstT> mFuncCFGs;  /*!< Functions in the translation unit, in declaration order */
             BlockPtr<InstT> mGlobalBlock;          /*!< TODO */
         };
     }
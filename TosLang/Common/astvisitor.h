@@ -3,7 +3,7 @@
 
 #include "../AST/ast.h"
 
-#include <functional>
+#include <vector>
 
 namespace TosLang
 {
@@ -12,13 +12,17 @@ namespace TosLang
         /*
         * \class ASTVisitor
         * \brief Tree visitor that does a traversal of the AST.
-        *        It is based on CRTP, so any derived class should provide itself as the template argument
+        *        It is based on CRTP, so any derived class should provide itself as the template argument.
+        *        The node handlers and the prologue/epilogue hooks are resolved at compile time, which lets
+        *        the compiler inline them in the traversal.
+        *        The traversal keeps the path to the current node on an explicit stack instead of recursing
+        *        once per level, so that deep trees can't overflow the native stack.
         */
         template <typename Derived>
         class ASTVisitor
         {
         public:
-            ASTVisitor() : mCurrentNode(nullptr) { }
+            ASTVisitor() : mCurrentNode(nullptr), mTraversalStack(M_INITIAL_STACK_CAPACITY) { }
             ~ASTVisitor() = default;
 
         protected:
@@ -29,19 +33,7 @@ namespace TosLang
             */
             void VisitPostOrder(const std::unique_ptr<FrontEnd::ASTNode>& root)
             {
-                if (root != nullptr)
-                {
-                    mCurrentNode = root.get();
-                    mPrologueFtr();
-
-                    for (auto& childNode : root->GetChildrenNodes())
-                        VisitPostOrder(childNode);
-
-                    mCurrentNode = root.get();
-                    DispatchNode(root.get());
-                 
-                    mEpilogueFtr();
-                }
+                Traverse<false>(root.get());
             }
 
             /*
@@ -51,20 +43,21 @@ namespace TosLang
             */
             void VisitPreOrder(const std::unique_ptr<FrontEnd::ASTNode>& root)
             {
-                if (root != nullptr)
-                {
-                    mCurrentNode = root.get();
-                    mPrologueFtr();
-                    
-                    DispatchNode(root.get());
+                Traverse<true>(root.get());
+            }
 
-                    for (auto& childNode : root->GetChildrenNodes())
-                        VisitPreOrder(childNode);
+        protected:  // Traversal hooks
+            /*
+            * \fn       NodePrologue
+            * \brief    Called when entering a node, before any of its children or itself is handled
+            */
+            void NodePrologue() { }
 
-                    mCurrentNode = root.get();
-                    mEpilogueFtr();
-                }
-            }
+            /*
+            * \fn       NodeEpilogue
+            * \brief    Called when leaving a node, after all of its children and itself were handled
+            */
+            void NodeEpilogue() { }
 
         protected:  // Declarations
             /*
@@ -184,6 +177,120 @@ namespace TosLang
             void HandleWhileStmt() { }
 
         private:
+            /*
+            * \struct  TraversalFrame
+            * \brief   Node on the path from the root of the traversal to the current node
+            */
+            struct TraversalFrame
+            {
+                FrontEnd::ASTNode* mNode;                               /*!< Node whose children are being visited */
+                const std::unique_ptr<FrontEnd::ASTNode>* mChildIt;     /*!< Next child of the node to visit */
+                const std::unique_ptr<FrontEnd::ASTNode>* mChildEnd;    /*!< End of the children of the node */
+            };
+
+            constexpr static size_t M_INITIAL_STACK_CAPACITY = 256;
+
+        private:
+            /*
+            * \fn               Traverse
+            * \brief            Visit the tree rooted at root without recursing once per level of the tree
+            * \param root       Root node of the tree to visit
+            * \tparam isPreOrder Is a node handled before its children? It is handled after them otherwise.
+            */
+            template <bool isPreOrder>
+            void Traverse(FrontEnd::ASTNode* root)
+            {
+                if (root == nullptr)
+                    return;
+
+                // The stack of the previous traversals is reused. A traversal started by a handler gets a stack of its own.
+                std::vector<TraversalFrame> stack = std::move(mTraversalStack);
+                if (stack.empty())
+                    stack.resize(M_INITIAL_STACK_CAPACITY);
+
+                size_t depth = 0;
+                if (EnterNode<isPreOrder>(root))
+                    stack[depth++] = MakeFrame(root);
+
+                while (depth > 0)
+                {
+                    TraversalFrame& frame = stack[depth - 1];
+                    if (frame.mChildIt != frame.mChildEnd)
+                    {
+                        FrontEnd::ASTNode* child = (frame.mChildIt++)->get();
+                        if ((child != nullptr) && EnterNode<isPreOrder>(child))
+                        {
+                            if (depth == stack.size())
+                                stack.resize(2 * depth);
+
+                            stack[depth++] = MakeFrame(child);
+                        }
+                    }
+                    else
+                    {
+                        FrontEnd::ASTNode* node = frame.mNode;
+                        --depth;
+                        LeaveNode<isPreOrder>(node);
+                    }
+                }
+
+                mTraversalStack = std::move(stack);
+            }
+
+            /*
+            * \fn               EnterNode
+            * \brief            Starts the visit of a node, before any of its children is visited.
+            *                   A leaf is visited completely right away.
+            * \param node       Visited node
+            * \tparam isPreOrder Is the node handled before its children?
+            * \return           True if the children of the node still have to be visited
+            */
+            template <bool isPreOrder>
+            bool EnterNode(FrontEnd::ASTNode* node)
+            {
+                mCurrentNode = node;
+                GetDerived().NodePrologue();
+
+                if (isPreOrder)
+                    DispatchNode(node);
+
+                if (node->GetChildrenNodes().empty())
+                {
+                    LeaveNode<isPreOrder>(node);
+                    return false;
+                }
+
+                return true;
+            }
+
+            /*
+            * \fn               LeaveNode
+            * \brief            Ends the visit of a node, once all of its children were visited
+            * \param node       Visited node
+            * \tparam isPreOrder Was the node handled before its children?
+            */
+            template <bool isPreOrder>
+            void LeaveNode(FrontEnd::ASTNode* node)
+            {
+                mCurrentNode = node;
+                if (!isPreOrder)
+                    DispatchNode(node);
+
+                GetDerived().NodeEpilogue();
+            }
+
+            /*
+            * \fn           MakeFrame
+            * \brief        Creates the frame visiting the children of a node
+            * \param node   Node whose children are visited
+            * \return       Frame pointing to the first child of the node
+            */
+            static TraversalFrame MakeFrame(FrontEnd::ASTNode* node)
+            {
+                const FrontEnd::ChildrenNodes& children = node->GetChildrenNodes();
+                return { node, children.data(), children.data() + children.size() };
+            }
+
             /*
             * \fn       GetDerived
             * \brief    Gets a reference to the current derived class of ASTVisitor
@@ -270,8 +377,9 @@ namespace TosLang
 
         protected:
             FrontEnd::ASTNode* mCurrentNode;        /*!< Current node being handled in the traversal */
-            std::function<void()> mPrologueFtr;     /*!< Functor to be called when entering a node */
-            std::function<void()> mEpilogueFtr;     /*!< Functor to be called when leaving a node */
+
+        private:
+            std::vector<TraversalFrame> mTraversalStack;    /*!< Memory of the stack holding the path from the root of the traversal to the current node */
         };
     }
 }
@@ -0,0 +1,209 @@
+#include "internedstring.h"
+
+#include <atomic>
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+using namespace TosLang::Common;
+
+namespace
+{
+    constexpr unsigned FIRST_CHUNK_BITS = 8;
+    constexpr uint32_t FIRST_CHUNK_SIZE = 1u << FIRST_CHUNK_BITS;
+    constexpr size_t NB_CHUNKS = 32 - FIRST_CHUNK_BITS;     // Chunk i holds FIRST_CHUNK_SIZE << i strings
+    constexpr size_t FIRST_TABLE_SIZE = 1024;
+
+    unsigned HighestBit(uint32_t value)
+    {
+#if defined(_MSC_VER)
+        unsigned long idx;
+        _BitScanReverse(&idx, value);
+        return static_cast<unsigned>(idx);
+#else
+        return 31 - static_cast<unsigned>(__builtin_clz(value));
+#endif
+    }
+
+    /*
+    * \struct   IDTable
+    * \brief    Open addressing hash table from strings to their ID. Each slot packs the upper half of
+    *           the hash of a string with its ID, 0 marking an empty slot since the empty string isn't in the table.
+    */
+    struct IDTable
+    {
+        explicit IDTable(size_t capacity) : mMask{ capacity - 1 }, mSlots{ new std::atomic<uint64_t>[capacity] }
+        {
+            for (size_t iSlot = 0; iSlot < capacity; ++iSlot)
+                mSlots[iSlot].store(0, std::memory_order_relaxed);
+        }
+
+        size_t mMask;
+        std::unique_ptr<std::atomic<uint64_t>[]> mSlots;
+    };
+
+    /*
+    * \struct   StringPool
+    * \brief    Storage of every interned string. Strings live in chunks which are never moved nor freed while
+    *           the program runs, so that looking a string up needs no lock. Only insertions are serialized.
+    */
+    struct StringPool
+    {
+        StringPool() : mSize{ 1 }, mIDs{ nullptr }
+        {
+            for (auto& chunk : mChunks)
+                chunk.store(nullptr, std::memory_order_relaxed);
+
+            // The first chunk holds the empty string
+            mChunks[0].store(new std::string[FIRST_CHUNK_SIZE], std::memory_order_release);
+            mTables.emplace_back(new IDTable{ FIRST_TABLE_SIZE });
+            mIDs.store(mTables.back().get(), std::memory_order_release);
+        }
+
+        ~StringPool()
+        {
+            for (auto& chunk : mChunks)
+                delete[] chunk.load(std::memory_order_relaxed);
+        }
+
+        std::mutex mMutex;                                  /*!< Serializes the insertions */
+        std::atomic<std::string*> mChunks[NB_CHUNKS];       /*!< Chunks of strings, allocated as the pool grows */
+        std::atomic<uint32_t> mSize;                        /*!< Number of strings in the pool */
+        std::atomic<IDTable*> mIDs;                         /*!< Current table of the IDs */
+        std::vector<std::unique_ptr<IDTable>> mTables;      /*!< Every table used so far, as a lookup may still be going through an old one */
+    };
+
+    StringPool& GetPool()
+    {
+        static StringPool pool;
+        return pool;
+    }
+
+    /*
+    * \fn       GetString
+    * \brief    Gives the string stored with the given ID
+    * \param id ID of the string
+    * \return   String stored with the ID
+    */
+    const std::string& GetString(const StringPool& pool, uint32_t id)
+    {
+        const uint32_t pos = id + FIRST_CHUNK_SIZE;
+        const unsigned highestBit = HighestBit(pos);
+        const std::string* chunk = pool.mChunks[highestBit - FIRST_CHUNK_BITS].load(std::memory_order_acquire);
+        return chunk[pos - (1u << highestBit)];
+    }
+
+    /*
+    * \fn           FindID
+    * \brief        Finds the ID of a string in a table
+    * \param pool   Pool holding the strings
+    * \param table  Table of the IDs
+    * \param str    String to find
+    * \param hash   Hash of the string
+    * \return       ID of the string. 0 if the string isn't in the table.
+    */
+    uint32_t FindID(const StringPool& pool, const IDTable& table, std::string_view str, uint64_t hash)
+    {
+        const uint64_t hashTag = hash & 0xFFFFFFFF00000000ull;
+        for (size_t iSlot = static_cast<size_t>(hash) & table.mMask;; iSlot = (iSlot + 1) & table.mMask)
+        {
+            const uint64_t slot = table.mSlots[iSlot].load(std::memory_order_acquire);
+            if (slot == 0)
+                return 0;
+
+            const uint32_t id = static_cast<uint32_t>(slot);
+            if (((slot & 0xFFFFFFFF00000000ull) == hashTag) && (GetString(pool, id) == str))
+                return id;
+        }
+    }
+
+    /*
+    * \fn           InsertID
+    * \brief        Adds the ID of a string to a table which doesn't hold the string yet
+    * \param table  Table of the IDs
+    * \param id     ID of the string
+    * \param hash   Hash of the string
+    */
+    void InsertID(IDTable& table, uint32_t id, uint64_t hash)
+    {
+        size_t iSlot = static_cast<size_t>(hash) & table.mMask;
+        while (table.mSlots[iSlot].load(std::memory_order_relaxed) != 0)
+            iSlot = (iSlot + 1) & table.mMask;
+
+        table.mSlots[iSlot].store((hash & 0xFFFFFFFF00000000ull) | id, std::memory_order_release);
+    }
+}
+
+/*
+* \fn           Intern
+* \brief        Finds the ID of a string, adding the string to the pool if needed
+* \param str    String to intern
+* \return       ID of the string
+*/
+uint32_t InternedString::Intern(std::string_view str)
+{
+    if (str.empty())
+        return 0;
+
+    StringPool& pool = GetPool();
+    const uint64_t hash = std::hash<std::string_view>{}(str);
+
+    // Most strings have been seen before, which needs no lock
+    uint32_t id = FindID(pool, *pool.mIDs.load(std::memory_order_acquire), str, hash);
+    if (id != 0)
+        return id;
+
+    std::lock_guard<std::mutex> lock{ pool.mMutex };
+    IDTable* table = pool.mIDs.load(std::memory_order_relaxed);
+    id = FindID(pool, *table, str, hash);
+    if (id != 0)
+        return id;
+
+    id = pool.mSize.load(std::memory_order_relaxed);
+    assert(id < std::numeric_limits<uint32_t>::max() - FIRST_CHUNK_SIZE);
+    const uint32_t pos = id + FIRST_CHUNK_SIZE;
+    const unsigned highestBit = HighestBit(pos);
+    std::atomic<std::string*>& chunk = pool.mChunks[highestBit - FIRST_CHUNK_BITS];
+    if (chunk.load(std::memory_order_relaxed) == nullptr)
+        chunk.store(new std::string[size_t{ 1 } << highestBit], std::memory_order_release);
+    chunk.load(std::memory_order_relaxed)[pos - (1u << highestBit)] = str;
+
+    // The table is kept at most half full. The bigger one is filled before it is published.
+    if (2 * (static_cast<size_t>(id) + 1) > table->mMask + 1)
+    {
+        pool.mTables.emplace_back(new IDTable{ 2 * (table->mMask + 1) });
+        table = pool.mTables.back().get();
+        for (uint32_t prevID = 1; prevID < id; ++prevID)
+            InsertID(*table, prevID, std::hash<std::string_view>{}(GetString(pool, prevID)));
+
+        pool.mIDs.store(table, std::memory_order_release);
+    }
+
+    InsertID(*table, id, hash);
+    pool.mSize.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+/*
+* \fn       Lookup
+* \brief    Gives the string interned with the given ID
+* \param id ID of the string
+* \return   Content of the string
+*/
+const std::string& InternedString::Lookup(uint32_t id)
+{
+    const StringPool& pool = GetPool();
+    assert(id < pool.mSize.load(std::memory_order_acquire));
+    return GetString(pool, id);
+}
+
+size_t InternedString::GetPoolSize()
+{
+    return GetPool().mSize.load(std::memory_order_acquire);
+}
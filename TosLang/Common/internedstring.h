@@ -0,0 +1,89 @@
+#ifndef INTERNED_STRING_H__TOSLANG
+#define INTERNED_STRING_H__TOSLANG
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace TosLang
+{
+    namespace Common
+    {
+        /*
+        * \class InternedString
+        * \brief Compact handle to a string stored once in the string pool shared by the whole compiler.
+        *        Two handles refer to equal strings if and only if they have the same ID, which makes
+        *        comparing names an integer comparison. The pool can be used from any thread.
+        */
+        class InternedString
+        {
+        public:
+            /*
+            * \fn       InternedString
+            * \brief    Constructor of the empty string
+            */
+            InternedString() : mID{ 0 } { }
+
+            /*
+            * \fn       InternedString
+            * \brief    Constructor. Adds the string to the pool if it isn't already there.
+            * \param    str String to intern
+            */
+            InternedString(std::string_view str) : mID{ Intern(str) } { }
+            InternedString(const std::string& str) : mID{ Intern(str) } { }
+            InternedString(const char* str) : mID{ Intern(str) } { }
+
+        public:
+            /*
+            * \fn       GetID
+            * \brief    Gives the ID of the string in the pool
+            * \return   ID of the string, 0 being the empty string
+            */
+            uint32_t GetID() const { return mID; }
+
+            /*
+            * \fn       GetStr
+            * \brief    Gives the content of the string. It stays valid as long as the program runs.
+            * \return   Content of the string
+            */
+            const std::string& GetStr() const { return Lookup(mID); }
+
+            /*
+            * \fn       IsEmpty
+            * \brief    Indicates if the string is empty
+            * \return   True if the string is empty
+            */
+            bool IsEmpty() const { return mID == 0; }
+
+            /*
+            * \fn       GetPoolSize
+            * \brief    Gives the number of distinct strings interned so far
+            * \return   Number of strings in the pool, including the empty string
+            */
+            static size_t GetPoolSize();
+
+        public:
+            friend bool operator==(const InternedString& lhs, const InternedString& rhs) { return lhs.mID == rhs.mID; }
+            friend bool operator!=(const InternedString& lhs, const InternedString& rhs) { return lhs.mID != rhs.mID; }
+
+        private:
+            static uint32_t Intern(std::string_view str);
+            static const std::string& Lookup(uint32_t id);
+
+        private:
+            uint32_t mID;   /*!< Index of the string in the pool */
+        };
+    }
+}
+
+namespace std
+{
+    template <>
+    struct hash<TosLang::Common::InternedString>
+    {
+        size_t operator()(const TosLang::Common::InternedString& str) const { return std::hash<uint32_t>{}(str.GetID()); }
+    };
+}
+
+#endif // INTERNED_STRING_H__TOSLANG
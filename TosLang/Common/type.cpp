@@ -17,3 +17,16 @@ Type TosLang::Common::GetArrayVersion(const Type type)
 
     return tyToArrayTy[type];
 }
+
+Type TosLang::Common::GetScalarVersion(const Type type)
+{
+    static std::map<Type, Type> arrayTyToTy{
+        { Type::BOOL_ARRAY, Type::BOOL },
+        { Type::NUMBER_ARRAY, Type::NUMBER },
+        { Type::STRING_ARRAY, Type::STRING }
+    };
+
+    assert((type == Type::BOOL_ARRAY) || (type == Type::NUMBER_ARRAY) || (type == Type::STRING_ARRAY));
+
+    return arrayTyToTy[type];
+}
@@ -35,6 +35,14 @@ namespace TosLang
         * \return       Array version of the type given
         */
         Type GetArrayVersion(const Type type);
+
+        /*
+        * \fn           GetScalarVersion
+        * \param type   Type to convert
+        * \brief        Converts an array type to the type of its elements
+        * \return       Scalar version of the type given
+        */
+        Type GetScalarVersion(const Type type);
     }
 }
 
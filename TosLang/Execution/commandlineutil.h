@@ -9,6 +9,7 @@ namespace Execution
 {
     enum class ExecutionCommand
     {
+        CHECK,
         COMPILE_CHIP16,
         COMPILE_LLVM,
         DUMP_AST,
@@ -18,26 +19,90 @@ namespace Execution
         UNKNOWN,
     };
 
+    enum class StatsFormat
+    {
+        NONE,
+        TABLE,
+        JSON,
+    };
+
     struct ExecutionInfo
     {
         ExecutionCommand command;
-        std::string programFile;
+        std::vector<std::string> programFiles;
+        std::string cacheDirectory;             /*!< Directory of the compilation cache. Empty if incremental compilation is disabled. */
+        StatsFormat statsFormat;                /*!< How to report the measures of the compiler passes. NONE if they aren't measured. */
     };
 
     void ShowHelp()
     {
-        std::cout << "Correct usage: tc [options] <filename>"                                       << std::endl
+        std::cout << "Correct usage: tc [options] <filename>..."                                    << std::endl
                   << "Options:"                                                                     << std::endl
                   << "  -compile=                   Compiles the program to the specified format"   << std::endl
                   << "      chip16                  Chip16 assembly"                                << std::endl
                   << "      llvm                    LLVM intermediate representation"               << std::endl
+                  << "  -check                      Reports the errors of the program without running it" << std::endl
                   << "  -dump-ast                   Outputs the program AST to stdout"              << std::endl
                   << "  -dump-cfg                   Outputs the program CFG to stdout"              << std::endl
-                  << "  -interpret                  Executes the program through an interpreter"    << std::endl
-                  << "                              (Requires Tostitos to works)"                   << std::endl;
+                  << "  -interpret                  Executes the program with the bytecode virtual machine" << std::endl
+                  << "  -cache-dir=<directory>      Only recompiles the functions that changed since the last compilation." << std::endl
+                  << "                              Applies to -check and -dump-cfg"                << std::endl
+                  << "  -time-passes                Reports the time, memory and work of each compiler pass to stderr" << std::endl
+                  << "  -stats=                     Same as -time-passes, in the specified format"  << std::endl
+                  << "      table                   Table meant to be read by a human"              << std::endl
+                  << "      json                    JSON document meant to be read by tools"        << std::endl;
+    }
+
+    ExecutionInfo ParseCommand(const std::vector<std::string>& args);
+
+    ExecutionInfo ParseCommandLine(const std::vector<std::string>& cmdArgs)
+    {
+        // Settings can appear anywhere on the command line, the command and the files are what remains
+        const std::string cacheDirOption = "-cache-dir=";
+        std::string cacheDirectory;
+        StatsFormat statsFormat = StatsFormat::NONE;
+        std::vector<std::string> args;
+        for (const std::string& arg : cmdArgs)
+        {
+            if (arg.compare(0, cacheDirOption.size(), cacheDirOption) == 0)
+            {
+                cacheDirectory = arg.substr(cacheDirOption.size());
+            }
+            else if ((arg == "-time-passes") || (arg == "-stats") || (arg == "-stats=table"))
+            {
+                statsFormat = StatsFormat::TABLE;
+            }
+            else if (arg == "-stats=json")
+            {
+                statsFormat = StatsFormat::JSON;
+            }
+            else if (arg.compare(0, 7, "-stats=") == 0)
+            {
+                std::cout << "Unknown statistics format\n";
+                return{ ExecutionCommand::UNKNOWN };
+            }
+            else
+            {
+                args.push_back(arg);
+            }
+        }
+
+        ExecutionInfo info = ParseCommand(args);
+        if (!cacheDirectory.empty() && (info.command != ExecutionCommand::CHECK) && (info.command != ExecutionCommand::DUMP_CFG))
+        {
+            // The warning goes to stderr so that it doesn't mix with the output of the program
+            if (info.command != ExecutionCommand::UNKNOWN)
+                std::cerr << "Ignoring -cache-dir, which only applies to -check and -dump-cfg\n";
+
+            cacheDirectory.clear();
+        }
+
+        info.cacheDirectory = cacheDirectory;
+        info.statsFormat = statsFormat;
+        return info;
     }
 
-    ExecutionInfo ParseCommandLine(const std::vector<std::string>& args)
+    ExecutionInfo ParseCommand(const std::vector<std::string>& args)
     {
         if (args.size() < 3)
         {
@@ -57,7 +122,7 @@ namespace Execution
             else if (arg.find("llvm") != std::string::npos)
             {
 #ifdef USE_LLVM_BACKEND
-                return ExecutionCommand::COMPILE_LLVM;
+                return{ ExecutionCommand::COMPILE_LLVM, { args.begin() + 2, args.end() } };
 #else
                 std::cout << "Requires building TosLang with LLVM backend\n";
                 return{ ExecutionCommand::UNKNOWN };
@@ -69,18 +134,22 @@ namespace Execution
                 return{ ExecutionCommand::UNKNOWN };
             }
         }
+        else if (arg == "-check")
+        {
+            return{ ExecutionCommand::CHECK, { args.begin() + 2, args.end() } };
+        }
         else if (arg == "-dump-ast")
         {
-            return{ ExecutionCommand::DUMP_AST, args.back() };
+            return{ ExecutionCommand::DUMP_AST, { args.begin() + 2, args.end() } };
+        }
+        else if (arg == "-dump-cfg")
+        {
+            return{ ExecutionCommand::DUMP_CFG, { args.begin() + 2, args.end() } };
         }
-        //else if (arg == "-dump-cfg")
-        //{
-        //    return ExecutionCommand::DUMP_CFG;
-        //}
         else if (arg == "-dump-llvm")
         {
 #ifdef USE_LLVM_BACKEND
-            return ExecutionCommand::DUMP_LLVM;
+            return{ ExecutionCommand::DUMP_LLVM, { args.begin() + 2, args.end() } };
 #else
             std::cout << "Requires building TosLang with LLVM backend\n";
             return{ ExecutionCommand::UNKNOWN };
@@ -88,7 +157,7 @@ namespace Execution
         }
         else if (arg == "-interpret")
         {
-            return{ ExecutionCommand::INTERPRET, args.back() };
+            return{ ExecutionCommand::INTERPRET, { args.begin() + 2, args.end() } };
         }
         else
         {
@@ -0,0 +1,536 @@
+#include "compilationcache.h"
+
+#include "../AST/declarations.h"
+#include "../AST/expressions.h"
+#include "../Sema/symboltable.h"
+#include "../SSA/cfgbuilder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <tuple>
+#include <unordered_map>
+
+using namespace Execution;
+using namespace TosLang;
+using namespace TosLang::BackEnd;
+using namespace TosLang::FrontEnd;
+
+namespace
+{
+    // Bumped whenever the content of the keys or of the entries changes, which invalidates every entry
+    const uint64_t CACHE_FORMAT_VERSION = 1;
+    const char CACHE_MAGIC[] = { 'T', 'O', 'S', 'C' };
+
+    /*
+    * \class    KeyHasher
+    * \brief    64 bits FNV-1a hash. Values are hashed byte by byte in little endian order,
+    *           so that keys don't depend on the machine the cache was written on.
+    */
+    class KeyHasher
+    {
+    public:
+        KeyHasher() : mHash{ 14695981039346656037ull } { }
+
+        void AddBytes(const char* data, size_t size)
+        {
+            for (size_t iByte = 0; iByte < size; ++iByte)
+            {
+                mHash ^= static_cast<unsigned char>(data[iByte]);
+                mHash *= 1099511628211ull;
+            }
+        }
+
+        void AddInt(uint64_t value)
+        {
+            for (size_t iByte = 0; iByte < sizeof(value); ++iByte)
+            {
+                const char byte = static_cast<char>((value >> (8 * iByte)) & 0xFF);
+                AddBytes(&byte, 1);
+            }
+        }
+
+        void AddString(const std::string& str)
+        {
+            AddInt(str.size());
+            AddBytes(str.data(), str.size());
+        }
+
+        uint64_t GetHash() const { return mHash; }
+
+    private:
+        uint64_t mHash;
+    };
+
+    /*
+    * \fn               HashSymbolSignature
+    * \brief            Adds what the users of a function or a global variable depend on to a key
+    * \param sym        Symbol of the function or of the variable
+    * \param hasher     Key being computed
+    */
+    void HashSymbolSignature(const Symbol& sym, KeyHasher& hasher)
+    {
+        hasher.AddString(sym.GetName());
+
+        if (sym.IsFunction())
+        {
+            hasher.AddInt(static_cast<uint64_t>(sym.GetFunctionReturnType()));
+            const std::vector<Common::Type> paramTypes = sym.GetFunctionParamTypes();
+            hasher.AddInt(paramTypes.size());
+            for (Common::Type paramType : paramTypes)
+                hasher.AddInt(static_cast<uint64_t>(paramType));
+        }
+        else
+        {
+            hasher.AddInt(static_cast<uint64_t>(sym.GetVariableType()));
+            hasher.AddInt(static_cast<uint64_t>(sym.GetSize()));
+        }
+    }
+
+    /*
+    * \fn               HashSubtree
+    * \brief            Adds the nodes of a subtree and the signatures they depend on to a key. The nodes are scanned
+    *                   in pre-order, straight from the columns of the flat AST.
+    *                   Source locations are left out, so moving a function around doesn't change its key.
+    * \param flatAST    Flat AST holding the subtree
+    * \param rootID     Root of the subtree
+    * \param symTable   Symbol table of the program
+    * \param hasher     Key being computed
+    */
+    void HashSubtree(const FlatAST& flatAST, FlatAST::NodeID rootID, const SymbolTable& symTable, KeyHasher& hasher)
+    {
+        const FlatAST::NodeID endID = flatAST.GetSubtreeEnd(rootID);
+        for (FlatAST::NodeID id = rootID; id < endID; ++id)
+        {
+            if (flatAST.GetNode(id) == nullptr)
+            {
+                hasher.AddInt(~0ull);
+                continue;
+            }
+
+            const ASTNode::NodeKind kind = flatAST.GetKind(id);
+            hasher.AddInt(static_cast<uint64_t>(kind));
+            hasher.AddString(flatAST.GetName(id).GetStr());
+
+            switch (kind)
+            {
+            case ASTNode::NodeKind::FUNCTION_DECL:
+                hasher.AddInt(static_cast<uint64_t>(flatAST.GetType(id)));
+                break;
+            case ASTNode::NodeKind::VAR_DECL:
+                hasher.AddInt(static_cast<uint64_t>(flatAST.GetType(id)));
+                hasher.AddInt(static_cast<uint64_t>(flatAST.GetValue(id)));
+                break;
+            case ASTNode::NodeKind::BINARY_EXPR:
+            case ASTNode::NodeKind::BOOLEAN_EXPR:
+            case ASTNode::NodeKind::NUMBER_EXPR:
+                hasher.AddInt(static_cast<uint64_t>(flatAST.GetValue(id)));
+                break;
+            case ASTNode::NodeKind::STRING_EXPR:
+                hasher.AddString(static_cast<const StringExpr*>(flatAST.GetNode(id))->GetValue());
+                break;
+            case ASTNode::NodeKind::CALL_EXPR:
+                // The call may resolve to any function of the overload set
+                for (const Symbol* fnSym : symTable.GetOverloadCandidates(flatAST.GetName(id)))
+                    HashSymbolSignature(*fnSym, hasher);
+                break;
+            case ASTNode::NodeKind::IDENTIFIER_EXPR:
+            {
+                bool symFound;
+                const Symbol* varSym;
+                std::tie(symFound, varSym) = symTable.TryGetSymbol(flatAST.GetNode(id));
+                if (symFound && !varSym->IsFunction() && varSym->IsGlobal())
+                    HashSymbolSignature(*varSym, hasher);
+            }
+                break;
+            default:
+                break;
+            }
+
+            hasher.AddInt(flatAST.GetNbChildren(id));
+        }
+    }
+
+    /*
+    * \class    EntryWriter
+    * \brief    Appends fixed size little endian integers and strings to an entry
+    */
+    class EntryWriter
+    {
+    public:
+        explicit EntryWriter(std::string& buffer) : mBuffer{ buffer } { }
+
+        void WriteInt(uint64_t value)
+        {
+            for (size_t iByte = 0; iByte < sizeof(value); ++iByte)
+                mBuffer.push_back(static_cast<char>((value >> (8 * iByte)) & 0xFF));
+        }
+
+        void WriteString(const std::string& str)
+        {
+            WriteInt(str.size());
+            mBuffer.append(str);
+        }
+
+    private:
+        std::string& mBuffer;
+    };
+
+    /*
+    * \class    EntryReader
+    * \brief    Reads back what an EntryWriter wrote. Reading past the end of the entry fails,
+    *           and the reader then stays in error.
+    */
+    class EntryReader
+    {
+    public:
+        EntryReader(const char* it, const char* end) : mIt{ it }, mEnd{ end }, mFailed{ false } { }
+
+        uint64_t ReadInt()
+        {
+            if (mEnd - mIt < static_cast<std::ptrdiff_t>(sizeof(uint64_t)))
+            {
+                mFailed = true;
+                return 0;
+            }
+
+            uint64_t value = 0;
+            for (size_t iByte = 0; iByte < sizeof(value); ++iByte)
+                value |= static_cast<uint64_t>(static_cast<unsigned char>(*mIt++)) << (8 * iByte);
+            return value;
+        }
+
+        std::string ReadString()
+        {
+            const uint64_t size = ReadInt();
+            if (mFailed || (static_cast<uint64_t>(mEnd - mIt) < size))
+            {
+                mFailed = true;
+                return{};
+            }
+
+            std::string str{ mIt, mIt + size };
+            mIt += size;
+            return str;
+        }
+
+        bool HasFailed() const { return mFailed; }
+        bool IsAtEnd() const { return mIt == mEnd; }
+
+    private:
+        const char* mIt;
+        const char* mEnd;
+        bool mFailed;
+    };
+
+    void WriteValue(const SSAValue& value, EntryWriter& writer)
+    {
+        writer.WriteInt(static_cast<uint64_t>(value.GetKind()));
+        writer.WriteInt(value.GetID());
+        writer.WriteInt(static_cast<uint64_t>(static_cast<int64_t>(value.GetLiteralValue())));
+    }
+
+    SSAValue ReadValue(EntryReader& reader)
+    {
+        const uint64_t kind = reader.ReadInt();
+        const uint64_t id = reader.ReadInt();
+        const int64_t litVal = static_cast<int64_t>(reader.ReadInt());
+        if (kind > static_cast<uint64_t>(SSAValue::ValueKind::RESULT))
+            return SSAValue{};
+
+        return SSAValue{ static_cast<SSAValue::ValueKind>(kind), static_cast<size_t>(id), static_cast<int>(litVal) };
+    }
+
+    /*
+    * \fn           WriteFunction
+    * \brief        Serializes the SSA form of a function: its arguments, then its blocks with their instructions,
+    *               then the edges between the blocks and finally the users of each instruction
+    * \param func   Function to serialize
+    * \return       Serialized function
+    */
+    std::string WriteFunction(const SSAFunction& func)
+    {
+        std::string buffer;
+        EntryWriter writer{ buffer };
+
+        writer.WriteInt(func.GetNbArguments());
+        for (size_t iArg = 0; iArg < func.GetNbArguments(); ++iArg)
+            WriteValue(func.GetArgument(iArg), writer);
+
+        // Blocks and instructions are referred to by their position
+        const BlockList<SSAInstruction>& blocks = func.GetBlocks();
+        std::unordered_map<const SSABlock*, size_t> blockIndexes;
+        std::unordered_map<const SSAInstruction*, std::pair<size_t, size_t>> instIndexes;
+
+        writer.WriteInt(blocks.size());
+        for (size_t iBlock = 0; iBlock < blocks.size(); ++iBlock)
+        {
+            const SSABlockPtr& block = blocks[iBlock];
+            blockIndexes[block.get()] = iBlock;
+
+            writer.WriteString(block->GetName());
+            writer.WriteInt(block->GetNbInstructions());
+
+            size_t iInst = 0;
+            for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt, ++iInst)
+            {
+                const SSAInstruction& inst = **instIt;
+                instIndexes[&inst] = { iBlock, iInst };
+
+                writer.WriteInt(static_cast<uint64_t>(inst.GetOperation()));
+                writer.WriteInt(inst.GetReturnValue().GetID());
+                writer.WriteInt(inst.GetOperands().size());
+                for (const SSAValue& operand : inst.GetOperands())
+                    WriteValue(operand, writer);
+            }
+        }
+
+        for (const SSABlockPtr& block : blocks)
+        {
+            writer.WriteInt(block->GetSuccessors().size());
+            for (const SSABlockPtr& succ : block->GetSuccessors())
+                writer.WriteInt(blockIndexes.at(succ.get()));
+        }
+
+        for (const SSABlockPtr& block : blocks)
+        {
+            for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+            {
+                writer.WriteInt((*instIt)->GetUsers().size());
+                for (const SSAInstruction* user : (*instIt)->GetUsers())
+                {
+                    const std::pair<size_t, size_t>& userIndex = instIndexes.at(user);
+                    writer.WriteInt(userIndex.first);
+                    writer.WriteInt(userIndex.second);
+                }
+            }
+        }
+
+        return buffer;
+    }
+
+    /*
+    * \fn           ReadFunction
+    * \brief        Rebuilds the SSA form of a function serialized by WriteFunction
+    * \param data   Serialized function
+    * \return       SSA form of the function. Nullptr if the data is corrupted.
+    */
+    FuncPtr ReadFunction(const std::string& data)
+    {
+        EntryReader reader{ data.data(), data.data() + data.size() };
+        FuncPtr func = std::make_shared<SSAFunction>();
+
+        const uint64_t nbArgs = reader.ReadInt();
+        for (uint64_t iArg = 0; (iArg < nbArgs) && !reader.HasFailed(); ++iArg)
+            func->AddArguments(ReadValue(reader));
+
+        const uint64_t nbBlocks = reader.ReadInt();
+        std::vector<std::vector<SSAInstruction*>> blockInsts;
+        for (uint64_t iBlock = 0; (iBlock < nbBlocks) && !reader.HasFailed(); ++iBlock)
+        {
+            SSABlockPtr block = func->CreateNewBlock(reader.ReadString());
+            blockInsts.emplace_back();
+
+            const uint64_t nbInsts = reader.ReadInt();
+            for (uint64_t iInst = 0; (iInst < nbInsts) && !reader.HasFailed(); ++iInst)
+            {
+                const uint64_t op = reader.ReadInt();
+                if (op >= static_cast<uint64_t>(SSAInstruction::Operation::UNKNOWN))
+                    return nullptr;
+
+                SSAInstruction inst{ static_cast<SSAInstruction::Operation>(op), static_cast<size_t>(reader.ReadInt()), block.get() };
+                const uint64_t nbOperands = reader.ReadInt();
+                for (uint64_t iOperand = 0; (iOperand < nbOperands) && !reader.HasFailed(); ++iOperand)
+                    inst.AddOperand(ReadValue(reader));
+
+                block->InsertInstruction(std::move(inst));
+                blockInsts.back().push_back(block->GetTerminator());
+            }
+        }
+
+        if (reader.HasFailed())
+            return nullptr;
+
+        const BlockList<SSAInstruction>& blocks = func->GetBlocks();
+        for (const SSABlockPtr& block : blocks)
+        {
+            const uint64_t nbSuccs = reader.ReadInt();
+            for (uint64_t iSucc = 0; (iSucc < nbSuccs) && !reader.HasFailed(); ++iSucc)
+            {
+                const uint64_t succIdx = reader.ReadInt();
+                if (succIdx >= blocks.size())
+                    return nullptr;
+
+                block->InsertBranch(blocks[succIdx]);
+            }
+        }
+
+        for (const std::vector<SSAInstruction*>& insts : blockInsts)
+        {
+            for (SSAInstruction* inst : insts)
+            {
+                const uint64_t nbUsers = reader.ReadInt();
+                for (uint64_t iUser = 0; (iUser < nbUsers) && !reader.HasFailed(); ++iUser)
+                {
+                    const uint64_t blockIdx = reader.ReadInt();
+                    const uint64_t instIdx = reader.ReadInt();
+                    if ((blockIdx >= blockInsts.size()) || (instIdx >= blockInsts[blockIdx].size()))
+                        return nullptr;
+
+                    inst->AddUser(blockInsts[blockIdx][instIdx]);
+                }
+            }
+        }
+
+        if (reader.HasFailed() || !reader.IsAtEnd())
+            return nullptr;
+
+        return func;
+    }
+}
+
+CompilationCache::CompilationCache(const std::string& directory) : mDirectory{ directory }
+{
+    // A cache that can't be created behaves as an empty cache
+    std::error_code error;
+    std::filesystem::create_directories(mDirectory, error);
+}
+
+uint64_t CompilationCache::ComputeFunctionKey(const FunctionDecl* fDecl, const SymbolTable& symTable)
+{
+    assert(fDecl != nullptr);
+
+    return ComputeFunctionKey(FlatAST{ fDecl }, 0, symTable);
+}
+
+uint64_t CompilationCache::ComputeFunctionKey(const FlatAST& flatAST, FlatAST::NodeID fnID, const SymbolTable& symTable)
+{
+    assert(flatAST.GetKind(fnID) == ASTNode::NodeKind::FUNCTION_DECL);
+
+    KeyHasher hasher;
+    hasher.AddInt(CACHE_FORMAT_VERSION);
+    HashSubtree(flatAST, fnID, symTable, hasher);
+    return hasher.GetHash();
+}
+
+bool CompilationCache::IsChecked(uint64_t key) const
+{
+    Entry entry;
+    return ReadEntry(key, entry) && entry.mIsChecked;
+}
+
+void CompilationCache::MarkChecked(uint64_t key)
+{
+    Entry entry;
+    if (!ReadEntry(key, entry))
+        entry = Entry{ false, {} };
+
+    if (entry.mIsChecked)
+        return;
+
+    entry.mIsChecked = true;
+    WriteEntry(key, entry);
+}
+
+std::shared_ptr<SSAFunction> CompilationCache::LoadFunction(uint64_t key) const
+{
+    Entry entry;
+    if (!ReadEntry(key, entry) || entry.mFunction.empty())
+        return nullptr;
+
+    return ReadFunction(entry.mFunction);
+}
+
+void CompilationCache::StoreFunction(uint64_t key, const SSAFunction& func)
+{
+    Entry entry;
+    if (!ReadEntry(key, entry))
+        entry = Entry{ false, {} };
+
+    entry.mFunction = WriteFunction(func);
+    WriteEntry(key, entry);
+}
+
+/*
+* \fn           GetEntryPath
+* \brief        Gives the path of the file holding an entry
+* \param key    Key of the entry
+* \return       Path of the entry
+*/
+std::string CompilationCache::GetEntryPath(uint64_t key) const
+{
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+
+    std::string fileName(16, '0');
+    for (size_t iDigit = 0; iDigit < fileName.size(); ++iDigit)
+        fileName[fileName.size() - 1 - iDigit] = HEX_DIGITS[(key >> (4 * iDigit)) & 0xF];
+
+    return (std::filesystem::path{ mDirectory } / (fileName + ".tosc")).string();
+}
+
+/*
+* \fn           ReadEntry
+* \brief        Reads an entry from the disk
+* \param key    Key of the entry
+* \param entry  Entry read
+* \return       True if the entry exists and is valid
+*/
+bool CompilationCache::ReadEntry(uint64_t key, Entry& entry) const
+{
+    std::ifstream stream{ GetEntryPath(key), std::ios::binary };
+    if (!stream)
+        return false;
+
+    const std::string data{ std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+    if ((data.size() < sizeof(CACHE_MAGIC)) || !std::equal(std::begin(CACHE_MAGIC), std::end(CACHE_MAGIC), data.begin()))
+        return false;
+
+    EntryReader reader{ data.data() + sizeof(CACHE_MAGIC), data.data() + data.size() };
+    if (reader.ReadInt() != CACHE_FORMAT_VERSION)
+        return false;
+
+    entry.mIsChecked = reader.ReadInt() != 0;
+    entry.mFunction = reader.ReadString();
+    return !reader.HasFailed() && reader.IsAtEnd();
+}
+
+/*
+* \fn           WriteEntry
+* \brief        Writes an entry to the disk. The entry is written to a temporary file which then replaces
+*               the previous one, so that an interrupted compilation never leaves a truncated entry behind.
+*               Each write gets its own temporary file, since other threads or compilers may write the same entry.
+* \param key    Key of the entry
+* \param entry  Entry to write
+*/
+void CompilationCache::WriteEntry(uint64_t key, const Entry& entry) const
+{
+    std::string data{ std::begin(CACHE_MAGIC), std::end(CACHE_MAGIC) };
+    EntryWriter writer{ data };
+    writer.WriteInt(CACHE_FORMAT_VERSION);
+    writer.WriteInt(entry.mIsChecked ? 1 : 0);
+    writer.WriteString(entry.mFunction);
+
+    const std::string entryPath = GetEntryPath(key);
+    static const uint64_t processTag = (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+    static std::atomic<uint64_t> nbWrites{ 0 };
+    const std::string tempPath = entryPath + "." + std::to_string(processTag) + "." + std::to_string(nbWrites++) + ".tmp";
+
+    std::error_code error;
+    {
+        std::ofstream stream{ tempPath, std::ios::binary | std::ios::trunc };
+        if (!stream.write(data.data(), data.size()))
+        {
+            stream.close();
+            std::filesystem::remove(tempPath, error);
+            return;
+        }
+    }
+
+    std::filesystem::rename(tempPath, entryPath, error);
+    if (error)
+        std::filesystem::remove(tempPath, error);
+}
@@ -0,0 +1,117 @@
+#ifndef COMPILATION_CACHE_H__TOSLANG
+#define COMPILATION_CACHE_H__TOSLANG
+
+#include "../AST/flatast.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace TosLang
+{
+    namespace FrontEnd
+    {
+        class FunctionDecl;
+        class SymbolTable;
+    }
+
+    namespace BackEnd
+    {
+        class SSAFunction;
+    }
+}
+
+namespace Execution
+{
+    /*
+    * \class CompilationCache
+    * \brief On-disk cache of the work done by the compiler on each function of a program, which lets
+    *        a program be recompiled without re-analyzing and re-lowering the functions that didn't change.
+    *        Entries are keyed by a hash of the function (its declaration and body, without the source locations)
+    *        and of the signatures of the functions and global variables it uses. Editing a function thus only
+    *        invalidates its entry, and changing its signature also invalidates the entries of its callers.
+    *        An entry records that the function type checked without errors, and holds its SSA form.
+    */
+    class CompilationCache
+    {
+    public:
+        /*
+        * \fn               CompilationCache
+        * \brief            Ctor
+        * \param directory  Directory holding the cache entries. It is created if needed.
+        */
+        explicit CompilationCache(const std::string& directory);
+
+    public:
+        /*
+        * \fn               ComputeFunctionKey
+        * \brief            Computes the key of the cache entry of a function
+        * \param fDecl      Declaration of the function
+        * \param symTable   Symbol table filled by the symbol collector for the function's program
+        * \return           Key of the function's entry
+        */
+        static uint64_t ComputeFunctionKey(const TosLang::FrontEnd::FunctionDecl* fDecl, const TosLang::FrontEnd::SymbolTable& symTable);
+
+        /*
+        * \fn               ComputeFunctionKey
+        * \brief            Computes the key of the cache entry of a function of a flat AST
+        * \param flatAST    Flat AST of the function's program
+        * \param fnID       Node of the function's declaration in the flat AST
+        * \param symTable   Symbol table filled by the symbol collector for the function's program
+        * \return           Key of the function's entry
+        */
+        static uint64_t ComputeFunctionKey(const TosLang::FrontEnd::FlatAST& flatAST, TosLang::FrontEnd::FlatAST::NodeID fnID, 
+                                           const TosLang::FrontEnd::SymbolTable& symTable);
+
+        /*
+        * \fn       IsChecked
+        * \brief    Indicates if the function having the given key is known to be free of type errors
+        * \param    key Key of the function
+        * \return   True if the function type checked without errors
+        */
+        bool IsChecked(uint64_t key) const;
+
+        /*
+        * \fn       MarkChecked
+        * \brief    Records that the function having the given key type checked without errors
+        * \param    key Key of the function
+        */
+        void MarkChecked(uint64_t key);
+
+        /*
+        * \fn       LoadFunction
+        * \brief    Reads back the SSA form of the function having the given key
+        * \param    key Key of the function
+        * \return   SSA form of the function. Nullptr if it isn't in the cache.
+        */
+        std::shared_ptr<TosLang::BackEnd::SSAFunction> LoadFunction(uint64_t key) const;
+
+        /*
+        * \fn           StoreFunction
+        * \brief        Stores the SSA form of the function having the given key
+        * \param key    Key of the function
+        * \param func   SSA form of the function
+        */
+        void StoreFunction(uint64_t key, const TosLang::BackEnd::SSAFunction& func);
+
+    private:
+        /*
+        * \struct   Entry
+        * \brief    Content of the cache file of a function
+        */
+        struct Entry
+        {
+            bool mIsChecked;        /*!< Did the function type check without errors? */
+            std::string mFunction;  /*!< Serialized SSA form of the function. Empty if it wasn't stored. */
+        };
+
+        std::string GetEntryPath(uint64_t key) const;
+        bool ReadEntry(uint64_t key, Entry& entry) const;
+        void WriteEntry(uint64_t key, const Entry& entry) const;
+
+    private:
+        std::string mDirectory;     /*!< Directory holding the cache entries */
+    };
+}
+
+#endif // COMPILATION_CACHE_H__TOSLANG
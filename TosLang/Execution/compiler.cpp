@@ -1,16 +1,23 @@
 #include "compiler.h"
 
+#include "compilationcache.h"
+#include "passstatistics.h"
+
+#include "../AST/declarations.h"
 #include "../Parse/parser.h"
 #include "../Sema/symbolcollector.h"
 #include "../Sema/symboltable.h"
 #include "../Sema/typechecker.h"
 #include "../SSA/cfgbuilder.h"
+#include "../SSA/ssapassmanager.h"
 #include "../Utils/astprinter.h"
+#include "../Utils/scheduler.h"
 
 #ifdef USE_LLVM_BACKEND
 #include "LLVMBackend/llvmgenerator.h"
 #endif
 
+#include <cassert>
 #include <iostream>
 
 using namespace Execution;
@@ -18,7 +25,7 @@ using namespace TosLang;
 using namespace TosLang::BackEnd;
 using namespace TosLang::FrontEnd;
 
-Compiler::Compiler()
+Compiler::Compiler() : mStats{ nullptr }
 {
     mParser.reset(new Parser{});
     
@@ -32,84 +39,236 @@ Compiler::Compiler()
     //mISel.reset(new BackEnd::InstructionSelector{});
 
 #ifdef USE_LLVM_BACKEND
-    mLLVNGen.reset(new BackEnd::LLVMGenerator{})
+    mLLVMGen.reset(new LLVMGenerator{});
 #endif
 }
 
 Compiler::~Compiler() = default;   // Required because of the forward declarations used in the header for our member pointers
 
-void Compiler::Compile(const std::string& programFile)
+void Compiler::SetCacheDirectory(const std::string& directory)
+{
+    mCache.reset(new CompilationCache{ directory });
+}
+
+bool Compiler::Compile(const std::vector<std::string>& programFiles)
 {
-    auto programAST = ParseProgram(programFile);
+    auto programAST = ParseProgram(programFiles);
     if (programAST == nullptr)
-        return;
+        return false;
 
-    size_t errorCount = mSymCollector->Run(programAST);
+    size_t errorCount = CollectSymbols(programAST);
     if (errorCount != 0)
-        return;
+        return false;
+
+    // Functions which type checked in a previous compilation and didn't change since aren't checked again
+    const FunctionKeys fKeys = GetFunctionKeys(programAST);
+    TypeChecker::DeclSet checkedDecls;
+    for (const auto& fKey : fKeys)
+    {
+        if (mCache->IsChecked(fKey.second))
+            checkedDecls.insert(fKey.first);
+    }
+
+    // Programs made of multiple files are type checked concurrently as well
+    PassStatistics::Timer timer{ mStats, "TypeChecker" };
+    errorCount = mScheduler != nullptr ? mTChecker->Run(programAST, mSymTable, *mScheduler, checkedDecls) 
+                                       : mTChecker->Run(programAST, mSymTable, checkedDecls);
+    timer.Stop();
+    if (mStats != nullptr)
+        mStats->AddCounter("checked_decls", programAST->GetChildrenNodes().size() - checkedDecls.size());
 
-    errorCount = mTChecker->Run(programAST, mSymTable);
     if (errorCount != 0)
-        return;
+        return false;
+
+    for (const auto& fKey : fKeys)
+    {
+        if (checkedDecls.find(fKey.first) == checkedDecls.end())
+            mCache->MarkChecked(fKey.second);
+    }
+
+    return true;
 }
 
-void Compiler::DumpAST(const std::string& programFile)
+bool Compiler::DumpAST(const std::vector<std::string>& programFiles)
 {
-    auto programAST = ParseProgram(programFile);
+    auto programAST = ParseProgram(programFiles);
     if (programAST == nullptr)
-        return;
+        return false;
 
     std::ostream& stream = std::cout;
     TosLang::Utils::ASTPrinter<std::ostream> printer(stream);
     printer.Run(programAST);
+    return true;
 }
 
-void Compiler::DumpCFG(const std::string& programFile)
+bool Compiler::DumpCFG(const std::vector<std::string>& programFiles)
 {
-    auto programAST = ParseProgram(programFile);
+    auto programAST = ParseProgram(programFiles);
     if (programAST == nullptr)
-        return;
+        return false;
 
-    size_t errorCount = mSymCollector->Run(programAST);
+    size_t errorCount = CollectSymbols(programAST);
     if (errorCount != 0)
-        return;
+        return false;
+
+    // Functions which were lowered in a previous compilation and didn't change since are read back instead
+    const FunctionKeys fKeys = GetFunctionKeys(programAST);
+    CFGBuilder::PrebuiltFunctions cachedFuncs;
+    for (const auto& fKey : fKeys)
+    {
+        FuncPtr func = mCache->LoadFunction(fKey.second);
+        if (func != nullptr)
+            cachedFuncs[fKey.first] = func;
+    }
 
-    std::unique_ptr<SSAModule> module = mBuilder->Run(programAST, mSymTable);
+    // Functions of programs made of multiple files are built concurrently as well
+    PassStatistics::Timer timer{ mStats, "CFGBuilder" };
+    std::unique_ptr<SSAModule> module = mScheduler != nullptr ? mBuilder->Run(programAST, mSymTable, *mScheduler, cachedFuncs) 
+                                                              : mBuilder->Run(programAST, mSymTable, cachedFuncs);
+    timer.Stop();
     if (module == nullptr)
-        return;
+        return false;
+
+    if (mStats != nullptr)
+    {
+        size_t nbFunctions = 0;
+        size_t nbBlocks = 0;
+        size_t nbInstructions = 0;
+        size_t nbPhis = 0;
+        for (const auto& funcCFG : *module)
+        {
+            ++nbFunctions;
+            for (const auto& block : funcCFG.second->GetBlocks())
+            {
+                ++nbBlocks;
+                for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+                {
+                    ++nbInstructions;
+                    if ((*instIt)->GetOperation() == SSAInstruction::Operation::PHI)
+                        ++nbPhis;
+                }
+            }
+        }
+
+        mStats->AddCounter("functions", nbFunctions);
+        mStats->AddCounter("cached_functions", cachedFuncs.size());
+        mStats->AddCounter("blocks", nbBlocks);
+        mStats->AddCounter("ssa_instructions", nbInstructions);
+        mStats->AddCounter("phis", nbPhis);
+    }
+
+    // The module holds the functions in declaration order
+    auto funcIt = module->begin();
+    for (const auto& fKey : fKeys)
+    {
+        assert(funcIt != module->end());
+        if (cachedFuncs.find(fKey.first) == cachedFuncs.end())
+            mCache->StoreFunction(fKey.second, static_cast<const SSAFunction&>(*funcIt->second));
+        ++funcIt;
+    }
+
+    // The cache keeps the functions as they were built, so they are optimized on every compilation
+    SSAPassManager passManager;
+    passManager.AddOptimizationPasses();
+    passManager.Run(*module);
+    if (mStats != nullptr)
+    {
+        for (const auto& timing : passManager.GetTimings())
+        {
+            mStats->AddPass(timing.mName, timing.mWallTime, timing.mCPUTime);
+            mStats->AddCounter("changes", timing.mNbChanges);
+        }
+    }
 
     module->Print(std::cout);
+    return true;
 }
 
 #ifdef USE_LLVM_BACKEND
-void Compiler::DumpLLVMIR(const std::string& programFile)
+bool Compiler::DumpLLVMIR(const std::vector<std::string>& programFiles)
 {
-    auto programAST = ParseProgram(programFile);
+    auto programAST = ParseProgram(programFiles);
     if (programAST == nullptr)
-        return;
+        return false;
 
-    size_t errorCount = mSymCollector->Run(programAST);
+    size_t errorCount = CollectSymbols(programAST);
     if (errorCount != 0)
-        return;
+        return false;
 
+    PassStatistics::Timer timer{ mStats, "LLVMGenerator" };
     auto llvmModule = mLLVMGen->Run(programAST, mSymTable);
+    timer.Stop();
 
     llvmModule->dump();
+    return true;
 }
 #endif
 
-std::unique_ptr<ASTNode> Compiler::ParseProgram(const std::string & programFile)
+std::unique_ptr<ASTNode> Compiler::ParseProgram(const std::vector<std::string>& programFiles)
 {
-    return mParser->ParseProgram(programFile);
+    // The parser pulls its tokens from the lexer as it goes, so lexing is measured on its own beforehand.
+    // The time of the parser thus includes lexing.
+    if (mStats != nullptr)
+    {
+        PassStatistics::Timer timer{ mStats, "Lexer" };
+        const size_t nbTokens = PassStatistics::CountTokens(programFiles);
+        timer.Stop();
+        mStats->AddCounter("tokens", nbTokens);
+    }
+
+    if ((programFiles.size() != 1) && (mScheduler == nullptr))
+        mScheduler.reset(new Utils::Scheduler{});
+
+    PassStatistics::Timer timer{ mStats, "Parser" };
+    std::unique_ptr<ASTNode> programAST = programFiles.size() == 1 ? mParser->ParseProgram(programFiles.front())
+                                                                   : Parser::ParseProgram(programFiles, *mScheduler);
+    timer.Stop();
+    if (mStats != nullptr)
+        mStats->AddCounter("ast_nodes", PassStatistics::CountASTNodes(programAST.get()));
+
+    return programAST;
+}
+
+size_t Compiler::CollectSymbols(const std::unique_ptr<ASTNode>& root)
+{
+    PassStatistics::Timer timer{ mStats, "SymbolCollector" };
+    const size_t errorCount = mSymCollector->Run(root);
+    timer.Stop();
+    if (mStats != nullptr)
+    {
+        mStats->AddCounter("symbols", mSymTable->GetNbSymbols());
+        mStats->AddCounter("scopes", mSymTable->GetNbScopes());
+    }
+
+    return errorCount;
+}
+
+Compiler::FunctionKeys Compiler::GetFunctionKeys(const std::unique_ptr<ASTNode>& root) const
+{
+    FunctionKeys fKeys;
+    if (mCache == nullptr)
+        return fKeys;
+
+    // The whole program is flattened once, then every function is hashed from a contiguous range of its nodes
+    const FlatAST flatAST{ root.get() };
+    for (FlatAST::NodeID declID = flatAST.GetFirstChild(0); declID != FlatAST::INVALID_NODE; declID = flatAST.GetNextSibling(declID))
+    {
+        if (flatAST.GetKind(declID) == ASTNode::NodeKind::FUNCTION_DECL)
+            fKeys.emplace_back(flatAST.GetNode(declID), CompilationCache::ComputeFunctionKey(flatAST, declID, *mSymTable));
+    }
+
+    return fKeys;
 }
 
 std::shared_ptr<SymbolTable> Compiler::GetSymbolTable(const std::unique_ptr<ASTNode>& root)
 {
-    size_t errorCount = mSymCollector->Run(root);
+    size_t errorCount = CollectSymbols(root);
     if (errorCount != 0)
         return nullptr;
 
+    PassStatistics::Timer timer{ mStats, "TypeChecker" };
     errorCount = mTChecker->Run(root, mSymTable);
+    timer.Stop();
     if (errorCount != 0)
         return nullptr;
 
@@ -1,8 +1,11 @@
 #ifndef COMPILER__TOSLANG
 #define COMPILER__TOSLANG
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace TosLang
 {
@@ -21,10 +24,18 @@ namespace TosLang
         //class InstructionSelector;
         class LLVMGenerator;
     }
+
+    namespace Utils
+    {
+        class Scheduler;
+    }
 }
 
 namespace Execution
 {
+    class CompilationCache;
+    class PassStatistics;
+
     /*
     * \class Compiler
     * \brief The TosLang driver
@@ -44,49 +55,83 @@ namespace Execution
         */
         ~Compiler();
 
+    public:
+        /*
+        * \fn               SetCacheDirectory
+        * \brief            Enables incremental compilation. The work done on each function is kept in the
+        *                   given directory, and later compilations only redo it for the functions that changed.
+        * \param directory  Directory holding the compilation cache
+        */
+        void SetCacheDirectory(const std::string& directory);
+
+        /*
+        * \fn           SetStatistics
+        * \brief        Measures the passes run by the compiler from now on
+        * \param stats  Statistics receiving the measures. Nullptr to stop measuring.
+        */
+        void SetStatistics(PassStatistics* stats) { mStats = stats; }
+
     public:
         /*
         * \fn                   Compile
-        * \brief                Compiles a TosLang program to a MinChip16 binary
-        * \param programFile    Name (including path) of the .tos file to compile
+        * \brief                Runs the front end over a TosLang program. Generating a MinChip16 binary isn't supported yet.
+        * \param programFiles   Names (including path) of the .tos files making up the program
+        * \return               True if the program has no error
         */
-        void Compile(const std::string& programFile);
+        bool Compile(const std::vector<std::string>& programFiles);
 
     public:
         /*
         * \fn                   DumpAST
         * \brief                Dumps the program's AST to stdout
-        * \param programFile    Name (including path) of the .tos file to compile
+        * \param programFiles   Names (including path) of the .tos files making up the program
+        * \return               True if the program could be parsed
         */
-        void DumpAST(const std::string& programFile);
+        bool DumpAST(const std::vector<std::string>& programFiles);
 
         /*
         * \fn                   DumpCFG
         * \brief                Dumps the program's control flow graph (CFG) to stdout
-        * \param programFile    Name (including path) of the .tos file to compile
+        * \param programFiles   Names (including path) of the .tos files making up the program
+        * \return               True if the CFG could be built
         */
-        void DumpCFG(const std::string& programFile);
+        bool DumpCFG(const std::vector<std::string>& programFiles);
         
 #ifdef USE_LLVM_BACKEND
         /*
         * \fn                   DumpLLVMIR
         * \brief                Dumps the LLVM IR corresponding to the program to stdout
-        * \param programFile    Name (including path) of the .tos file to compile
+        * \param programFiles   Names (including path) of the .tos files making up the program
+        * \return               True if the IR could be generated
         */
-        void DumpLLVMIR(const std::string& programFile);
+        bool DumpLLVMIR(const std::vector<std::string>& programFiles);
 #endif
 
     public:
         /*
         * \fn                   ParseProgram
-        * \brief                Parse a TosLang program to produce an AST
-        * \param programFile    Name (including path) of the .tos file to compile
+        * \brief                Parse a TosLang program to produce an AST. Files are parsed concurrently.
+        * \param programFiles   Names (including path) of the .tos files making up the program
         * \return               Root node of the program's AST
         */
-        std::unique_ptr<TosLang::FrontEnd::ASTNode> ParseProgram(const std::string& programFile);
+        std::unique_ptr<TosLang::FrontEnd::ASTNode> ParseProgram(const std::vector<std::string>& programFiles);
 
         std::shared_ptr<TosLang::FrontEnd::SymbolTable> GetSymbolTable(const std::unique_ptr<TosLang::FrontEnd::ASTNode>& root);
 
+    private:
+        size_t CollectSymbols(const std::unique_ptr<TosLang::FrontEnd::ASTNode>& root);
+
+    private:
+        using FunctionKeys = std::vector<std::pair<const TosLang::FrontEnd::ASTNode*, uint64_t>>;
+
+        /*
+        * \fn           GetFunctionKeys
+        * \brief        Computes the compilation cache keys of the functions of a program
+        * \param root   Root node of the program's AST, whose symbols have been collected
+        * \return       Function declarations, in order, along with their keys. Empty if there is no cache.
+        */
+        FunctionKeys GetFunctionKeys(const std::unique_ptr<TosLang::FrontEnd::ASTNode>& root) const;
+
     private:
         std::shared_ptr<TosLang::FrontEnd::SymbolTable> mSymTable;           /*!< Symbol table for a program */
 
@@ -95,9 +140,12 @@ namespace Execution
         std::unique_ptr<TosLang::FrontEnd::TypeChecker> mTChecker;           /*!< Type checker */
         std::unique_ptr<TosLang::BackEnd::CFGBuilder> mBuilder;              /*!< CFG Builder */
         //std::unique_ptr<BackEnd::InstructionSelector> mISel;        /*!< Instruction selector */
+        std::unique_ptr<TosLang::Utils::Scheduler> mScheduler;               /*!< Runs the front end of multiple files. Created on first use. */
+        std::unique_ptr<CompilationCache> mCache;                            /*!< Work done on each function by previous compilations. Nullptr if disabled. */
+        PassStatistics* mStats;                                              /*!< Measures of the passes. Nullptr if they aren't measured. */
 
 #ifdef USE_LLVM_BACKEND
-        std::unique_ptr<BackEnd::LLVMGenerator> mLLVMGen;           /*!< LLVM IR Generator */
+        std::unique_ptr<TosLang::BackEnd::LLVMGenerator> mLLVMGen;           /*!< LLVM IR Generator */
 #endif
     };
 }
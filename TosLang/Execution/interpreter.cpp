@@ -1,17 +1,25 @@
 #include "interpreter.h"
+#include "passstatistics.h"
 
 #include "../Parse/parser.h"
 #include "../Sema/symbolcollector.h"
 #include "../Sema/symboltable.h"
 #include "../Sema/typechecker.h"
+#include "../VM/bytecodegenerator.h"
+#include "../VM/virtualmachine.h"
 
 #include "../Utils/errorlogger.h"
+#include "../Utils/scheduler.h"
 
 using namespace Execution;
 using namespace TosLang::FrontEnd;
 using namespace TosLang::Common;
+using namespace TosLang::Utils;
+using namespace TosLang::VM;
 
-Interpreter::Interpreter() : mAST{ }
+Interpreter::Interpreter() : Interpreter{ VirtualMachine::GetDefaultDispatchMode() } { }
+
+Interpreter::Interpreter(DispatchMode mode) : mAST{ }, mStats{ nullptr }
 {
     mParser.reset(new Parser{});
 
@@ -19,28 +27,70 @@ Interpreter::Interpreter() : mAST{ }
 
     mSymCollector.reset(new SymbolCollector{ mSymTable });
     mTChecker.reset(new TypeChecker{});
+
+    mBCGenerator.reset(new BytecodeGenerator{});
+    mVM.reset(new VirtualMachine{ mode });
 }
 
 Interpreter::~Interpreter() { }   // Required because of the forward declarations used in the header for our member pointers
 
-// TODO: What about error handling?
-
 bool Interpreter::Run(const std::string& programFile)
 {
+    return Run(std::vector<std::string>{ programFile });
+}
+
+bool Interpreter::Run(const std::vector<std::string>& programFiles)
+{
+    // The parser pulls its tokens from the lexer as it goes, so lexing is measured on its own beforehand
+    if (mStats != nullptr)
+    {
+        PassStatistics::Timer timer{ mStats, "Lexer" };
+        const size_t nbTokens = PassStatistics::CountTokens(programFiles);
+        timer.Stop();
+        mStats->AddCounter("tokens", nbTokens);
+    }
+
     // Let's start by building the AST
-    mAST = mParser->ParseProgram(programFile);
+    PassStatistics::Timer parserTimer{ mStats, "Parser" };
+    if (programFiles.size() == 1)
+    {
+        mAST = mParser->ParseProgram(programFiles.front());
+    }
+    else
+    {
+        if (mScheduler == nullptr)
+            mScheduler.reset(new Scheduler{});
+
+        mAST = Parser::ParseProgram(programFiles, *mScheduler);
+    }
+    parserTimer.Stop();
+
     if (mAST == nullptr)
         return false;
 
+    if (mStats != nullptr)
+        mStats->AddCounter("ast_nodes", PassStatistics::CountASTNodes(mAST.get()));
+
     // Then we'll collect the program's symbols
+    PassStatistics::Timer collectorTimer{ mStats, "SymbolCollector" };
     size_t errorCount = mSymCollector->Run(mAST);
+    collectorTimer.Stop();
+    if (mStats != nullptr)
+    {
+        mStats->AddCounter("symbols", mSymTable->GetNbSymbols());
+        mStats->AddCounter("scopes", mSymTable->GetNbScopes());
+    }
+
     if (errorCount != 0)
         return false;
 
     // Making sure the program is well formed.
     // Also, since type checking rules dictate the choices made by overload resolution,
-    // this will also ties functions and function calls together
-    errorCount = mTChecker->Run(mAST, mSymTable);
+    // this will also ties functions and function calls together.
+    // Programs made of multiple files are type checked concurrently, like they were parsed.
+    PassStatistics::Timer checkerTimer{ mStats, "TypeChecker" };
+    errorCount = mScheduler != nullptr ? mTChecker->Run(mAST, mSymTable, *mScheduler) : mTChecker->Run(mAST, mSymTable);
+    checkerTimer.Stop();
     if (errorCount != 0)
         return false;
 
@@ -49,12 +99,28 @@ bool Interpreter::Run(const std::string& programFile)
     const ASTNode* mainNode = mSymTable->GetFunctionDecl({ fnTypes, "main" });
     if (mainNode == nullptr)
     {
-        // TODO: Log error and add a unit test for it
+        ErrorLogger::PrintError(ErrorLogger::ErrorType::FN_MISSING_MAIN);
         return false;
     }
 
-    // TODO: Disabled for now.
-    //Threading::CreateThread(mAST.get(), mSymTable.get());
-    
-    return true;
+    // Translate the program to bytecode and hand it to the virtual machine
+    PassStatistics::Timer generatorTimer{ mStats, "BytecodeGenerator" };
+    std::unique_ptr<BytecodeModule> module = mBCGenerator->Run(mAST, mSymTable);
+    generatorTimer.Stop();
+    if (module == nullptr)
+        return false;
+
+    module->SetEntryIdx(mBCGenerator->GetFunctionIndex(mainNode));
+
+    if (mStats != nullptr)
+    {
+        size_t nbInstructions = 0;
+        for (const BytecodeFunction& function : module->GetFunctions())
+            nbInstructions += function.GetCode().size();
+
+        mStats->AddCounter("functions", module->GetFunctions().size());
+        mStats->AddCounter("bytecode_instructions", nbInstructions);
+    }
+
+    return mVM->Run(*module);
 }
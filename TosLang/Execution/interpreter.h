@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace TosLang
 {
@@ -16,16 +17,38 @@ namespace TosLang
         class SymbolTable;
         class TypeChecker;
     }
+
+    namespace VM
+    {
+        class BytecodeGenerator;
+        class VirtualMachine;
+        enum class DispatchMode;
+    }
+
+    namespace Utils
+    {
+        class Scheduler;
+    }
 }
 
 namespace Execution
 {
+    class PassStatistics;
+
     class Interpreter
     {
     public:
         Interpreter();
+        explicit Interpreter(TosLang::VM::DispatchMode mode);
         ~Interpreter();
 
+        /*
+        * \fn           SetStatistics
+        * \brief        Measures the passes compiling the program to bytecode from now on
+        * \param stats  Statistics receiving the measures. Nullptr to stop measuring.
+        */
+        void SetStatistics(PassStatistics* stats) { mStats = stats; }
+
         /*
         * \fn                   Run
         * \brief                Runs a TosLang program
@@ -33,6 +56,14 @@ namespace Execution
         * \return               Has the program correctly terminated?
         */
         bool Run(const std::string& programFile);
+
+        /*
+        * \fn                   Run
+        * \brief                Runs a TosLang program spanning several files. Files are parsed concurrently.
+        * \param programFiles   Names (including path) of the .tos files making up the program
+        * \return               Has the program correctly terminated?
+        */
+        bool Run(const std::vector<std::string>& programFiles);
         
     private:
         std::unique_ptr<TosLang::FrontEnd::ASTNode> mAST;                   /*!< Symbol table for a program */
@@ -42,6 +73,10 @@ namespace Execution
         std::unique_ptr<TosLang::FrontEnd::Parser> mParser;                  /*!< Parser */
         std::unique_ptr<TosLang::FrontEnd::SymbolCollector> mSymCollector;   /*!< Symbol collector */
         std::unique_ptr<TosLang::FrontEnd::TypeChecker> mTChecker;           /*!< Type checker */
+        std::unique_ptr<TosLang::VM::BytecodeGenerator> mBCGenerator;        /*!< Bytecode generator */
+        std::unique_ptr<TosLang::VM::VirtualMachine> mVM;                    /*!< Virtual machine executing the program */
+        std::unique_ptr<TosLang::Utils::Scheduler> mScheduler;               /*!< Runs the front end of multiple files. Created on first use. */
+        PassStatistics* mStats;                                              /*!< Measures of the passes. Nullptr if they aren't measured. */
     };
 }
 
@@ -0,0 +1,223 @@
+#include "passstatistics.h"
+
+#include "../AST/ast.h"
+#include "../Parse/lexer.h"
+
+#include <iomanip>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#   define TOSLANG_HAS_RUSAGE 1
+#   include <sys/resource.h>
+#else
+#   define TOSLANG_HAS_RUSAGE 0
+#endif
+
+using namespace Execution;
+using namespace TosLang::FrontEnd;
+
+/*
+* \fn               Timer
+* \brief            Starts measuring a pass
+* \param stats      Statistics receiving the record of the pass. Nullptr to measure nothing.
+* \param passName   Name of the pass
+*/
+PassStatistics::Timer::Timer(PassStatistics* stats, const std::string& passName) : mStats{ stats }, mPassName{ passName }, mCPUStart{ 0 }, mPeakRSSStart{ 0 }
+{
+    if (mStats == nullptr)
+        return;
+
+    mPeakRSSStart = GetPeakRSS();
+    mCPUStart = std::clock();
+    mWallStart = std::chrono::steady_clock::now();
+}
+
+/*
+* \fn       Stop
+* \brief    Stops measuring the pass and adds its record to the statistics. Does nothing if the timer was already stopped.
+*/
+void PassStatistics::Timer::Stop()
+{
+    if (mStats == nullptr)
+        return;
+
+    const auto wallEnd = std::chrono::steady_clock::now();
+    const std::clock_t cpuEnd = std::clock();
+    const size_t peakRSSEnd = GetPeakRSS();
+
+    PassRecord record;
+    record.mName = mPassName;
+    record.mWallTime = std::chrono::duration<double, std::milli>(wallEnd - mWallStart).count();
+    record.mCPUTime = 1000.0 * static_cast<double>(cpuEnd - mCPUStart) / CLOCKS_PER_SEC;
+    record.mPeakRSSDelta = peakRSSEnd - mPeakRSSStart;
+    mStats->mPasses.push_back(std::move(record));
+
+    mStats = nullptr;
+}
+
+/*
+* \fn           AddCounter
+* \brief        Adds a counter to the record of the last pass measured
+* \param name   Name of the counter
+* \param value  Value of the counter
+*/
+void PassStatistics::AddCounter(const std::string& name, size_t value)
+{
+    if (!mPasses.empty())
+        mPasses.back().mCounters.emplace_back(name, value);
+}
+
+/*
+* \fn               AddPass
+* \brief            Adds the record of a pass measured elsewhere, such as a pass run by a pass manager
+* \param passName   Name of the pass
+* \param wallTime   Elapsed time, in milliseconds
+* \param cpuTime    Processor time, in milliseconds
+*/
+void PassStatistics::AddPass(const std::string& passName, double wallTime, double cpuTime)
+{
+    PassRecord record;
+    record.mName = passName;
+    record.mWallTime = wallTime;
+    record.mCPUTime = cpuTime;
+    record.mPeakRSSDelta = 0;
+    mPasses.push_back(std::move(record));
+}
+
+/*
+* \fn           PrintTable
+* \brief        Prints the records of the passes as a table, meant to be read by a human
+* \param stream Output stream
+*/
+void PassStatistics::PrintTable(std::ostream& stream) const
+{
+    stream << std::left << std::setw(30) << "Pass"
+           << std::right << std::setw(12) << "Wall (ms)"
+           << std::setw(12) << "CPU (ms)"
+           << std::setw(16) << "Peak RSS (KB)"
+           << "  Counters" << std::endl;
+
+    double totalWallTime = 0.0;
+    double totalCPUTime = 0.0;
+    size_t totalPeakRSSDelta = 0;
+    for (const PassRecord& pass : mPasses)
+    {
+        std::ostringstream counters;
+        for (const auto& counter : pass.mCounters)
+            counters << "  " << counter.first << "=" << counter.second;
+
+        stream << std::left << std::setw(30) << pass.mName
+               << std::right << std::fixed << std::setprecision(3)
+               << std::setw(12) << pass.mWallTime
+               << std::setw(12) << pass.mCPUTime
+               << std::setw(16) << ("+" + std::to_string(pass.mPeakRSSDelta))
+               << counters.str() << std::endl;
+
+        totalWallTime += pass.mWallTime;
+        totalCPUTime += pass.mCPUTime;
+        totalPeakRSSDelta += pass.mPeakRSSDelta;
+    }
+
+    stream << std::left << std::setw(30) << "Total"
+           << std::right << std::fixed << std::setprecision(3)
+           << std::setw(12) << totalWallTime
+           << std::setw(12) << totalCPUTime
+           << std::setw(16) << ("+" + std::to_string(totalPeakRSSDelta)) << std::endl;
+}
+
+/*
+* \fn           PrintJSON
+* \brief        Prints the records of the passes as a JSON document, meant to be read by tools
+* \param stream Output stream
+*/
+void PassStatistics::PrintJSON(std::ostream& stream) const
+{
+    // Pass and counter names are plain identifiers, so they never need to be escaped
+    stream << "{\"passes\":[";
+    for (size_t iPass = 0; iPass < mPasses.size(); ++iPass)
+    {
+        const PassRecord& pass = mPasses[iPass];
+        stream << (iPass != 0 ? "," : "")
+               << "{\"name\":\"" << pass.mName << "\""
+               << std::fixed << std::setprecision(3)
+               << ",\"wall_ms\":" << pass.mWallTime
+               << ",\"cpu_ms\":" << pass.mCPUTime
+               << ",\"peak_rss_delta_kb\":" << pass.mPeakRSSDelta
+               << ",\"counters\":{";
+
+        for (size_t iCounter = 0; iCounter < pass.mCounters.size(); ++iCounter)
+            stream << (iCounter != 0 ? "," : "") << "\"" << pass.mCounters[iCounter].first << "\":" << pass.mCounters[iCounter].second;
+
+        stream << "}}";
+    }
+    stream << "]}" << std::endl;
+}
+
+/*
+* \fn                   CountTokens
+* \brief                Lexes a program without parsing it
+* \param programFiles   Names of the files making up the program
+* \return               Number of tokens of the program
+*/
+size_t PassStatistics::CountTokens(const std::vector<std::string>& programFiles)
+{
+    size_t nbTokens = 0;
+    for (const std::string& filename : programFiles)
+    {
+        Lexer lexer;
+        if (!lexer.Init(filename))
+            continue;
+
+        while (lexer.GetNextToken() != Lexer::Token::TOK_EOF)
+            ++nbTokens;
+    }
+
+    return nbTokens;
+}
+
+/*
+* \fn           CountASTNodes
+* \brief        Counts the nodes of an AST. The nodes left to count are kept on a stack, so deep trees can be counted.
+* \param root   Root of the AST
+* \return       Number of nodes of the AST
+*/
+size_t PassStatistics::CountASTNodes(const ASTNode* root)
+{
+    size_t nbNodes = 0;
+    std::vector<const ASTNode*> nodesToCount{ root };
+    while (!nodesToCount.empty())
+    {
+        const ASTNode* node = nodesToCount.back();
+        nodesToCount.pop_back();
+        if (node == nullptr)
+            continue;
+
+        ++nbNodes;
+        for (const auto& child : node->GetChildrenNodes())
+            nodesToCount.push_back(child.get());
+    }
+
+    return nbNodes;
+}
+
+/*
+* \fn       GetPeakRSS
+* \brief    Gives the largest resident set size the process had so far
+* \return   Peak resident set size in kilobytes. 0 if the platform doesn't report it.
+*/
+size_t PassStatistics::GetPeakRSS()
+{
+#if TOSLANG_HAS_RUSAGE
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+#if defined(__APPLE__)
+    return static_cast<size_t>(usage.ru_maxrss) / 1024;   // Reported in bytes
+#else
+    return static_cast<size_t>(usage.ru_maxrss);          // Reported in kilobytes
+#endif
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,94 @@
+#ifndef PASS_STATISTICS_H__TOSLANG
+#define PASS_STATISTICS_H__TOSLANG
+
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TosLang
+{
+    namespace FrontEnd
+    {
+        class ASTNode;
+    }
+}
+
+namespace Execution
+{
+    /*
+    * \class PassStatistics
+    * \brief Measures where the time and the memory of a compilation go. Every pass (phase) of the
+    *        compilation gets a record holding its wall time, its CPU time, how much it raised the peak
+    *        resident set size of the process and counters describing the work it did.
+    */
+    class PassStatistics
+    {
+    public:
+        /*
+        * \struct   PassRecord
+        * \brief    Measures of one pass
+        */
+        struct PassRecord
+        {
+            std::string mName;                                          /*!< Name of the pass */
+            double mWallTime;                                           /*!< Elapsed time, in milliseconds */
+            double mCPUTime;                                            /*!< Processor time used by every thread of the process, in milliseconds */
+            size_t mPeakRSSDelta;                                       /*!< Growth of the peak resident set size, in kilobytes */
+            std::vector<std::pair<std::string, size_t>> mCounters;     /*!< Work done by the pass, by counter name */
+        };
+
+        /*
+        * \class Timer
+        * \brief Measures a pass from its construction until it is stopped or destroyed.
+        *        A timer created without statistics measures nothing, so call sites don't need to check for them.
+        */
+        class Timer
+        {
+        public:
+            Timer(PassStatistics* stats, const std::string& passName);
+            ~Timer() { Stop(); }
+
+            Timer(const Timer&) = delete;
+            Timer& operator=(const Timer&) = delete;
+
+        public:
+            void Stop();
+
+        private:
+            PassStatistics* mStats;                                 /*!< Statistics receiving the record of the pass */
+            std::string mPassName;                                  /*!< Name of the measured pass */
+            std::chrono::steady_clock::time_point mWallStart;       /*!< Wall clock when the pass started */
+            std::clock_t mCPUStart;                                 /*!< Processor time when the pass started */
+            size_t mPeakRSSStart;                                   /*!< Peak resident set size when the pass started */
+        };
+
+    public:
+        void AddCounter(const std::string& name, size_t value);
+        void AddPass(const std::string& passName, double wallTime, double cpuTime);
+
+        /*
+        * \fn       GetPasses
+        * \brief    Gives the records of the passes measured so far, in the order they ran
+        * \return   Records of the passes
+        */
+        const std::vector<PassRecord>& GetPasses() const { return mPasses; }
+
+        void PrintTable(std::ostream& stream) const;
+        void PrintJSON(std::ostream& stream) const;
+
+    public:
+        static size_t CountTokens(const std::vector<std::string>& programFiles);
+        static size_t CountASTNodes(const TosLang::FrontEnd::ASTNode* root);
+        static size_t GetPeakRSS();
+
+    private:
+        std::vector<PassRecord> mPasses;    /*!< Records of the passes, in the order they ran */
+    };
+}
+
+#endif // PASS_STATISTICS_H__TOSLANG
@@ -194,7 +194,7 @@ llvm::Value* LLVMGenerator::HandleExpr(const Expr* expr)
         return llvm::constant
 
         // We add the string literal to the module
-        unsigned memSlot = mMod->InsertArrayVariable(sExpr->GetName(), sExpr->GetName()); // Name and value are the same for simplicity
+        unsigned memSlot = mMod->InsertArrayVariable(sExpr->GetValue(), sExpr->GetValue()); // Name and value are the same for simplicity
 
         // We generate a load of the string literal address
         auto vInst = VirtualInstruction{ VirtualInstruction::Opcode::LOAD_IMM }
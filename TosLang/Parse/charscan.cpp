@@ -0,0 +1,206 @@
+#include "charscan.h"
+
+#include <cstring>
+
+// Runs of characters are scanned a whole vector at a time when the target supports it. The widest
+// instruction set enabled at build time is used (e.g. -mavx2), otherwise the scalar loops take over.
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#   define TOSLANG_SIMD_WIDTH 32
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#   include <emmintrin.h>
+#   define TOSLANG_SIMD_WIDTH 16
+#else
+#   define TOSLANG_SIMD_WIDTH 0
+#endif
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+using namespace TosLang::FrontEnd;
+
+namespace
+{
+    constexpr std::array<uint8_t, 256> MakeCharClasses()
+    {
+        std::array<uint8_t, 256> classes{};
+        for (size_t c = 0; c < classes.size(); ++c)
+        {
+            if ((c == ' ') || (('\t' <= c) && (c <= '\r')))
+                classes[c] |= CHAR_SPACE;
+            if ((('a' <= c) && (c <= 'z')) || (('A' <= c) && (c <= 'Z')))
+                classes[c] |= CHAR_ALPHA;
+            if (('0' <= c) && (c <= '9'))
+                classes[c] |= CHAR_DIGIT;
+        }
+        return classes;
+    }
+
+#if TOSLANG_SIMD_WIDTH
+    unsigned CountTrailingZeros(uint32_t mask)
+    {
+#if defined(_MSC_VER)
+        unsigned long idx;
+        _BitScanForward(&idx, mask);
+        return static_cast<unsigned>(idx);
+#else
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+
+    unsigned HighestBit(uint32_t mask)
+    {
+#if defined(_MSC_VER)
+        unsigned long idx;
+        _BitScanReverse(&idx, mask);
+        return static_cast<unsigned>(idx);
+#else
+        return 31 - static_cast<unsigned>(__builtin_clz(mask));
+#endif
+    }
+
+    unsigned PopCount(uint32_t mask)
+    {
+#if defined(_MSC_VER)
+        return __popcnt(mask);
+#else
+        return static_cast<unsigned>(__builtin_popcount(mask));
+#endif
+    }
+
+    /*
+    * \struct   Chunk
+    * \brief    TOSLANG_SIMD_WIDTH consecutive characters compared all at once.
+    *           Comparisons give one bit per character, the first character being the lowest bit.
+    */
+    struct Chunk
+    {
+#if TOSLANG_SIMD_WIDTH == 32
+        using Vector = __m256i;
+        static Vector Load(const char* it) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it)); }
+        static Vector Splat(char c) { return _mm256_set1_epi8(c); }
+        static Vector Equal(Vector a, Vector b) { return _mm256_cmpeq_epi8(a, b); }
+        static Vector Greater(Vector a, Vector b) { return _mm256_cmpgt_epi8(a, b); }
+        static Vector And(Vector a, Vector b) { return _mm256_and_si256(a, b); }
+        static Vector Or(Vector a, Vector b) { return _mm256_or_si256(a, b); }
+        static uint32_t Mask(Vector v) { return static_cast<uint32_t>(_mm256_movemask_epi8(v)); }
+        static const uint32_t FULL_MASK = 0xFFFFFFFF;
+#else
+        using Vector = __m128i;
+        static Vector Load(const char* it) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(it)); }
+        static Vector Splat(char c) { return _mm_set1_epi8(c); }
+        static Vector Equal(Vector a, Vector b) { return _mm_cmpeq_epi8(a, b); }
+        static Vector Greater(Vector a, Vector b) { return _mm_cmpgt_epi8(a, b); }
+        static Vector And(Vector a, Vector b) { return _mm_and_si128(a, b); }
+        static Vector Or(Vector a, Vector b) { return _mm_or_si128(a, b); }
+        static uint32_t Mask(Vector v) { return static_cast<uint32_t>(_mm_movemask_epi8(v)); }
+        static const uint32_t FULL_MASK = 0xFFFF;
+#endif
+
+        explicit Chunk(const char* it) : mChars{ Load(it) } { }
+
+        Vector Is(char c) const { return Equal(mChars, Splat(c)); }
+
+        // Comparisons are signed, which conveniently excludes every non ASCII character from ASCII ranges
+        Vector IsBetween(char first, char last) const
+        {
+            return And(Greater(mChars, Splat(first - 1)), Greater(Splat(last + 1), mChars));
+        }
+
+        Vector mChars;
+    };
+#endif
+}
+
+const std::array<uint8_t, 256> TosLang::FrontEnd::gCharClasses = MakeCharClasses();
+
+const char* TosLang::FrontEnd::SkipSpaces(const char* it, const char* end, size_t& nbNewlines, const char*& lastNewline)
+{
+    // Most runs are a single space between two tokens
+    if ((it == end) || !IsInCharClass(*it, CHAR_SPACE))
+        return it;
+
+#if TOSLANG_SIMD_WIDTH
+    while (end - it >= TOSLANG_SIMD_WIDTH)
+    {
+        const Chunk chunk{ it };
+        const uint32_t newlines = Chunk::Mask(chunk.Is('\n'));
+        const uint32_t spaces = Chunk::Mask(Chunk::Or(chunk.Is(' '), chunk.IsBetween('\t', '\r')));
+        const uint32_t others = ~spaces & Chunk::FULL_MASK;
+
+        // Only the newlines before the end of the run count
+        const unsigned runLength = others != 0 ? CountTrailingZeros(others) : TOSLANG_SIMD_WIDTH;
+        const uint32_t runNewlines = runLength < 32 ? newlines & ((1u << runLength) - 1) : newlines;
+        if (runNewlines != 0)
+        {
+            nbNewlines += PopCount(runNewlines);
+            lastNewline = it + HighestBit(runNewlines);
+        }
+
+        if (others != 0)
+            return it + runLength;
+
+        it += TOSLANG_SIMD_WIDTH;
+    }
+#endif
+
+    for (; (it != end) && IsInCharClass(*it, CHAR_SPACE); ++it)
+    {
+        if (*it == '\n')
+        {
+            ++nbNewlines;
+            lastNewline = it;
+        }
+    }
+
+    return it;
+}
+
+const char* TosLang::FrontEnd::SkipAlnums(const char* it, const char* end)
+{
+#if TOSLANG_SIMD_WIDTH
+    while (end - it >= TOSLANG_SIMD_WIDTH)
+    {
+        const Chunk chunk{ it };
+        const uint32_t alnums = Chunk::Mask(Chunk::Or(Chunk::Or(chunk.IsBetween('a', 'z'), chunk.IsBetween('A', 'Z')),
+                                                      chunk.IsBetween('0', '9')));
+        const uint32_t others = ~alnums & Chunk::FULL_MASK;
+        if (others != 0)
+            return it + CountTrailingZeros(others);
+
+        it += TOSLANG_SIMD_WIDTH;
+    }
+#endif
+
+    while ((it != end) && IsInCharClass(*it, CHAR_ALNUM))
+        ++it;
+
+    return it;
+}
+
+const char* TosLang::FrontEnd::SkipDigits(const char* it, const char* end)
+{
+#if TOSLANG_SIMD_WIDTH
+    while (end - it >= TOSLANG_SIMD_WIDTH)
+    {
+        const uint32_t others = ~Chunk::Mask(Chunk{ it }.IsBetween('0', '9')) & Chunk::FULL_MASK;
+        if (others != 0)
+            return it + CountTrailingZeros(others);
+
+        it += TOSLANG_SIMD_WIDTH;
+    }
+#endif
+
+    while ((it != end) && IsInCharClass(*it, CHAR_DIGIT))
+        ++it;
+
+    return it;
+}
+
+const char* TosLang::FrontEnd::FindChar(const char* it, const char* end, char c)
+{
+    // The C library already provides a vectorized search
+    const void* found = std::memchr(it, c, static_cast<size_t>(end - it));
+    return found != nullptr ? static_cast<const char*>(found) : end;
+}
@@ -0,0 +1,83 @@
+#ifndef CHAR_SCAN_H__TOSLANG
+#define CHAR_SCAN_H__TOSLANG
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace TosLang
+{
+    namespace FrontEnd
+    {
+        /*
+        * \enum     CharClass
+        * \brief    Classes of characters recognized by the lexer. A character can belong to many classes.
+        *           Only ASCII characters belong to a class, like with the "C" locale.
+        */
+        enum CharClass : uint8_t
+        {
+            CHAR_SPACE  = 1 << 0,   // ' ', '\t', '\n', '\v', '\f' and '\r'
+            CHAR_ALPHA  = 1 << 1,   // 'a' to 'z' and 'A' to 'Z'
+            CHAR_DIGIT  = 1 << 2,   // '0' to '9'
+            CHAR_ALNUM  = CHAR_ALPHA | CHAR_DIGIT,
+        };
+
+        /*
+        * \brief    Classes of every character, indexed by the unsigned value of the character
+        */
+        extern const std::array<uint8_t, 256> gCharClasses;
+
+        /*
+        * \fn               IsInCharClass
+        * \brief            Checks if a character belongs to a class
+        * \param c          Character
+        * \param charClass  Class (or union of classes)
+        * \return           True if the character belongs to the class
+        */
+        inline bool IsInCharClass(char c, uint8_t charClass)
+        {
+            return (gCharClasses[static_cast<unsigned char>(c)] & charClass) != 0;
+        }
+
+        /*
+        * \fn                   SkipSpaces
+        * \brief                Finds the end of a run of whitespaces, keeping track of the newlines in the run
+        * \param it             Start of the run
+        * \param end            End of the buffer
+        * \param nbNewlines     Incremented by the number of newlines in the run
+        * \param lastNewline    Set to the last newline of the run, if the run contains any
+        * \return               First character that isn't a whitespace (or end)
+        */
+        const char* SkipSpaces(const char* it, const char* end, size_t& nbNewlines, const char*& lastNewline);
+
+        /*
+        * \fn           SkipAlnums
+        * \brief        Finds the end of a run of letters and digits
+        * \param it     Start of the run
+        * \param end    End of the buffer
+        * \return       First character that is neither a letter nor a digit (or end)
+        */
+        const char* SkipAlnums(const char* it, const char* end);
+
+        /*
+        * \fn           SkipDigits
+        * \brief        Finds the end of a run of digits
+        * \param it     Start of the run
+        * \param end    End of the buffer
+        * \return       First character that isn't a digit (or end)
+        */
+        const char* SkipDigits(const char* it, const char* end);
+
+        /*
+        * \fn           FindChar
+        * \brief        Finds the first occurrence of a character
+        * \param it     Start of the search
+        * \param end    End of the buffer
+        * \param c      Character to look for
+        * \return       First occurrence of the character (or end)
+        */
+        const char* FindChar(const char* it, const char* end, char c);
+    }
+}
+
+#endif // CHAR_SCAN_H__TOSLANG
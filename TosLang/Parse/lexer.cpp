@@ -1,30 +1,148 @@
 #include "lexer.h"
 
+#include "charscan.h"
+
 #include "../Utils/errorlogger.h"
 
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
 #include <fstream>
-#include <iterator>
 
 using namespace TosLang::FrontEnd;
 
+namespace
+{
+    using Token = Lexer::Token;
+
+    /*
+    * \struct   KeywordEntry
+    * \brief    Slot of the keyword table. Empty slots have an empty spelling.
+    */
+    struct KeywordEntry
+    {
+        std::string_view mSpelling;
+        Token mToken;
+        TosLang::Common::Type mType;    /*!< Type named by the keyword, for the TYPE token */
+    };
+
+    constexpr KeywordEntry gKeywords[] =
+    {
+        { "fn",     Token::FUNCTION,    TosLang::Common::Type::UNKNOWN },
+        { "if",     Token::IF,          TosLang::Common::Type::UNKNOWN },
+        { "print",  Token::PRINT,       TosLang::Common::Type::UNKNOWN },
+        { "return", Token::RETURN,      TosLang::Common::Type::UNKNOWN },
+        { "scan",   Token::SCAN,        TosLang::Common::Type::UNKNOWN },
+        { "spawn",  Token::SPAWN,       TosLang::Common::Type::UNKNOWN },
+        { "sleep",  Token::SLEEP,       TosLang::Common::Type::UNKNOWN },
+        { "sync",   Token::SYNC,        TosLang::Common::Type::UNKNOWN },
+        { "var",    Token::VAR,         TosLang::Common::Type::UNKNOWN },
+        { "while",  Token::WHILE,       TosLang::Common::Type::UNKNOWN },
+        { "False",  Token::FALSE,       TosLang::Common::Type::UNKNOWN },
+        { "True",   Token::TRUE,        TosLang::Common::Type::UNKNOWN },
+        { "Bool",   Token::TYPE,        TosLang::Common::Type::BOOL },
+        { "Int",    Token::TYPE,        TosLang::Common::Type::NUMBER },
+        { "String", Token::TYPE,        TosLang::Common::Type::STRING },
+        { "Void",   Token::TYPE,        TosLang::Common::Type::VOID },
+    };
+
+    constexpr size_t KEYWORD_TABLE_SIZE = 64;
+
+    /*
+    * \fn           HashKeyword
+    * \brief        Hashes a word from its first and last characters and its length
+    * \param word   Non empty word to hash
+    * \param seed   Multiplier of the first character
+    * \return       Slot of the word in the keyword table
+    */
+    constexpr size_t HashKeyword(std::string_view word, size_t seed)
+    {
+        return ((static_cast<unsigned char>(word.front()) * seed + static_cast<unsigned char>(word.back())) ^ word.size())
+               & (KEYWORD_TABLE_SIZE - 1);
+    }
+
+    /*
+    * \fn       FindKeywordHashSeed
+    * \brief    Searches for a seed giving each keyword its own slot
+    * \return   Seed of the perfect hash. 0 if there is none.
+    */
+    constexpr size_t FindKeywordHashSeed()
+    {
+        for (size_t seed = 1; seed < 1024; ++seed)
+        {
+            std::array<bool, KEYWORD_TABLE_SIZE> usedSlots{};
+            bool isPerfect = true;
+            for (const KeywordEntry& keyword : gKeywords)
+            {
+                const size_t slot = HashKeyword(keyword.mSpelling, seed);
+                isPerfect = isPerfect && !usedSlots[slot];
+                usedSlots[slot] = true;
+            }
+
+            if (isPerfect)
+                return seed;
+        }
+
+        return 0;
+    }
+
+    constexpr size_t KEYWORD_HASH_SEED = FindKeywordHashSeed();
+    static_assert(KEYWORD_HASH_SEED != 0, "No perfect hash found for the keywords, KEYWORD_TABLE_SIZE must grow");
+
+    constexpr std::array<KeywordEntry, KEYWORD_TABLE_SIZE> MakeKeywordTable()
+    {
+        std::array<KeywordEntry, KEYWORD_TABLE_SIZE> table{};
+        for (size_t i = 0; i < table.size(); ++i)
+            table[i] = { {}, Token::IDENTIFIER, TosLang::Common::Type::UNKNOWN };
+
+        for (const KeywordEntry& keyword : gKeywords)
+            table[HashKeyword(keyword.mSpelling, KEYWORD_HASH_SEED)] = keyword;
+
+        return table;
+    }
+
+    constexpr std::array<KeywordEntry, KEYWORD_TABLE_SIZE> gKeywordTable = MakeKeywordTable();
+}
+
 /*
 * \fn               Init
 * \brief            Initialize the lexer by acquiring the content of a TosLang file
 * \param filename   Name of a file containing a TosLang program
+* \param mode       How the content of the file is acquired
 * \return           Has the initialization been successful?
 */
-bool Lexer::Init(const std::string& filename)
+bool Lexer::Init(const std::string& filename, LoadingMode mode)
 {
-    std::ifstream stream(filename);
-    if (stream)
+    mMappedFile.Close();
+    mBuffer.clear();
+    mCurrentStr = {};
+
+    if ((mode == LoadingMode::MEMORY_MAP) && Utils::MappedFile::IsSupported())
     {
-        mBuffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
-        mBufferIt = mBuffer.begin();
-        mSrcLoc.Init();
-        return true;
+        if (!mMappedFile.Open(filename))
+            return false;
+
+        mBufferIt = mMappedFile.GetData();
+        mBufferEnd = mBufferIt + mMappedFile.GetSize();
     }
-    return false;
+    else
+    {
+        std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+        if (!stream)
+            return false;
+
+        // The file is read in one go rather than character by character
+        mBuffer.resize(static_cast<size_t>(stream.tellg()));
+        stream.seekg(0);
+        stream.read(&mBuffer[0], static_cast<std::streamsize>(mBuffer.size()));
+
+        mBufferIt = mBuffer.data();
+        mBufferEnd = mBufferIt + mBuffer.size();
+    }
+
+    mSrcLoc.Init();
+    return true;
 }
 
 /*
@@ -34,15 +152,19 @@ bool Lexer::Init(const std::string& filename)
 */
 Lexer::Token Lexer::GetNextToken()
 {
-    // Skipping any whitespaces
-    while (mBufferIt != mBuffer.end() && isspace(*mBufferIt, mLoc))
+    // Skipping any whitespaces. The source location is only updated once for the whole run.
+    size_t nbNewlines = 0;
+    const char* lastNewline = nullptr;
+    const char* spacesEnd = SkipSpaces(mBufferIt, mBufferEnd, nbNewlines, lastNewline);
+    if (spacesEnd != mBufferIt)
     {
-        mSrcLoc.Advance(*mBufferIt == '\n');
-        ++mBufferIt;
+        const char* lineStart = nbNewlines > 0 ? lastNewline + 1 : mBufferIt;
+        mSrcLoc.Advance(static_cast<unsigned>(nbNewlines), static_cast<unsigned>(spacesEnd - lineStart));
+        mBufferIt = spacesEnd;
     }
 
     // End of file, we're done
-    if (mBufferIt == mBuffer.end())
+    if (mBufferIt == mBufferEnd)
         return Token::TOK_EOF;
 
     // Caching the current char because we will use it a lot
@@ -79,7 +201,7 @@ Lexer::Token Lexer::GetNextToken()
 		++mBufferIt;
 		return Token::RIGHT_PAREN;
 	case '=':   // TODO: Add test to verify that a distinction is made between assignment and equality
-        if (*(++mBufferIt) == '=')
+        if (NextChar() == '=')
         {
             ++mBufferIt;
             return Token::EQUAL;
@@ -101,7 +223,7 @@ Lexer::Token Lexer::GetNextToken()
 		++mBufferIt;
 		return Token::NOT;
 	case '-':
-		if (*(++mBufferIt) == '>')
+		if (NextChar() == '>')
 		{
 			++mBufferIt;
 			return Token::ARROW;
@@ -111,30 +233,24 @@ Lexer::Token Lexer::GetNextToken()
 			return Token::MINUS;
 		}
 	case '/':
-		if (*(++mBufferIt) == '/')
+		if (NextChar() == '/')
 		{
 			// A comment covers a whole line
-			while (mBufferIt != mBuffer.end() && *mBufferIt != '\n')
-				++mBufferIt;
+			mBufferIt = FindChar(mBufferIt, mBufferEnd, '\n');
 			return Token::COMMENT;
 		}
-        else if (*mBufferIt == '*')
+        else if (CurrentChar() == '*')
         {
             // A multiline comment stops only at the multiline closing symbol '*/'
-            bool lastCharWasStar = false;
-            while (mBufferIt != mBuffer.end())
+            for (const char* star = FindChar(mBufferIt, mBufferEnd, '*'); star != mBufferEnd; star = FindChar(star + 1, mBufferEnd, '*'))
             {
-                if (lastCharWasStar && (*mBufferIt == '/'))
+                if ((star + 1 != mBufferEnd) && (star[1] == '/'))
                 {
-                    ++mBufferIt;
+                    mBufferIt = star + 2;
                     return Token::ML_COMMENT;
                 }
-                else
-                {
-                    lastCharWasStar = (*mBufferIt == '*');
-                    ++mBufferIt;
-                }
             }
+            mBufferIt = mBufferEnd;
 
             Utils::ErrorLogger::PrintErrorAtLocation(Utils::ErrorLogger::ErrorType::UNCLOSED_ML_COMMENT, mSrcLoc);
             return Token::UNKNOWN;
@@ -144,7 +260,7 @@ Lexer::Token Lexer::GetNextToken()
 			return Token::DIVIDE;
 		}
 	case '&':
-		if (*(++mBufferIt) == '&')
+		if (NextChar() == '&')
 		{
 			++mBufferIt;
 			return Token::AND_BOOL;
@@ -154,7 +270,7 @@ Lexer::Token Lexer::GetNextToken()
 			return Token::AND_INT;
 		}
 	case '|':
-		if (*(++mBufferIt) == '|')
+		if (NextChar() == '|')
 		{
 			++mBufferIt;
 			return Token::OR_BOOL;
@@ -164,7 +280,7 @@ Lexer::Token Lexer::GetNextToken()
 			return Token::OR_INT;
 		}
 	case '>':
-		if (*(++mBufferIt) == '>')
+		if (NextChar() == '>')
 		{
 			++mBufferIt;
 			return Token::RIGHT_SHIFT;
@@ -174,7 +290,7 @@ Lexer::Token Lexer::GetNextToken()
 			return Token::GREATER_THAN;
 		}
 	case '<':
-		if (*(++mBufferIt) == '<')
+		if (NextChar() == '<')
 		{
 			++mBufferIt;
 			return Token::LEFT_SHIFT;
@@ -184,11 +300,14 @@ Lexer::Token Lexer::GetNextToken()
 			return Token::LESS_THAN;
 		}
 	case '\"':
-		mCurrentStr.clear();
-        while ((++mBufferIt != mBuffer.end()) && (*mBufferIt != '\n') && (*mBufferIt != '\"'))
-            mCurrentStr += *mBufferIt;
+    {
+        // The string literal is a view of the buffer, without its quotes
+        const char* strStart = mBufferIt + 1;
+        while ((++mBufferIt != mBufferEnd) && (*mBufferIt != '\n') && (*mBufferIt != '\"'))
+            continue;
+        mCurrentStr = std::string_view(strStart, static_cast<size_t>(mBufferIt - strStart));
 
-		if (mBufferIt == mBuffer.end())
+		if (mBufferIt == mBufferEnd)
 		{
             Utils::ErrorLogger::PrintErrorAtLocation(Utils::ErrorLogger::ErrorType::MISSING_CLOSING_QUOTE, mSrcLoc);
 			return Token::UNKNOWN;
@@ -197,10 +316,11 @@ Lexer::Token Lexer::GetNextToken()
         {
             Utils::ErrorLogger::PrintErrorAtLocation(Utils::ErrorLogger::ErrorType::NEW_LINE_IN_LITERAL, mSrcLoc);
 
-            while ((mBufferIt != mBuffer.end()) && (*mBufferIt != '\"'))
+            while ((mBufferIt != mBufferEnd) && (*mBufferIt != '\"'))
                 ++mBufferIt;
 
-            ++mBufferIt;
+            if (mBufferIt != mBufferEnd)
+                ++mBufferIt;
 
             return Token::UNKNOWN;
         }
@@ -209,89 +329,59 @@ Lexer::Token Lexer::GetNextToken()
 			++mBufferIt;
 			return Token::STRING_LITERAL;
 		}
+    }
 	default:
 		// We have and identifier or a keyword
-		if (isalpha(currentChar, mLoc))
+		if (IsInCharClass(currentChar, CHAR_ALPHA))
 		{
-			mCurrentStr = currentChar;
-			while (++mBufferIt != mBuffer.end() && isalnum(*mBufferIt, mLoc))
-			{
-				mCurrentStr += *mBufferIt;
-                mSrcLoc.Advance();
-			}
-
-			if (mCurrentStr == "fn")
-				return Token::FUNCTION;
-			else if (mCurrentStr == "print")
-				return Token::PRINT;
-			else if (mCurrentStr == "scan")
-				return Token::SCAN;
-			else if (mCurrentStr == "String")
-            {
-                mCurrentType = Common::Type::STRING;
-                return Token::TYPE;
-            }
-			else if (mCurrentStr == "var")
-				return Token::VAR;
-			else if (mCurrentStr == "Void")
-            {
-                mCurrentType = Common::Type::VOID;
-                return Token::TYPE;
-            }
-            else if (mCurrentStr == "Int")
-            {
-                mCurrentType = Common::Type::NUMBER;
-                return Token::TYPE;
-            }
-			else if (mCurrentStr == "Bool")
+			const char* identStart = mBufferIt;
+			mBufferIt = SkipAlnums(mBufferIt + 1, mBufferEnd);
+            mCurrentStr = std::string_view(identStart, static_cast<size_t>(mBufferIt - identStart));
+            mSrcLoc.Advance(0, static_cast<unsigned>(mCurrentStr.size() - 1));
+
+            // Keywords are recognized with a single probe in a perfect hash table
+            const KeywordEntry& keyword = gKeywordTable[HashKeyword(mCurrentStr, KEYWORD_HASH_SEED)];
+            if ((keyword.mSpelling.size() == mCurrentStr.size())
+                && (std::memcmp(keyword.mSpelling.data(), mCurrentStr.data(), mCurrentStr.size()) == 0))
             {
-                mCurrentType = Common::Type::BOOL;
-                return Token::TYPE;
+                if (keyword.mToken == Token::TYPE)
+                    mCurrentType = keyword.mType;
+
+                return keyword.mToken;
             }
-			else if (mCurrentStr == "True")
-				return Token::TRUE;
-			else if (mCurrentStr == "False")
-				return Token::FALSE;
-			else if (mCurrentStr == "if")
-				return Token::IF;
-			else if (mCurrentStr == "while")
-				return Token::WHILE;
-			else if (mCurrentStr == "spawn")
-				return Token::SPAWN;
-            else if (mCurrentStr == "sleep")
-                return Token::SLEEP;    // TODO: Test it
-			else if (mCurrentStr == "sync")
-				return Token::SYNC;
-			else if (mCurrentStr == "return")
-				return Token::RETURN;
-			else
-				return Token::IDENTIFIER;
+
+            mCurrentIdentifier = mCurrentStr;
+            return Token::IDENTIFIER;
 		}
 		// We have a numeric value
-		else if (isdigit(currentChar, mLoc))
+		else if (IsInCharClass(currentChar, CHAR_DIGIT))
 		{
-			std::string numberStr;
-			do
-			{
-				numberStr += *mBufferIt;
-			} while (isdigit(*(++mBufferIt), mLoc));
+			const char* numberStart = mBufferIt;
+			mBufferIt = SkipDigits(mBufferIt + 1, mBufferEnd);
 
-            if (isalpha(*mBufferIt, mLoc))
+            if (IsInCharClass(CurrentChar(), CHAR_ALPHA))
             {
                 // Error: letter in a number
                 Utils::ErrorLogger::PrintErrorAtLocation(Utils::ErrorLogger::ErrorType::NUMBER_BAD_SUFFIX, mSrcLoc);
                 // Advance to the next statement
-                while ((mBufferIt != mBuffer.end()) && (*mBufferIt != ';'))
+                while ((mBufferIt != mBufferEnd) && (*mBufferIt != ';'))
                     ++mBufferIt;
 
-                if (mBufferIt != mBuffer.end())
+                if (mBufferIt != mBufferEnd)
                     ++mBufferIt;
 
                 return Token::UNKNOWN;
             }
             else
             {
-                mCurrentNumber = std::stoi(numberStr);
+                const auto result = std::from_chars(numberStart, mBufferIt, mCurrentNumber);
+                if ((result.ec != std::errc{}) || (result.ptr != mBufferIt))
+                {
+                    // Error: the number doesn't fit in an integer
+                    Utils::ErrorLogger::PrintErrorAtLocation(Utils::ErrorLogger::ErrorType::NUMBER_OUT_OF_RANGE, mSrcLoc);
+                    return Token::UNKNOWN;
+                }
+
                 return Token::NUMBER;
             }
 		}
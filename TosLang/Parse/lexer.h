@@ -1,11 +1,13 @@
 #ifndef LEXER_H__TOSLANG
 #define LEXER_H__TOSLANG
 
+#include "../Common/internedstring.h"
 #include "../Common/type.h"
+#include "../Utils/mappedfile.h"
 #include "../Utils/sourceloc.h"
 
-#include <locale>
 #include <string>
+#include <string_view>
 
 namespace TosLang
 {
@@ -81,11 +83,21 @@ namespace TosLang
                 UNKNOWN
             };
 
+            /*
+            * \enum     LoadingMode
+            * \brief    Ways for the lexer to access the content of a file
+            */
+            enum class LoadingMode
+            {
+                COPY,           // The file is read into a buffer owned by the lexer
+                MEMORY_MAP,     // The file is mapped in memory and lexed in place (falls back to COPY where unsupported)
+            };
+
         public:
-            Lexer() : mCurrentType{ Common::Type::ERROR }, mCurrentNumber{ 0 }, mLoc{ "" } { };
+            Lexer() : mCurrentType{ Common::Type::ERROR }, mCurrentNumber{ 0 }, mBufferIt{ nullptr }, mBufferEnd{ nullptr } { };
 
         public:
-            bool Init(const std::string& filename);
+            bool Init(const std::string& filename, LoadingMode mode = LoadingMode::MEMORY_MAP);
             Token GetNextToken();
             
             /*
@@ -111,21 +123,46 @@ namespace TosLang
 
             /*
             * \fn       GetCurrentStr
-            * \brief    Gives the current string
+            * \brief    Gives the current string. It points into the lexer buffer, so it is only
+            *           valid until the lexer is initialized with another file or destroyed.
             * \return   The current string
             */
-            const std::string& GetCurrentStr() const { return mCurrentStr; }
+            std::string_view GetCurrentStr() const { return mCurrentStr; }
+
+            /*
+            * \fn       GetCurrentIdentifier
+            * \brief    Gives the current identifier, as it is stored in the string pool
+            * \return   The current identifier
+            */
+            Common::InternedString GetCurrentIdentifier() const { return mCurrentIdentifier; }
+
+        private:
+            /*
+            * \fn       CurrentChar
+            * \brief    Gives the character at the current position of the lexer
+            * \return   The current character, or '\0' at the end of the buffer
+            */
+            char CurrentChar() const { return mBufferIt != mBufferEnd ? *mBufferIt : '\0'; }
+
+            /*
+            * \fn       NextChar
+            * \brief    Moves the lexer to the next character
+            * \return   The new current character, or '\0' at the end of the buffer
+            */
+            char NextChar() { ++mBufferIt; return CurrentChar(); }
 
         private:
             Common::Type mCurrentType;          /*!< Current type recognized by the lexer */
             Utils::SourceLocation mSrcLoc;      /*!< Information about the current location of the lexer in the file */
 
             int mCurrentNumber;                 /*!< Current number in the lexer buffer */
-            std::string mCurrentStr;            /*!< Current string in the lexer buffer */
+            std::string_view mCurrentStr;       /*!< Current string in the lexer buffer */
+            Common::InternedString mCurrentIdentifier;  /*!< Current identifier */
 
-            std::string mBuffer;                /*!< The lexer buffer */
-            std::string::const_iterator mBufferIt;    /*!< Iterator of the lexer buffer */
-            std::locale mLoc;                   /*!< The source locale */
+            std::string mBuffer;                /*!< Copy of the file (LoadingMode::COPY) */
+            Utils::MappedFile mMappedFile;      /*!< Mapping of the file (LoadingMode::MEMORY_MAP) */
+            const char* mBufferIt;              /*!< Current position in the lexer buffer */
+            const char* mBufferEnd;             /*!< End of the lexer buffer */
         };
     }
 }
@@ -7,6 +7,8 @@
 
 #include "../Utils/errorlogger.h"
 
+#include "../Utils/scheduler.h"
+
 #include <algorithm>
 
 using namespace TosLang::FrontEnd;
@@ -15,6 +17,18 @@ using namespace TosLang::Utils;
 
 static Operation TokenToOpcode(Lexer::Token tok);
 
+/*
+* \struct   PendingBinaryOp
+* \brief    Binary operation whose left-hand side was parsed, waiting for its right-hand side
+*/
+struct Parser::PendingBinaryOp
+{
+    Lexer::Token op;                /*!< Token of the operation */
+    std::unique_ptr<Expr> lhs;      /*!< Left-hand side of the operation */
+    SourceLocation srcLoc;          /*!< Location of the operation */
+    bool isSpawnedExpr;             /*!< Is the expression containing the operation spawning a thread? */
+};
+
 /*
 * \fn               ParseProgram
 * \brief            Generate an AST from
@@ -38,6 +52,46 @@ std::unique_ptr<ASTNode> Parser::ParseProgram(const std::string& filename)
     return ParseProgramDecl();
 }
 
+/*
+* \fn               ParseProgram
+* \brief            Generate the AST of a program spanning several files. Each file is parsed
+*                   concurrently by its own parser, in its own arena, and the declarations of
+*                   the files are then merged in the order of the files.
+* \param filenames  Names of the TosLang files making up the program
+* \param scheduler  Scheduler running the parsers
+* \return           Root node of the AST. Nullptr if a file can't be parsed.
+*/
+std::unique_ptr<ASTNode> Parser::ParseProgram(const std::vector<std::string>& filenames, Utils::Scheduler& scheduler)
+{
+    std::vector<std::unique_ptr<ASTNode>> fileASTs(filenames.size());
+    std::vector<std::string> fileErrors(filenames.size());
+    scheduler.ParallelFor(filenames.size(), [&](size_t iFile)
+    {
+        ErrorLogger::Capture errorCapture;
+        Parser parser;
+        fileASTs[iFile] = parser.ParseProgram(filenames[iFile]);
+        fileErrors[iFile] = errorCapture.GetErrors();
+    });
+
+    // Errors are reported file by file, whatever the order the files were parsed in
+    auto programNode = std::make_unique<ProgramDecl>();
+    bool isProgramValid = true;
+    for (size_t iFile = 0; iFile < filenames.size(); ++iFile)
+    {
+        ErrorLogger::PrintCapturedErrors(fileErrors[iFile]);
+
+        if (fileASTs[iFile] == nullptr)
+            isProgramValid = false;
+        else if (isProgramValid)
+            programNode->MergeProgram(static_cast<ProgramDecl&>(*fileASTs[iFile]));
+    }
+
+    if (!isProgramValid)
+        return nullptr;
+
+    return std::move(programNode);
+}
+
 /*
 * \fn       ParseProgramDecl
 * \brief    programdecl ::= decls
@@ -45,12 +99,18 @@ std::unique_ptr<ASTNode> Parser::ParseProgram(const std::string& filename)
 */
 std::unique_ptr<ASTNode> Parser::ParseProgramDecl()
 {
+    // Every node of the program lives in the arena of the program, which frees them all at once
     auto programNode = std::make_unique<ProgramDecl>();
+    auto arena = std::make_unique<ASTArena>();
+    ASTArena::Scope arenaScope{ arena.get() };
+    programNode->AddArena(std::move(arena));
+
     mCurrentToken = mLexer.GetNextToken();
     
-    std::unique_ptr<Decl> node = std::make_unique<Decl>();
     while (mCurrentToken != Lexer::Token::TOK_EOF)
     {
+        std::unique_ptr<Decl> node;
+
         // Only function and variable are allowed at the program top level
         switch (mCurrentToken)
         {
@@ -65,10 +125,13 @@ std::unique_ptr<ASTNode> Parser::ParseProgramDecl()
             break;
         default:
             ErrorLogger::PrintErrorAtLocation(ErrorLogger::ErrorType::EXPECTED_DECL, mLexer.GetCurrentLocation());
+            node = std::make_unique<Decl>();
             break;
         }
         
-        programNode->AddProgramDecl(std::move(node));
+        // Comments don't declare anything
+        if (node != nullptr)
+            programNode->AddProgramDecl(std::move(node));
 
         // Go to next declaration.
         // In case an error happens, this will skip straight to the next declaration
@@ -95,7 +158,7 @@ std::unique_ptr<FunctionDecl> Parser::ParseFunctionDecl()
         ErrorLogger::PrintErrorAtLocation(ErrorLogger::ErrorType::FN_MISSING_IDENTIFIER, mLexer.GetCurrentLocation());
         return std::move(fnNode);
     }
-    const std::string fnName = mLexer.GetCurrentStr();
+    const Common::InternedString fnName = mLexer.GetCurrentIdentifier();
     SourceLocation srcLoc = mLexer.GetCurrentLocation();
 
     // Make sure the function name is followed by an opening parenthesis
@@ -108,7 +171,7 @@ std::unique_ptr<FunctionDecl> Parser::ParseFunctionDecl()
     // Parse all the parameters
     auto params = std::make_unique<ParamVarDecls>();
     std::unique_ptr<VarDecl> param;
-    std::string varName;
+    Common::InternedString varName;
     while ((mCurrentToken = mLexer.GetNextToken()) != Lexer::Token::RIGHT_PAREN)
     {        
         srcLoc = mLexer.GetCurrentLocation();
@@ -117,7 +180,7 @@ std::unique_ptr<FunctionDecl> Parser::ParseFunctionDecl()
             ErrorLogger::PrintErrorAtLocation(ErrorLogger::ErrorType::PARAM_MISSING_NAME, mLexer.GetCurrentLocation());
             return std::move(fnNode);
         }
-        varName = mLexer.GetCurrentStr();
+        varName = mLexer.GetCurrentIdentifier();
 
         if ((mCurrentToken = mLexer.GetNextToken()) != Lexer::Token::COLON)
         {
@@ -196,7 +259,7 @@ std::unique_ptr<VarDecl> Parser::ParseVarDecl()
         ErrorLogger::PrintErrorAtLocation(ErrorLogger::ErrorType::VAR_MISSING_IDENTIFIER, mLexer.GetCurrentLocation());
         return std::move(node);
     }
-    const std::string varName = mLexer.GetCurrentStr();
+    const Common::InternedString varName = mLexer.GetCurrentIdentifier();
     const SourceLocation srcLoc = mLexer.GetCurrentLocation();
     
     // Make sure the variable name is followed by a colon
@@ -268,14 +331,118 @@ std::unique_ptr<VarDecl> Parser::ParseVarDecl()
 *               ::= numberexpr
 *               ::= spawnexpr
 *               ::= stringexpr
+*
+*           binopexpr ::= expr OP expr
+*
+*           Binary expressions are right associative: the right-hand side of an operation is the rest of the expression.
+*           Instead of recursing once per operation, the operations waiting for their right-hand side are kept on a stack,
+*           so that long chains of operations can't overflow the native stack.
 * \return   A node representing an expression
 */
 std::unique_ptr<Expr> Parser::ParseExpr()
 {
+    std::vector<PendingBinaryOp> pendingOps;
     std::unique_ptr<Expr> node;
     bool isSpawnedExpr = false;
+    bool isOperandParsed = false;
+
+    const Lexer::Token exprTerminators[] = { Lexer::Token::SEMI_COLON, Lexer::Token::LEFT_BRACE, 
+                                             Lexer::Token::RIGHT_BRACE, Lexer::Token::RIGHT_PAREN, Lexer::Token::COMMA };
+    const auto& terminatorsBegin = std::begin(exprTerminators);
+    const auto& terminatorsEnd = std::end(exprTerminators);
+
+    for (;;)
+    {
+        // Parse the beginning of the expression
+        bool isExprDone = false;
+        if (!isOperandParsed)
+        {
+            isSpawnedExpr = false;
+            node = ParseOperandExpr(isSpawnedExpr);
+            isExprDone = node == nullptr;
+        }
+
+        // Here, what could happen is one of the following cases:
+        //      1- The expression could be part of a binary expression
+        //      2- The expression could be a function call
+        //      3- The expression could be an indexed expression
+        //      4- The expression is done being parsed
+        bool isOperationPending = false;
+        while (!isExprDone && (std::find(terminatorsBegin, terminatorsEnd, mCurrentToken) == terminatorsEnd))
+        {
+            if ((Lexer::Token::OP_START <= mCurrentToken) && (mCurrentToken <= Lexer::Token::OP_END))
+            {
+                // The right-hand side of the operation is parsed next
+                const Lexer::Token op = mCurrentToken;
+                mCurrentToken = mLexer.GetNextToken();
+                pendingOps.push_back({ op, std::move(node), mLexer.GetCurrentLocation(), isSpawnedExpr });
+                isOperationPending = true;
+                break;
+            }
+            else if (mCurrentToken == Lexer::Token::LEFT_PAREN)
+            {
+                node.reset(ParseCallExpr(std::move(node), isSpawnedExpr).release());
+            }
+            else if (mCurrentToken == Lexer::Token::LEFT_BRACKET)
+            {
+                // TODO: Check that it really is an identifier we're trying to index, if not log an error (also unit test this)
+                std::unique_ptr<Expr> identExpr{ node.release() };
+                std::unique_ptr<Expr> indexExpr = ParseExpr();
+                SourceLocation arraySrcLoc = mLexer.GetCurrentLocation();
+
+                if (mCurrentToken == Lexer::Token::RIGHT_BRACKET)
+                {
+                    // TODO: Log an error and add a test for it
+                    node.reset();
+                    isExprDone = true;
+                }
+                else
+                {
+                    node.reset(new IndexedExpr(std::move(identExpr), std::move(indexExpr), arraySrcLoc));
+                }
+            }
+            else
+            {
+                // The expression has a trailing part and isn't well-formed, log an error
+                //ErrorLogger::PrintErrorAtLocation(ErrorLogger::ErrorType::WRONG_OPERATION, mLexer.GetCurrentLocation());
+                node.reset();
+                isExprDone = true;
+            }
+        }
+
+        if (isOperationPending)
+        {
+            isOperandParsed = false;
+            continue;
+        }
+
+        // The expression has come to its end. It is either a whole expression or the right-hand side of an operation.
+        if (pendingOps.empty())
+            return node;
+
+        PendingBinaryOp pendingOp = std::move(pendingOps.back());
+        pendingOps.pop_back();
+        if (node == nullptr)
+            ErrorLogger::PrintErrorAtLocation(ErrorLogger::ErrorType::MISSING_RHS, mLexer.GetCurrentLocation());
+        else
+            node = std::make_unique<BinaryOpExpr>(TokenToOpcode(pendingOp.op), std::move(pendingOp.lhs), std::move(node), pendingOp.srcLoc);
+
+        // What comes after the right-hand side belongs to the expression containing the operation
+        isSpawnedExpr = pendingOp.isSpawnedExpr;
+        isOperandParsed = true;
+    }
+}
+
+/*
+* \fn                   ParseOperandExpr
+* \brief                Parses the beginning of an expression, up to what could be an operation, a call or an index
+* \param isSpawnedExpr  Is the expression a function call that'll spawn a thread?
+* \return               A node representing the beginning of the expression. Nullptr if the expression ends there.
+*/
+std::unique_ptr<Expr> Parser::ParseOperandExpr(bool& isSpawnedExpr)
+{
+    std::unique_ptr<Expr> node;
 
-    // Parse the beginning of the expression
     switch (mCurrentToken)
     {
     case Lexer::Token::FALSE:
@@ -288,7 +455,7 @@ std::unique_ptr<Expr> Parser::ParseExpr()
         node = std::make_unique<NumberExpr>(mLexer.GetCurrentNumber(), mLexer.GetCurrentLocation());
         break;
     case Lexer::Token::IDENTIFIER:
-        node = std::make_unique<IdentifierExpr>(mLexer.GetCurrentStr(), mLexer.GetCurrentLocation());
+        node = std::make_unique<IdentifierExpr>(mLexer.GetCurrentIdentifier(), mLexer.GetCurrentLocation());
         break;
     case Lexer::Token::SEMI_COLON:
         return nullptr;
@@ -298,10 +465,13 @@ std::unique_ptr<Expr> Parser::ParseExpr()
     case Lexer::Token::SPAWN:
         isSpawnedExpr = true;
         mCurrentToken = mLexer.GetNextToken();
-        // TODO: the next token must be an identifier
+        // Only a function call can be spawned so the next token must be the name of a function
+        if (mCurrentToken != Lexer::Token::IDENTIFIER)
+            return nullptr;
+        node = std::make_unique<IdentifierExpr>(mLexer.GetCurrentIdentifier(), mLexer.GetCurrentLocation());
         break;
     case Lexer::Token::STRING_LITERAL:
-        node = std::make_unique<StringExpr>(mLexer.GetCurrentStr(), mLexer.GetCurrentLocation());
+        node = std::make_unique<StringExpr>(std::string{ mLexer.GetCurrentStr() }, mLexer.GetCurrentLocation());
         break;
     default:
         if ((Lexer::Token::OP_START <= mCurrentToken) && (mCurrentToken <= Lexer::Token::OP_END))
@@ -314,59 +484,7 @@ std::unique_ptr<Expr> Parser::ParseExpr()
 
     // Look at what comes next
     mCurrentToken = mLexer.GetNextToken();
-
-    const Lexer::Token exprTerminators[] = { Lexer::Token::SEMI_COLON, Lexer::Token::LEFT_BRACE, 
-                                             Lexer::Token::RIGHT_BRACE, Lexer::Token::RIGHT_PAREN, Lexer::Token::COMMA };
-    const auto& terminatorsBegin = std::begin(exprTerminators);
-    const auto& terminatorsEnd = std::end(exprTerminators);
-
-    // Here, what could happen is one of the following cases:
-    //      1- The expression could be part of a binary expression
-    //      2- The expression could be a function call
-    //      3- The expression could be an indexed expression
-    //      4- The expression is done being parsed
-    while (std::find(terminatorsBegin, terminatorsEnd, mCurrentToken) == terminatorsEnd)
-    {
-        if ((Lexer::Token::OP_START <= mCurrentToken) && (mCurrentToken <= Lexer::Token::OP_END))
-        {
-            node.reset(ParseBinaryOpExpr(mCurrentToken, std::move(node)).release());
-        }
-        else if (mCurrentToken == Lexer::Token::LEFT_PAREN)
-        {
-            node.reset(ParseCallExpr(std::move(node), isSpawnedExpr).release());
-        }
-        else if (mCurrentToken == Lexer::Token::LEFT_BRACKET)
-        {
-            // TODO: Check that it really is an identifier we're trying to index, if not log an error (also unit test this)
-            std::unique_ptr<Expr> identExpr{ node.release() };
-            std::unique_ptr<Expr> indexExpr = ParseExpr();
-            SourceLocation arraySrcLoc = mLexer.GetCurrentLocation();
-
-            if (mCurrentToken == Lexer::Token::RIGHT_BRACKET)
-            {
-                // TODO: Log an error and add a test for it
-                return nullptr;
-            }
-
-            node.reset(new IndexedExpr(std::move(identExpr), std::move(indexExpr), arraySrcLoc));
-        }
-        else
-        {
-            // The expression has a trailing part and isn't well-formed, log an error
-            //ErrorLogger::PrintErrorAtLocation(ErrorLogger::ErrorType::WRONG_OPERATION, mLexer.GetCurrentLocation());
-            return nullptr;
-        }
-    }
-    
-    // The expression has come to its natural end, return the expression node we built
-    if (std::find(terminatorsBegin, terminatorsEnd, mCurrentToken) != terminatorsEnd)
-    {
-        return std::move(node);
-    }
-
-    // The expression has a trailing part and isn't well-formed, log an error
-    ErrorLogger::PrintErrorAtLocation(ErrorLogger::ErrorType::WRONG_OPERATION, mLexer.GetCurrentLocation());
-    return nullptr;
+    return node;
 }
 
 /*
@@ -412,32 +530,6 @@ std::unique_ptr<Expr> Parser::ParseArrayExpr()
     return aExpr;
 }
 
-/*
-* \fn           ParseBinaryOpExpr
-* \brief        binopexpr ::= expr OP expr
-* \param lhs    The left hand side expression of the binary expression
-* \param op     The operation in the binary expression
-* \return       A node representing a binary expression 
-*/
-std::unique_ptr<Expr> Parser::ParseBinaryOpExpr(Lexer::Token op, std::unique_ptr<Expr>&& lhs)
-{
-    // Parse the right-hand side of the expression. It is assumed that the left-hand side of the expression has been parsed.
-
-    mCurrentToken = mLexer.GetNextToken();
-    const SourceLocation srcLoc = mLexer.GetCurrentLocation();
-
-    std::unique_ptr<Expr> rhs = ParseExpr();
-    if (rhs == nullptr)
-    {
-        ErrorLogger::PrintErrorAtLocation(ErrorLogger::ErrorType::MISSING_RHS, mLexer.GetCurrentLocation());
-        return nullptr;
-    }
-    else
-    {
-        return std::make_unique<BinaryOpExpr>(TokenToOpcode(op), std::move(lhs), std::move(rhs), srcLoc);
-    }
-}
-
 /*
 * \fn                   ParseCallExpr
 * \brief                callexpr ::= identifierexpr '(' expr* ')'
@@ -485,7 +577,7 @@ std::unique_ptr<Expr> Parser::ParseCallExpr(std::unique_ptr<Expr>&& fn, bool isS
 
     mCurrentToken = mLexer.GetNextToken();
 
-    cExpr.reset(new CallExpr(fn->GetName(), std::move(args), srcLoc));
+    cExpr.reset(new CallExpr(fn->GetNameID(), std::move(args), srcLoc));
 
     if (isSpawnedExpr)
         cExpr.reset(new SpawnExpr(std::move(cExpr), srcLoc));
@@ -669,7 +761,7 @@ std::unique_ptr<ScanStmt> Parser::ParseScanStmt()
     else if(inputExpr->GetKind() != ASTNode::NodeKind::IDENTIFIER_EXPR)
         ErrorLogger::PrintErrorAtLocation(ErrorLogger::ErrorType::SCAN_WRONG_INPUT_TYPE, mLexer.GetCurrentLocation());
     else
-        sStmt.reset(new ScanStmt(std::make_unique<IdentifierExpr>(inputExpr->GetName(), mLexer.GetCurrentLocation()), srcLoc));
+        sStmt.reset(new ScanStmt(std::make_unique<IdentifierExpr>(inputExpr->GetNameID(), mLexer.GetCurrentLocation()), srcLoc));
         
     return sStmt;
 }
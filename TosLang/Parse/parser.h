@@ -4,9 +4,15 @@
 #include "lexer.h"
 
 #include <memory>
+#include <vector>
 
 namespace TosLang
 {
+    namespace Utils
+    {
+        class Scheduler;
+    }
+
     namespace FrontEnd
     {
         class ASTNode;
@@ -32,6 +38,7 @@ namespace TosLang
             ~Parser() = default;
 
             std::unique_ptr<ASTNode> ParseProgram(const std::string& filename);
+            static std::unique_ptr<ASTNode> ParseProgram(const std::vector<std::string>& filenames, Utils::Scheduler& scheduler);
             
         private:	// Declarations
             std::unique_ptr<ASTNode> ParseProgramDecl();
@@ -40,8 +47,8 @@ namespace TosLang
 
 		private:	// Expressions
 			std::unique_ptr<Expr> ParseExpr();
+            std::unique_ptr<Expr> ParseOperandExpr(bool& isSpawnedExpr);
             std::unique_ptr<Expr> ParseArrayExpr();
-			std::unique_ptr<Expr> ParseBinaryOpExpr(Lexer::Token operationToken, std::unique_ptr<Expr>&& lhs);
             std::unique_ptr<Expr> ParseCallExpr(std::unique_ptr<Expr>&& fn, const bool isSpawnedExpr);
 
         private:    // Statements
@@ -56,6 +63,9 @@ namespace TosLang
         private:    // Helpers
             bool ParseArrayType(int& arraySize, Common::Type& arrayType);
 
+        private:
+            struct PendingBinaryOp;
+
         private:
             Lexer mLexer;               /*!< Lexer used by the parser to acquire tokens */
             Lexer::Token mCurrentToken; /*!< Current token being treated by the parser */
@@ -4,43 +4,123 @@
 #include "../AST/declarations.h"
 #include "../AST/expressions.h"
 #include "../Sema/symboltable.h"
+#include "../Utils/scheduler.h"
 
 #include <cassert>
+#include <utility>
+#include <vector>
 
 // TODO: I've named way too much variables 'ssaInst'. Some renamings are in order.
 
 using namespace TosLang::FrontEnd;
 using namespace TosLang::BackEnd;
 
-std::unique_ptr<SSAModule> CFGBuilder::Run(const std::unique_ptr<ASTNode>& root, const std::shared_ptr<SymbolTable>& symTable)
+/*
+* \fn                   Run
+* \brief                Builds the CFG of the program
+* \param root           Root of the program AST
+* \param symTable       Symbol table associated with the given AST
+* \param prebuiltFuncs  CFGs of function declarations built beforehand, which are used as is
+* \return               Module containing the CFG of the program
+*/
+std::unique_ptr<SSAModule> CFGBuilder::Run(const std::unique_ptr<ASTNode>& root, const std::shared_ptr<SymbolTable>& symTable, 
+                                           const PrebuiltFunctions& prebuiltFuncs)
 {
     // Reset the state of the cfg builder
+    mNextID = 0;
     mCurrentVarDef.clear();
     mIncompletePHIs.clear();
+    mSealedBlocks.clear();
     mMod.reset(new SSAModule{});
 
     mSymTable = symTable;
 
-    HandleProgramDecl(root);
+    for (const ASTNode* fDecl : HandleProgramDecl(root))
+    {
+        const std::string& fName = dynamic_cast<const FunctionDecl*>(fDecl)->GetFunctionName();
+
+        auto prebuiltIt = prebuiltFuncs.find(fDecl);
+        if (prebuiltIt != prebuiltFuncs.end())
+        {
+            mMod->InsertFunction(fName, prebuiltIt->second);
+            continue;
+        }
+
+        CFGBuilder fBuilder;
+        fBuilder.mSymTable = mSymTable;
+        mMod->InsertFunction(fName, fBuilder.HandleFunctionDecl(fDecl));
+    }
+
+    return std::move(mMod);
+}
+
+/*
+* \fn               Run
+* \brief            Builds the CFG of the program, building its functions concurrently.
+*                   Each function is built by its own builder, and the functions are then 
+*                   inserted in the module in declaration order, as a serial run would do.
+* \param root           Root of the program AST
+* \param symTable       Symbol table associated with the given AST
+* \param scheduler      Scheduler running the builders
+* \param prebuiltFuncs  CFGs of function declarations built beforehand, which are used as is
+* \return               Module containing the CFG of the program
+*/
+std::unique_ptr<SSAModule> CFGBuilder::Run(const std::unique_ptr<ASTNode>& root, const std::shared_ptr<SymbolTable>& symTable, Utils::Scheduler& scheduler,
+                                           const PrebuiltFunctions& prebuiltFuncs)
+{
+    // Reset the state of the cfg builder
+    mNextID = 0;
+    mCurrentVarDef.clear();
+    mIncompletePHIs.clear();
+    mSealedBlocks.clear();
+    mMod.reset(new SSAModule{});
+
+    mSymTable = symTable;
+
+    const std::vector<const ASTNode*> fDecls = HandleProgramDecl(root);
+
+    // The symbol table and the AST are shared by every thread, so they are only read
+    std::vector<FuncPtr> functions(fDecls.size());
+    scheduler.ParallelFor(fDecls.size(), [&](size_t iDecl)
+    {
+        auto prebuiltIt = prebuiltFuncs.find(fDecls[iDecl]);
+        if (prebuiltIt != prebuiltFuncs.end())
+        {
+            functions[iDecl] = prebuiltIt->second;
+            return;
+        }
+
+        CFGBuilder fBuilder;
+        fBuilder.mSymTable = mSymTable;
+        functions[iDecl] = fBuilder.HandleFunctionDecl(fDecls[iDecl]);
+    });
+
+    for (size_t iDecl = 0; iDecl < fDecls.size(); ++iDecl)
+        mMod->InsertFunction(dynamic_cast<const FunctionDecl*>(fDecls[iDecl])->GetFunctionName(), functions[iDecl]);
+
     return std::move(mMod);
 }
 
 // Declarations
-void CFGBuilder::HandleProgramDecl(const std::unique_ptr<ASTNode>& root)
+std::vector<const ASTNode*> CFGBuilder::HandleProgramDecl(const std::unique_ptr<ASTNode>& root)
 {
+    std::vector<const ASTNode*> fDecls;
+
     for (auto& stmt : root->GetChildrenNodes())
     {
         if (stmt->GetKind() == ASTNode::NodeKind::FUNCTION_DECL)
-            HandleFunctionDecl(stmt.get());
+            fDecls.push_back(stmt.get());
         else if (stmt->GetKind() == ASTNode::NodeKind::VAR_DECL)
             HandleVarDecl(stmt.get());
         else
             // Shouldn't happen. If it does, it's because someone forgot to run the scope checker.
             assert(false && "Unknown declaration in program");  
     }
+
+    return fDecls;
 }
 
-void CFGBuilder::HandleFunctionDecl(const ASTNode* decl)
+FuncPtr CFGBuilder::HandleFunctionDecl(const ASTNode* decl)
 {
     const FunctionDecl* fDecl = dynamic_cast<const FunctionDecl*>(decl);
     assert(fDecl != nullptr);
@@ -50,8 +130,6 @@ void CFGBuilder::HandleFunctionDecl(const ASTNode* decl)
     mCurrentFunction = pFuncPtr.get();
     mCurrentBlock = mCurrentFunction->CreateNewBlock().get();
 
-    mMod->InsertFunction(fDecl->GetFunctionName(), pFuncPtr);
-
     // Associate each of the function argument with a SSA value
     const ParamVarDecls* paramsDecl = fDecl->GetParametersDecl();
     for (auto& param : paramsDecl->GetParameters())
@@ -66,7 +144,7 @@ void CFGBuilder::HandleFunctionDecl(const ASTNode* decl)
         SSAValue ssaVal{ mNextID++ };
         mCurrentFunction->AddArguments(ssaVal);
         WriteVariable(paramSymbol, mCurrentBlock, 
-                      mCurrentFunction->GetArgument(mCurrentFunction->GetNbArguments()));
+                      mCurrentFunction->GetArgument(mCurrentFunction->GetNbArguments() - 1));
     }
 
     HandleCompoundStmt(fDecl->GetBody());
@@ -74,6 +152,8 @@ void CFGBuilder::HandleFunctionDecl(const ASTNode* decl)
     // Removing ties to the function
     mCurrentBlock = nullptr;
     mCurrentFunction = nullptr;
+
+    return pFuncPtr;
 }
 
 void CFGBuilder::HandleVarDecl(const ASTNode* decl) 
@@ -163,7 +243,7 @@ const SSAInstruction* CFGBuilder::HandleExpr(const Expr* expr)
         //assert(sExpr != nullptr);
         //
         //// We add the string literal to the module
-        //unsigned memSlot = mMod->InsertArrayVariable(sExpr->GetName(), sExpr->GetName()); // Name and value are the same for simplicity
+        //unsigned memSlot = mMod->InsertArrayVariable(sExpr->GetValue(), sExpr->GetValue()); // Name and value are the same for simplicity
         //
         //// We generate a load of the string literal address
         //auto vInst = VirtualInstruction{ VirtualInstruction::Opcode::LOAD_IMM }
@@ -183,11 +263,40 @@ const SSAInstruction* CFGBuilder::HandleExpr(const Expr* expr)
 
 const SSAInstruction* CFGBuilder::HandleBinaryExpr(const ASTNode* expr)
 {
-    const BinaryOpExpr* bExpr = dynamic_cast<const BinaryOpExpr*>(expr);
-    assert(bExpr != nullptr);
-
     // TODO: Assignment
 
+    // Binary expressions are right associative, so a long expression is a chain of right hand sides as deep as it is long.
+    // The chain is walked with a loop: the left hand sides are handled on the way down, then the operations are added 
+    // on the way back up.
+    std::vector<std::pair<SSAInstruction::Operation, SSAValue>> pendingOps;
+    const ASTNode* rhs = expr;
+    do
+    {
+        const BinaryOpExpr* bExpr = dynamic_cast<const BinaryOpExpr*>(rhs);
+        assert(bExpr != nullptr);
+
+        const SSAInstruction* lhsInst = HandleExpr(bExpr->GetLHS());
+        pendingOps.emplace_back(GetBinaryOperation(bExpr), lhsInst->GetReturnValue());
+        rhs = bExpr->GetRHS();
+    } while (rhs->GetKind() == ASTNode::NodeKind::BINARY_EXPR);
+
+    const SSAInstruction* exprInst = HandleExpr(static_cast<const Expr*>(rhs));
+    while (!pendingOps.empty())
+    {
+        SSAInstruction ssaInst{ pendingOps.back().first, mNextID++, mCurrentBlock };
+        ssaInst.AddOperand(pendingOps.back().second);
+        ssaInst.AddOperand(exprInst->GetReturnValue());
+
+        // Add the instruction to the program
+        exprInst = AddInstruction(ssaInst);
+        pendingOps.pop_back();
+    }
+
+    return exprInst;
+}
+
+SSAInstruction::Operation CFGBuilder::GetBinaryOperation(const BinaryOpExpr* bExpr)
+{
     // Choose the correct opcode
     SSAInstruction::Operation op = SSAInstruction::Operation::UNKNOWN;
     switch (bExpr->GetOperation())
@@ -240,16 +349,7 @@ const SSAInstruction* CFGBuilder::HandleBinaryExpr(const ASTNode* expr)
     // A match should have been found
     assert(op != SSAInstruction::Operation::UNKNOWN);
 
-    // Handle the expression's operands
-    const SSAInstruction* lhsInst = HandleExpr(bExpr->GetLHS());
-    const SSAInstruction* rhsInst = HandleExpr(bExpr->GetRHS());
-        
-    SSAInstruction ssaInst{ op, mNextID++, mCurrentBlock };
-    ssaInst.AddOperand(lhsInst->GetReturnValue());
-    ssaInst.AddOperand(rhsInst->GetReturnValue());
-
-    // Add the instruction to the program
-    return AddInstruction(ssaInst);    
+    return op;
 }
 
 void CFGBuilder::HandleCallExpr(const ASTNode* expr) 
@@ -464,7 +564,7 @@ void CFGBuilder::WriteVariable(const Symbol* variable, const SSABlock* block, co
     mCurrentVarDef[variable][block] = value;
 }
 
-SSAValue CFGBuilder::ReadVariable(const Symbol* variable, const SSABlock* block)
+SSAValue CFGBuilder::ReadVariable(const Symbol* variable, SSABlock* block)
 {
     auto varIt = mCurrentVarDef[variable].find(block);
     if (varIt != mCurrentVarDef[variable].end())
@@ -473,7 +573,7 @@ SSAValue CFGBuilder::ReadVariable(const Symbol* variable, const SSABlock* block)
         return ReadVariableRecursive(variable, block);
 }
 
-SSAValue CFGBuilder::ReadVariableRecursive(const Symbol* variable, const SSABlock* block)
+SSAValue CFGBuilder::ReadVariableRecursive(const Symbol* variable, SSABlock* block)
 {
     SSAInstruction* ssaInst;
     SSAValue ssaVal;
@@ -482,21 +582,21 @@ SSAValue CFGBuilder::ReadVariableRecursive(const Symbol* variable, const SSABloc
     if (sealedIt != mSealedBlocks.end())
     {
         // Incomplete CFG
-        mCurrentBlock->InsertInstruction(SSAInstruction{ SSAInstruction::Operation::PHI, mNextID++, mCurrentBlock });
-        ssaInst = mCurrentBlock->GetTerminator();
+        block->InsertInstruction(SSAInstruction{ SSAInstruction::Operation::PHI, mNextID++, block });
+        ssaInst = block->GetTerminator();
         mIncompletePHIs[block][variable] = ssaInst;
     }
-    else if (mCurrentBlock->GetPredecessors().size() == 1)
+    else if (block->GetPredecessors().size() == 1)
     {
         // No PHI needed for a block with a single predecessor
-        ssaVal = ReadVariable(variable, mCurrentBlock->GetPredecessors().front().get());
+        ssaVal = ReadVariable(variable, block->GetPredecessors().front().get());
     }
     else
     {
         // Break potential cycles with operandless PHI
-        mCurrentBlock->InsertInstruction(SSAInstruction{ SSAInstruction::Operation::PHI, mNextID++, mCurrentBlock });
-        ssaInst = mCurrentBlock->GetTerminator();
-        WriteVariable(variable, block, ssaVal);
+        block->InsertInstruction(SSAInstruction{ SSAInstruction::Operation::PHI, mNextID++, block });
+        ssaInst = block->GetTerminator();
+        WriteVariable(variable, block, ssaInst->GetReturnValue());
         ssaVal = AddPHIOperand(variable, ssaInst);
     }
 
@@ -8,12 +8,19 @@
 #include <memory>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 namespace TosLang
 {
+    namespace Utils
+    {
+        class Scheduler;
+    }
+
     namespace FrontEnd
     {
         class ASTNode;
+        class BinaryOpExpr;
         class CompoundStmt;
         class Expr;
         class FunctionDecl;
@@ -35,6 +42,8 @@ namespace TosLang
          * \brief Builds a graphical representation (CFG) of the program described by given AST. 
          *        The CFG produced is in SSA form to facilitate further optimizations and register allocation.
          *        The algorithm used is largely inspired by: https://pp.info.uni-karlsruhe.de/uploads/publikationen/braun13cc.pdf
+         *        Functions are built independently of each other: their blocks and values are numbered from 0,
+         *        which gives the same CFGs whether they are built one after another or concurrently.
          */
         class CFGBuilder
         {
@@ -45,17 +54,48 @@ namespace TosLang
                   mCurrentFunction{ nullptr }, mCurrentBlock{ nullptr } { }
 
         public:
+            using PrebuiltFunctions = std::unordered_map<const FrontEnd::ASTNode*, FuncPtr>;
+
             std::unique_ptr<Module<SSAInstruction>> Run(const std::unique_ptr<FrontEnd::ASTNode>& root, 
-                                                        const std::shared_ptr<FrontEnd::SymbolTable>& symTable);
+                                                        const std::shared_ptr<FrontEnd::SymbolTable>& symTable,
+                                                        const PrebuiltFunctions& prebuiltFuncs = {});
+            std::unique_ptr<Module<SSAInstruction>> Run(const std::unique_ptr<FrontEnd::ASTNode>& root,
+                                                        const std::shared_ptr<FrontEnd::SymbolTable>& symTable,
+                                                        Utils::Scheduler& scheduler,
+                                                        const PrebuiltFunctions& prebuiltFuncs = {});
 
         protected:  // Declarations
-            void HandleFunctionDecl(const FrontEnd::ASTNode* decl);
-            void HandleProgramDecl(const std::unique_ptr<FrontEnd::ASTNode>& root);
+            /*
+            * \fn           HandleFunctionDecl
+            * \brief        Builds the CFG of a function. Only the state of the function being built is
+            *               modified, so functions can be built by different builders at the same time.
+            * \param decl   Function declaration AST node
+            * \return       CFG of the function
+            */
+            FuncPtr HandleFunctionDecl(const FrontEnd::ASTNode* decl);
+
+            /*
+            * \fn           HandleProgramDecl
+            * \brief        Adds the global variables of the program to the module
+            * \param root   Program declaration AST node
+            * \return       Function declarations of the program, in order, left for the caller to build
+            */
+            std::vector<const FrontEnd::ASTNode*> HandleProgramDecl(const std::unique_ptr<FrontEnd::ASTNode>& root);
+
             void HandleVarDecl(const FrontEnd::ASTNode* decl);
 
         protected:  // Expressions
             const SSAInstruction* HandleExpr(const FrontEnd::Expr* expr);
+
+            /*
+            * \fn           HandleBinaryExpr
+            * \brief        Adds the instructions of a binary operation. The chain of operations nested in its right hand side
+            *               is handled without recursing.
+            * \param expr   Binary operation AST node
+            * \return       Instruction computing the value of the operation
+            */
             const SSAInstruction* HandleBinaryExpr(const FrontEnd::ASTNode* expr);
+
             void HandleCallExpr(const FrontEnd::ASTNode* expr);
 
         protected:  // Statements
@@ -75,6 +115,14 @@ namespace TosLang
             void HandleWhileStmt(const FrontEnd::ASTNode* stmt);
 
         private:
+            /*
+            * \fn           GetBinaryOperation
+            * \brief        Finds the SSA operation performing a binary operation
+            * \param bExpr  Binary operation AST node
+            * \return       SSA operation
+            */
+            static SSAInstruction::Operation GetBinaryOperation(const FrontEnd::BinaryOpExpr* bExpr);
+
             /*
             * TODO
             */
@@ -96,12 +144,12 @@ namespace TosLang
             /*
             * TODO
             */
-            SSAValue ReadVariable(const FrontEnd::Symbol* variable, const SSABlock* block);
+            SSAValue ReadVariable(const FrontEnd::Symbol* variable, SSABlock* block);
 
             /*
             * TODO
             */
-            SSAValue ReadVariableRecursive(const FrontEnd::Symbol* variable, const SSABlock* block);
+            SSAValue ReadVariableRecursive(const FrontEnd::Symbol* variable, SSABlock* block);
 
             /*
             * TODO
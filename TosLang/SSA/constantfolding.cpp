@@ -0,0 +1,191 @@
+#include "constantfolding.h"
+
+#include <climits>
+#include <cstdint>
+#include <unordered_map>
+
+using namespace TosLang::BackEnd;
+
+/*
+* \fn           Run
+* \brief        Folds the constant instructions of a function
+* \param func   Function to transform
+* \return       Number of operands replaced by literals and of instructions folded
+*/
+size_t ConstantFolding::Run(SSAFunction& func)
+{
+    std::unordered_map<size_t, int> constants;
+    size_t nbChanges = 0;
+
+    // A value can be used in a block coming before the one defining it, so the function is swept until nothing changes
+    bool hasChanged = true;
+    while (hasChanged)
+    {
+        hasChanged = false;
+        for (const auto& block : func.GetBlocks())
+        {
+            for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+            {
+                SSAInstruction& inst = **instIt;
+
+                // PHIs depend on the path taken to their block, and moves with many operands are assignments
+                const bool isPHI = inst.GetOperation() == SSAInstruction::Operation::PHI;
+                const bool isAssignment = (inst.GetOperation() == SSAInstruction::Operation::MOV) && (inst.GetOperands().size() != 1);
+                if (isPHI || isAssignment)
+                    continue;
+
+                const std::vector<SSAValue>& operands = inst.GetOperands();
+                for (size_t iOp = 0; iOp < operands.size(); ++iOp)
+                {
+                    if (operands[iOp].GetKind() == SSAValue::ValueKind::LITERAL)
+                        continue;
+
+                    auto constIt = constants.find(operands[iOp].GetID());
+                    if (constIt != constants.end())
+                    {
+                        inst.SetOperand(iOp, SSAValue{ operands[iOp].GetID(), constIt->second });
+                        ++nbChanges;
+                        hasChanged = true;
+                    }
+                }
+
+                int result;
+                if (IsFoldable(inst)
+                    && (operands[0].GetKind() == SSAValue::ValueKind::LITERAL)
+                    && (operands[1].GetKind() == SSAValue::ValueKind::LITERAL)
+                    && FoldOperation(inst.GetOperation(), operands[0].GetLiteralValue(), operands[1].GetLiteralValue(), result))
+                {
+                    ReplaceWithConstant(inst, result);
+                    ++nbChanges;
+                    hasChanged = true;
+                }
+
+                if (IsConstantMove(inst))
+                    constants.emplace(inst.GetReturnValue().GetID(), inst.GetOperands().front().GetLiteralValue());
+            }
+        }
+    }
+
+    return nbChanges;
+}
+
+/*
+* \fn           FoldOperation
+* \brief        Computes the result of a binary operation on constants, the way the machine would.
+*               Operations failing at runtime, such as a division by zero, are left for the machine to report.
+* \param op     Operation
+* \param lhs    Left hand side operand
+* \param rhs    Right hand side operand
+* \param result Result of the operation
+* \return       True if the operation could be folded
+*/
+bool ConstantFolding::FoldOperation(SSAInstruction::Operation op, int lhs, int rhs, int& result)
+{
+    // Arithmetic wraps around on overflow instead of being undefined
+    const uint32_t uLhs = static_cast<uint32_t>(lhs);
+    const uint32_t uRhs = static_cast<uint32_t>(rhs);
+
+    switch (op)
+    {
+    case SSAInstruction::Operation::ADD:
+        result = static_cast<int>(uLhs + uRhs);
+        return true;
+    case SSAInstruction::Operation::SUB:
+        result = static_cast<int>(uLhs - uRhs);
+        return true;
+    case SSAInstruction::Operation::MUL:
+        result = static_cast<int>(uLhs * uRhs);
+        return true;
+    case SSAInstruction::Operation::DIV:
+    case SSAInstruction::Operation::MOD:
+        if ((rhs == 0) || ((lhs == INT_MIN) && (rhs == -1)))
+            return false;
+        result = op == SSAInstruction::Operation::DIV ? lhs / rhs : lhs % rhs;
+        return true;
+    case SSAInstruction::Operation::LSHIFT:
+    case SSAInstruction::Operation::RSHIFT:
+        if ((rhs < 0) || (rhs >= 32))
+            return false;
+        result = op == SSAInstruction::Operation::LSHIFT ? static_cast<int>(uLhs << rhs) : lhs >> rhs;
+        return true;
+    case SSAInstruction::Operation::AND:
+        result = lhs & rhs;
+        return true;
+    case SSAInstruction::Operation::OR:
+        result = lhs | rhs;
+        return true;
+    case SSAInstruction::Operation::XOR:
+        result = lhs ^ rhs;
+        return true;
+    case SSAInstruction::Operation::GT:
+        result = lhs > rhs ? 1 : 0;
+        return true;
+    case SSAInstruction::Operation::LT:
+        result = lhs < rhs ? 1 : 0;
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*
+* \fn           IsFoldable
+* \brief        Indicates if an instruction is a binary operation that can be folded when its operands are constants
+* \param inst   Instruction
+* \return       True if the instruction can be folded
+*/
+bool ConstantFolding::IsFoldable(const SSAInstruction& inst)
+{
+    if (inst.GetOperands().size() != 2)
+        return false;
+
+    switch (inst.GetOperation())
+    {
+    case SSAInstruction::Operation::ADD:
+    case SSAInstruction::Operation::SUB:
+    case SSAInstruction::Operation::MUL:
+    case SSAInstruction::Operation::DIV:
+    case SSAInstruction::Operation::MOD:
+    case SSAInstruction::Operation::LSHIFT:
+    case SSAInstruction::Operation::RSHIFT:
+    case SSAInstruction::Operation::AND:
+    case SSAInstruction::Operation::OR:
+    case SSAInstruction::Operation::XOR:
+    case SSAInstruction::Operation::GT:
+    case SSAInstruction::Operation::LT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*
+* \fn           IsConstantMove
+* \brief        Indicates if an instruction moves a literal in its value
+* \param inst   Instruction
+* \return       True if the value of the instruction is a constant
+*/
+bool ConstantFolding::IsConstantMove(const SSAInstruction& inst)
+{
+    return (inst.GetOperation() == SSAInstruction::Operation::MOV)
+        && (inst.GetOperands().size() == 1)
+        && (inst.GetOperands().front().GetKind() == SSAValue::ValueKind::LITERAL);
+}
+
+/*
+* \fn           ReplaceWithConstant
+* \brief        Replaces an instruction by a move of a constant in its value. The value and the users of the instruction are kept.
+* \param inst   Instruction to replace
+* \param value  Constant taken by the value of the instruction
+*/
+void ConstantFolding::ReplaceWithConstant(SSAInstruction& inst, int value)
+{
+    const size_t valID = inst.GetReturnValue().GetID();
+
+    SSAInstruction constMove{ SSAInstruction::Operation::MOV, valID, inst.GetBlock() };
+    constMove.AddOperand(SSAValue{ valID, value });
+    for (SSAInstruction* user : inst.GetUsers())
+        constMove.AddUser(user);
+
+    inst = constMove;
+}
@@ -0,0 +1,32 @@
+#ifndef CONSTANT_FOLDING__TOSLANG
+#define CONSTANT_FOLDING__TOSLANG
+
+#include "ssapassmanager.h"
+
+namespace TosLang
+{
+    namespace BackEnd
+    {
+        /*
+        * \class ConstantFolding
+        * \brief Replaces the arithmetic and logic instructions whose operands are all constants by a move of their result.
+        *        Operands known to be constants are replaced by literals, so the folding goes along chains of instructions.
+        *        Control flow isn't looked at: values merged by PHIs are left to the SCCP pass.
+        */
+        class ConstantFolding : public SSAPass
+        {
+        public:
+            const char* GetName() const override { return "ConstantFolding"; }
+
+            size_t Run(SSAFunction& func) override;
+
+        public:
+            static bool FoldOperation(SSAInstruction::Operation op, int lhs, int rhs, int& result);
+            static bool IsFoldable(const SSAInstruction& inst);
+            static bool IsConstantMove(const SSAInstruction& inst);
+            static void ReplaceWithConstant(SSAInstruction& inst, int value);
+        };
+    }
+}
+
+#endif // CONSTANT_FOLDING__TOSLANG
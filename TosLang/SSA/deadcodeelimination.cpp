@@ -0,0 +1,119 @@
+#include "deadcodeelimination.h"
+
+using namespace TosLang::BackEnd;
+
+/*
+* \fn           Run
+* \brief        Removes the dead instructions of a function
+* \param func   Function to transform
+* \return       Number of instructions removed
+*/
+size_t DeadCodeElimination::Run(SSAFunction& func)
+{
+    func.UpdateUsers();
+
+    mDefs.clear();
+    mDeadInsts.clear();
+    mWorklist.clear();
+    for (const SSABlockPtr& block : func.GetBlocks())
+    {
+        for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+        {
+            SSAInstruction* inst = instIt->get();
+            mDefs.emplace(inst->GetReturnValue().GetID(), inst);
+            if (inst->GetUsers().empty() && !HasSideEffects(*inst))
+                mWorklist.push_back(inst);
+        }
+    }
+
+    while (!mWorklist.empty())
+    {
+        SSAInstruction* inst = mWorklist.back();
+        mWorklist.pop_back();
+        if (!mDeadInsts.insert(inst).second)
+            continue;
+
+        for (const SSAValue& operand : inst->GetOperands())
+        {
+            if (operand.GetKind() == SSAValue::ValueKind::LITERAL)
+                continue;
+
+            auto defIt = mDefs.find(operand.GetID());
+            if (defIt == mDefs.end())
+                continue;
+
+            SSAInstruction* def = defIt->second;
+            def->RemoveUser(inst);
+            if (def->GetUsers().empty() && !HasSideEffects(*def))
+                mWorklist.push_back(def);
+        }
+    }
+
+    if (mDeadInsts.empty())
+        return 0;
+
+    for (const SSABlockPtr& block : func.GetBlocks())
+        block->RemoveInstructions([this](const SSAInstruction& inst) { return mDeadInsts.find(&inst) != mDeadInsts.end(); });
+
+    return mDeadInsts.size();
+}
+
+/*
+* \fn           CanTrap
+* \brief        Indicates if an instruction can stop the program. A division stops it when the divisor is zero,
+*               or when the dividend is INT_MIN and the divisor -1, so only literal divisors other than these are safe.
+* \param inst   Instruction
+* \return       True if the instruction may stop the program
+*/
+bool DeadCodeElimination::CanTrap(const SSAInstruction& inst)
+{
+    switch (inst.GetOperation())
+    {
+    case SSAInstruction::Operation::DIV:
+    case SSAInstruction::Operation::MOD:
+    {
+        if (inst.GetOperands().size() != 2)
+            return true;
+
+        const SSAValue& divisor = inst.GetOperands().back();
+        return (divisor.GetKind() != SSAValue::ValueKind::LITERAL) || (divisor.GetLiteralValue() == 0) || (divisor.GetLiteralValue() == -1);
+    }
+    default:
+        return false;
+    }
+}
+
+/*
+* \fn           HasSideEffects
+* \brief        Indicates if an instruction does more than computing its value, in which case it must be kept
+* \param inst   Instruction
+* \return       True if the instruction has side effects
+*/
+bool DeadCodeElimination::HasSideEffects(const SSAInstruction& inst)
+{
+    switch (inst.GetOperation())
+    {
+    case SSAInstruction::Operation::PHI:
+    case SSAInstruction::Operation::ADD:
+    case SSAInstruction::Operation::SUB:
+    case SSAInstruction::Operation::GT:
+    case SSAInstruction::Operation::LT:
+    case SSAInstruction::Operation::AND:
+    case SSAInstruction::Operation::OR:
+    case SSAInstruction::Operation::XOR:
+    case SSAInstruction::Operation::MUL:
+    case SSAInstruction::Operation::LSHIFT:
+    case SSAInstruction::Operation::RSHIFT:
+    case SSAInstruction::Operation::NOT:
+    case SSAInstruction::Operation::NEG:
+        return false;
+    case SSAInstruction::Operation::MOV:
+        // Moves with many operands are assignments
+        return inst.GetOperands().size() != 1;
+    case SSAInstruction::Operation::DIV:
+    case SSAInstruction::Operation::MOD:
+        return CanTrap(inst);
+    default:
+        return true;
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef DEAD_CODE_ELIMINATION__TOSLANG
+#define DEAD_CODE_ELIMINATION__TOSLANG
+
+#include "ssapassmanager.h"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace TosLang
+{
+    namespace BackEnd
+    {
+        /*
+        * \class DeadCodeElimination
+        * \brief Removes the instructions without side effects whose value isn't used by any other instruction.
+        *        Removing an instruction can leave the instructions computing its operands without users,
+        *        so they are removed in turn.
+        */
+        class DeadCodeElimination : public SSAPass
+        {
+        public:
+            const char* GetName() const override { return "DeadCodeElimination"; }
+
+            size_t Run(SSAFunction& func) override;
+
+        public:
+            static bool CanTrap(const SSAInstruction& inst);
+            static bool HasSideEffects(const SSAInstruction& inst);
+
+        private:
+            std::unordered_map<size_t, SSAInstruction*> mDefs;          /*!< Instruction defining every value, by value ID */
+            std::unordered_set<const SSAInstruction*> mDeadInsts;       /*!< Instructions to be removed */
+            std::vector<SSAInstruction*> mWorklist;                     /*!< Instructions found to be without users */
+        };
+    }
+}
+
+#endif // DEAD_CODE_ELIMINATION__TOSLANG
@@ -0,0 +1,242 @@
+#include "globalvaluenumbering.h"
+
+#include <utility>
+
+using namespace TosLang::BackEnd;
+
+/*
+* \fn           Run
+* \brief        Removes the redundant instructions of a function
+* \param func   Function to transform
+* \return       Number of instructions removed
+*/
+size_t GlobalValueNumbering::Run(SSAFunction& func)
+{
+    if (func.GetBlocks().empty())
+        return 0;
+
+    func.UpdateUsers();
+
+    mDefs.clear();
+    mExpressions.clear();
+    mScopedExpressions.clear();
+    mRedundantInsts.clear();
+
+    size_t nbInsts = 0;
+    for (const SSABlockPtr& block : func.GetBlocks())
+        nbInsts += block->GetNbInstructions();
+
+    mDefs.reserve(nbInsts);
+    mExpressions.reserve(nbInsts);
+    mRedundantInsts.reserve(nbInsts);
+    for (const SSABlockPtr& block : func.GetBlocks())
+    {
+        for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+            mDefs.emplace((*instIt)->GetReturnValue().GetID(), instIt->get());
+    }
+
+    // Depth-first walk of the dominator tree. The expressions computed by a block are available
+    // in the blocks it dominates, and are forgotten once all those blocks have been visited.
+    const CFGAnalysis<SSAInstruction>& analysis = func.GetAnalysis();
+    std::vector<std::pair<SSABlock*, size_t>> path;
+    std::vector<size_t> scopeStarts;
+
+    SSABlock* entryBlock = func.GetEntryBlock().get();
+    scopeStarts.push_back(mScopedExpressions.size());
+    VisitBlock(*entryBlock);
+    path.emplace_back(entryBlock, 0);
+    while (!path.empty())
+    {
+        const std::vector<SSABlock*>& domBlocks = analysis.GetDominatedBlocks(path.back().first);
+        const size_t childPos = path.back().second;
+        if (childPos < domBlocks.size())
+        {
+            ++path.back().second;
+            scopeStarts.push_back(mScopedExpressions.size());
+            VisitBlock(*domBlocks[childPos]);
+            path.emplace_back(domBlocks[childPos], 0);
+        }
+        else
+        {
+            for (size_t iExpr = scopeStarts.back(); iExpr < mScopedExpressions.size(); ++iExpr)
+                mExpressions.erase(mExpressions.find(*mScopedExpressions[iExpr]));
+
+            mScopedExpressions.resize(scopeStarts.back());
+            scopeStarts.pop_back();
+            path.pop_back();
+        }
+    }
+
+    if (mRedundantInsts.empty())
+        return 0;
+
+    for (const SSABlockPtr& block : func.GetBlocks())
+        block->RemoveInstructions([this](const SSAInstruction& inst) { return mRedundantInsts.find(&inst) != mRedundantInsts.end(); });
+
+    // The removed instructions are dropped from the users all at once, instead of searching for them every time
+    func.UpdateUsers();
+    return mRedundantInsts.size();
+}
+
+/*
+* \fn           VisitBlock
+* \brief        Numbers the instructions of a block. The instructions computing an expression
+*               available in the block are marked for removal, the others make theirs available.
+* \param block  Block
+*/
+void GlobalValueNumbering::VisitBlock(SSABlock& block)
+{
+    for (auto instIt = block.inst_begin(), instEnd = block.inst_end(); instIt != instEnd; ++instIt)
+    {
+        SSAInstruction& inst = **instIt;
+
+        const std::vector<SSAValue>& operands = inst.GetOperands();
+        const bool isCopy = (inst.GetOperation() == SSAInstruction::Operation::MOV)
+                            && (operands.size() == 1)
+                            && (operands.front().GetKind() != SSAValue::ValueKind::LITERAL);
+        if (isCopy)
+        {
+            ReplaceValue(inst, operands.front());
+            continue;
+        }
+
+        ExpressionKey key;
+        if (!GetExpressionKey(inst, key))
+            continue;
+
+        auto exprIt = mExpressions.emplace(std::move(key), &inst);
+        if (exprIt.second)
+            mScopedExpressions.push_back(&exprIt.first->first);
+        else
+            ReplaceValue(inst, exprIt.first->second->GetReturnValue());
+    }
+}
+
+/*
+* \fn           ReplaceValue
+* \brief        Makes the users of the value of an instruction use another value, and marks the instruction for removal.
+*               The instruction is left among the users of its operands until it is removed.
+* \param inst   Redundant instruction
+* \param newVal Value replacing the one of the instruction
+*/
+void GlobalValueNumbering::ReplaceValue(SSAInstruction& inst, const SSAValue& newVal)
+{
+    const size_t oldID = inst.GetReturnValue().GetID();
+    auto newDefIt = mDefs.find(newVal.GetID());
+    SSAInstruction* newDef = newDefIt == mDefs.end() ? nullptr : newDefIt->second;
+
+    for (SSAInstruction* user : inst.GetUsers())
+    {
+        const std::vector<SSAValue>& userOperands = user->GetOperands();
+        for (size_t iOp = 0; iOp < userOperands.size(); ++iOp)
+        {
+            if ((userOperands[iOp].GetKind() != SSAValue::ValueKind::LITERAL) && (userOperands[iOp].GetID() == oldID))
+                user->SetOperand(iOp, newVal);
+        }
+
+        if (newDef != nullptr)
+            newDef->AddUser(user);
+    }
+
+    inst.ClearUsers();
+    mRedundantInsts.insert(&inst);
+}
+
+/*
+* \fn           GetExpressionKey
+* \brief        Computes what identifies the value of an instruction. The operands of commutative operations
+*               are sorted, and comparisons are turned into greater than comparisons, so that equivalent
+*               instructions get the same key.
+* \param inst   Instruction
+* \param key    Key of the instruction
+* \return       False if the value of the instruction can't be shared with another instruction
+*/
+bool GlobalValueNumbering::GetExpressionKey(const SSAInstruction& inst, ExpressionKey& key)
+{
+    const std::vector<SSAValue>& operands = inst.GetOperands();
+
+    key.mOp = inst.GetOperation();
+    switch (key.mOp)
+    {
+    case SSAInstruction::Operation::ADD:
+    case SSAInstruction::Operation::SUB:
+    case SSAInstruction::Operation::GT:
+    case SSAInstruction::Operation::LT:
+    case SSAInstruction::Operation::AND:
+    case SSAInstruction::Operation::OR:
+    case SSAInstruction::Operation::XOR:
+    case SSAInstruction::Operation::MUL:
+    case SSAInstruction::Operation::DIV:
+    case SSAInstruction::Operation::LSHIFT:
+    case SSAInstruction::Operation::RSHIFT:
+    case SSAInstruction::Operation::MOD:
+    case SSAInstruction::Operation::NOT:
+    case SSAInstruction::Operation::NEG:
+        // A division by zero dominating an identical one stops the program before the second one
+        break;
+    case SSAInstruction::Operation::MOV:
+        // Moves with many operands are assignments
+        if (operands.size() != 1)
+            return false;
+        break;
+    default:
+        // PHIs depend on the path taken to their block, the other instructions have side effects
+        return false;
+    }
+
+    if (operands.size() > key.mOperands.size())
+        return false;
+
+    key.mNbOperands = operands.size();
+    key.mOperands.fill(OperandKey{ false, 0 });
+    for (size_t iOp = 0; iOp < operands.size(); ++iOp)
+    {
+        if (operands[iOp].GetKind() == SSAValue::ValueKind::LITERAL)
+            key.mOperands[iOp] = OperandKey{ true, static_cast<size_t>(static_cast<unsigned int>(operands[iOp].GetLiteralValue())) };
+        else
+            key.mOperands[iOp] = OperandKey{ false, operands[iOp].GetID() };
+    }
+
+    const bool isBinary = key.mNbOperands == 2;
+    switch (key.mOp)
+    {
+    case SSAInstruction::Operation::ADD:
+    case SSAInstruction::Operation::MUL:
+    case SSAInstruction::Operation::AND:
+    case SSAInstruction::Operation::OR:
+    case SSAInstruction::Operation::XOR:
+        if (isBinary && (key.mOperands[1] < key.mOperands[0]))
+            std::swap(key.mOperands[0], key.mOperands[1]);
+        break;
+    case SSAInstruction::Operation::LT:
+        // a < b is b > a
+        if (isBinary)
+        {
+            key.mOp = SSAInstruction::Operation::GT;
+            std::swap(key.mOperands[0], key.mOperands[1]);
+        }
+        break;
+    default:
+        break;
+    }
+
+    return true;
+}
+
+/*
+* \fn           operator()
+* \brief        Hashes an expression key
+* \param key    Key to hash
+* \return       Hash of the key
+*/
+size_t GlobalValueNumbering::ExpressionKeyHash::operator()(const ExpressionKey& key) const
+{
+    size_t hash = static_cast<size_t>(key.mOp) * 4 + key.mNbOperands;
+    for (const OperandKey& operand : key.mOperands)
+    {
+        const size_t operandHash = (operand.mValue << 1) | (operand.mIsLiteral ? 1 : 0);
+        hash ^= operandHash + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    }
+
+    return hash;
+}
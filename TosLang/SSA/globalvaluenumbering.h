@@ -0,0 +1,85 @@
+#ifndef GLOBAL_VALUE_NUMBERING__TOSLANG
+#define GLOBAL_VALUE_NUMBERING__TOSLANG
+
+#include "ssapassmanager.h"
+
+#include <array>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace TosLang
+{
+    namespace BackEnd
+    {
+        /*
+        * \class GlobalValueNumbering
+        * \brief Removes the instructions computing a value already computed by an instruction dominating them.
+        *        Blocks are visited along the dominator tree, keeping the expressions computed by the blocks
+        *        dominating the current one. Two instructions compute the same value when they have the same
+        *        operation and the same operands, operands of commutative operations being taken in any order.
+        *        Copies are removed as well, their users being given the copied value instead.
+        */
+        class GlobalValueNumbering : public SSAPass
+        {
+        public:
+            const char* GetName() const override { return "GlobalValueNumbering"; }
+
+            size_t Run(SSAFunction& func) override;
+
+        private:
+            /*
+            * \struct   OperandKey
+            * \brief    What identifies an operand: the constant for a literal, the ID of the value otherwise
+            */
+            struct OperandKey
+            {
+                bool mIsLiteral;
+                size_t mValue;
+
+                bool operator==(const OperandKey& other) const { return (mIsLiteral == other.mIsLiteral) && (mValue == other.mValue); }
+                bool operator<(const OperandKey& other) const { return mIsLiteral != other.mIsLiteral ? mIsLiteral : mValue < other.mValue; }
+            };
+
+            /*
+            * \struct   ExpressionKey
+            * \brief    What identifies the value computed by an instruction. Instructions with more
+            *           than two operands are never redundant, which keeps the key from allocating memory.
+            */
+            struct ExpressionKey
+            {
+                SSAInstruction::Operation mOp;
+                size_t mNbOperands;
+                std::array<OperandKey, 2> mOperands;    /*!< Operands of the instruction. The unused ones are zeroed. */
+
+                bool operator==(const ExpressionKey& other) const 
+                { 
+                    return (mOp == other.mOp) && (mNbOperands == other.mNbOperands) && (mOperands == other.mOperands); 
+                }
+            };
+
+            /*
+            * \struct   ExpressionKeyHash
+            * \brief    Functor providing a hash for the expression keys
+            */
+            struct ExpressionKeyHash
+            {
+                size_t operator()(const ExpressionKey& key) const;
+            };
+
+        private:
+            void VisitBlock(SSABlock& block);
+            void ReplaceValue(SSAInstruction& inst, const SSAValue& newVal);
+
+            static bool GetExpressionKey(const SSAInstruction& inst, ExpressionKey& key);
+
+        private:
+            std::unordered_map<size_t, SSAInstruction*> mDefs;                                      /*!< Instruction defining every value, by value ID */
+            std::unordered_map<ExpressionKey, SSAInstruction*, ExpressionKeyHash> mExpressions;     /*!< Instruction computing every expression available in the current block */
+            std::vector<const ExpressionKey*> mScopedExpressions;                                   /*!< Expressions added by the blocks on the path to the current block in the dominator tree */
+            std::unordered_set<const SSAInstruction*> mRedundantInsts;                              /*!< Instructions to be removed */
+        };
+    }
+}
+
+#endif // GLOBAL_VALUE_NUMBERING__TOSLANG
@@ -0,0 +1,319 @@
+#include "loopinvariantcodemotion.h"
+
+#include "deadcodeelimination.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace TosLang::BackEnd;
+
+namespace
+{
+    // Loop of a value whose instruction hasn't been visited yet, which can't be moved before it
+    const size_t UNVISITED_LOOP = CFGAnalysis<SSAInstruction>::INVALID_INDEX - 1;
+}
+
+/*
+* \fn           Run
+* \brief        Moves the loop invariant instructions of a function to the preheaders of their loops
+* \param func   Function to transform
+* \return       Number of instructions moved
+*/
+size_t LoopInvariantCodeMotion::Run(SSAFunction& func)
+{
+    if (func.GetBlocks().empty())
+        return 0;
+
+    // The analysis is only updated on the next call to GetAnalysis, so it can be used while preheaders are created
+    const Analysis& analysis = func.GetAnalysis();
+    const std::vector<Loop>& loops = analysis.GetLoops();
+    if (loops.empty())
+        return 0;
+
+    mPreheaders.assign(loops.size(), nullptr);
+    mCanHoist.assign(loops.size(), false);
+    for (size_t iLoop = 0; iLoop < loops.size(); ++iLoop)
+    {
+        mPreheaders[iLoop] = FindPreheader(analysis, loops[iLoop]);
+        mCanHoist[iLoop] = (mPreheaders[iLoop] != nullptr) || CanCreatePreheader(analysis, loops[iLoop]);
+    }
+
+    mNextID = 0;
+    mValueLoops.clear();
+    for (const SSABlockPtr& block : func.GetBlocks())
+    {
+        for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+        {
+            mValueLoops.emplace((*instIt)->GetReturnValue().GetID(), UNVISITED_LOOP);
+            mNextID = std::max(mNextID, (*instIt)->GetReturnValue().GetID() + 1);
+            for (const SSAValue& operand : (*instIt)->GetOperands())
+                mNextID = std::max(mNextID, operand.GetID() + 1);
+        }
+    }
+
+    FindInvariants(analysis);
+
+    size_t nbHoisted = 0;
+    std::unordered_set<const SSAInstruction*> hoistedInsts;
+    for (size_t iLoop = 0; iLoop < loops.size(); ++iLoop)
+    {
+        if (mHoistedInsts[iLoop].empty())
+            continue;
+
+        SSABlock* preheader = mPreheaders[iLoop];
+        if (preheader == nullptr)
+            preheader = CreatePreheader(func, analysis, loops[iLoop]);
+
+        // The instructions go before the branch to the loop, in the order they had in the loop
+        size_t instIdx = 0;
+        for (auto instIt = preheader->inst_begin(), instEnd = preheader->inst_end(); instIt != instEnd; ++instIt, ++instIdx)
+        {
+            if ((*instIt)->GetOperation() == SSAInstruction::Operation::BR)
+                break;
+        }
+
+        for (const SSAInstruction* inst : mHoistedInsts[iLoop])
+        {
+            SSAInstruction hoistedInst{ inst->GetOperation(), inst->GetReturnValue().GetID(), preheader };
+            for (const SSAValue& operand : inst->GetOperands())
+                hoistedInst.AddOperand(operand);
+
+            preheader->InsertInstruction(instIdx++, hoistedInst);
+            hoistedInsts.insert(inst);
+        }
+
+        nbHoisted += mHoistedInsts[iLoop].size();
+    }
+
+    if (nbHoisted == 0)
+        return 0;
+
+    for (const SSABlockPtr& block : func.GetBlocks())
+        block->RemoveInstructions([&hoistedInsts](const SSAInstruction& inst) { return hoistedInsts.find(&inst) != hoistedInsts.end(); });
+
+    func.UpdateUsers();
+    return nbHoisted;
+}
+
+/*
+* \fn               FindInvariants
+* \brief            Finds the outermost loop every instruction can be moved out of. Blocks are visited in reverse post-order,
+*                   so the instructions computing the operands of an instruction are visited before it, except for PHIs.
+* \param analysis   Analysis of the function
+*/
+void LoopInvariantCodeMotion::FindInvariants(const Analysis& analysis)
+{
+    const std::vector<Loop>& loops = analysis.GetLoops();
+    mHoistedInsts.assign(loops.size(), {});
+
+    for (SSABlock* block : analysis.GetRPOBlocks())
+    {
+        const Loop* blockLoop = analysis.GetLoop(block);
+        const size_t blockLoopIdx = blockLoop == nullptr ? Analysis::INVALID_INDEX : static_cast<size_t>(blockLoop - loops.data());
+
+        for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+        {
+            SSAInstruction* inst = instIt->get();
+
+            size_t targetIdx = Analysis::INVALID_INDEX;
+            if (IsHoistable(*inst))
+            {
+                for (size_t loopIdx = blockLoopIdx;
+                     (loopIdx != Analysis::INVALID_INDEX) && mCanHoist[loopIdx] && IsInvariant(*inst, loopIdx, analysis);
+                     loopIdx = loops[loopIdx].mParent)
+                {
+                    targetIdx = loopIdx;
+                }
+            }
+
+            if (targetIdx == Analysis::INVALID_INDEX)
+            {
+                mValueLoops[inst->GetReturnValue().GetID()] = blockLoopIdx;
+            }
+            else
+            {
+                mHoistedInsts[targetIdx].push_back(inst);
+                mValueLoops[inst->GetReturnValue().GetID()] = loops[targetIdx].mParent;
+            }
+        }
+    }
+}
+
+/*
+* \fn               IsInvariant
+* \brief            Indicates if the operands of an instruction are all computed outside of a loop
+* \param inst       Instruction
+* \param loopIdx    Index of the loop
+* \param analysis   Analysis of the function
+* \return           True if the instruction computes the same value on every iteration of the loop
+*/
+bool LoopInvariantCodeMotion::IsInvariant(const SSAInstruction& inst, size_t loopIdx, const Analysis& analysis) const
+{
+    for (const SSAValue& operand : inst.GetOperands())
+    {
+        if (operand.GetKind() == SSAValue::ValueKind::LITERAL)
+            continue;
+
+        // Arguments aren't computed by any instruction
+        auto valueIt = mValueLoops.find(operand.GetID());
+        if (valueIt == mValueLoops.end())
+            continue;
+
+        if ((valueIt->second == UNVISITED_LOOP) || IsNestedIn(valueIt->second, loopIdx, analysis))
+            return false;
+    }
+
+    return true;
+}
+
+/*
+* \fn               CreatePreheader
+* \brief            Creates a block through which all the branches entering a loop go. The PHIs of the loop header get
+*                   a single operand for the preheader, which merges the values coming from outside of the loop if needed.
+* \param func       Function containing the loop
+* \param analysis   Analysis of the function, computed before any preheader was created
+* \param loop       Loop
+* \return           Preheader of the loop
+*/
+SSABlock* LoopInvariantCodeMotion::CreatePreheader(SSAFunction& func, const Analysis& analysis, const Loop& loop)
+{
+    SSABlock* header = loop.mHeader;
+    const BlockList<SSAInstruction> headerPreds = header->GetPredecessors();
+    std::vector<bool> isOutsidePred(headerPreds.size());
+    for (size_t iPred = 0; iPred < headerPreds.size(); ++iPred)
+        isOutsidePred[iPred] = !analysis.IsInLoop(headerPreds[iPred].get(), loop);
+
+    SSABlockPtr preheader = func.CreateNewBlock();
+
+    // The branches keep their place among the successors of the blocks they come from. The predecessors of
+    // the header keep their order as well, the preheader coming last, which gives the new order of the PHI operands.
+    for (size_t iPred = 0; iPred < headerPreds.size(); ++iPred)
+    {
+        if (!isOutsidePred[iPred])
+            continue;
+
+        const BlockList<SSAInstruction>& predSuccs = headerPreds[iPred]->GetSuccessors();
+        auto succIt = std::find_if(predSuccs.begin(), predSuccs.end(), [header](const SSABlockPtr& succ) { return succ.get() == header; });
+        headerPreds[iPred]->ReplaceBranch(std::distance(predSuccs.begin(), succIt), preheader);
+    }
+    preheader->InsertBranch(header->shared_from_this());
+
+    for (auto instIt = header->inst_begin(), instEnd = header->inst_end(); instIt != instEnd; ++instIt)
+    {
+        SSAInstruction& phi = **instIt;
+        if (phi.GetOperation() != SSAInstruction::Operation::PHI)
+            continue;
+
+        SSAInstruction outsidePhi{ SSAInstruction::Operation::PHI, mNextID, preheader.get() };
+        SSAInstruction headerPhi{ SSAInstruction::Operation::PHI, phi.GetReturnValue().GetID(), header };
+        for (size_t iOp = 0; iOp < phi.GetOperands().size(); ++iOp)
+        {
+            if (isOutsidePred[iOp])
+                outsidePhi.AddOperand(phi.GetOperands()[iOp]);
+            else
+                headerPhi.AddOperand(phi.GetOperands()[iOp]);
+        }
+
+        // Only merge the values coming from outside of the loop if they differ
+        const std::vector<SSAValue>& outsideOperands = outsidePhi.GetOperands();
+        if (std::all_of(outsideOperands.begin(), outsideOperands.end(), [&outsideOperands](const SSAValue& val) { return val == outsideOperands.front(); }))
+        {
+            headerPhi.AddOperand(outsideOperands.front());
+        }
+        else
+        {
+            preheader->InsertInstruction(outsidePhi);
+            headerPhi.AddOperand(SSAValue{ mNextID++ });
+        }
+
+        phi = headerPhi;
+    }
+
+    preheader->InsertInstruction(SSAInstruction{ SSAInstruction::Operation::BR, mNextID++, preheader.get() });
+    return preheader.get();
+}
+
+/*
+* \fn               CanCreatePreheader
+* \brief            Indicates if a preheader can be created for a loop. The entry block can't be preceded by another
+*                   block, and the PHIs of the header must have one operand per predecessor to be split between blocks.
+* \param analysis   Analysis of the function
+* \param loop       Loop
+* \return           True if a preheader can be created
+*/
+bool LoopInvariantCodeMotion::CanCreatePreheader(const Analysis& analysis, const Loop& loop)
+{
+    if (analysis.GetRPONumber(loop.mHeader) == 0)
+        return false;
+
+    const size_t nbPreds = loop.mHeader->GetPredecessors().size();
+    for (auto instIt = loop.mHeader->inst_begin(), instEnd = loop.mHeader->inst_end(); instIt != instEnd; ++instIt)
+    {
+        if (((*instIt)->GetOperation() == SSAInstruction::Operation::PHI) && ((*instIt)->GetOperands().size() != nbPreds))
+            return false;
+    }
+
+    return true;
+}
+
+/*
+* \fn               FindPreheader
+* \brief            Finds the block that is the only way into a loop. It must only branch to the loop header.
+* \param analysis   Analysis of the function
+* \param loop       Loop
+* \return           Preheader of the loop. Nullptr if the loop has none.
+*/
+SSABlock* LoopInvariantCodeMotion::FindPreheader(const Analysis& analysis, const Loop& loop)
+{
+    SSABlock* preheader = nullptr;
+    for (const SSABlockPtr& pred : loop.mHeader->GetPredecessors())
+    {
+        if (analysis.IsInLoop(pred.get(), loop))
+            continue;
+
+        if ((preheader != nullptr) && (preheader != pred.get()))
+            return nullptr;
+
+        preheader = pred.get();
+    }
+
+    if (preheader == nullptr)
+        return nullptr;
+
+    const BlockList<SSAInstruction>& succs = preheader->GetSuccessors();
+    const bool onlyEntersLoop = std::all_of(succs.begin(), succs.end(), [&loop](const SSABlockPtr& succ) { return succ.get() == loop.mHeader; });
+    return onlyEntersLoop ? preheader : nullptr;
+}
+
+/*
+* \fn           IsHoistable
+* \brief        Indicates if an instruction can run in a preheader, where it runs even when the loop doesn't.
+*               The rules are the ones of the dead code elimination, so that both passes agree on
+*               which divisions can stop the program (see DeadCodeElimination::CanTrap).
+* \param inst   Instruction
+* \return       True if the instruction can be moved out of a loop
+*/
+bool LoopInvariantCodeMotion::IsHoistable(const SSAInstruction& inst)
+{
+    // PHIs depend on the path taken to their block
+    return (inst.GetOperation() != SSAInstruction::Operation::PHI) && !DeadCodeElimination::HasSideEffects(inst);
+}
+
+/*
+* \fn               IsNestedIn
+* \brief            Indicates if a loop is another one, or is nested in it
+* \param innerIdx   Index of the inner loop. INVALID_INDEX for the code outside of any loop.
+* \param outerIdx   Index of the outer loop
+* \param analysis   Analysis of the function
+* \return           True if the inner loop is part of the outer one
+*/
+bool LoopInvariantCodeMotion::IsNestedIn(size_t innerIdx, size_t outerIdx, const Analysis& analysis)
+{
+    for (size_t loopIdx = innerIdx; loopIdx != Analysis::INVALID_INDEX; loopIdx = analysis.GetLoops()[loopIdx].mParent)
+    {
+        if (loopIdx == outerIdx)
+            return true;
+    }
+
+    return false;
+}
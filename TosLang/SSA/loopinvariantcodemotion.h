@@ -0,0 +1,52 @@
+#ifndef LOOP_INVARIANT_CODE_MOTION__TOSLANG
+#define LOOP_INVARIANT_CODE_MOTION__TOSLANG
+
+#include "ssapassmanager.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace TosLang
+{
+    namespace BackEnd
+    {
+        /*
+        * \class LoopInvariantCodeMotion
+        * \brief Moves the instructions computing the same value on every iteration of a loop to the preheader of the loop,
+        *        a block running once before the loop is entered. Only instructions without side effects that can't stop the
+        *        program are moved, so that running them when the loop is never entered doesn't change the program. An instruction leaves as many loops
+        *        as its operands allow, inner loops first. Loops without a preheader are given one when something can be moved.
+        */
+        class LoopInvariantCodeMotion : public SSAPass
+        {
+        public:
+            const char* GetName() const override { return "LoopInvariantCodeMotion"; }
+
+            size_t Run(SSAFunction& func) override;
+
+        private:
+            using Analysis = CFGAnalysis<SSAInstruction>;
+            using Loop = Analysis::Loop;
+
+        private:
+            void FindInvariants(const Analysis& analysis);
+            bool IsInvariant(const SSAInstruction& inst, size_t loopIdx, const Analysis& analysis) const;
+
+            SSABlock* CreatePreheader(SSAFunction& func, const Analysis& analysis, const Loop& loop);
+
+            static bool CanCreatePreheader(const Analysis& analysis, const Loop& loop);
+            static bool IsHoistable(const SSAInstruction& inst);
+            static SSABlock* FindPreheader(const Analysis& analysis, const Loop& loop);
+            static bool IsNestedIn(size_t innerIdx, size_t outerIdx, const Analysis& analysis);
+
+        private:
+            std::vector<SSABlock*> mPreheaders;                         /*!< Preheader of every loop. Nullptr if it has to be created. */
+            std::vector<bool> mCanHoist;                                /*!< Can instructions be moved out of every loop? */
+            std::vector<std::vector<SSAInstruction*>> mHoistedInsts;    /*!< Instructions moved to the preheader of every loop, in order */
+            std::unordered_map<size_t, size_t> mValueLoops;             /*!< Innermost loop every value is computed in once instructions are moved, by value ID */
+            size_t mNextID;                                             /*!< ID of the next value created by the pass */
+        };
+    }
+}
+
+#endif // LOOP_INVARIANT_CODE_MOTION__TOSLANG
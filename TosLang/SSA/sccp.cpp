@@ -0,0 +1,416 @@
+#include "sccp.h"
+
+#include "constantfolding.h"
+
+#include <algorithm>
+
+using namespace TosLang::BackEnd;
+
+/*
+* \fn           Run
+* \brief        Propagates the constants of a function
+* \param func   Function to transform
+* \return       Number of instructions and operands replaced by constants and of branches removed
+*/
+size_t SCCP::Run(SSAFunction& func)
+{
+    if (func.GetBlocks().empty())
+        return 0;
+
+    Init(func);
+
+    // Only the entry block is known to be reachable at first
+    mBlockWorklist.push_back(0);
+    while (!mBlockWorklist.empty() || !mValueWorklist.empty())
+    {
+        while (!mValueWorklist.empty())
+        {
+            const size_t valID = mValueWorklist.back();
+            mValueWorklist.pop_back();
+
+            for (const InstUse& use : mUses[valID])
+            {
+                if (mExecBlocks[use.mBlockIdx])
+                    VisitInstruction(*use.mInst, use.mBlockIdx);
+            }
+        }
+
+        if (!mBlockWorklist.empty())
+        {
+            const size_t blockIdx = mBlockWorklist.back();
+            mBlockWorklist.pop_back();
+            VisitBlock(blockIdx);
+        }
+    }
+
+    return Rewrite(func);
+}
+
+/*
+* \fn           Init
+* \brief        Indexes the blocks, the values and the uses of a function and marks every value as undefined
+* \param func   Function to be propagated
+*/
+void SCCP::Init(SSAFunction& func)
+{
+    mBlocks.clear();
+    mBlockIndices.clear();
+    mCondBranches.clear();
+    mEdgeOffsets.clear();
+    mCells.clear();
+    mUses.clear();
+    mBlockWorklist.clear();
+    mValueWorklist.clear();
+
+    size_t nbEdges = 0;
+    size_t nbValues = 0;
+    for (const auto& block : func.GetBlocks())
+    {
+        mBlockIndices.emplace(block.get(), mBlocks.size());
+        mBlocks.push_back(block.get());
+        mEdgeOffsets.push_back(nbEdges);
+        nbEdges += block->GetSuccessors().size();
+
+        // A block branches on a condition when its branch has an operand and it has two different successors.
+        // The builder may give a block the same successor more than once.
+        const SSABlock* trueTarget = GetBranchTarget(*block, true);
+        const SSABlock* falseTarget = GetBranchTarget(*block, false);
+        const bool hasTwoTargets = (falseTarget != nullptr)
+                                && std::all_of(block->succ_begin(), block->succ_end(), [trueTarget, falseTarget](const SSABlockPtr& succBlock)
+                                               {
+                                                   return (succBlock.get() == trueTarget) || (succBlock.get() == falseTarget);
+                                               });
+        const SSAInstruction* condBranch = nullptr;
+        for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+        {
+            const SSAInstruction& inst = **instIt;
+            nbValues = std::max(nbValues, inst.GetReturnValue().GetID() + 1);
+            for (const SSAValue& operand : inst.GetOperands())
+                nbValues = std::max(nbValues, operand.GetID() + 1);
+
+            if ((condBranch == nullptr) && (inst.GetOperation() == SSAInstruction::Operation::BR)
+                && !inst.GetOperands().empty() && hasTwoTargets)
+                condBranch = &inst;
+        }
+        mCondBranches.push_back(condBranch);
+    }
+
+    mExecBlocks.assign(mBlocks.size(), false);
+    mExecEdges.assign(nbEdges, false);
+    mUses.resize(nbValues);
+
+    // Values that no instruction defines, such as the arguments, can't be known.
+    // Neither can values defined more than once, which the builder isn't expected to produce.
+    mCells.assign(nbValues, LatticeCell{ LatticeCell::State::OVERDEFINED, 0 });
+    std::vector<bool> isDefined(nbValues, false);
+    for (size_t iBlock = 0; iBlock < mBlocks.size(); ++iBlock)
+    {
+        for (auto instIt = mBlocks[iBlock]->inst_begin(), instEnd = mBlocks[iBlock]->inst_end(); instIt != instEnd; ++instIt)
+        {
+            SSAInstruction* inst = instIt->get();
+            const size_t valID = inst->GetReturnValue().GetID();
+            mCells[valID].mState = isDefined[valID] ? LatticeCell::State::OVERDEFINED : LatticeCell::State::UNDEFINED;
+            isDefined[valID] = true;
+
+            for (const SSAValue& operand : inst->GetOperands())
+            {
+                if (operand.GetKind() != SSAValue::ValueKind::LITERAL)
+                    mUses[operand.GetID()].push_back(InstUse{ inst, iBlock });
+            }
+        }
+    }
+}
+
+/*
+* \fn           VisitBlock
+* \brief        Evaluates the instructions of a block reached by a new branch. The first time
+*               a block is reached, all its instructions are evaluated. Afterwards, only its PHIs are.
+* \param blockIdx   Index of the block
+*/
+void SCCP::VisitBlock(size_t blockIdx)
+{
+    const bool isFirstVisit = !mExecBlocks[blockIdx];
+    mExecBlocks[blockIdx] = true;
+
+    const SSABlock* block = mBlocks[blockIdx];
+    for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+    {
+        const SSAInstruction& inst = **instIt;
+        if (isFirstVisit || (inst.GetOperation() == SSAInstruction::Operation::PHI))
+        {
+            if (inst.GetOperation() != SSAInstruction::Operation::BR)
+                VisitInstruction(inst, blockIdx);
+        }
+    }
+
+    if (isFirstVisit)
+        VisitBranch(blockIdx);
+}
+
+/*
+* \fn           VisitBranch
+* \brief        Marks the branches of a reachable block that can be taken
+* \param blockIdx   Index of the block
+*/
+void SCCP::VisitBranch(size_t blockIdx)
+{
+    const SSAInstruction* condBranch = mCondBranches[blockIdx];
+    if (condBranch == nullptr)
+    {
+        for (size_t iSucc = 0; iSucc < mBlocks[blockIdx]->GetSuccessors().size(); ++iSucc)
+            MarkEdgeExecutable(blockIdx, iSucc);
+        return;
+    }
+
+    const LatticeCell condCell = GetCell(condBranch->GetOperands().front());
+    if (condCell.mState == LatticeCell::State::UNDEFINED)
+        return;
+
+    const SSABlock* target = GetBranchTarget(*mBlocks[blockIdx], condCell.mValue != 0);
+    const BlockList<SSAInstruction>& succs = mBlocks[blockIdx]->GetSuccessors();
+    for (size_t iSucc = 0; iSucc < succs.size(); ++iSucc)
+    {
+        if ((condCell.mState == LatticeCell::State::OVERDEFINED) || (succs[iSucc].get() == target))
+            MarkEdgeExecutable(blockIdx, iSucc);
+    }
+}
+
+/*
+* \fn               GetBranchTarget
+* \brief            Gives the block a conditional branch goes to. The first successor of the block is taken
+*                   when the condition holds, and the first successor different from it otherwise.
+* \param block      Block ending with the branch
+* \param isCondTrue Does the condition hold?
+* \return           Block the branch goes to. Nullptr if the block doesn't have such a successor.
+*/
+const SSABlock* SCCP::GetBranchTarget(const SSABlock& block, bool isCondTrue)
+{
+    const BlockList<SSAInstruction>& succs = block.GetSuccessors();
+    if (succs.empty())
+        return nullptr;
+    if (isCondTrue)
+        return succs.front().get();
+
+    auto succIt = std::find_if(succs.begin(), succs.end(), [&succs](const SSABlockPtr& succBlock) { return succBlock != succs.front(); });
+    return succIt != succs.end() ? succIt->get() : nullptr;
+}
+
+/*
+* \fn           VisitInstruction
+* \brief        Evaluates an instruction of a reachable block, lowering the cell of its value if needed
+* \param inst       Instruction
+* \param blockIdx   Index of the block of the instruction
+*/
+void SCCP::VisitInstruction(const SSAInstruction& inst, size_t blockIdx)
+{
+    if (inst.GetOperation() == SSAInstruction::Operation::BR)
+    {
+        VisitBranch(blockIdx);
+        return;
+    }
+
+    const size_t valID = inst.GetReturnValue().GetID();
+    const LatticeCell oldCell = mCells[valID];
+    const LatticeCell newCell = Meet(oldCell, Evaluate(inst, blockIdx));
+    if ((newCell.mState != oldCell.mState) || (newCell.mValue != oldCell.mValue))
+    {
+        mCells[valID] = newCell;
+        mValueWorklist.push_back(valID);
+    }
+}
+
+/*
+* \fn           Evaluate
+* \brief        Computes what is known about the value of an instruction from what is known about its operands
+* \param inst       Instruction
+* \param blockIdx   Index of the block of the instruction
+* \return       Cell of the value of the instruction
+*/
+SCCP::LatticeCell SCCP::Evaluate(const SSAInstruction& inst, size_t blockIdx) const
+{
+    const LatticeCell overdefined{ LatticeCell::State::OVERDEFINED, 0 };
+    const std::vector<SSAValue>& operands = inst.GetOperands();
+
+    switch (inst.GetOperation())
+    {
+    case SSAInstruction::Operation::MOV:
+        // Moves with many operands are assignments
+        return operands.size() == 1 ? GetCell(operands.front()) : overdefined;
+    case SSAInstruction::Operation::PHI:
+    {
+        // The operands of a PHI come from the predecessors of its block, in order
+        const BlockList<SSAInstruction>& preds = mBlocks[blockIdx]->GetPredecessors();
+        if (operands.size() != preds.size())
+            return overdefined;
+
+        LatticeCell phiCell{ LatticeCell::State::UNDEFINED, 0 };
+        for (size_t iOp = 0; iOp < operands.size(); ++iOp)
+        {
+            if (IsEdgeExecutable(preds[iOp].get(), blockIdx))
+                phiCell = Meet(phiCell, GetCell(operands[iOp]));
+        }
+        return phiCell;
+    }
+    default:
+        break;
+    }
+
+    if (!ConstantFolding::IsFoldable(inst))
+        return overdefined;
+
+    const LatticeCell lhsCell = GetCell(operands[0]);
+    const LatticeCell rhsCell = GetCell(operands[1]);
+    if ((lhsCell.mState == LatticeCell::State::OVERDEFINED) || (rhsCell.mState == LatticeCell::State::OVERDEFINED))
+        return overdefined;
+    if ((lhsCell.mState == LatticeCell::State::UNDEFINED) || (rhsCell.mState == LatticeCell::State::UNDEFINED))
+        return LatticeCell{ LatticeCell::State::UNDEFINED, 0 };
+
+    int result;
+    if (!ConstantFolding::FoldOperation(inst.GetOperation(), lhsCell.mValue, rhsCell.mValue, result))
+        return overdefined;
+
+    return LatticeCell{ LatticeCell::State::CONSTANT, result };
+}
+
+/*
+* \fn           GetCell
+* \brief        Gives what is known about a value
+* \param value  Value
+* \return       Cell of the value
+*/
+SCCP::LatticeCell SCCP::GetCell(const SSAValue& value) const
+{
+    if (value.GetKind() == SSAValue::ValueKind::LITERAL)
+        return LatticeCell{ LatticeCell::State::CONSTANT, value.GetLiteralValue() };
+
+    return mCells[value.GetID()];
+}
+
+/*
+* \fn               IsEdgeExecutable
+* \brief            Indicates if a branch going from a block to another can be taken
+* \param predBlock  Block the branch goes from
+* \param blockIdx   Index of the block the branch goes to
+* \return           True if the branch can be taken
+*/
+bool SCCP::IsEdgeExecutable(const SSABlock* predBlock, size_t blockIdx) const
+{
+    auto predIt = mBlockIndices.find(predBlock);
+    if (predIt == mBlockIndices.end())
+        return false;
+
+    const BlockList<SSAInstruction>& succs = predBlock->GetSuccessors();
+    for (size_t iSucc = 0; iSucc < succs.size(); ++iSucc)
+    {
+        if ((succs[iSucc].get() == mBlocks[blockIdx]) && mExecEdges[mEdgeOffsets[predIt->second] + iSucc])
+            return true;
+    }
+
+    return false;
+}
+
+/*
+* \fn           MarkEdgeExecutable
+* \brief        Records that a branch can be taken. The block it goes to is visited again if it's the first time.
+* \param blockIdx   Index of the block the branch goes from
+* \param succIdx    Index of the branch among the successors of the block
+*/
+void SCCP::MarkEdgeExecutable(size_t blockIdx, size_t succIdx)
+{
+    const size_t edgeIdx = mEdgeOffsets[blockIdx] + succIdx;
+    if (mExecEdges[edgeIdx])
+        return;
+
+    mExecEdges[edgeIdx] = true;
+    mBlockWorklist.push_back(mBlockIndices.at(mBlocks[blockIdx]->GetSuccessors()[succIdx].get()));
+}
+
+/*
+* \fn           Rewrite
+* \brief        Replaces the constant values of the reachable blocks by literals and removes the branches that can't be taken
+* \param func   Function that was propagated
+* \return       Number of changes made to the function
+*/
+size_t SCCP::Rewrite(SSAFunction& func)
+{
+    size_t nbChanges = 0;
+
+    for (size_t iBlock = 0; iBlock < mBlocks.size(); ++iBlock)
+    {
+        if (!mExecBlocks[iBlock])
+            continue;
+
+        SSABlock* block = mBlocks[iBlock];
+        for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+        {
+            SSAInstruction& inst = **instIt;
+            const LatticeCell& valCell = mCells[inst.GetReturnValue().GetID()];
+            if ((valCell.mState == LatticeCell::State::CONSTANT) && !ConstantFolding::IsConstantMove(inst))
+            {
+                ConstantFolding::ReplaceWithConstant(inst, valCell.mValue);
+                ++nbChanges;
+                continue;
+            }
+
+            const bool isAssignment = (inst.GetOperation() == SSAInstruction::Operation::MOV) && (inst.GetOperands().size() != 1);
+            if (isAssignment)
+                continue;
+
+            const std::vector<SSAValue>& operands = inst.GetOperands();
+            for (size_t iOp = 0; iOp < operands.size(); ++iOp)
+            {
+                const LatticeCell opCell = GetCell(operands[iOp]);
+                if ((operands[iOp].GetKind() != SSAValue::ValueKind::LITERAL) && (opCell.mState == LatticeCell::State::CONSTANT))
+                {
+                    inst.SetOperand(iOp, SSAValue{ operands[iOp].GetID(), opCell.mValue });
+                    ++nbChanges;
+                }
+            }
+        }
+
+        // A branch on a constant condition only keeps the successor it goes to
+        const SSAInstruction* condBranch = mCondBranches[iBlock];
+        if (condBranch == nullptr)
+            continue;
+
+        const LatticeCell condCell = GetCell(condBranch->GetOperands().front());
+        if (condCell.mState != LatticeCell::State::CONSTANT)
+            continue;
+
+        const SSABlock* deadTarget = GetBranchTarget(*block, condCell.mValue == 0);
+        size_t iSucc = 0;
+        while (iSucc < block->GetSuccessors().size())
+        {
+            if (block->GetSuccessors()[iSucc].get() == deadTarget)
+            {
+                func.RemoveBranch(block, iSucc);
+                ++nbChanges;
+            }
+            else
+            {
+                ++iSucc;
+            }
+        }
+    }
+
+    return nbChanges;
+}
+
+/*
+* \fn           Meet
+* \brief        Combines what is known about two values that may flow to the same place
+* \param lhsCell    Cell of the first value
+* \param rhsCell    Cell of the second value
+* \return       Combined cell
+*/
+SCCP::LatticeCell SCCP::Meet(const LatticeCell& lhsCell, const LatticeCell& rhsCell)
+{
+    if (lhsCell.mState == LatticeCell::State::UNDEFINED)
+        return rhsCell;
+    if (rhsCell.mState == LatticeCell::State::UNDEFINED)
+        return lhsCell;
+    if ((lhsCell.mState == LatticeCell::State::CONSTANT) && (rhsCell.mState == LatticeCell::State::CONSTANT) && (lhsCell.mValue == rhsCell.mValue))
+        return lhsCell;
+
+    return LatticeCell{ LatticeCell::State::OVERDEFINED, 0 };
+}
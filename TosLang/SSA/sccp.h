@@ -0,0 +1,91 @@
+#ifndef SCCP__TOSLANG
+#define SCCP__TOSLANG
+
+#include "ssapassmanager.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace TosLang
+{
+    namespace BackEnd
+    {
+        /*
+        * \class SCCP
+        * \brief Sparse conditional constant propagation. Values are assumed to be undefined until proven otherwise,
+        *        and blocks are assumed to be unreachable until a branch that can be taken leads to them.
+        *        PHIs only merge the values coming from the branches that can be taken, which finds the
+        *        constants flowing around loops and through branches on constant conditions.
+        *        The algorithm used is the one of: https://dl.acm.org/doi/10.1145/103135.103136
+        *        Constant values are then replaced by literals and the branches that can't be taken are removed.
+        *        Blocks that became unreachable are left in the function.
+        */
+        class SCCP : public SSAPass
+        {
+        public:
+            const char* GetName() const override { return "SCCP"; }
+
+            size_t Run(SSAFunction& func) override;
+
+        private:
+            /*
+            * \struct   LatticeCell
+            * \brief    What is known about a value
+            */
+            struct LatticeCell
+            {
+                enum class State
+                {
+                    UNDEFINED,      // Not computed yet, may still be any constant
+                    CONSTANT,       // Always the same constant
+                    OVERDEFINED,    // Can't be known before running the function
+                };
+
+                State mState;
+                int mValue;     /*!< Constant taken by the value. Only meaningful for a constant cell. */
+            };
+
+            /*
+            * \struct   InstUse
+            * \brief    Instruction using a value, along with the index of its block
+            */
+            struct InstUse
+            {
+                SSAInstruction* mInst;
+                size_t mBlockIdx;
+            };
+
+        private:
+            void Init(SSAFunction& func);
+            size_t Rewrite(SSAFunction& func);
+
+            void VisitBlock(size_t blockIdx);
+            void VisitBranch(size_t blockIdx);
+            void VisitInstruction(const SSAInstruction& inst, size_t blockIdx);
+
+            LatticeCell Evaluate(const SSAInstruction& inst, size_t blockIdx) const;
+            LatticeCell GetCell(const SSAValue& value) const;
+            bool IsEdgeExecutable(const SSABlock* predBlock, size_t blockIdx) const;
+            void MarkEdgeExecutable(size_t blockIdx, size_t succIdx);
+
+            static const SSABlock* GetBranchTarget(const SSABlock& block, bool isCondTrue);
+            static LatticeCell Meet(const LatticeCell& lhsCell, const LatticeCell& rhsCell);
+
+        private:
+            std::vector<SSABlock*> mBlocks;                             /*!< Blocks of the function */
+            std::unordered_map<const SSABlock*, size_t> mBlockIndices;  /*!< Index of every block of the function */
+            std::vector<const SSAInstruction*> mCondBranches;           /*!< Conditional branch ending every block. Nullptr if there is none. */
+            std::vector<size_t> mEdgeOffsets;                           /*!< Index of the first outgoing edge of every block in mExecEdges */
+
+            std::vector<LatticeCell> mCells;                            /*!< What is known about every value, by value ID */
+            std::vector<std::vector<InstUse>> mUses;                    /*!< Instructions using every value, by value ID */
+            std::vector<bool> mExecBlocks;                              /*!< Is a block reachable? */
+            std::vector<bool> mExecEdges;                               /*!< Can a branch be taken? */
+
+            std::vector<size_t> mBlockWorklist;                         /*!< Blocks reached by a new branch */
+            std::vector<size_t> mValueWorklist;                         /*!< Values whose cell changed */
+        };
+    }
+}
+
+#endif // SCCP__TOSLANG
@@ -1,7 +1,72 @@
 #include "ssafunction.h"
 
+#include <unordered_map>
+
+using namespace TosLang::BackEnd;
+
 std::ostream& TosLang::BackEnd::operator<<(std::ostream& stream, const SSAFunction&)
 {
     // TODO
     return stream;
 }
+
+/*
+* \fn           RemoveBranch
+* \brief        Removes a branch of a block of the function. The PHIs of the block it went
+*               to lose the operand they had for it, so that they keep one operand per predecessor.
+* \param block  Block the branch goes from
+* \param succIdx    Index of the branch among the successors of the block
+* \return       Number of PHIs updated
+*/
+size_t SSAFunction::RemoveBranch(BasicBlock<SSAInstruction>* block, size_t succIdx)
+{
+    BasicBlock<SSAInstruction>* succBlock = block->GetSuccessors()[succIdx].get();
+    const size_t predIdx = block->RemoveBranch(succIdx);
+
+    size_t nbPHIs = 0;
+    for (auto instIt = succBlock->inst_begin(), instEnd = succBlock->inst_end(); instIt != instEnd; ++instIt)
+    {
+        SSAInstruction& inst = **instIt;
+        if ((inst.GetOperation() == SSAInstruction::Operation::PHI) && (inst.GetOperands().size() == succBlock->GetPredecessors().size() + 1))
+        {
+            inst.RemoveOperand(predIdx);
+            ++nbPHIs;
+        }
+    }
+
+    return nbPHIs;
+}
+
+/*
+* \fn       UpdateUsers
+* \brief    Rebuilds the users of every instruction of the function from the operands of the instructions.
+*           The users aren't kept up to date when operands change, so passes relying on them call this first.
+*/
+void SSAFunction::UpdateUsers()
+{
+    std::unordered_map<size_t, SSAInstruction*> defs;
+    for (const auto& block : mBlocks)
+    {
+        for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+        {
+            (*instIt)->ClearUsers();
+            defs.emplace((*instIt)->GetReturnValue().GetID(), instIt->get());
+        }
+    }
+
+    for (const auto& block : mBlocks)
+    {
+        for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+        {
+            for (const SSAValue& operand : (*instIt)->GetOperands())
+            {
+                if (operand.GetKind() == SSAValue::ValueKind::LITERAL)
+                    continue;
+
+                auto defIt = defs.find(operand.GetID());
+                if (defIt != defs.end())
+                    defIt->second->AddUser(instIt->get());
+            }
+        }
+    }
+}
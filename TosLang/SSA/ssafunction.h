@@ -37,6 +37,7 @@ namespace TosLang
             * \return       Function argument
             */
             SSAValue& GetArgument(const size_t idx) { assert(idx < mArguments.size()); return mArguments[idx]; }
+            const SSAValue& GetArgument(const size_t idx) const { assert(idx < mArguments.size()); return mArguments[idx]; }
 
             /*
             * \fn           GetNbArguments
@@ -45,6 +46,10 @@ namespace TosLang
             */
             size_t GetNbArguments() const { return mArguments.size(); }
 
+        public:
+            size_t RemoveBranch(BasicBlock<SSAInstruction>* block, size_t succIdx);
+            void UpdateUsers();
+
         private:
             std::vector<SSAValue> mArguments;   /*!< Function's arguments */
         };
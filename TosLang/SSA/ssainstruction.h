@@ -3,6 +3,7 @@
 
 #include "ssavalue.h"
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 
@@ -76,6 +77,21 @@ namespace TosLang
             */
             const std::vector<SSAValue>& GetOperands() const { return mOperands; }
 
+            /*
+            * \fn           SetOperand
+            * \brief        Replaces an operand of the instruction
+            * \param idx    Index of the operand
+            * \param val    New value of the operand
+            */
+            void SetOperand(const size_t idx, const SSAValue& val) { assert(idx < mOperands.size()); mOperands[idx] = val; }
+
+            /*
+            * \fn           RemoveOperand
+            * \brief        Removes an operand of the instruction, shifting the following ones
+            * \param idx    Index of the operand
+            */
+            void RemoveOperand(const size_t idx) { assert(idx < mOperands.size()); mOperands.erase(mOperands.begin() + idx); }
+
             /*
             * TODO
             */
@@ -91,6 +107,24 @@ namespace TosLang
             */
             void AddUser(SSAInstruction* user) { mUsers.push_back(user); }
 
+            /*
+            * \fn           RemoveUser
+            * \brief        Removes one use of the value of the instruction by another instruction
+            * \param user   Instruction no longer using the value
+            */
+            void RemoveUser(const SSAInstruction* user)
+            {
+                auto userIt = std::find(mUsers.begin(), mUsers.end(), user);
+                if (userIt != mUsers.end())
+                    mUsers.erase(userIt);
+            }
+
+            /*
+            * \fn       ClearUsers
+            * \brief    Forgets the users of the value of the instruction
+            */
+            void ClearUsers() { mUsers.clear(); }
+
         private:
             Operation mOp;
             BasicBlock<SSAInstruction>* mBlock;     /*!< Block containing the instruction */
@@ -0,0 +1,91 @@
+#include "ssapassmanager.h"
+
+#include "constantfolding.h"
+#include "deadcodeelimination.h"
+#include "globalvaluenumbering.h"
+#include "loopinvariantcodemotion.h"
+#include "sccp.h"
+#include "unreachableblockelimination.h"
+
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+
+using namespace TosLang::BackEnd;
+
+/*
+* \fn       AddOptimizationPasses
+* \brief    Appends the passes making up the optimization pipeline of the compiler. Constants are folded locally
+*           first, which leaves fewer values for the sparse conditional constant propagation to go through.
+*           Redundant instructions are numbered once the propagation turned the constants into literals,
+*           and the instructions still computing the same value on every iteration of a loop are moved out of it.
+*           The blocks and the instructions left unused are removed last.
+*/
+void SSAPassManager::AddOptimizationPasses()
+{
+    AddPass(std::make_unique<ConstantFolding>());
+    AddPass(std::make_unique<SCCP>());
+    AddPass(std::make_unique<UnreachableBlockElimination>());
+    AddPass(std::make_unique<GlobalValueNumbering>());
+    AddPass(std::make_unique<LoopInvariantCodeMotion>());
+    AddPass(std::make_unique<DeadCodeElimination>());
+}
+
+/*
+* \fn           Run
+* \brief        Runs every pass of the pipeline over every function of a module.
+*               A pass goes through all the functions before the next pass starts.
+* \param module Module to transform
+* \return       Number of changes made to the module
+*/
+size_t SSAPassManager::Run(SSAModule& module)
+{
+    mTimings.clear();
+
+    size_t nbChanges = 0;
+    for (const auto& pass : mPasses)
+    {
+        const auto wallStart = std::chrono::steady_clock::now();
+        const std::clock_t cpuStart = std::clock();
+
+        size_t nbPassChanges = 0;
+        for (auto& funcCFG : module)
+            nbPassChanges += pass->Run(static_cast<SSAFunction&>(*funcCFG.second));
+
+        const std::clock_t cpuEnd = std::clock();
+        const auto wallEnd = std::chrono::steady_clock::now();
+
+        PassTiming timing;
+        timing.mName = pass->GetName();
+        timing.mWallTime = std::chrono::duration<double, std::milli>(wallEnd - wallStart).count();
+        timing.mCPUTime = 1000.0 * static_cast<double>(cpuEnd - cpuStart) / CLOCKS_PER_SEC;
+        timing.mNbChanges = nbPassChanges;
+        mTimings.push_back(std::move(timing));
+
+        nbChanges += nbPassChanges;
+    }
+
+    return nbChanges;
+}
+
+/*
+* \fn           PrintTimings
+* \brief        Prints the measures of the passes of the last run as a table
+* \param stream Output stream
+*/
+void SSAPassManager::PrintTimings(std::ostream& stream) const
+{
+    stream << std::left << std::setw(30) << "Pass"
+           << std::right << std::setw(12) << "Wall (ms)"
+           << std::setw(12) << "CPU (ms)"
+           << std::setw(12) << "Changes" << std::endl;
+
+    for (const PassTiming& timing : mTimings)
+    {
+        stream << std::left << std::setw(30) << timing.mName
+               << std::right << std::fixed << std::setprecision(3)
+               << std::setw(12) << timing.mWallTime
+               << std::setw(12) << timing.mCPUTime
+               << std::setw(12) << timing.mNbChanges << std::endl;
+    }
+}
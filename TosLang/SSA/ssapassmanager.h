@@ -0,0 +1,104 @@
+#ifndef SSA_PASS_MANAGER__TOSLANG
+#define SSA_PASS_MANAGER__TOSLANG
+
+#include "cfgbuilder.h"
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace TosLang
+{
+    namespace BackEnd
+    {
+        /*
+        * \class SSAPass
+        * \brief Transformation of the SSA form of a function. Passes are run one after another
+        *        by a SSAPassManager, over every function of a module.
+        */
+        class SSAPass
+        {
+        public:
+            virtual ~SSAPass() = default;
+
+        public:
+            /*
+            * \fn       GetName
+            * \brief    Gives the name of the pass, as it appears in the timings of the pass manager
+            * \return   Name of the pass
+            */
+            virtual const char* GetName() const = 0;
+
+            /*
+            * \fn           Run
+            * \brief        Transforms a function
+            * \param func   Function to transform
+            * \return       Number of changes made to the function. 0 if it was left as is.
+            */
+            virtual size_t Run(SSAFunction& func) = 0;
+        };
+
+        /*
+        * \class SSAPassManager
+        * \brief Runs a pipeline of passes over the functions of a SSA module, measuring each pass
+        */
+        class SSAPassManager
+        {
+        public:
+            /*
+            * \struct   PassTiming
+            * \brief    Measures of one pass over a whole module
+            */
+            struct PassTiming
+            {
+                std::string mName;      /*!< Name of the pass */
+                double mWallTime;       /*!< Elapsed time, in milliseconds */
+                double mCPUTime;        /*!< Processor time, in milliseconds */
+                size_t mNbChanges;      /*!< Changes made by the pass to the functions of the module */
+            };
+
+        public:
+            SSAPassManager() = default;
+            ~SSAPassManager() = default;
+
+            SSAPassManager(const SSAPassManager&) = delete;
+            SSAPassManager& operator=(const SSAPassManager&) = delete;
+
+        public:
+            /*
+            * \fn           AddPass
+            * \brief        Appends a pass to the pipeline
+            * \param pass   Pass to be added
+            */
+            void AddPass(std::unique_ptr<SSAPass>&& pass) { mPasses.push_back(std::move(pass)); }
+
+            void AddOptimizationPasses();
+
+            /*
+            * \fn       GetNbPasses
+            * \brief    Gives the number of passes in the pipeline
+            * \return   Number of passes
+            */
+            size_t GetNbPasses() const { return mPasses.size(); }
+
+            /*
+            * \fn       GetTimings
+            * \brief    Gives the measures of the passes of the last run, in the order they ran
+            * \return   Measures of the passes
+            */
+            const std::vector<PassTiming>& GetTimings() const { return mTimings; }
+
+        public:
+            size_t Run(SSAModule& module);
+
+            void PrintTimings(std::ostream& stream) const;
+
+        private:
+            std::vector<std::unique_ptr<SSAPass>> mPasses;  /*!< Pipeline of passes, in execution order */
+            std::vector<PassTiming> mTimings;               /*!< Measures of the passes of the last run */
+        };
+    }
+}
+
+#endif // SSA_PASS_MANAGER__TOSLANG
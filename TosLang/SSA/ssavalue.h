@@ -24,11 +24,34 @@ namespace TosLang
             };
 
         public:
-            SSAValue() : mKind{ ValueKind::UNKNOWN }, mID{ 0 }, mLitVal{ 0 } { }
-            SSAValue(size_t id) : mKind{ ValueKind::ARGUMENT }, mID{ id }, mLitVal{ 0 } { }
-            SSAValue(size_t id, int constVal) : mKind{ ValueKind::LITERAL }, mID{ id }, mLitVal{ constVal } { }
+            SSAValue() : mKind{ ValueKind::UNKNOWN }, mID{ 0 }, mLitVal{ 0 }, mDef{ nullptr } { }
+            SSAValue(size_t id) : mKind{ ValueKind::ARGUMENT }, mID{ id }, mLitVal{ 0 }, mDef{ nullptr } { }
+            SSAValue(size_t id, int constVal) : mKind{ ValueKind::LITERAL }, mID{ id }, mLitVal{ constVal }, mDef{ nullptr } { }
+            SSAValue(ValueKind kind, size_t id, int constVal) : mKind{ kind }, mID{ id }, mLitVal{ constVal }, mDef{ nullptr } { }
             virtual ~SSAValue() = default;
 
+        public:
+            /*
+            * \fn       GetKind
+            * \brief    Gives the kind of the value
+            * \return   Kind of the value
+            */
+            ValueKind GetKind() const { return mKind; }
+
+            /*
+            * \fn       GetID
+            * \brief    Gives the number of the value in its function
+            * \return   ID of the value
+            */
+            size_t GetID() const { return mID; }
+
+            /*
+            * \fn       GetLiteralValue
+            * \brief    Gives the constant held by a literal value
+            * \return   Literal value
+            */
+            int GetLiteralValue() const { return mLitVal; }
+
         public:
             friend std::ostream& operator<<(std::ostream& stream, const SSAValue& ssaVal);
             friend bool operator==(const SSAValue& lhsVal, const SSAValue& rhsVal);
@@ -0,0 +1,52 @@
+#include "unreachableblockelimination.h"
+
+using namespace TosLang::BackEnd;
+
+/*
+* \fn           Run
+* \brief        Removes the unreachable blocks of a function
+* \param func   Function to transform
+* \return       Number of blocks removed
+*/
+size_t UnreachableBlockElimination::Run(SSAFunction& func)
+{
+    const BlockList<SSAInstruction>& blocks = func.GetBlocks();
+    if (blocks.empty())
+        return 0;
+
+    mReachableBlocks.clear();
+    mReachableBlocks.insert(blocks.front().get());
+    mBlockStack.assign(1, blocks.front().get());
+    while (!mBlockStack.empty())
+    {
+        const SSABlock* block = mBlockStack.back();
+        mBlockStack.pop_back();
+
+        for (const SSABlockPtr& succBlock : block->GetSuccessors())
+        {
+            if (mReachableBlocks.insert(succBlock.get()).second)
+                mBlockStack.push_back(succBlock.get());
+        }
+    }
+
+    if (mReachableBlocks.size() == blocks.size())
+        return 0;
+
+    // Branches between unreachable blocks go away with the blocks, but the reachable blocks have to forget them first
+    for (const SSABlockPtr& block : blocks)
+    {
+        if (mReachableBlocks.find(block.get()) != mReachableBlocks.end())
+            continue;
+
+        size_t iSucc = 0;
+        while (iSucc < block->GetSuccessors().size())
+        {
+            if (mReachableBlocks.find(block->GetSuccessors()[iSucc].get()) != mReachableBlocks.end())
+                func.RemoveBranch(block.get(), iSucc);
+            else
+                ++iSucc;
+        }
+    }
+
+    return func.RemoveBlocks([this](const SSABlock& block) { return mReachableBlocks.find(&block) == mReachableBlocks.end(); });
+}
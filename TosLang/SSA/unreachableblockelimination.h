@@ -0,0 +1,33 @@
+#ifndef UNREACHABLE_BLOCK_ELIMINATION__TOSLANG
+#define UNREACHABLE_BLOCK_ELIMINATION__TOSLANG
+
+#include "ssapassmanager.h"
+
+#include <unordered_set>
+#include <vector>
+
+namespace TosLang
+{
+    namespace BackEnd
+    {
+        /*
+        * \class UnreachableBlockElimination
+        * \brief Removes the blocks that no path from the entry block leads to, such as the bodies of
+        *        the if statements whose condition SCCP found to be always false. The branches going
+        *        from them to the remaining blocks are removed along with the operands PHIs had for them.
+        */
+        class UnreachableBlockElimination : public SSAPass
+        {
+        public:
+            const char* GetName() const override { return "UnreachableBlockElimination"; }
+
+            size_t Run(SSAFunction& func) override;
+
+        private:
+            std::unordered_set<const SSABlock*> mReachableBlocks;   /*!< Blocks a path from the entry block leads to */
+            std::vector<SSABlock*> mBlockStack;                     /*!< Blocks whose successors are left to be explored */
+        };
+    }
+}
+
+#endif // UNREACHABLE_BLOCK_ELIMINATION__TOSLANG
@@ -1,6 +1,7 @@
 #ifndef SYMBOL_H__TOSLANG
 #define SYMBOL_H__TOSLANG
 
+#include "../Common/internedstring.h"
 #include "../Common/type.h"
 
 #include <cassert>
@@ -32,7 +33,7 @@ namespace TosLang
             * \param name       Name of the variable
             * \param size       Size of the variable
             */
-            Symbol(Common::Type t, size_t scopeID, const std::string& name, int size) 
+            Symbol(Common::Type t, size_t scopeID, Common::InternedString name, int size) 
                 : mType{ t }, mScopeID{ scopeID }, mIsFunction{ false }, mName{ name }, mSize{ size } { }
 
             /*
@@ -41,7 +42,7 @@ namespace TosLang
             * \param t          Types of the function. The first one is the return type and all the others are the parameters' types
             * \param name       Name of the function
             */
-            Symbol(std::vector<Common::Type> ts, const std::string& name) 
+            Symbol(std::vector<Common::Type> ts, Common::InternedString name) 
                 : mType{ ts }, mScopeID{ 0 }, mIsFunction{ true }, mName{ name }, mSize{ 0 } { }
 
             /*
@@ -120,7 +121,14 @@ namespace TosLang
             * \brief    Gets the name of the symbol
             * \return   Name of the symbol
             */
-            const std::string& GetName() const { assert(mType.front() != Common::Type::ERROR); return mName; }
+            const std::string& GetName() const { assert(mType.front() != Common::Type::ERROR); return mName.GetStr(); }
+
+            /*
+            * \fn       GetNameID
+            * \brief    Gets the name of the symbol as it is stored in the string pool
+            * \return   Interned name of the symbol
+            */
+            Common::InternedString GetNameID() const { assert(mType.front() != Common::Type::ERROR); return mName; }
 
             /*
             * \fn       GetSize
@@ -145,7 +153,7 @@ namespace TosLang
                                                      For function, the first type is the return type and the others are its parameters types */
             size_t mScopeID;                    /*!< Scope in which the symbol was declared */
             bool mIsFunction;                   /*!< Is the symbol representing a function */
-            std::string mName;                  /*!< Name of the symbol in the source code */
+            Common::InternedString mName;       /*!< Name of the symbol in the source code */
             int mSize;                          /*!< Size of the variable referred to by the symbol.
                                                      A size of 0 means that the variable is a scalar. */
         };
@@ -12,43 +12,9 @@ using namespace TosLang::Common;
 using namespace TosLang::Utils;
 
 SymbolCollector::SymbolCollector(const std::shared_ptr<SymbolTable>& symTab) 
-    : mCurrentScopeID{ 0 }, mErrorCount{ 0 }, mCurrentFunc{ nullptr }, mSymbolTable{ symTab }
+    : mCurrentScopeID{ SymbolTable::GLOBAL_SCOPE_ID }, mFunctionScopeID{ SymbolTable::GLOBAL_SCOPE_ID }, 
+      mErrorCount{ 0 }, mCurrentFunc{ nullptr }, mSymbolTable{ symTab }
 {
-    mCurrentScopesPath.push_front(mCurrentScopeID);
-
-    // TODO: This probably needs some refactoring since the same code is also present in the type checker
-    this->mPrologueFtr = [this]()
-    { 
-        if (mCurrentNode != nullptr)
-        {
-            if (mCurrentNode->GetKind() == ASTNode::NodeKind::COMPOUND_STMT)
-            {
-                ++mCurrentScopeID;
-                mCurrentScopesPath.push_front(mCurrentScopeID);
-            }
-            else if (mCurrentNode->GetKind() == ASTNode::NodeKind::FUNCTION_DECL)
-            {
-                mCurrentFunc = static_cast<const FunctionDecl*>(mCurrentNode);
-                assert(mCurrentFunc != nullptr);
-            }
-        }
-    };
-
-    this->mEpilogueFtr = [this]()
-    {
-        if (mCurrentNode != nullptr)
-        {
-            if (mCurrentNode->GetKind() == ASTNode::NodeKind::COMPOUND_STMT)
-            {
-                mCurrentScopesPath.pop_front();
-            }
-            else if (mCurrentNode->GetKind() == ASTNode::NodeKind::FUNCTION_DECL)
-            {
-                assert(mCurrentFunc != nullptr);
-                mCurrentFunc = nullptr;
-            }
-        }
-    };
 }
 
 /*
@@ -61,7 +27,7 @@ size_t SymbolCollector::Run(const std::unique_ptr<ASTNode>& root)
 {
     mErrorCount = 0;
     mSymbolTable->Clear();
-    mCurrentScopeID = 0;
+    mCurrentScopeID = SymbolTable::GLOBAL_SCOPE_ID;
 
     this->VisitPreOrder(root);
 
@@ -70,6 +36,46 @@ size_t SymbolCollector::Run(const std::unique_ptr<ASTNode>& root)
     return mErrorCount;
 }
 
+/*
+* \fn       NodePrologue
+* \brief    Opens the scope of a function or of a compound statement.
+*           The scope tree built here is kept in the symbol table for the passes that come after.
+*/
+void SymbolCollector::NodePrologue()
+{
+    if (mCurrentNode->GetKind() == ASTNode::NodeKind::COMPOUND_STMT)
+    {
+        // The body of a function shares the scope of the function parameters
+        if ((mCurrentFunc != nullptr) && (mCurrentNode == mCurrentFunc->GetBody()))
+            mCurrentScopeID = mFunctionScopeID;
+        else
+            mCurrentScopeID = mSymbolTable->AddScope(mCurrentScopeID);
+    }
+    else if (mCurrentNode->GetKind() == ASTNode::NodeKind::FUNCTION_DECL)
+    {
+        mCurrentFunc = static_cast<const FunctionDecl*>(mCurrentNode);
+        assert(mCurrentFunc != nullptr);
+        mFunctionScopeID = mSymbolTable->AddScope(mCurrentScopeID);
+    }
+}
+
+/*
+* \fn       NodeEpilogue
+* \brief    Closes the scope of a function or of a compound statement
+*/
+void SymbolCollector::NodeEpilogue()
+{
+    if (mCurrentNode->GetKind() == ASTNode::NodeKind::COMPOUND_STMT)
+    {
+        mCurrentScopeID = mSymbolTable->GetParentScope(mCurrentScopeID);
+    }
+    else if (mCurrentNode->GetKind() == ASTNode::NodeKind::FUNCTION_DECL)
+    {
+        assert(mCurrentFunc != nullptr);
+        mCurrentFunc = nullptr;
+    }
+}
+
 /*
 * \fn       HandleFunctionDecl
 * \brief    Collects symbols related to a function
@@ -101,7 +107,7 @@ void SymbolCollector::HandleFunctionDecl()
     }
 
     // Add the function symbol to the table
-    if (!mSymbolTable->AddSymbol(fnDecl, { fnType, fnDecl->GetName() }))
+    if (!mSymbolTable->AddSymbol(fnDecl, { fnType, fnDecl->GetNameID() }))
     {
         // Couldn't insert the function in the symbol table because it's trying to redefine another function
         ErrorLogger::PrintErrorAtLocation(ErrorLogger::ErrorType::FN_REDEFINITION, fnDecl->GetSourceLocation());
@@ -127,7 +133,7 @@ void SymbolCollector::HandleParamVarDecl()
         paramTypes.push_back(paramVar->GetVarType());
 
         // Add the parameter to the symbols defined in the scope of the current function
-        if (!mSymbolTable->AddSymbol(param.get(), { paramVar->GetVarType(), mCurrentScopeID + 1, paramVar->GetName(), paramVar->GetVarSize() }))
+        if (!mSymbolTable->AddSymbol(param.get(), { paramVar->GetVarType(), mFunctionScopeID, paramVar->GetNameID(), paramVar->GetVarSize() }))
         {
             // Couldn't insert the param in the symbol table because it's trying to redefine another param
             ErrorLogger::PrintErrorAtLocation(ErrorLogger::ErrorType::PARAM_REDEFINITION, paramVar->GetSourceLocation());
@@ -153,7 +159,7 @@ void SymbolCollector::HandleVarDecl()
     if (varDecl->IsFunctionParameter())
         return;
 
-    bool isNotAlreadyDefined  = mSymbolTable->AddSymbol(varDecl, { varDecl->GetVarType(), mCurrentScopeID, varDecl->GetName(), varDecl->GetVarSize() });
+    bool isNotAlreadyDefined  = mSymbolTable->AddSymbol(varDecl, { varDecl->GetVarType(), mCurrentScopeID, varDecl->GetNameID(), varDecl->GetVarSize() });
 
     if (!isNotAlreadyDefined)
     {
@@ -171,7 +177,7 @@ void SymbolCollector::HandleCallExpr()
     const CallExpr* cExpr = static_cast<const CallExpr*>(this->mCurrentNode);
     assert(cExpr != nullptr);
 
-    if (!mSymbolTable->IsFunctionNameValid(cExpr->GetCalleeName()))
+    if (!mSymbolTable->IsFunctionNameValid(cExpr->GetNameID()))
     {
         ErrorLogger::PrintErrorAtLocation(ErrorLogger::ErrorType::FN_UNDECLARED, cExpr->GetSourceLocation());
         ++mErrorCount;
@@ -187,7 +193,7 @@ void SymbolCollector::HandleIdentifierExpr()
     const IdentifierExpr* iExpr = static_cast<const IdentifierExpr*>(this->mCurrentNode);
     assert(iExpr != nullptr);
 
-    if (!mSymbolTable->AddVariableUse(iExpr, mCurrentScopesPath))
+    if (!mSymbolTable->AddVariableUse(iExpr, mCurrentScopeID))
     {
         ErrorLogger::PrintErrorAtLocation(ErrorLogger::ErrorType::VAR_UNDECLARED_IDENTIFIER, iExpr->GetSourceLocation());
         ++mErrorCount;
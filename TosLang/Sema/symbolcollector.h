@@ -4,8 +4,6 @@
 #include "../Common/astvisitor.h"
 #include "symboltable.h"
 
-#include <deque>
-
 namespace TosLang
 {
     namespace FrontEnd
@@ -26,6 +24,10 @@ namespace TosLang
         public:
             size_t Run(const std::unique_ptr<ASTNode>& root);
 
+        protected:  // Traversal hooks
+            void NodePrologue();
+            void NodeEpilogue();
+
         protected:  // Declarations
             void HandleFunctionDecl();
             void HandleParamVarDecl();
@@ -40,10 +42,10 @@ namespace TosLang
 
         private:
             size_t mCurrentScopeID;                     /*!< Current scope identifier */
+            size_t mFunctionScopeID;                    /*!< Scope of the parameters and of the body of the current function */
             size_t mErrorCount;                         /*!< Number of errors found by the symbol collector */
             const FunctionDecl* mCurrentFunc;           /*!< Current traversed function */
             std::shared_ptr<SymbolTable> mSymbolTable;  /*!< Symbol table to be filled by the symbol collector */
-            std::deque<size_t> mCurrentScopesPath;      /*<! Path from the current scope to the global scope */
         };
     }
 }
@@ -9,6 +9,31 @@
 using namespace TosLang::FrontEnd;
 using namespace TosLang::Common;
 
+/*
+* \fn               AddScope
+* \brief            Adds a scope to the scope tree
+* \param parentScopeID  ID of the scope enclosing the new scope
+* \return           ID of the new scope
+*/
+size_t SymbolTable::AddScope(size_t parentScopeID)
+{
+    assert(parentScopeID < mScopes.size());
+    mScopes.push_back({ parentScopeID, {} });
+    return mScopes.size() - 1;
+}
+
+/*
+* \fn       Clear
+* \brief    Clears all the internal structures maintained by the symbol table, leaving only the global scope
+*/
+void SymbolTable::Clear()
+{
+    mTable.clear();
+    mUseDefs.clear();
+    mFunctions.clear();
+    mScopes.assign(1, { GLOBAL_SCOPE_ID, {} });
+}
+
 /*
 * \fn           AddSymbol
 * \brief        Add a symbol to the symbol table
@@ -21,72 +46,79 @@ bool SymbolTable::AddSymbol(const ASTNode* node, Symbol&& sym)
     if (node == nullptr)
         return false;
 
-    const ASTNode::NodeKind kind = node->GetKind();
-
-    assert(kind == ASTNode::NodeKind::FUNCTION_DECL
-           || kind == ASTNode::NodeKind::VAR_DECL);
-
-    auto symIt = std::find_if(mTable.begin(), mTable.end(), 
-                              [&sym](const std::pair<const ASTNode*, Symbol>& nodeSym)
-                              {
-                                  const Symbol& symbol = nodeSym.second;
-
-                                  if (symbol.IsFunction() && sym.IsFunction())
-                                  {
-                                      // Check for every aspects of a function
-                                      const std::vector<Common::Type>& candidateParamTypes = symbol.GetFunctionParamTypes();
-                                      const std::vector<Common::Type>& expectedParamTypes = sym.GetFunctionParamTypes();
-
-                                      return candidateParamTypes.size() == expectedParamTypes.size()
-                                          && candidateParamTypes == expectedParamTypes
-                                          && symbol.GetFunctionReturnType() == sym.GetFunctionReturnType()
-                                          && symbol.GetName() == sym.GetName();
-                                  }
-                                  else if (!symbol.IsFunction() && !sym.IsFunction())
-                                  {
-                                      // Check only for the scope and the name to disallow declaring 
-                                      // the same variable with another type
-                                      return symbol.GetScopeID() == sym.GetScopeID()
-                                          && symbol.GetName() == sym.GetName();
-                                  }
-                                  else
-                                  {
-                                      return false;
-                                  }
-                              });
-
-    // Symbol was already defined
-    if (symIt != mTable.end())
+    assert(node->GetKind() == ASTNode::NodeKind::FUNCTION_DECL
+           || node->GetKind() == ASTNode::NodeKind::VAR_DECL);
+
+    // A declaration defines a single symbol
+    if (mTable.find(node) != mTable.end())
         return false;
 
-    mTable[node] = sym;
+    if (sym.IsFunction())
+    {
+        // Check for every aspects of a function among the functions sharing its name
+        std::vector<const ASTNode*>& overloadSet = mFunctions[sym.GetNameID()];
+        auto fnIt = std::find_if(overloadSet.begin(), overloadSet.end(),
+                                 [this, &sym](const ASTNode* fnDecl)
+                                 {
+                                     const Symbol& symbol = mTable.at(fnDecl);
+                                     return symbol.GetFunctionParamTypes() == sym.GetFunctionParamTypes()
+                                         && symbol.GetFunctionReturnType() == sym.GetFunctionReturnType();
+                                 });
+
+        // Symbol was already defined
+        if (fnIt != overloadSet.end())
+            return false;
+
+        overloadSet.push_back(node);
+    }
+    else
+    {
+        // Check only for the scope and the name to disallow declaring 
+        // the same variable with another type
+        assert(sym.GetScopeID() < mScopes.size());
+        if (!mScopes[sym.GetScopeID()].mVariables.emplace(sym.GetNameID(), node).second)
+            return false;
+    }
+
+    mTable.emplace(node, std::move(sym));
 
     return true;
 }
 
 /*
 * \fn               AddVariableUse
-* \brief            Add a usage for a variable
+* \brief            Add a usage for a variable, declared in the scope of the identifier or in an enclosing scope
 * \param cExpr      Identifier expression
-* \param scopePath  Path from the identifier's scope to the global scope
+* \param scopeID    Scope of the identifier
 * \return           True if the use could be added, else false
 */
-bool SymbolTable::AddVariableUse(const IdentifierExpr* iExpr, const std::deque<size_t>& scopePath)
+bool SymbolTable::AddVariableUse(const IdentifierExpr* iExpr, size_t scopeID)
 {
-    for (const auto& scopeID : scopePath)
+    assert(scopeID < mScopes.size());
+
+    // Walk up the scope chain, the innermost declaration wins
+    while (true)
     {
-        auto varIt = std::find_if(mTable.begin(), mTable.end(), 
-                     [&scopeID, &iExpr](const std::pair<const ASTNode*, Symbol>& nodeSym) 
-                     {
-                         return nodeSym.second.GetScopeID() == scopeID
-                             && nodeSym.second.GetName() == iExpr->GetName();
-                     });
-
-        if (varIt != mTable.end())
+        const Scope& scope = mScopes[scopeID];
+        auto varIt = scope.mVariables.find(iExpr->GetNameID());
+        if (varIt != scope.mVariables.end())
         {
-            mUseDefs[iExpr] = varIt->first;
+            mUseDefs[iExpr] = varIt->second;
             return true;
         }
+
+        if (scopeID == GLOBAL_SCOPE_ID)
+            break;
+
+        scopeID = scope.mParentID;
+    }
+
+    // Functions are declared in the global scope, so a global name can also refer to a function
+    auto fnIt = mFunctions.find(iExpr->GetNameID());
+    if ((fnIt != mFunctions.end()) && !fnIt->second.empty())
+    {
+        mUseDefs[iExpr] = fnIt->second.front();
+        return true;
     }
 
     return false;
@@ -101,15 +133,10 @@ bool SymbolTable::AddVariableUse(const IdentifierExpr* iExpr, const std::deque<s
 */
 bool SymbolTable::AddFunctionUse(const CallExpr* cExpr, const Symbol& fnSym)
 {
-    auto fnIt = std::find_if(mTable.begin(), mTable.end(),
-                            [&fnSym, &cExpr](const std::pair<const ASTNode*, Symbol>& nodeSym)
-                            {
-                                return nodeSym.second == fnSym;
-                            });
-
-    if (fnIt != mTable.end())
+    const ASTNode* fnDecl = FindFunctionDecl(fnSym);
+    if (fnDecl != nullptr)
     {
-        mUseDefs[cExpr] = fnIt->first;
+        mUseDefs[cExpr] = fnDecl;
         return true;
     }
 
@@ -164,17 +191,15 @@ std::pair<bool, const Symbol*> SymbolTable::TryGetSymbol(const ASTNode* node) co
 * \param fnName     Name of the function called
 * \return           Overload set for the function call
 */
-std::vector<const Symbol*> SymbolTable::GetOverloadCandidates(const std::string& fnName) const
+std::vector<const Symbol*> SymbolTable::GetOverloadCandidates(Common::InternedString fnName) const
 {
     std::vector<const Symbol*> overloadCandidates;
 
-    for (const auto& nodeSym : mTable)
+    auto fnIt = mFunctions.find(fnName);
+    if (fnIt != mFunctions.end())
     {
-        if ((nodeSym.first->GetKind() == ASTNode::NodeKind::FUNCTION_DECL)
-            && (nodeSym.second.GetName() == fnName))
-        {
-            overloadCandidates.push_back(&nodeSym.second);
-        }
+        for (const ASTNode* fnDecl : fnIt->second)
+            overloadCandidates.push_back(&mTable.at(fnDecl));
     }
 
     return overloadCandidates;
@@ -188,16 +213,7 @@ std::vector<const Symbol*> SymbolTable::GetOverloadCandidates(const std::string&
 */
 const ASTNode* SymbolTable::GetFunctionDecl(const Symbol& fnSym) const
 {
-    auto fnIt = std::find_if(mTable.begin(), mTable.end(),
-                             [&fnSym](const std::pair<const ASTNode*, Symbol>& nodeSym)
-                             {
-                                 return nodeSym.second == fnSym;
-                             });
-
-    if (fnIt != mTable.end())
-        return fnIt->first;
-    else
-        return nullptr;
+    return FindFunctionDecl(fnSym);
 }
 
 /*
@@ -225,39 +241,26 @@ const ASTNode* SymbolTable::GetVarDecl(const ASTNode* identExpr) const
 }
 
 /*
-* \fn           IsFunctionNameValid
-* \brief        Checks if a function with the given name is present in the symbol table
-* \param sym    Function name
-* \return       True if the function was found.
+* \fn           IsFunctionSymbolValid
+* \brief        Checks if the symbol is present in the symbol table
+* \param sym    Function symbol to verify
+* \return       True if the symbol was found.
 */
 bool SymbolTable::IsFunctionSymbolValid(const Symbol& fnSym) const
 {
-    auto fnIt = std::find_if(mTable.begin(), mTable.end(), 
-                             [&fnSym](const std::pair<const ASTNode*, Symbol> nodeSym)
-                             {
-                                 return nodeSym.first->GetKind() == ASTNode::NodeKind::FUNCTION_DECL
-                                     && nodeSym.second == fnSym;
-                             });
-
-    return fnIt != mTable.end();
+    return FindFunctionDecl(fnSym) != nullptr;
 }
 
 /*
-* \fn           IsFunctionSymbolValid
-* \brief        Checks if the symbol is present in the symbol table
-* \param sym    Function symbol to verify
-* \return       True if the symbol was found.
+* \fn           IsFunctionNameValid
+* \brief        Checks if a function with the given name is present in the symbol table
+* \param sym    Function name
+* \return       True if the function was found.
 */
-bool SymbolTable::IsFunctionNameValid(const std::string& fnName) const
+bool SymbolTable::IsFunctionNameValid(Common::InternedString fnName) const
 {
-    auto fnIt = std::find_if(mTable.begin(), mTable.end(),
-                             [&fnName](const std::pair<const ASTNode*, Symbol> nodeSym)
-                             {
-                                 return nodeSym.first->GetKind() == ASTNode::NodeKind::FUNCTION_DECL
-                                     && nodeSym.second.GetName() == fnName;
-                             });
-
-    return fnIt != mTable.end();
+    auto fnIt = mFunctions.find(fnName);
+    return (fnIt != mFunctions.end()) && !fnIt->second.empty();
 }
 
 /*
@@ -268,14 +271,12 @@ bool SymbolTable::IsFunctionNameValid(const std::string& fnName) const
 */
 bool SymbolTable::IsVariableSymbolValid(const Symbol & varSym) const
 {
-    auto fnIt = std::find_if(mTable.begin(), mTable.end(),
-                             [&varSym](const std::pair<const ASTNode*, Symbol> nodeSym)
-                             {
-                                 return nodeSym.first->GetKind() == ASTNode::NodeKind::VAR_DECL
-                                     && nodeSym.second == varSym;
-                             });
-
-    return fnIt != mTable.end();
+    if (varSym.IsFunction() || (varSym.GetScopeID() >= mScopes.size()))
+        return false;
+
+    const Scope& scope = mScopes[varSym.GetScopeID()];
+    auto varIt = scope.mVariables.find(varSym.GetNameID());
+    return (varIt != scope.mVariables.end()) && (mTable.at(varIt->second) == varSym);
 }
 
 /*
@@ -307,3 +308,26 @@ bool SymbolTable::IsGlobalVariable(const ASTNode* node) const
     return symIt->second.GetScopeID() == 0;
 }
 
+/*
+* \fn           FindFunctionDecl
+* \brief        Finds the function declaration producing the given symbol, among the functions sharing its name
+* \param fnSym  Symbol of the desired function
+* \return       Pointer to the function declaration node. Nullptr if no matching declaration is found
+*/
+const ASTNode* SymbolTable::FindFunctionDecl(const Symbol& fnSym) const
+{
+    if (!fnSym.IsFunction())
+        return nullptr;
+
+    auto fnIt = mFunctions.find(fnSym.GetNameID());
+    if (fnIt == mFunctions.end())
+        return nullptr;
+
+    auto declIt = std::find_if(fnIt->second.begin(), fnIt->second.end(),
+                               [this, &fnSym](const ASTNode* fnDecl)
+                               {
+                                   return mTable.at(fnDecl) == fnSym;
+                               });
+
+    return declIt != fnIt->second.end() ? *declIt : nullptr;
+}
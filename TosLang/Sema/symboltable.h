@@ -3,8 +3,8 @@
 
 #include "symbol.h"
 
-#include <deque>
 #include <unordered_map>
+#include <vector>
 
 namespace TosLang
 {
@@ -20,37 +20,79 @@ namespace TosLang
         * \brief Manages the symbols produced by the compiler. 
         *        Concretly, this is where the symbols produced by the symbol collection pass are put. 
         *        They are then later queried by the type checker and the instruction selector.
+        *        Variables are organized in a tree of scopes rooted at the global scope.
         */
         class SymbolTable
         {
         public:
-            bool AddSymbol(const ASTNode* node, Symbol&& sym);
-            bool AddVariableUse(const IdentifierExpr* iExpr, const std::deque<size_t>& scopePath);
-            bool AddFunctionUse(const CallExpr* cExpr, const Symbol& fnSym);
+            SymbolTable() { Clear(); }
+
+        public:
+            static constexpr size_t GLOBAL_SCOPE_ID = 0;
+
+            size_t AddScope(size_t parentScopeID);
+
+            /*
+            * \fn               GetParentScope
+            * \brief            Gets the scope enclosing a scope
+            * \param scopeID    ID of the scope
+            * \return           ID of the enclosing scope. The global scope is its own parent.
+            */
+            size_t GetParentScope(size_t scopeID) const { assert(scopeID < mScopes.size()); return mScopes[scopeID].mParentID; }
+
+            /*
+            * \fn       GetNbScopes
+            * \brief    Gets the number of scopes of the scope tree
+            * \return   Number of scopes, including the global scope
+            */
+            size_t GetNbScopes() const { return mScopes.size(); }
 
             /*
-            * \fn       Clear
-            * \brief    Clears all the internal structures maintained by the symbol table
+            * \fn       GetNbSymbols
+            * \brief    Gets the number of symbols (functions, variables and parameters) defined in the program
+            * \return   Number of symbols
             */
-            void Clear() { mTable.clear(); }
+            size_t GetNbSymbols() const { return mTable.size(); }
+
+            bool AddSymbol(const ASTNode* node, Symbol&& sym);
+            bool AddVariableUse(const IdentifierExpr* iExpr, size_t scopeID);
+            bool AddFunctionUse(const CallExpr* cExpr, const Symbol& fnSym);
+
+            void Clear();
 
             std::pair<bool, const Symbol*> TryGetSymbol(const ASTNode* node) const;
-            std::vector<const Symbol*> GetOverloadCandidates(const std::string& fnName) const;
+            std::vector<const Symbol*> GetOverloadCandidates(Common::InternedString fnName) const;
             const ASTNode* GetFunctionDecl(const Symbol& fnSym) const;
             const ASTNode* GetFunctionDecl(const ASTNode* identExpr) const;            
             const ASTNode* GetVarDecl(const ASTNode* identExpr) const;
-            bool IsFunctionNameValid(const std::string& fnName) const;
+            bool IsFunctionNameValid(Common::InternedString fnName) const;
             bool IsFunctionSymbolValid(const Symbol& fnSym) const;
             bool IsVariableSymbolValid(const Symbol& varSym) const;
             bool IsGlobalVariable(const ASTNode* var) const;
             
         private:
+            const ASTNode* FindFunctionDecl(const Symbol& fnSym) const;
+
+        private:
+            /*
+            * \struct   Scope
+            * \brief    Node of the scope tree
+            */
+            struct Scope
+            {
+                size_t mParentID;                                                   /*!< Enclosing scope */
+                std::unordered_map<Common::InternedString, const ASTNode*> mVariables;  /*!< Variables declared in the scope, by name */
+            };
+
             using SymTable = std::unordered_map<const ASTNode*, Symbol>;
             using UseDefMap = std::unordered_map<const ASTNode*, const ASTNode*>;
+            using FunctionIndex = std::unordered_map<Common::InternedString, std::vector<const ASTNode*>>;
             
         private:
-            SymTable mTable;    /*!< Table containing all symbol defined in the program */
-            UseDefMap mUseDefs; /*!< Mapping between the uses and the definition of a variable */
+            SymTable mTable;            /*!< Table containing all symbol defined in the program */
+            UseDefMap mUseDefs;         /*!< Mapping between the uses and the definition of a variable */
+            std::vector<Scope> mScopes; /*!< Scope tree, indexed by scope ID */
+            FunctionIndex mFunctions;   /*!< Function declarations of mTable, by name (the overload sets), in declaration order */
         };
     }
 }
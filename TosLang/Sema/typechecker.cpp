@@ -3,6 +3,7 @@
 #include "../AST/declarations.h"
 #include "../Sema/symboltable.h"
 #include "../Utils/errorlogger.h"
+#include "../Utils/scheduler.h"
 
 #include <algorithm>
 #include <cassert>
@@ -13,54 +14,136 @@ using namespace TosLang::Common;
 using namespace TosLang::Utils;
 
 TypeChecker::TypeChecker() 
-    : mErrorCount{ 0 }, mCurrentScopeID{ 0 }, mCurrentFunc{ nullptr }
+    : mErrorCount{ 0 }, mCurrentFunc{ nullptr }, mDeferFunctionUses{ false }
 {
-    mCurrentScopesTraversed.push_front(mCurrentScopeID);
+}
 
-    this->mPrologueFtr = [this]()
-    {
-        if (mCurrentNode->GetKind() == ASTNode::NodeKind::COMPOUND_STMT)
-        {   
-            mCurrentScopesTraversed.push_front(++mCurrentScopeID);
-        }
-        else if (mCurrentNode->GetKind() == ASTNode::NodeKind::FUNCTION_DECL)
-        {
-            mCurrentFunc = static_cast<const FunctionDecl*>(mCurrentNode);
-            assert(mCurrentFunc != nullptr);
-        }
-    };
+/*
+* \fn                   Run
+* \brief                Recursively walk the tree rooted at root to check for type errors
+* \param root           Root of the tree to type check
+* \param symTab         Symbol table associated with the given AST
+* \param checkedDecls   Top-level declarations already known to be free of type errors, which are skipped
+* \return               Number of errors encountered during type checking
+*/
+size_t TypeChecker::Run(const std::unique_ptr<ASTNode>& root, const std::shared_ptr<SymbolTable>& symTab, const DeclSet& checkedDecls)
+{
+    // Cleanup before starting a new run
+    mErrorCount = 0;
+    mSymbolTable = symTab;
+    mNodeTypes.clear();
+    mOverloadMap.clear();
+    mDeferFunctionUses = false;
+    mFunctionUses.clear();
 
-    this->mEpilogueFtr = [this]()
+    if (checkedDecls.empty())
     {
-        if (mCurrentNode->GetKind() == ASTNode::NodeKind::COMPOUND_STMT)
-        {
-            mCurrentScopesTraversed.pop_front();
-        }
-        else if (mCurrentNode->GetKind() == ASTNode::NodeKind::FUNCTION_DECL)
+        this->VisitPostOrder(root);
+    }
+    else if (root != nullptr)
+    {
+        for (const auto& decl : root->GetChildrenNodes())
         {
-            assert(mCurrentFunc != nullptr);
-            mCurrentFunc = nullptr;
+            if (checkedDecls.find(decl.get()) == checkedDecls.end())
+                this->VisitPostOrder(decl);
         }
-    };
+    }
+
+    ResolvePendingCalls();
+
+    return mErrorCount;
 }
 
 /*
-* \fn           Run
-* \brief        Recursively walk the tree rooted at root to check for type errors
-* \param root   Root of the tree to type check
-* \param symTab Symbol table associated with the given AST
-* \return       Number of errors encountered during type checking
+* \fn               Run
+* \brief            Checks the tree rooted at root for type errors, checking its declarations concurrently.
+*                   Each declaration only depends on the symbol table, so the declarations are split in
+*                   contiguous ranges, each checked by its own type checker. The results of the ranges
+*                   are then merged in order, which reports the same errors as a serial run, in the same order.
+* \param root           Root of the tree to type check
+* \param symTab         Symbol table associated with the given AST
+* \param scheduler      Scheduler running the type checkers
+* \param checkedDecls   Top-level declarations already known to be free of type errors, which are skipped
+* \return               Number of errors encountered during type checking
 */
-size_t TypeChecker::Run(const std::unique_ptr<ASTNode>& root, const std::shared_ptr<SymbolTable>& symTab)
+size_t TypeChecker::Run(const std::unique_ptr<ASTNode>& root, const std::shared_ptr<SymbolTable>& symTab, Utils::Scheduler& scheduler, 
+                        const DeclSet& checkedDecls)
 {
     // Cleanup before starting a new run
     mErrorCount = 0;
     mSymbolTable = symTab;
     mNodeTypes.clear();
     mOverloadMap.clear();
+    mDeferFunctionUses = false;
+    mFunctionUses.clear();
 
-    this->VisitPostOrder(root);
+    if (root == nullptr)
+        return mErrorCount;
+
+    // A few ranges per thread balance the load without paying for a type checker per declaration
+    const ChildrenNodes& decls = root->GetChildrenNodes();
+    const size_t nbRanges = std::min(decls.size(), 4 * (scheduler.GetNbWorkers() + 1));
+
+    std::vector<std::unique_ptr<TypeChecker>> rangeCheckers(nbRanges);
+    std::vector<std::string> rangeErrors(nbRanges);
+    scheduler.ParallelFor(nbRanges, [&](size_t iRange)
+    {
+        ErrorLogger::Capture errorCapture;
+
+        // The symbol table is shared by every thread, so it is only read until the ranges are merged
+        auto checker = std::make_unique<TypeChecker>();
+        checker->mSymbolTable = symTab;
+        checker->mDeferFunctionUses = true;
+
+        const size_t declsEnd = (iRange + 1) * decls.size() / nbRanges;
+        for (size_t iDecl = iRange * decls.size() / nbRanges; iDecl < declsEnd; ++iDecl)
+        {
+            if (checkedDecls.find(decls[iDecl].get()) == checkedDecls.end())
+                checker->VisitPostOrder(decls[iDecl]);
+        }
+
+        rangeErrors[iRange] = errorCapture.GetErrors();
+        rangeCheckers[iRange] = std::move(checker);
+    });
+
+    for (size_t iRange = 0; iRange < nbRanges; ++iRange)
+    {
+        TypeChecker& checker = *rangeCheckers[iRange];
+        ErrorLogger::PrintCapturedErrors(rangeErrors[iRange]);
+        mErrorCount += checker.mErrorCount;
+
+        for (const auto& functionUse : checker.mFunctionUses)
+            mSymbolTable->AddFunctionUse(functionUse.first, *functionUse.second);
+
+        mNodeTypes.merge(checker.mNodeTypes);
+        mOverloadMap.merge(checker.mOverloadMap);
+    }
+
+    ResolvePendingCalls();
+
+    return mErrorCount;
+}
+
+/*
+* \fn           AddFunctionUse
+* \brief        Ties a function call to the function it resolved to
+* \param cExpr  Function call expression
+* \param fnSym  Symbol of the function being called
+*/
+void TypeChecker::AddFunctionUse(const CallExpr* cExpr, const Symbol& fnSym)
+{
+    if (mDeferFunctionUses)
+        mFunctionUses.emplace_back(cExpr, &fnSym);
+    else
+        mSymbolTable->AddFunctionUse(cExpr, fnSym);
+}
 
+/*
+* \fn       ResolvePendingCalls
+* \brief    Resolves the calls whose overload resolution couldn't be completed during the traversal
+*/
+void TypeChecker::ResolvePendingCalls()
+{
     // Some calls may still be unresolved because of lack of context at their call sites 
     // (mostly due to an ignored returned value). We try to resolve these calls by going over
     // their overload sets and checking if there's a valid function candidate. If there's 
@@ -70,7 +153,7 @@ size_t TypeChecker::Run(const std::unique_ptr<ASTNode>& root, const std::shared_
         if (callOverloads.second.size() == 1)
         {
             const CallExpr* cExpr = dynamic_cast<const CallExpr*>(callOverloads.first);
-            mSymbolTable->AddFunctionUse(cExpr, *callOverloads.second.front());
+            AddFunctionUse(cExpr, *callOverloads.second.front());
         }
         else if (!callOverloads.second.empty())
         {
@@ -78,8 +161,6 @@ size_t TypeChecker::Run(const std::unique_ptr<ASTNode>& root, const std::shared_
             ++mErrorCount;
         }
     }
-
-    return mErrorCount;
 }
 
 /*
@@ -91,6 +172,10 @@ size_t TypeChecker::Run(const std::unique_ptr<ASTNode>& root, const std::shared_
 */
 bool TypeChecker::CheckExprEvaluateToType(const Expr* expr, Type type)
 {
+    // A spawned call evaluates to the value returned by the call
+    if (expr->GetKind() == ASTNode::NodeKind::SPAWN_EXPR)
+        expr = static_cast<const SpawnExpr*>(expr)->GetCall();
+
     // In the most common case, we already know the type of the expression
     if ((expr->GetKind() != ASTNode::NodeKind::BINARY_EXPR) 
         && (expr->GetKind() != ASTNode::NodeKind::CALL_EXPR))
@@ -131,7 +216,7 @@ bool TypeChecker::CheckExprEvaluateToType(const Expr* expr, Type type)
 
         if (matchIt != overloadSet.end())
         {
-            mSymbolTable->AddFunctionUse(cExpr, **matchIt);
+            AddFunctionUse(cExpr, **matchIt);
 
             // No need for the overload set anymore
             mOverloadMap.erase(oSetIt);
@@ -161,7 +246,21 @@ bool TypeChecker::CheckExprEvaluateToType(const Expr* expr, Type type)
         Type typeForEval = type;
         // A '<' or a '>' requires numbers to be compared to one another
         if ((bExpr->GetOperation() == Operation::GREATER_THAN) || (bExpr->GetOperation() == Operation::LESS_THAN))
+        {
             typeForEval = Type::NUMBER;
+        }
+        // A '=' requires both operands to be of the same type. If one of them is already known, the other must match it.
+        else if (bExpr->GetOperation() == Operation::EQUAL)
+        {
+            auto lhsIt = mNodeTypes.find(bExpr->GetLHS());
+            auto rhsIt = mNodeTypes.find(bExpr->GetRHS());
+            if (lhsIt != mNodeTypes.end())
+                typeForEval = lhsIt->second;
+            else if (rhsIt != mNodeTypes.end())
+                typeForEval = rhsIt->second;
+            else
+                typeForEval = Type::NUMBER;
+        }
         
         bool evalutesToType = CheckExprEvaluateToType(bExpr->GetLHS(), typeForEval);
         evalutesToType &= CheckExprEvaluateToType(bExpr->GetRHS(), typeForEval);
@@ -179,6 +278,33 @@ bool TypeChecker::CheckExprEvaluateToType(const Expr* expr, Type type)
     }
 }
 
+/*
+* \fn       NodePrologue
+* \brief    Keeps track of the function being type checked.
+*           Identifiers were already resolved against the scope tree of the symbol table by the symbol collector.
+*/
+void TypeChecker::NodePrologue()
+{
+    if (mCurrentNode->GetKind() == ASTNode::NodeKind::FUNCTION_DECL)
+    {
+        mCurrentFunc = static_cast<const FunctionDecl*>(mCurrentNode);
+        assert(mCurrentFunc != nullptr);
+    }
+}
+
+/*
+* \fn       NodeEpilogue
+* \brief    Leaves the function being type checked
+*/
+void TypeChecker::NodeEpilogue()
+{
+    if (mCurrentNode->GetKind() == ASTNode::NodeKind::FUNCTION_DECL)
+    {
+        assert(mCurrentFunc != nullptr);
+        mCurrentFunc = nullptr;
+    }
+}
+
 void TypeChecker::HandleVarDecl()
 {
     const VarDecl* vDecl = static_cast<const VarDecl*>(this->mCurrentNode);
@@ -294,29 +420,32 @@ void TypeChecker::HandleBinaryExpr()
     Type operandTypes[2];
     for (int i = 0; i < 2; ++i)
     {
-        switch (children[i]->GetKind())
-        {
-        case ASTNode::NodeKind::BINARY_EXPR:
-            operandTypes[i] = mNodeTypes.at(children[i].get());
-            break;
-        case ASTNode::NodeKind::BOOLEAN_EXPR:
-            operandTypes[i] = Type::BOOL;
-            break;
-        case ASTNode::NodeKind::IDENTIFIER_EXPR:
+        // An operand can still have an undecided type. This happens when it is a call expression 
+        // (or a binary expression containing one) waiting for the end of its overload resolution.
+        auto typeIt = mNodeTypes.find(children[i].get());
+        if (typeIt != mNodeTypes.end())
         {
-            const IdentifierExpr* iExpr = static_cast<const IdentifierExpr*>(children[i].get());
-            // It is assumed that the scope checker has been run before the type checker
-            const Symbol* varSym;
-            bool symFound;
-            std::tie(symFound, varSym) = mSymbolTable->TryGetSymbol(iExpr);
-            assert(symFound);
-            operandTypes[i] = varSym->GetVariableType();
+            operandTypes[i] = typeIt->second;
+            continue;
         }
-            break;
-        case ASTNode::NodeKind::NUMBER_EXPR:
-            operandTypes[i] = Type::NUMBER;
-            break;
+
+        // The left hand side of an assignment gives the context needed to resolve its right hand side
+        if ((i == 1) && (bExpr->GetOperation() == Operation::ASSIGNMENT))
+        {
+            if (CheckExprEvaluateToType(bExpr->GetRHS(), operandTypes[0]))
+            {
+                mNodeTypes[bExpr] = operandTypes[0];
+            }
+            else if (children[i]->GetKind() != ASTNode::NodeKind::CALL_EXPR)
+            {
+                // A call expression has already been flagged by its overload resolution
+                ErrorLogger::PrintErrorAtLocation(ErrorLogger::ErrorType::WRONG_BIN_EXPR_TYPE, bExpr->GetSourceLocation());
+                ++mErrorCount;
+            }
         }
+
+        // Otherwise, the type of this expression will be decided by the node making use of it
+        return;
     }
 
     // Check if the operands' types match
@@ -342,7 +471,7 @@ void TypeChecker::HandleCallExpr()
     const CallExpr* cExpr = static_cast<const CallExpr*>(this->mCurrentNode);
     assert(cExpr != nullptr);
 
-    std::vector<const Symbol*> overloadCandidates = mSymbolTable->GetOverloadCandidates(cExpr->GetCalleeName());
+    std::vector<const Symbol*> overloadCandidates = mSymbolTable->GetOverloadCandidates(cExpr->GetNameID());
     
     const ChildrenNodes& argNodes = cExpr->GetArgs();
     const size_t argSize = argNodes.size();
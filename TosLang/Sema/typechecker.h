@@ -7,12 +7,21 @@
 #include <memory>
 #include <stack>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace TosLang
 {
+    namespace Utils
+    {
+        class Scheduler;
+    }
+
     namespace FrontEnd
     {
         class BinaryOpExpr;
+        class CallExpr;
         class Expr;
         class FunctionDecl;
         class Symbol;
@@ -30,10 +39,21 @@ namespace TosLang
             TypeChecker();
 
         public:
-            size_t Run(const std::unique_ptr<ASTNode>& root, const std::shared_ptr<SymbolTable>& symTab);
+            using DeclSet = std::unordered_set<const ASTNode*>;
+
+            size_t Run(const std::unique_ptr<ASTNode>& root, const std::shared_ptr<SymbolTable>& symTab, 
+                       const DeclSet& checkedDecls = {});
+            size_t Run(const std::unique_ptr<ASTNode>& root, const std::shared_ptr<SymbolTable>& symTab, Utils::Scheduler& scheduler, 
+                       const DeclSet& checkedDecls = {});
             
         private:
+            void AddFunctionUse(const CallExpr* cExpr, const Symbol& fnSym);
             bool CheckExprEvaluateToType(const Expr* expr, Common::Type type);
+            void ResolvePendingCalls();
+
+        protected:  // Traversal hooks
+            void NodePrologue();
+            void NodeEpilogue();
 
         protected:  // Declarations
             void HandleVarDecl();
@@ -58,15 +78,16 @@ namespace TosLang
         private:
             using NodeTypeMap = std::unordered_map<const ASTNode*, Common::Type>;
             using OverloadMap = std::unordered_map<const ASTNode*, std::vector<const Symbol*>>;
+            using FunctionUses = std::vector<std::pair<const CallExpr*, const Symbol*>>;
             
         private:
             size_t mErrorCount;                         /*!< Number of errors found by the type checker */
-            size_t mCurrentScopeID;                     /*!< Current scope identifier */
             const FunctionDecl* mCurrentFunc;           /*!< Current traversed function */
-            std::deque<size_t> mCurrentScopesTraversed; /*!< Path from the current scope to the global scopes */
             std::shared_ptr<SymbolTable> mSymbolTable;  /*!< Symbol table to be used by the type checker */
             NodeTypeMap mNodeTypes;                     /*!< Type of the value produced by an AST node */
             OverloadMap mOverloadMap;                   /*!< Mapping between a function call and its overload set */
+            bool mDeferFunctionUses;                    /*!< Are resolved calls kept in mFunctionUses rather than added to the symbol table? */
+            FunctionUses mFunctionUses;                 /*!< Resolved calls waiting to be added to the symbol table */
         };
     }
 }
@@ -7,21 +7,22 @@ using namespace TosLang::Common;
 
 TosLang::FrontEnd::TypeInfer::TypeInfer(const std::shared_ptr<SymbolTable>& symTab) : mCurrentScopeLevel{ 0 }, mSymbolTable { symTab }
 {
-    this->mPrologueFtr = [this]()
+}
+
+void TosLang::FrontEnd::TypeInfer::NodePrologue()
+{
+    if (mCurrentNode->GetKind() == ASTNode::NodeKind::COMPOUND_STMT)
     {
-        if (mCurrentNode->GetKind() == ASTNode::NodeKind::COMPOUND_STMT)
-        {
-            ++mCurrentScopeLevel;
-        }
-    };
+        ++mCurrentScopeLevel;
+    }
+}
 
-    this->mEpilogueFtr = [this]()
+void TosLang::FrontEnd::TypeInfer::NodeEpilogue()
+{
+    if (mCurrentNode->GetKind() == ASTNode::NodeKind::COMPOUND_STMT)
     {
-        if (mCurrentNode->GetKind() == ASTNode::NodeKind::COMPOUND_STMT)
-        {
-            --mCurrentScopeLevel;
-        }
-    };
+        --mCurrentScopeLevel;
+    }
 }
 
 void TosLang::FrontEnd::TypeInfer::Infer(const std::unique_ptr<ASTNode>& /*root*/)
@@ -18,6 +18,19 @@ namespace TosLang
         public:
             void Infer(const std::unique_ptr<ASTNode>& root);
 
+        protected:  // Traversal hooks
+            /*
+            * \fn       NodePrologue
+            * \brief    Enters the scope of a compound statement
+            */
+            void NodePrologue();
+
+            /*
+            * \fn       NodeEpilogue
+            * \brief    Leaves the scope of a compound statement
+            */
+            void NodeEpilogue();
+
         protected:  // Declarations
             /*
             * \fn       HandleFunctionDecl
@@ -0,0 +1,694 @@
+#include "astbinary.h"
+
+#include "../AST/declarations.h"
+#include "../AST/expressions.h"
+#include "../AST/statements.h"
+#include "mappedfile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using namespace TosLang::FrontEnd;
+using namespace TosLang::Utils;
+
+static const char MAGIC[] = { 'T', 'O', 'S', 'A' };
+static const uint32_t FORMAT_VERSION = 1;
+
+/*
+* \fn               WriteInt
+* \brief            Appends a 32 bits little endian integer to a buffer
+* \param buffer     Buffer to append to
+* \param value      Integer to append
+*/
+static void WriteInt(std::string& buffer, uint32_t value)
+{
+    const char bytes[] = { static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF),
+                           static_cast<char>((value >> 16) & 0xFF), static_cast<char>((value >> 24) & 0xFF) };
+    buffer.append(bytes, sizeof(bytes));
+}
+
+/*
+* \fn       IsExprKind
+* \brief    Indicates if nodes of the given kind are expressions
+* \param    kind Kind of a node
+* \return   True if the node is an expression
+*/
+static bool IsExprKind(ASTNode::NodeKind kind)
+{
+    return (kind >= ASTNode::NodeKind::ARRAY_EXPR) && (kind <= ASTNode::NodeKind::STRING_EXPR);
+}
+
+/*
+* \fn       IsStmtKind
+* \brief    Indicates if nodes of the given kind are statements
+* \param    kind Kind of a node
+* \return   True if the node is a statement
+*/
+static bool IsStmtKind(ASTNode::NodeKind kind)
+{
+    return (kind >= ASTNode::NodeKind::COMPOUND_STMT) && (kind <= ASTNode::NodeKind::WHILE_STMT);
+}
+
+/*
+* \fn       TakeAs
+* \brief    Takes the ownership of a node as a pointer to one of its base classes
+* \param    node Node to take. It is left empty.
+* \return   Pointer of the given type to the node
+*/
+template <class T>
+static std::unique_ptr<T> TakeAs(std::unique_ptr<ASTNode>& node)
+{
+    return std::unique_ptr<T>{ static_cast<T*>(node.release()) };
+}
+
+//////////////////// Writer ////////////////////
+
+/*
+* \fn               Run
+* \brief            Stores an AST in a binary AST file
+* \param root       Root node of the AST. It must be a ProgramDecl.
+* \param filename   Name of the binary AST file
+* \return           Has the AST been stored?
+*/
+bool ASTBinaryWriter::Run(const std::unique_ptr<ASTNode>& root, const std::string& filename)
+{
+    std::string buffer;
+    if (!Serialize(root, buffer))
+        return false;
+
+    std::ofstream stream{ filename, std::ios::binary };
+    stream.write(buffer.data(), buffer.size());
+    return stream.good();
+}
+
+/*
+* \fn               Serialize
+* \brief            Stores an AST in a buffer, in the binary AST format
+* \param root       Root node of the AST. It must be a ProgramDecl.
+* \param buffer     Buffer receiving the binary AST
+* \return           Has the AST been stored?
+*/
+bool ASTBinaryWriter::Serialize(const std::unique_ptr<ASTNode>& root, std::string& buffer)
+{
+    if ((root == nullptr) || (root->GetKind() != ASTNode::NodeKind::PROGRAM_DECL))
+        return false;
+
+    mNodes.clear();
+    mStrings.clear();
+    mStringIdx.clear();
+    mNbNodes = 0;
+
+    if (!WriteNodes(root.get()))
+        return false;
+
+    buffer.assign(std::begin(MAGIC), std::end(MAGIC));
+    WriteInt(buffer, FORMAT_VERSION);
+    WriteInt(buffer, static_cast<uint32_t>(mStrings.size()));
+    WriteInt(buffer, mNbNodes);
+
+    for (const std::string* str : mStrings)
+    {
+        WriteInt(buffer, static_cast<uint32_t>(str->size()));
+        buffer.append(*str);
+    }
+
+    buffer.append(mNodes);
+    return true;
+}
+
+/*
+* \fn           WriteNodes
+* \brief        Writes the records of a tree in pre-order, without recursing once per level of the tree
+* \param root   Root node of the tree to write
+* \return       False if a node of the tree is missing or is an ERROR node
+*/
+bool ASTBinaryWriter::WriteNodes(const ASTNode* root)
+{
+    mNodesToWrite.clear();
+    mNodesToWrite.push_back(root);
+    while (!mNodesToWrite.empty())
+    {
+        const ASTNode* node = mNodesToWrite.back();
+        mNodesToWrite.pop_back();
+        if ((node == nullptr) || (node->GetKind() == ASTNode::NodeKind::ERROR))
+            return false;
+
+        WriteNode(node);
+
+        // The first child is written next
+        const ChildrenNodes& children = node->GetChildrenNodes();
+        for (auto childIt = children.rbegin(); childIt != children.rend(); ++childIt)
+            mNodesToWrite.push_back(childIt->get());
+    }
+
+    return true;
+}
+
+/*
+* \fn           WriteNode
+* \brief        Writes the record of a node. The records of its children must follow.
+* \param node   Node to write
+*/
+void ASTBinaryWriter::WriteNode(const ASTNode* node)
+{
+    const ASTNode::NodeKind kind = node->GetKind();
+    const ChildrenNodes& children = node->GetChildrenNodes();
+
+    WriteInt(mNodes, static_cast<uint32_t>(kind));
+    WriteInt(mNodes, node->GetSourceLocation().GetCurrentLine());
+    WriteInt(mNodes, node->GetSourceLocation().GetCurrentColumn());
+    WriteInt(mNodes, static_cast<uint32_t>(children.size()));
+    ++mNbNodes;
+
+    switch (kind)
+    {
+    case ASTNode::NodeKind::FUNCTION_DECL:
+    {
+        const FunctionDecl* fDecl = static_cast<const FunctionDecl*>(node);
+        WriteInt(mNodes, GetStringIdx(fDecl->GetFunctionName()));
+        WriteInt(mNodes, static_cast<uint32_t>(fDecl->GetReturnType()));
+        break;
+    }
+    case ASTNode::NodeKind::VAR_DECL:
+    {
+        const VarDecl* vDecl = static_cast<const VarDecl*>(node);
+        WriteInt(mNodes, GetStringIdx(vDecl->GetVarName()));
+        WriteInt(mNodes, static_cast<uint32_t>(vDecl->GetVarType()));
+        WriteInt(mNodes, static_cast<uint32_t>(vDecl->GetVarSize()));
+        WriteInt(mNodes, vDecl->IsFunctionParameter() ? 1 : 0);
+        break;
+    }
+    case ASTNode::NodeKind::BINARY_EXPR:
+        WriteInt(mNodes, static_cast<uint32_t>(static_cast<const BinaryOpExpr*>(node)->GetOperation()));
+        break;
+    case ASTNode::NodeKind::BOOLEAN_EXPR:
+        WriteInt(mNodes, static_cast<const BooleanExpr*>(node)->GetValue() ? 1 : 0);
+        break;
+    case ASTNode::NodeKind::CALL_EXPR:
+        WriteInt(mNodes, GetStringIdx(node->GetName()));
+        break;
+    case ASTNode::NodeKind::STRING_EXPR:
+        WriteInt(mNodes, GetStringIdx(static_cast<const StringExpr*>(node)->GetValue()));
+        break;
+    case ASTNode::NodeKind::IDENTIFIER_EXPR:
+        WriteInt(mNodes, GetStringIdx(node->GetName()));
+        WriteInt(mNodes, static_cast<uint32_t>(static_cast<const IdentifierExpr*>(node)->GetType()));
+        break;
+    case ASTNode::NodeKind::NUMBER_EXPR:
+        WriteInt(mNodes, static_cast<uint32_t>(static_cast<const NumberExpr*>(node)->GetValue()));
+        break;
+    default:
+        break;
+    }
+}
+
+/*
+* \fn       GetStringIdx
+* \brief    Gives the index of a string in the string table, adding it to the table if needed
+* \param    str String to look for
+* \return   Index of the string
+*/
+uint32_t ASTBinaryWriter::GetStringIdx(const std::string& str)
+{
+    auto strIt = mStringIdx.find(str);
+    if (strIt != mStringIdx.end())
+        return strIt->second;
+
+    strIt = mStringIdx.emplace(str, static_cast<uint32_t>(mStrings.size())).first;
+    mStrings.push_back(&strIt->first);
+    return strIt->second;
+}
+
+//////////////////// Reader ////////////////////
+
+/*
+* \fn               Run
+* \brief            Creates an AST from the contents of a binary AST file
+* \param filename   Name of a binary AST file
+* \return           Root node of the generated AST. Nullptr if the file is missing or malformed.
+*/
+std::unique_ptr<ASTNode> ASTBinaryReader::Run(const std::string& filename)
+{
+    if (MappedFile::IsSupported())
+    {
+        MappedFile file;
+        if (!file.Open(filename))
+            return nullptr;
+
+        return Run(file.GetData(), file.GetSize());
+    }
+
+    std::ifstream stream{ filename, std::ios::binary };
+    if (!stream.is_open())
+        return nullptr;
+
+    const std::string content{ std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+    return Run(content.data(), content.size());
+}
+
+/*
+* \fn           Run
+* \brief        Creates an AST from a binary AST held in memory
+* \param data   First byte of the binary AST
+* \param size   Size of the binary AST in bytes
+* \return       Root node of the generated AST. Nullptr if the binary AST is malformed.
+*/
+std::unique_ptr<ASTNode> ASTBinaryReader::Run(const char* data, size_t size)
+{
+    mDataIt = data;
+    mDataEnd = data + size;
+    mHasFailed = false;
+    mStrings.clear();
+    mNames.clear();
+    mPendingNodes.clear();
+    mOpenRecords.clear();
+
+    if ((size < sizeof(MAGIC)) || (std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0))
+        return nullptr;
+    mDataIt += sizeof(MAGIC);
+
+    if (ReadInt() != FORMAT_VERSION)
+        return nullptr;
+
+    // Every string takes at least 4 bytes, which bounds the size of the table of a malformed file
+    const uint32_t nbStrings = ReadInt();
+    mNbNodesLeft = ReadInt();
+    if (mHasFailed || (nbStrings > static_cast<size_t>(mDataEnd - mDataIt) / 4))
+        return nullptr;
+
+    mStrings.reserve(nbStrings);
+    for (uint32_t iStr = 0; iStr < nbStrings; ++iStr)
+    {
+        const uint32_t strSize = ReadInt();
+        if (mHasFailed || (strSize > static_cast<size_t>(mDataEnd - mDataIt)))
+            return nullptr;
+
+        mStrings.emplace_back(mDataIt, strSize);
+        mDataIt += strSize;
+    }
+    mNames.resize(nbStrings);
+
+    // The binary AST must start with a ProgramDecl node
+    if ((mNbNodesLeft == 0) || (static_cast<ASTNode::NodeKind>(ReadInt()) != ASTNode::NodeKind::PROGRAM_DECL))
+        return nullptr;
+    --mNbNodesLeft;
+    ReadInt();  // The program has no source location
+    ReadInt();
+    const uint32_t nbDecls = ReadInt();
+
+    // Every node of the program lives in the arena of the program, which frees them all at once
+    auto programNode = std::make_unique<ProgramDecl>();
+    auto arena = std::make_unique<ASTArena>();
+    ASTArena::Scope arenaScope{ arena.get() };
+    programNode->AddArena(std::move(arena));
+
+    for (uint32_t iDecl = 0; (iDecl < nbDecls) && !mHasFailed; ++iDecl)
+    {
+        if (!ReadNode())
+            break;
+
+        const ASTNode::NodeKind declKind = mPendingNodes.back()->GetKind();
+        if ((declKind != ASTNode::NodeKind::FUNCTION_DECL) && (declKind != ASTNode::NodeKind::VAR_DECL))
+        {
+            mHasFailed = true;
+            break;
+        }
+
+        programNode->AddProgramDecl(TakeAs<Decl>(mPendingNodes.back()));
+        mPendingNodes.pop_back();
+    }
+
+    // Nodes left behind by a malformed file must go before the arena holding them
+    mPendingNodes.clear();
+
+    if (mHasFailed || (mNbNodesLeft != 0) || (mDataIt != mDataEnd))
+        return nullptr;
+
+    return std::move(programNode);
+}
+
+/*
+* \fn       ReadInt
+* \brief    Reads the next 32 bits little endian integer of the binary AST
+* \return   Integer read. 0 if the binary AST is too short.
+*/
+uint32_t ASTBinaryReader::ReadInt()
+{
+    if (mDataEnd - mDataIt < 4)
+    {
+        mHasFailed = true;
+        return 0;
+    }
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(mDataIt);
+    mDataIt += 4;
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8)
+         | (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+/*
+* \fn       ReadString
+* \brief    Reads the index of a name of the string table. Each name is interned the first time it is read.
+* \return   Name read. The empty string if the index is out of the table.
+*/
+TosLang::Common::InternedString ASTBinaryReader::ReadString()
+{
+    const uint32_t strIdx = ReadInt();
+    if (strIdx >= mStrings.size())
+    {
+        mHasFailed = true;
+        return Common::InternedString{};
+    }
+
+    if (mNames[strIdx].IsEmpty())
+        mNames[strIdx] = mStrings[strIdx];
+
+    return mNames[strIdx];
+}
+
+/*
+* \fn       ReadLiteral
+* \brief    Reads the index of a string literal of the string table. Literals don't go to the string pool.
+* \return   Literal read. The empty string if the index is out of the table.
+*/
+std::string_view ASTBinaryReader::ReadLiteral()
+{
+    const uint32_t strIdx = ReadInt();
+    if (strIdx >= mStrings.size())
+    {
+        mHasFailed = true;
+        return{};
+    }
+
+    return mStrings[strIdx];
+}
+
+/*
+* \fn       ReadNode
+* \brief    Reads the records of a node and of its descendants, then creates the node. The records of the nodes
+*           on the path to the next record are kept on a stack instead of recursing once per level of the tree.
+*           The node is pushed on the pending nodes, from which its parent will take it.
+* \return   False if a record is malformed
+*/
+bool ASTBinaryReader::ReadNode()
+{
+    mOpenRecords.clear();
+    if (!ReadRecord())
+        return false;
+
+    while (!mOpenRecords.empty())
+    {
+        const NodeRecord& record = mOpenRecords.back();
+        if (mPendingNodes.size() - record.mFirstChildIdx < record.mNbChildren)
+        {
+            // The next record is the next child of the innermost open node
+            if (!ReadRecord())
+                return false;
+        }
+        else
+        {
+            if (!CreateNode(record))
+                return false;
+
+            mOpenRecords.pop_back();
+        }
+    }
+
+    return true;
+}
+
+/*
+* \fn       ReadRecord
+* \brief    Reads the record of a node and opens it, its children being the next records
+* \return   False if the record is malformed
+*/
+bool ASTBinaryReader::ReadRecord()
+{
+    if (mNbNodesLeft == 0)
+    {
+        mHasFailed = true;
+        return false;
+    }
+    --mNbNodesLeft;
+
+    NodeRecord record;
+    record.mKind = static_cast<ASTNode::NodeKind>(ReadInt());
+    const uint32_t line = ReadInt();
+    const uint32_t column = ReadInt();
+    record.mSrcLoc = SourceLocation{ line, column };
+    record.mNbChildren = ReadInt();
+    record.mOperands[0] = record.mOperands[1] = record.mOperands[2] = 0;
+    record.mFirstChildIdx = mPendingNodes.size();
+
+    // Operands of the node kind
+    switch (record.mKind)
+    {
+    case ASTNode::NodeKind::FUNCTION_DECL:
+        record.mName = ReadString();
+        record.mOperands[0] = ReadInt();
+        break;
+    case ASTNode::NodeKind::VAR_DECL:
+        record.mName = ReadString();
+        record.mOperands[0] = ReadInt();
+        record.mOperands[1] = ReadInt();
+        record.mOperands[2] = ReadInt();
+        break;
+    case ASTNode::NodeKind::BINARY_EXPR:
+    case ASTNode::NodeKind::BOOLEAN_EXPR:
+    case ASTNode::NodeKind::NUMBER_EXPR:
+        record.mOperands[0] = ReadInt();
+        break;
+    case ASTNode::NodeKind::CALL_EXPR:
+        record.mName = ReadString();
+        break;
+    case ASTNode::NodeKind::STRING_EXPR:
+        record.mLiteral = ReadLiteral();
+        break;
+    case ASTNode::NodeKind::IDENTIFIER_EXPR:
+        record.mName = ReadString();
+        record.mOperands[0] = ReadInt();
+        break;
+    case ASTNode::NodeKind::PARAM_VAR_DECL:
+    case ASTNode::NodeKind::ARRAY_EXPR:
+    case ASTNode::NodeKind::INDEX_EXPR:
+    case ASTNode::NodeKind::SPAWN_EXPR:
+    case ASTNode::NodeKind::COMPOUND_STMT:
+    case ASTNode::NodeKind::IF_STMT:
+    case ASTNode::NodeKind::PRINT_STMT:
+    case ASTNode::NodeKind::RETURN_STMT:
+    case ASTNode::NodeKind::SCAN_STMT:
+    case ASTNode::NodeKind::SLEEP_STMT:
+    case ASTNode::NodeKind::SYNC_STMT:
+    case ASTNode::NodeKind::WHILE_STMT:
+        break;
+    default:
+        mHasFailed = true;
+        break;
+    }
+
+    // Every child takes at least one record
+    if (mHasFailed || (record.mNbChildren > mNbNodesLeft))
+    {
+        mHasFailed = true;
+        return false;
+    }
+
+    mOpenRecords.push_back(std::move(record));
+    return true;
+}
+
+/*
+* \fn           CreateNode
+* \brief        Creates a node out of its record and of its children, which are the last pending nodes
+* \param record Record of the node
+* \return       False if the children aren't what the node expects
+*/
+bool ASTBinaryReader::CreateNode(const NodeRecord& record)
+{
+    const ASTNode::NodeKind kind = record.mKind;
+    const uint32_t nbChildren = record.mNbChildren;
+    const SourceLocation& srcLoc = record.mSrcLoc;
+    const Common::InternedString& name = record.mName;
+    const uint32_t* operands = record.mOperands;
+
+    // Checks that the children are what the node expects
+    auto children = mPendingNodes.begin() + record.mFirstChildIdx;
+    auto childIs = [&children](size_t childIdx, auto isExpectedKind) { return isExpectedKind(children[childIdx]->GetKind()); };
+    auto allChildrenAre = [&children, nbChildren](auto isExpectedKind)
+    {
+        return std::all_of(children, children + nbChildren, [&isExpectedKind](const std::unique_ptr<ASTNode>& child) { return isExpectedKind(child->GetKind()); });
+    };
+    auto isKind = [](ASTNode::NodeKind expectedKind) { return [expectedKind](ASTNode::NodeKind kind) { return kind == expectedKind; }; };
+    auto isInBlock = [](ASTNode::NodeKind kind) { return IsExprKind(kind) || IsStmtKind(kind) || (kind == ASTNode::NodeKind::VAR_DECL); };
+
+    bool isValid = false;
+    switch (kind)
+    {
+    case ASTNode::NodeKind::FUNCTION_DECL:
+        isValid = (nbChildren == 2) && childIs(0, isKind(ASTNode::NodeKind::PARAM_VAR_DECL)) && childIs(1, isKind(ASTNode::NodeKind::COMPOUND_STMT));
+        break;
+    case ASTNode::NodeKind::PARAM_VAR_DECL:
+        isValid = allChildrenAre(isKind(ASTNode::NodeKind::VAR_DECL));
+        break;
+    case ASTNode::NodeKind::VAR_DECL:
+    case ASTNode::NodeKind::PRINT_STMT:
+    case ASTNode::NodeKind::RETURN_STMT:
+        isValid = (nbChildren <= 1) && allChildrenAre(IsExprKind);
+        break;
+    case ASTNode::NodeKind::ARRAY_EXPR:
+    case ASTNode::NodeKind::CALL_EXPR:
+        isValid = allChildrenAre(IsExprKind);
+        break;
+    case ASTNode::NodeKind::BINARY_EXPR:
+        isValid = (nbChildren == 2) && allChildrenAre(IsExprKind);
+        break;
+    case ASTNode::NodeKind::BOOLEAN_EXPR:
+    case ASTNode::NodeKind::IDENTIFIER_EXPR:
+    case ASTNode::NodeKind::NUMBER_EXPR:
+    case ASTNode::NodeKind::STRING_EXPR:
+    case ASTNode::NodeKind::SYNC_STMT:
+        isValid = (nbChildren == 0);
+        break;
+    case ASTNode::NodeKind::INDEX_EXPR:
+        isValid = (nbChildren == 2) && childIs(0, isKind(ASTNode::NodeKind::IDENTIFIER_EXPR)) && childIs(1, IsExprKind);
+        break;
+    case ASTNode::NodeKind::SPAWN_EXPR:
+        isValid = (nbChildren == 1) && childIs(0, isKind(ASTNode::NodeKind::CALL_EXPR));
+        break;
+    case ASTNode::NodeKind::COMPOUND_STMT:
+        isValid = allChildrenAre(isInBlock);
+        break;
+    case ASTNode::NodeKind::IF_STMT:
+    case ASTNode::NodeKind::WHILE_STMT:
+        isValid = (nbChildren == 2) && childIs(0, IsExprKind) && childIs(1, isKind(ASTNode::NodeKind::COMPOUND_STMT));
+        break;
+    case ASTNode::NodeKind::SCAN_STMT:
+        isValid = (nbChildren == 1) && childIs(0, isKind(ASTNode::NodeKind::IDENTIFIER_EXPR));
+        break;
+    case ASTNode::NodeKind::SLEEP_STMT:
+        isValid = (nbChildren == 1) && childIs(0, IsExprKind);
+        break;
+    default:
+        break;
+    }
+
+    if (!isValid)
+    {
+        mHasFailed = true;
+        return false;
+    }
+
+    // Creates the node out of its children
+    std::unique_ptr<ASTNode> node;
+    switch (kind)
+    {
+    case ASTNode::NodeKind::FUNCTION_DECL:
+        node = std::make_unique<FunctionDecl>(name, static_cast<Common::Type>(operands[0]),
+                                              TakeAs<ParamVarDecls>(children[0]), TakeAs<CompoundStmt>(children[1]), srcLoc);
+        break;
+    case ASTNode::NodeKind::PARAM_VAR_DECL:
+    {
+        auto params = std::make_unique<ParamVarDecls>();
+        for (uint32_t iChild = 0; iChild < nbChildren; ++iChild)
+            params->AddParameter(TakeAs<VarDecl>(children[iChild]));
+        node = std::move(params);
+        break;
+    }
+    case ASTNode::NodeKind::VAR_DECL:
+    {
+        auto vDecl = std::make_unique<VarDecl>(name, static_cast<Common::Type>(operands[0]), operands[2] != 0,
+                                               static_cast<int>(operands[1]), srcLoc);
+        if (nbChildren == 1)
+            vDecl->AddInitialization(TakeAs<Expr>(children[0]));
+        node = std::move(vDecl);
+        break;
+    }
+    case ASTNode::NodeKind::ARRAY_EXPR:
+    case ASTNode::NodeKind::CALL_EXPR:
+    {
+        std::vector<std::unique_ptr<Expr>> elems;
+        elems.reserve(nbChildren);
+        for (uint32_t iChild = 0; iChild < nbChildren; ++iChild)
+            elems.push_back(TakeAs<Expr>(children[iChild]));
+
+        if (kind == ASTNode::NodeKind::ARRAY_EXPR)
+            node = std::make_unique<ArrayExpr>(std::move(elems), srcLoc);
+        else
+            node = std::make_unique<CallExpr>(name, std::move(elems), srcLoc);
+        break;
+    }
+    case ASTNode::NodeKind::BINARY_EXPR:
+        node = std::make_unique<BinaryOpExpr>(static_cast<Common::Operation>(operands[0]),
+                                              TakeAs<Expr>(children[0]), TakeAs<Expr>(children[1]), srcLoc);
+        break;
+    case ASTNode::NodeKind::BOOLEAN_EXPR:
+        node = std::make_unique<BooleanExpr>(operands[0] != 0, srcLoc);
+        break;
+    case ASTNode::NodeKind::IDENTIFIER_EXPR:
+    {
+        auto iExpr = std::make_unique<IdentifierExpr>(name, srcLoc);
+        iExpr->SetType(static_cast<Common::Type>(operands[0]));
+        node = std::move(iExpr);
+        break;
+    }
+    case ASTNode::NodeKind::INDEX_EXPR:
+        node = std::make_unique<IndexedExpr>(TakeAs<Expr>(children[0]), TakeAs<Expr>(children[1]), srcLoc);
+        break;
+    case ASTNode::NodeKind::NUMBER_EXPR:
+        node = std::make_unique<NumberExpr>(static_cast<int>(operands[0]), srcLoc);
+        break;
+    case ASTNode::NodeKind::SPAWN_EXPR:
+        node = std::make_unique<SpawnExpr>(TakeAs<Expr>(children[0]), srcLoc);
+        break;
+    case ASTNode::NodeKind::STRING_EXPR:
+        node = std::make_unique<StringExpr>(std::string{ record.mLiteral }, srcLoc);
+        break;
+    case ASTNode::NodeKind::COMPOUND_STMT:
+    {
+        auto cStmt = std::make_unique<CompoundStmt>();
+        for (uint32_t iChild = 0; iChild < nbChildren; ++iChild)
+            cStmt->AddStatement(std::move(children[iChild]));
+        node = std::move(cStmt);
+        break;
+    }
+    case ASTNode::NodeKind::IF_STMT:
+        node = std::make_unique<IfStmt>(TakeAs<Expr>(children[0]), TakeAs<CompoundStmt>(children[1]), srcLoc);
+        break;
+    case ASTNode::NodeKind::PRINT_STMT:
+    {
+        auto pStmt = std::make_unique<PrintStmt>(srcLoc);
+        if (nbChildren == 1)
+            pStmt->AddMessage(TakeAs<Expr>(children[0]));
+        node = std::move(pStmt);
+        break;
+    }
+    case ASTNode::NodeKind::RETURN_STMT:
+    {
+        auto rStmt = std::make_unique<ReturnStmt>(srcLoc);
+        if (nbChildren == 1)
+            rStmt->AddReturnValue(TakeAs<Expr>(children[0]));
+        node = std::move(rStmt);
+        break;
+    }
+    case ASTNode::NodeKind::SCAN_STMT:
+        node = std::make_unique<ScanStmt>(TakeAs<IdentifierExpr>(children[0]), srcLoc);
+        break;
+    case ASTNode::NodeKind::SLEEP_STMT:
+        node = std::make_unique<SleepStmt>(TakeAs<Expr>(children[0]), srcLoc);
+        break;
+    case ASTNode::NodeKind::SYNC_STMT:
+        node = std::make_unique<SyncStmt>(srcLoc);
+        break;
+    case ASTNode::NodeKind::WHILE_STMT:
+        node = std::make_unique<WhileStmt>(TakeAs<Expr>(children[0]), TakeAs<CompoundStmt>(children[1]), srcLoc);
+        break;
+    default:
+        break;
+    }
+
+    mPendingNodes.resize(record.mFirstChildIdx);
+    mPendingNodes.push_back(std::move(node));
+    return true;
+}
@@ -0,0 +1,114 @@
+#ifndef AST_BINARY_H__TOSLANG
+#define AST_BINARY_H__TOSLANG
+
+#include "../AST/ast.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace TosLang
+{
+    namespace Utils
+    {
+        /*
+        * Binary AST format
+        *
+        * Header        "TOSA", format version, number of strings, number of nodes
+        * String table  For each string: its length followed by its characters
+        * Nodes         Pre-order sequence of node records. A record holds the node kind, its source location,
+        *               its number of children and the operands of its kind (names are string table indices):
+        *                   FunctionDecl    name, return type
+        *                   VarDecl         name, type, size, is a function parameter
+        *                   BinaryOpExpr    operation
+        *                   BooleanExpr     value
+        *                   CallExpr        name
+        *                   IdentifierExpr  name, type
+        *                   NumberExpr      value
+        *                   StringExpr      name
+        *
+        * Every field is a 32 bits little endian integer, so that a record can be decoded without branching on its content.
+        */
+
+        /*
+        * \class ASTBinaryWriter
+        * \brief Utility class to store an AST in the binary AST format. Trees holding ERROR nodes, or missing
+        *        nodes, can't be stored. They come from programs with syntax errors.
+        */
+        class ASTBinaryWriter
+        {
+        public:
+            ASTBinaryWriter() : mNbNodes{ 0 } { }
+
+        public:
+            bool Run(const std::unique_ptr<FrontEnd::ASTNode>& root, const std::string& filename);
+            bool Serialize(const std::unique_ptr<FrontEnd::ASTNode>& root, std::string& buffer);
+
+        private:
+            bool WriteNodes(const FrontEnd::ASTNode* root);
+            void WriteNode(const FrontEnd::ASTNode* node);
+            uint32_t GetStringIdx(const std::string& str);
+
+        private:
+            std::string mNodes;                                     /*!< Node records written so far */
+            std::vector<const FrontEnd::ASTNode*> mNodesToWrite;    /*!< Nodes whose record remains to be written, the next one last */
+            std::vector<const std::string*> mStrings;               /*!< String table */
+            std::unordered_map<std::string, uint32_t> mStringIdx;   /*!< Index of each string of the string table */
+            uint32_t mNbNodes;                                      /*!< Number of node records written so far */
+        };
+
+        /*
+        * \class ASTBinaryReader
+        * \brief Utility class to create an AST from the contents of a binary AST file.
+        *        The file is memory mapped when the platform supports it.
+        */
+        class ASTBinaryReader
+        {
+        public:
+            ASTBinaryReader() : mDataIt{ nullptr }, mDataEnd{ nullptr }, mHasFailed{ false }, mNbNodesLeft{ 0 } { }
+
+        public:
+            std::unique_ptr<FrontEnd::ASTNode> Run(const std::string& filename);
+            std::unique_ptr<FrontEnd::ASTNode> Run(const char* data, size_t size);
+
+        private:
+            /*
+            * \struct   NodeRecord
+            * \brief    Record of a node whose children are being read
+            */
+            struct NodeRecord
+            {
+                FrontEnd::ASTNode::NodeKind mKind;
+                SourceLocation mSrcLoc;
+                uint32_t mNbChildren;
+                Common::InternedString mName;
+                std::string_view mLiteral;  /*!< Content of a string literal, pointing into the binary AST */
+                uint32_t mOperands[3];      /*!< Operands of the node kind. The unused ones are zeroed. */
+                size_t mFirstChildIdx;      /*!< Position of the first child of the node in the pending nodes */
+            };
+
+        private:
+            bool ReadNode();
+            bool ReadRecord();
+            bool CreateNode(const NodeRecord& record);
+            uint32_t ReadInt();
+            Common::InternedString ReadString();
+            std::string_view ReadLiteral();
+
+        private:
+            const char* mDataIt;                                            /*!< Next byte to be read */
+            const char* mDataEnd;                                           /*!< End of the binary AST */
+            bool mHasFailed;                                                /*!< Did the reader hit a malformed record? */
+            uint32_t mNbNodesLeft;                                          /*!< Number of node records that remain to be read */
+            std::vector<std::string_view> mStrings;                         /*!< String table, pointing into the binary AST */
+            std::vector<Common::InternedString> mNames;                     /*!< Strings of the table interned so far, the others being empty */
+            std::vector<std::unique_ptr<FrontEnd::ASTNode>> mPendingNodes;  /*!< Nodes read but not yet given to their parent */
+            std::vector<NodeRecord> mOpenRecords;                           /*!< Records of the nodes on the path to the next record, the innermost last */
+        };
+    }
+}
+
+#endif // AST_BINARY_H__TOSLANG
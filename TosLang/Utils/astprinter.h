@@ -21,11 +21,7 @@ namespace TosLang
             friend class Common::ASTVisitor<ASTPrinter<OS>>;
 
         public:
-            explicit ASTPrinter(OS& stream) : mCurrentLevel{ 0 }, mStream(stream)
-            {
-                this->mPrologueFtr = [this]() { ++mCurrentLevel; };
-                this->mEpilogueFtr = [this]() { --mCurrentLevel; };
-            }
+            explicit ASTPrinter(OS& stream) : mCurrentLevel{ 0 }, mStream(stream) { }
             
             ~ASTPrinter() = default;
 
@@ -40,6 +36,19 @@ namespace TosLang
                 this->VisitPreOrder(root);
             }
 
+        protected:  // Traversal hooks
+            /*
+            * \fn       NodePrologue
+            * \brief    Increases the indentation of the printed nodes
+            */
+            void NodePrologue() { ++mCurrentLevel; }
+
+            /*
+            * \fn       NodeEpilogue
+            * \brief    Decreases the indentation of the printed nodes
+            */
+            void NodeEpilogue() { --mCurrentLevel; }
+
         protected:  // Declarations
             /*
             * \fn       HandleProgramDecl
@@ -189,7 +198,7 @@ namespace TosLang
                 assert(sExpr != nullptr);
 
                 Indent();
-                mStream << "StringExpr: " << "\"" << sExpr->GetName() << "\"" << " ";
+                mStream << "StringExpr: " << "\"" << sExpr->GetValue() << "\"" << " ";
                 PrintSourceLocation(sExpr->GetSourceLocation());
             }
 
@@ -58,7 +58,7 @@ std::unique_ptr<ASTNode> ASTReader::Run(const std::string& filename)
     if (!mStream.is_open())
         return nullptr;
 
-    std::getline(mStream, mCurrentLine);
+    ReadNextLine();
 
     // AST file must start with a ProgramDecl node
     if (!std::regex_match(mCurrentLine, mNodeKindRegexes[ASTNode::NodeKind::PROGRAM_DECL]))
@@ -68,7 +68,7 @@ std::unique_ptr<ASTNode> ASTReader::Run(const std::string& filename)
     }
 
     auto astRoot = std::make_unique<ProgramDecl>();
-    std::getline(mStream, mCurrentLine);
+    ReadNextLine();
     
     while (!mStream.eof())
     {
@@ -80,6 +80,10 @@ std::unique_ptr<ASTNode> ASTReader::Run(const std::string& filename)
             mStream.close();
     }
 
+    // The reader can be run again on another file
+    if (mStream.is_open())
+        mStream.close();
+
     return std::move(astRoot);
 }
 
@@ -97,6 +101,18 @@ const SourceLocation ASTReader::ReadSourceLocation()
     return SourceLocation{};
 }
 
+/*
+* \fn       ReadNextLine
+* \brief    Reads the next line of the .ast file. The line ending is stripped so that 
+*           files written with Windows line endings are read the same way as the others.
+*/
+void ASTReader::ReadNextLine()
+{
+    std::getline(mStream, mCurrentLine);
+    if (!mCurrentLine.empty() && (mCurrentLine.back() == '\r'))
+        mCurrentLine.pop_back();
+}
+
 //////////////////// Declarations ////////////////////
 
 std::unique_ptr<FunctionDecl> ASTReader::ReadFuncDecl()
@@ -110,7 +126,7 @@ std::unique_ptr<FunctionDecl> ASTReader::ReadFuncDecl()
 
     // Read the parameters
     auto params = std::make_unique<ParamVarDecls>();
-    std::getline(mStream, mCurrentLine);
+    ReadNextLine();
     while(std::regex_match(mCurrentLine, mCurrentMatch, mNodeKindRegexes[ASTNode::NodeKind::PARAM_VAR_DECL]))
         params->AddParameter(ReadVarDecl(/*isFuncParam=*/true));
     
@@ -137,7 +153,7 @@ std::unique_ptr<VarDecl> ASTReader::ReadVarDecl(const bool isFuncParam)
 
     // Add an initialization expression if needed
     const size_t oldIndent = std::count(mCurrentLine.begin(), mCurrentLine.end(), '\t');
-    std::getline(mStream, mCurrentLine);
+    ReadNextLine();
     const size_t newIndent = std::count(mCurrentLine.begin(), mCurrentLine.end(), '\t');
     if (oldIndent < newIndent)
         vDecl->AddInitialization(ReadExpr());
@@ -154,7 +170,7 @@ std::unique_ptr<Expr> ASTReader::ReadExpr()
 
     if (std::regex_match(mCurrentLine, mCurrentMatch, mNodeKindRegexes[ASTNode::NodeKind::ARRAY_EXPR]))
     {
-        std::getline(mStream, mCurrentLine);
+        ReadNextLine();
      
         const size_t arrayElemsIndent = std::count(mCurrentLine.begin(), mCurrentLine.end(), '\t');
         size_t newIndent = std::count(mCurrentLine.begin(), mCurrentLine.end(), '\t');
@@ -173,7 +189,7 @@ std::unique_ptr<Expr> ASTReader::ReadExpr()
     {
         const std::string binOpStr = mCurrentMatch[1].str();
     
-        std::getline(mStream, mCurrentLine);
+        ReadNextLine();
         
         auto lhs = ReadExpr();
         auto rhs = ReadExpr();
@@ -183,7 +199,7 @@ std::unique_ptr<Expr> ASTReader::ReadExpr()
     else if (std::regex_match(mCurrentLine, mCurrentMatch, mNodeKindRegexes[ASTNode::NodeKind::BOOLEAN_EXPR]))
     {      
         const std::string boolStr = mCurrentMatch[1].str();
-        std::getline(mStream, mCurrentLine);
+        ReadNextLine();
         return std::make_unique<BooleanExpr>(boolStr == "True", srcLoc);
     }
     else if (std::regex_match(mCurrentLine, mCurrentMatch, mNodeKindRegexes[ASTNode::NodeKind::CALL_EXPR]))
@@ -192,7 +208,7 @@ std::unique_ptr<Expr> ASTReader::ReadExpr()
 
         const size_t callIndentLevel = std::count(mCurrentLine.begin(), mCurrentLine.end(), '\t');
         
-        std::getline(mStream, mCurrentLine);
+        ReadNextLine();
         size_t currentIndentLevel = std::count(mCurrentLine.begin(), mCurrentLine.end(), '\t');
         
         std::vector<std::unique_ptr<Expr>> args;
@@ -208,24 +224,24 @@ std::unique_ptr<Expr> ASTReader::ReadExpr()
     else if (std::regex_match(mCurrentLine, mCurrentMatch, mNodeKindRegexes[ASTNode::NodeKind::IDENTIFIER_EXPR]))
     {
         const std::string identifierStr = mCurrentMatch[1].str();
-        std::getline(mStream, mCurrentLine);
+        ReadNextLine();
         return std::make_unique<IdentifierExpr>(identifierStr, srcLoc);
     }
     else if (std::regex_match(mCurrentLine, mCurrentMatch, mNodeKindRegexes[ASTNode::NodeKind::NUMBER_EXPR]))
     {
         const std::string numberStr = mCurrentMatch[1].str();
-        std::getline(mStream, mCurrentLine);
+        ReadNextLine();
         return std::make_unique<NumberExpr>(std::stoi(numberStr), srcLoc);
     }
     else if (std::regex_match(mCurrentLine, mCurrentMatch, mNodeKindRegexes[ASTNode::NodeKind::STRING_EXPR]))
     {
         const std::string str = mCurrentMatch[1].str();
-        std::getline(mStream, mCurrentLine);
+        ReadNextLine();
         return std::make_unique<StringExpr>(str, srcLoc);
     }
     else
     {
-        std::getline(mStream, mCurrentLine);
+        ReadNextLine();
         return std::make_unique<Expr>(ASTNode::NodeKind::ERROR);
     }
 }
@@ -237,7 +253,7 @@ std::unique_ptr<CompoundStmt> ASTReader::ReadCompoundStmt()
     auto cStmt = std::make_unique<CompoundStmt>();
 
     const size_t topIndentLevel = std::count(mCurrentLine.begin(), mCurrentLine.end(), '\t');
-    std::getline(mStream, mCurrentLine);
+    ReadNextLine();
     size_t currentIndentLevel = std::count(mCurrentLine.begin(), mCurrentLine.end(), '\t');
 
     ASTNode::NodeKind stmtKinds[] = { 
@@ -272,7 +288,7 @@ std::unique_ptr<Stmt> ASTReader::ReadStmt()
     }
     else if (std::regex_match(mCurrentLine, mCurrentMatch, mNodeKindRegexes[ASTNode::NodeKind::IF_STMT]))
     {
-        std::getline(mStream, mCurrentLine);
+        ReadNextLine();
         auto condExpr = ReadExpr();
         auto body = ReadCompoundStmt();
         return std::make_unique<IfStmt>(std::move(condExpr), std::move(body), srcLoc);
@@ -282,7 +298,7 @@ std::unique_ptr<Stmt> ASTReader::ReadStmt()
         auto pStmt = std::make_unique<PrintStmt>(srcLoc);
 
         const size_t returnIndentLevel = std::count(mCurrentLine.begin(), mCurrentLine.end(), '\t');
-        std::getline(mStream, mCurrentLine);
+        ReadNextLine();
         const size_t nextIndentLevel = std::count(mCurrentLine.begin(), mCurrentLine.end(), '\t');
 
         if (returnIndentLevel < nextIndentLevel)
@@ -295,7 +311,7 @@ std::unique_ptr<Stmt> ASTReader::ReadStmt()
         auto rStmt = std::make_unique<ReturnStmt>(srcLoc);
 
         const size_t returnIndentLevel = std::count(mCurrentLine.begin(), mCurrentLine.end(), '\t');
-        std::getline(mStream, mCurrentLine);
+        ReadNextLine();
         const size_t nextIndentLevel = std::count(mCurrentLine.begin(), mCurrentLine.end(), '\t');
 
         if (returnIndentLevel < nextIndentLevel)
@@ -307,18 +323,18 @@ std::unique_ptr<Stmt> ASTReader::ReadStmt()
     {
         auto expr = ReadExpr();
         assert(expr->GetKind() == ASTNode::NodeKind::IDENTIFIER_EXPR);
-        return std::make_unique<ScanStmt>(std::make_unique<IdentifierExpr>(expr->GetName(), expr->GetSourceLocation()), srcLoc);
+        return std::make_unique<ScanStmt>(std::make_unique<IdentifierExpr>(expr->GetNameID(), expr->GetSourceLocation()), srcLoc);
     }
     else if (std::regex_match(mCurrentLine, mCurrentMatch, mNodeKindRegexes[ASTNode::NodeKind::WHILE_STMT]))
     {
-        std::getline(mStream, mCurrentLine);
+        ReadNextLine();
         auto condExpr = ReadExpr();
         auto body = ReadCompoundStmt();
         return std::make_unique<WhileStmt>(std::move(condExpr), std::move(body), srcLoc);
     }
     else
     {
-        std::getline(mStream, mCurrentLine);
+        ReadNextLine();
         return std::make_unique<Stmt>(ASTNode::NodeKind::ERROR);
     }
 }
@@ -46,6 +46,7 @@ namespace TosLang
 
         private:
             const SourceLocation ReadSourceLocation();
+            void ReadNextLine();
 
         private:
             // Declarations
@@ -6,6 +6,17 @@
 
 using namespace TosLang::Utils;
 
+namespace
+{
+    // Stream receiving the errors of the current thread. Nullptr for the standard error stream.
+    thread_local std::ostream* tErrorStream = nullptr;
+
+    std::ostream& GetErrorStream()
+    {
+        return tErrorStream != nullptr ? *tErrorStream : std::cerr;
+    }
+}
+
 std::unordered_map<ErrorLogger::ErrorType, std::string, ErrorLogger::ErrorTypeHash> ErrorLogger::mErrorMessages =
 {
 
@@ -23,6 +34,10 @@ std::unordered_map<ErrorLogger::ErrorType, std::string, ErrorLogger::ErrorTypeHa
     { ErrorType::MISSING_RHS,                   "ERROR: Missing right hand side in binary expression" },
     { ErrorType::WRONG_OPERATION,               "ERROR: Not an acceptable binary operation" },
     { ErrorType::WRONG_USE_OPERATION,           "ERROR: Not an acceptable use of a binary operation" },
+
+    // Bytecode
+    { ErrorType::BYTECODE_TOO_MANY_FUNCTIONS,   "BYTECODE ERROR: Too many functions to be called by the virtual machine" },
+    { ErrorType::BYTECODE_TOO_MANY_REGISTERS,   "BYTECODE ERROR: Function needs too many registers" },
     
     // Call
     { ErrorType::CALL_MISSING_PAREN,            "CALL ERROR: Function call is missing a closing parenthesis" },
@@ -42,6 +57,7 @@ std::unordered_map<ErrorLogger::ErrorType, std::string, ErrorLogger::ErrorTypeHa
     { ErrorType::FN_MISSING_TYPE,               "FUNCTION ERROR: Missing type from function declaration" },
     { ErrorType::FN_MISSING_IDENTIFIER,         "FUNCTION ERROR: The fn keyword should be followed by an identifier" },
     { ErrorType::FN_MISSING_LEFT_PAREN,         "FUNCTION ERROR: Missing left parenthesis in the function declaration" },
+    { ErrorType::FN_MISSING_MAIN,               "FUNCTION ERROR: Missing main function" },
     { ErrorType::FN_MISSING_RIGHT_PAREN,        "FUNCTION ERROR: Missing right parenthesis in the function declaration" },
     { ErrorType::FN_MISSING_RETURN,             "FUNCTION ERROR: Missing return statement" },
     { ErrorType::FN_MISSING_RETURN_TYPE,        "FUNCTION ERROR: Missing return type" },
@@ -61,6 +77,7 @@ std::unordered_map<ErrorLogger::ErrorType, std::string, ErrorLogger::ErrorTypeHa
     { ErrorType::NEW_LINE_IN_LITERAL,           "LITERAL ERROR: Newline in string literal" },
     { ErrorType::MISSING_CLOSING_QUOTE,         "LITERAL ERROR: Missing closing quote" },
     { ErrorType::NUMBER_BAD_SUFFIX,             "LITERAL ERROR: Bad suffix on number" },
+    { ErrorType::NUMBER_OUT_OF_RANGE,           "LITERAL ERROR: Number is too big" },
 
     // Misc
     { ErrorType::EXPECTED_DECL,                 "ERROR: Expected a declaration" },
@@ -72,6 +89,11 @@ std::unordered_map<ErrorLogger::ErrorType, std::string, ErrorLogger::ErrorTypeHa
     { ErrorType::PARAM_MISSING_NAME,            "PARAM ERROR: Expected parameter name" },
     { ErrorType::PARAM_MISSING_TYPE,            "PARAM ERROR: Expected parameter type" },
     
+    // Runtime
+    { ErrorType::RUNTIME_DIVISION_BY_ZERO,      "RUNTIME ERROR: Division by zero" },
+    { ErrorType::RUNTIME_INDEX_OUT_OF_BOUNDS,   "RUNTIME ERROR: Array index out of bounds" },
+    { ErrorType::RUNTIME_STACK_OVERFLOW,        "RUNTIME ERROR: Call stack overflow" },
+
     // Syntax
     { ErrorType::SYNTAX_MISSING_LBRACE,         "SYNTAX ERROR: Expected '{'" },
     { ErrorType::SYNTAX_MISSING_RBRACE,         "SYNTAX ERROR: Expected '}'" },
@@ -107,7 +129,7 @@ std::unordered_map<ErrorLogger::ErrorType, std::string, ErrorLogger::ErrorTypeHa
 */
 void ErrorLogger::PrintError(ErrorType eType)
 {
-    std::cerr << mErrorMessages[eType] << std::endl;
+    GetErrorStream() << mErrorMessages.at(eType) << std::endl;
 }
 
 /*
@@ -118,5 +140,25 @@ void ErrorLogger::PrintError(ErrorType eType)
 */
 void ErrorLogger::PrintErrorAtLocation(ErrorType eType, const SourceLocation& srcLoc)
 {
-    std::cerr << mErrorMessages[eType] << " at line " << srcLoc.GetCurrentLine() << ", column " << srcLoc.GetCurrentColumn() << std::endl;
+    GetErrorStream() << mErrorMessages.at(eType) << " at line " << srcLoc.GetCurrentLine() << ", column " << srcLoc.GetCurrentColumn() << std::endl;
+}
+
+/*
+* \fn           PrintCapturedErrors
+* \param errors Errors previously captured by an ErrorLogger::Capture
+* \brief        Logs errors that were captured, as they would have been logged without the capture
+*/
+void ErrorLogger::PrintCapturedErrors(const std::string& errors)
+{
+    GetErrorStream() << errors;
+}
+
+ErrorLogger::Capture::Capture() : mPreviousStream{ tErrorStream }
+{
+    tErrorStream = &mErrors;
+}
+
+ErrorLogger::Capture::~Capture()
+{
+    tErrorStream = mPreviousStream;
 }
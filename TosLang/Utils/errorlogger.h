@@ -1,6 +1,7 @@
 #ifndef ERROR_LOGGER_H__TOSLANG
 #define ERROR_LOGGER_H__TOSLANG
 
+#include <sstream>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
@@ -39,6 +40,10 @@ namespace TosLang
                 WRONG_OPERATION,
                 WRONG_USE_OPERATION,
 
+                // Bytecode
+                BYTECODE_TOO_MANY_FUNCTIONS,
+                BYTECODE_TOO_MANY_REGISTERS,
+
                 // Call
                 CALL_ARG_ERROR,
                 CALL_MISSING_PAREN,
@@ -56,6 +61,7 @@ namespace TosLang
                 FN_MISSING_TYPE,
                 FN_MISSING_IDENTIFIER,
                 FN_MISSING_LEFT_PAREN,
+                FN_MISSING_MAIN,
                 FN_MISSING_RIGHT_PAREN,
                 FN_MISSING_RETURN,
                 FN_MISSING_RETURN_TYPE,
@@ -75,12 +81,18 @@ namespace TosLang
                 NEW_LINE_IN_LITERAL,
                 MISSING_CLOSING_QUOTE,
                 NUMBER_BAD_SUFFIX,
+                NUMBER_OUT_OF_RANGE,
 
                 // Param
                 PARAM_MISSING_NAME,
                 PARAM_MISSING_COLON,
                 PARAM_MISSING_TYPE,
 
+                // Runtime
+                RUNTIME_DIVISION_BY_ZERO,
+                RUNTIME_INDEX_OUT_OF_BOUNDS,
+                RUNTIME_STACK_OVERFLOW,
+
                 // Syntax
                 SYNTAX_MISSING_LBRACE,
                 SYNTAX_MISSING_RBRACE,
@@ -134,9 +146,39 @@ namespace TosLang
             ErrorLogger& operator=(const ErrorLogger&) = delete;
             ~ErrorLogger() = default;
 
+        public:
+            /*
+            * \class Capture
+            * \brief Diverts the errors logged by the current thread into a buffer for its lifetime.
+            *        Work spread across threads captures its errors so that they can be reported in a
+            *        deterministic order.
+            */
+            class Capture
+            {
+            public:
+                Capture();
+                ~Capture();
+
+                Capture(const Capture&) = delete;
+                Capture& operator=(const Capture&) = delete;
+
+            public:
+                /*
+                * \fn       GetErrors
+                * \brief    Gets the errors captured so far
+                * \return   Captured errors, one per line
+                */
+                std::string GetErrors() const { return mErrors.str(); }
+
+            private:
+                std::ostringstream mErrors;     /*!< Errors logged by the thread */
+                std::ostream* mPreviousStream;  /*!< Stream errors were logged to before the capture */
+            };
+
         public:
             static void PrintError(ErrorType eType);
             static void PrintErrorAtLocation(ErrorType eType, const SourceLocation& srcLoc);
+            static void PrintCapturedErrors(const std::string& errors);
 
         private:
             ErrorLogger() = default;
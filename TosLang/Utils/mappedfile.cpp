@@ -0,0 +1,81 @@
+#include "mappedfile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#   define TOSLANG_HAS_MMAP 1
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#else
+#   define TOSLANG_HAS_MMAP 0
+#endif
+
+using namespace TosLang::Utils;
+
+bool MappedFile::IsSupported()
+{
+    return TOSLANG_HAS_MMAP != 0;
+}
+
+/*
+* \fn               Open
+* \brief            Maps a whole file in memory. Any previously mapped file is unmapped.
+* \param filename   Name of the file to map
+* \return           Has the mapping been successful?
+*/
+bool MappedFile::Open(const std::string& filename)
+{
+    Close();
+
+#if TOSLANG_HAS_MMAP
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat fileStat;
+    if ((fstat(fd, &fileStat) != 0) || !S_ISREG(fileStat.st_mode))
+    {
+        close(fd);
+        return false;
+    }
+
+    // An empty file can't be mapped, but there is nothing to read anyway
+    if (fileStat.st_size > 0)
+    {
+        void* mapping = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            close(fd);
+            return false;
+        }
+
+        // The file will be read once, from start to finish
+        madvise(mapping, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+
+        mData = static_cast<const char*>(mapping);
+        mSize = static_cast<size_t>(fileStat.st_size);
+    }
+
+    // The mapping stays valid once the file is closed
+    close(fd);
+    return true;
+#else
+    (void)filename;
+    return false;
+#endif
+}
+
+/*
+* \fn       Close
+* \brief    Unmaps the file
+*/
+void MappedFile::Close()
+{
+#if TOSLANG_HAS_MMAP
+    if (mData != nullptr)
+        munmap(const_cast<char*>(mData), mSize);
+#endif
+
+    mData = nullptr;
+    mSize = 0;
+}
@@ -0,0 +1,57 @@
+#ifndef MAPPED_FILE_H__TOSLANG
+#define MAPPED_FILE_H__TOSLANG
+
+#include <cstddef>
+#include <string>
+
+namespace TosLang
+{
+    namespace Utils
+    {
+        /*
+        * \class MappedFile
+        * \brief Read-only view of a whole file mapped in memory. The content of the file
+        *        is paged in by the operating system as it is accessed instead of being copied.
+        */
+        class MappedFile
+        {
+        public:
+            MappedFile() : mData{ nullptr }, mSize{ 0 } { }
+            ~MappedFile() { Close(); }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+        public:
+            /*
+            * \fn       IsSupported
+            * \brief    Indicates if files can be memory mapped on this platform
+            * \return   True if memory mapping is available
+            */
+            static bool IsSupported();
+
+            bool Open(const std::string& filename);
+            void Close();
+
+            /*
+            * \fn       GetData
+            * \brief    Gives the content of the file. Empty files have no content (nullptr).
+            * \return   Pointer to the first byte of the file
+            */
+            const char* GetData() const { return mData; }
+
+            /*
+            * \fn       GetSize
+            * \brief    Gives the size of the file
+            * \return   Size of the file in bytes
+            */
+            size_t GetSize() const { return mSize; }
+
+        private:
+            const char* mData;  /*!< Start of the mapping */
+            size_t mSize;       /*!< Size of the mapping */
+        };
+    }
+}
+
+#endif // MAPPED_FILE_H__TOSLANG
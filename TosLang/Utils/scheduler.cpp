@@ -0,0 +1,173 @@
+#include "scheduler.h"
+
+#include <cassert>
+
+using namespace TosLang::Utils;
+
+namespace
+{
+    // Identifies the scheduler, and the queue within it, owned by the current thread
+    thread_local const Scheduler* tCurrentScheduler = nullptr;
+    thread_local size_t tCurrentQueueIdx = 0;
+}
+
+Scheduler::Scheduler(size_t nbWorkers) : mNbQueuedTasks{ 0 }, mNbIdleWorkers{ 0 }, mStopping{ false }
+{
+    assert(nbWorkers > 0);
+
+    // The queues must all exist before any worker starts stealing from them
+    for (size_t iQueue = 0; iQueue <= nbWorkers; ++iQueue)
+        mQueues.emplace_back(std::make_unique<WorkQueue>());
+
+    for (size_t iWorker = 0; iWorker < nbWorkers; ++iWorker)
+        mWorkers.emplace_back(&Scheduler::WorkerLoop, this, iWorker);
+}
+
+Scheduler::~Scheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock{ mIdleMutex };
+        mStopping = true;
+    }
+    mIdleCV.notify_all();
+
+    for (auto& worker : mWorkers)
+        worker.join();
+}
+
+size_t Scheduler::GetDefaultNbWorkers()
+{
+    const size_t nbCores = std::thread::hardware_concurrency();
+    return nbCores != 0 ? nbCores : 1;
+}
+
+void Scheduler::Submit(Task* task)
+{
+    assert(task != nullptr);
+
+    WorkQueue& queue = *mQueues[GetCurrentQueueIdx()];
+    {
+        std::lock_guard<std::mutex> lock{ queue.mMutex };
+        queue.mTasks.push_back(task);
+    }
+    ++mNbQueuedTasks;
+
+    // A worker going to sleep declares itself idle before checking for tasks, so either it sees the new task or
+    // the task submitter sees it idle. Taking the idle mutex then guarantees that the notification isn't lost.
+    if (mNbIdleWorkers > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock{ mIdleMutex };
+        }
+        mIdleCV.notify_one();
+    }
+}
+
+bool Scheduler::TryRunTask()
+{
+    const size_t queueIdx = GetCurrentQueueIdx();
+
+    Task* task = PopTask(queueIdx);
+    if (task == nullptr)
+        task = StealTask(queueIdx);
+
+    if (task == nullptr)
+        return false;
+
+    --mNbQueuedTasks;
+    task->Run();
+    return true;
+}
+
+void Scheduler::ParallelFor(size_t nbTasks, const std::function<void(size_t)>& fn)
+{
+    // Spreading a single call gains nothing
+    if (nbTasks == 1)
+    {
+        fn(0);
+        return;
+    }
+
+    struct IndexedTask : public Task
+    {
+        void Run() override
+        {
+            (*mFn)(mIdx);
+            --(*mNbRemainingTasks);
+        }
+
+        const std::function<void(size_t)>* mFn;
+        size_t mIdx;
+        std::atomic<size_t>* mNbRemainingTasks;
+    };
+
+    std::atomic<size_t> nbRemainingTasks{ nbTasks };
+    std::vector<IndexedTask> tasks(nbTasks);
+    for (size_t iTask = 0; iTask < nbTasks; ++iTask)
+    {
+        tasks[iTask].mFn = &fn;
+        tasks[iTask].mIdx = iTask;
+        tasks[iTask].mNbRemainingTasks = &nbRemainingTasks;
+        Submit(&tasks[iTask]);
+    }
+
+    while (nbRemainingTasks > 0)
+    {
+        if (!TryRunTask())
+            std::this_thread::yield();
+    }
+}
+
+size_t Scheduler::GetCurrentQueueIdx() const
+{
+    // Threads that aren't workers of this scheduler all share the last queue
+    return tCurrentScheduler == this ? tCurrentQueueIdx : mWorkers.size();
+}
+
+Task* Scheduler::PopTask(size_t queueIdx)
+{
+    WorkQueue& queue = *mQueues[queueIdx];
+    std::lock_guard<std::mutex> lock{ queue.mMutex };
+    if (queue.mTasks.empty())
+        return nullptr;
+
+    Task* task = queue.mTasks.back();
+    queue.mTasks.pop_back();
+    return task;
+}
+
+Task* Scheduler::StealTask(size_t thiefIdx)
+{
+    // Victims are visited starting with the thief's neighbour so that thieves don't all target the same queue
+    const size_t nbQueues = mQueues.size();
+    for (size_t iVictim = 1; iVictim < nbQueues; ++iVictim)
+    {
+        WorkQueue& queue = *mQueues[(thiefIdx + iVictim) % nbQueues];
+        std::lock_guard<std::mutex> lock{ queue.mMutex };
+        if (!queue.mTasks.empty())
+        {
+            Task* task = queue.mTasks.front();
+            queue.mTasks.pop_front();
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+void Scheduler::WorkerLoop(size_t workerIdx)
+{
+    tCurrentScheduler = this;
+    tCurrentQueueIdx = workerIdx;
+
+    while (!mStopping)
+    {
+        if (TryRunTask())
+            continue;
+
+        std::unique_lock<std::mutex> lock{ mIdleMutex };
+        ++mNbIdleWorkers;
+        mIdleCV.wait(lock, [this]() { return mStopping || (mNbQueuedTasks > 0); });
+        --mNbIdleWorkers;
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef SCHEDULER_H__TOSLANG
+#define SCHEDULER_H__TOSLANG
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TosLang
+{
+    namespace Utils
+    {
+        /*
+        * \class Task
+        * \brief Unit of work executed by the scheduler
+        */
+        class Task
+        {
+        public:
+            virtual ~Task() = default;
+
+            /*
+            * \fn       Run
+            * \brief    Executes the task. Called exactly once, by whichever thread picked up the task.
+            */
+            virtual void Run() = 0;
+        };
+
+        /*
+        * \class Scheduler
+        * \brief Work stealing task scheduler. Every worker thread owns a deque of tasks: it pushes and pops
+        *        its own tasks at the back of the deque (most recent first, which keeps the working set hot)
+        *        while idle workers steal from the front of the other deques (oldest first, which usually
+        *        are the biggest pieces of work). Threads that aren't workers share an additional deque.
+        */
+        class Scheduler
+        {
+        public:
+            explicit Scheduler(size_t nbWorkers = GetDefaultNbWorkers());
+            ~Scheduler();
+
+            Scheduler(const Scheduler&) = delete;
+            Scheduler& operator=(const Scheduler&) = delete;
+
+        public:
+            /*
+            * \fn       GetDefaultNbWorkers
+            * \brief    Gets the number of workers needed to keep every core of the machine busy
+            * \return   Number of hardware threads (at least 1)
+            */
+            static size_t GetDefaultNbWorkers();
+
+            size_t GetNbWorkers() const { return mWorkers.size(); }
+
+            /*
+            * \fn           Submit
+            * \brief        Makes a task available to the workers. The task must outlive its execution.
+            * \param task   Task to execute
+            */
+            void Submit(Task* task);
+
+            /*
+            * \fn       TryRunTask
+            * \brief    Runs one pending task on the calling thread, if any. Threads waiting on other tasks
+            *           call this instead of blocking so that a wait never starves the scheduler of a thread.
+            * \return   True if a task was run
+            */
+            bool TryRunTask();
+
+            /*
+            * \fn           ParallelFor
+            * \brief        Runs a function once for every index in [0, nbTasks) and returns when every call is done.
+            *               The calling thread runs pending tasks while it waits.
+            * \param nbTasks Number of calls
+            * \param fn     Function to call with each index. Calls may run concurrently.
+            */
+            void ParallelFor(size_t nbTasks, const std::function<void(size_t)>& fn);
+
+        private:
+            /*
+            * \struct   WorkQueue
+            * \brief    Deque of tasks owned by a thread
+            */
+            struct WorkQueue
+            {
+                std::mutex mMutex;
+                std::deque<Task*> mTasks;
+            };
+
+            /*
+            * \fn       GetCurrentQueueIdx
+            * \brief    Gets the work queue owned by the calling thread
+            * \return   Index of the work queue
+            */
+            size_t GetCurrentQueueIdx() const;
+
+            Task* PopTask(size_t queueIdx);
+            Task* StealTask(size_t thiefIdx);
+            void WorkerLoop(size_t workerIdx);
+
+        private:
+            std::vector<std::unique_ptr<WorkQueue>> mQueues;    /*!< One queue per worker followed by the queue shared by other threads */
+            std::vector<std::thread> mWorkers;                  /*!< Worker threads */
+            std::atomic<size_t> mNbQueuedTasks;                 /*!< Number of tasks waiting in a queue */
+            std::atomic<size_t> mNbIdleWorkers;                 /*!< Number of workers sleeping until a task is submitted */
+            std::atomic<bool> mStopping;                        /*!< Tells the workers to exit */
+            std::mutex mIdleMutex;                              /*!< Protects the sleep of idle workers */
+            std::condition_variable mIdleCV;                    /*!< Wakes up idle workers when tasks are submitted */
+        };
+    }
+}
+
+#endif // SCHEDULER_H__TOSLANG
@@ -29,3 +29,20 @@ void SourceLocation::Advance(bool nextLine)
         ++mCurrentColumn;
     }
 }
+
+/*
+* \fn               Advance
+* \brief            Advances the SourceLocation over a whole span of the source file at once
+* \param nbLines    Number of new lines in the span
+* \param nbColumns  Number of columns in the span after its last new line
+*/
+void SourceLocation::Advance(unsigned nbLines, unsigned nbColumns)
+{
+    if (nbLines > 0)
+    {
+        mCurrentLine += nbLines;
+        mCurrentColumn = 1;
+    }
+
+    mCurrentColumn += nbColumns;
+}
@@ -29,6 +29,7 @@ namespace TosLang
         public:
             void Init();
             void Advance(bool nextLine = false);
+            void Advance(unsigned nbLines, unsigned nbColumns);
 
         public:
             /*
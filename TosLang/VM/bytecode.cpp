@@ -0,0 +1,98 @@
+#include "bytecode.h"
+
+#include <cassert>
+#include <iomanip>
+
+using namespace TosLang::VM;
+
+const char* TosLang::VM::GetOpCodeName(OpCode op)
+{
+    switch (op)
+    {
+    case OpCode::MOV:           return "MOV";
+    case OpCode::LOAD_INT:      return "LOAD_INT";
+    case OpCode::LOAD_STR:      return "LOAD_STR";
+    case OpCode::LOAD_GLOBAL:   return "LOAD_GLOBAL";
+    case OpCode::STORE_GLOBAL:  return "STORE_GLOBAL";
+    case OpCode::ADD:           return "ADD";
+    case OpCode::SUB:           return "SUB";
+    case OpCode::MUL:           return "MUL";
+    case OpCode::DIV:           return "DIV";
+    case OpCode::MOD:           return "MOD";
+    case OpCode::AND:           return "AND";
+    case OpCode::OR:            return "OR";
+    case OpCode::LSHIFT:        return "LSHIFT";
+    case OpCode::RSHIFT:        return "RSHIFT";
+    case OpCode::NOT:           return "NOT";
+    case OpCode::EQ:            return "EQ";
+    case OpCode::EQ_STR:        return "EQ_STR";
+    case OpCode::GT:            return "GT";
+    case OpCode::LT:            return "LT";
+    case OpCode::JMP:           return "JMP";
+    case OpCode::JMP_IF_FALSE:  return "JMP_IF_FALSE";
+    case OpCode::JMP_IF_TRUE:   return "JMP_IF_TRUE";
+    case OpCode::CALL:          return "CALL";
+    case OpCode::RET:           return "RET";
+    case OpCode::RET_VOID:      return "RET_VOID";
+    case OpCode::NEW_ARRAY:     return "NEW_ARRAY";
+    case OpCode::LOAD_ELEM:     return "LOAD_ELEM";
+    case OpCode::STORE_ELEM:    return "STORE_ELEM";
+    case OpCode::PRINT_BOOL:    return "PRINT_BOOL";
+    case OpCode::PRINT_INT:     return "PRINT_INT";
+    case OpCode::PRINT_STR:     return "PRINT_STR";
+    case OpCode::PRINT_NEWLINE: return "PRINT_NEWLINE";
+    case OpCode::SCAN_BOOL:     return "SCAN_BOOL";
+    case OpCode::SCAN_INT:      return "SCAN_INT";
+    case OpCode::SCAN_STR:      return "SCAN_STR";
+    case OpCode::SLEEP:         return "SLEEP";
+    case OpCode::SPAWN:         return "SPAWN";
+    case OpCode::SYNC:          return "SYNC";
+    default:
+        assert(false);
+        return "UNKNOWN";
+    }
+}
+
+/*
+* \fn           AddString
+* \brief        Adds a string constant to the module. Identical strings share the same index.
+* \param str    String constant
+* \return       Index of the string constant
+*/
+size_t BytecodeModule::AddString(const std::string& str)
+{
+    auto strIt = mStringIdx.find(str);
+    if (strIt != mStringIdx.end())
+        return strIt->second;
+
+    mStrings.push_back(str);
+    mStringIdx[str] = mStrings.size() - 1;
+
+    return mStrings.size() - 1;
+}
+
+/*
+* \fn           Print
+* \brief        Outputs a human readable version of the module
+* \param stream Stream to output the module to
+*/
+void BytecodeModule::Print(std::ostream& stream) const
+{
+    for (size_t iStr = 0; iStr < mStrings.size(); ++iStr)
+        stream << "str" << iStr << ": \"" << mStrings[iStr] << "\"" << std::endl;
+
+    for (size_t iFn = 0; iFn < mFunctions.size(); ++iFn)
+    {
+        const BytecodeFunction& fn = mFunctions[iFn];
+        stream << "fn" << iFn << " " << fn.GetName() << " (params: " << fn.GetNbParams()
+               << ", registers: " << fn.GetNbRegisters() << ")" << std::endl;
+
+        const std::vector<Instruction>& code = fn.GetCode();
+        for (size_t iInst = 0; iInst < code.size(); ++iInst)
+        {
+            const Instruction& inst = code[iInst];
+            stream << std::setw(6) << iInst << "  " << std::left << std::setw(14) << GetOpCodeName(inst.mOp) << std::right
+                   << inst.mA << " " << inst.mB << " " << inst.mC << std::endl;
+        }
+    }
+}
@@ -0,0 +1,206 @@
+#ifndef BYTECODE_H__TOSLANG
+#define BYTECODE_H__TOSLANG
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TosLang
+{
+    namespace VM
+    {
+        /*
+        * \brief    Every value manipulated by the virtual machine fits in a 64 bits register.
+        *           Booleans are stored as 0 or 1, strings and arrays are stored as handles.
+        */
+        using Value = int64_t;
+
+        /*
+        * \brief    Register operand indicating that the value produced by an instruction is not needed by anyone
+        */
+        const uint16_t NO_REGISTER = 0xFFFF;
+
+        /*
+        * \enum     OpCode
+        * \brief    Operations understood by the TosLang virtual machine.
+        *           Unless stated otherwise, A is the destination register and B and C are the source registers.
+        */
+        enum class OpCode : uint16_t
+        {
+            // Data movement
+            MOV,            // R[A] = R[B]
+            LOAD_INT,       // R[A] = Bx
+            LOAD_STR,       // R[A] = handle of the string constant Bx
+            LOAD_GLOBAL,    // R[A] = G[Bx]
+            STORE_GLOBAL,   // G[Bx] = R[A]
+
+            // Arithmetic and logic
+            ADD,
+            SUB,
+            MUL,
+            DIV,
+            MOD,
+            AND,
+            OR,
+            LSHIFT,
+            RSHIFT,
+            NOT,            // R[A] = !R[B]
+
+            // Comparisons
+            EQ,
+            EQ_STR,         // Compares the content of two strings
+            GT,
+            LT,
+
+            // Control flow
+            JMP,            // pc = Bx
+            JMP_IF_FALSE,   // if !R[A] then pc = Bx
+            JMP_IF_TRUE,    // if R[A] then pc = Bx
+            CALL,           // R[A] = F[B](R[C], ..., R[C + nbParams - 1])
+            RET,            // Returns R[A] to the caller
+            RET_VOID,       // Returns to the caller without a value
+
+            // Arrays
+            NEW_ARRAY,      // R[A] = handle of a new array of Bx elements
+            LOAD_ELEM,      // R[A] = R[B][R[C]]
+            STORE_ELEM,     // R[A][R[B]] = R[C]
+
+            // IO
+            PRINT_BOOL,     // Prints R[A] as a boolean followed by a newline
+            PRINT_INT,      // Prints R[A] as a number followed by a newline
+            PRINT_STR,      // Prints R[A] as a string followed by a newline
+            PRINT_NEWLINE,  // Prints a newline
+            SCAN_BOOL,      // R[A] = boolean read from the standard input
+            SCAN_INT,       // R[A] = number read from the standard input
+            SCAN_STR,       // R[A] = handle of a whitespace delimited word read from the standard input
+            SLEEP,          // Sleeps for R[A] milliseconds
+
+            // Threading
+            SPAWN,          // Same operands as CALL. R[A] (if A isn't NO_REGISTER) receives the result on the next SYNC
+            SYNC,           // Waits for every spawned call of the current function
+        };
+
+        /*
+        * \fn           GetOpCodeName
+        * \brief        Gets the mnemonic associated to an opcode
+        * \param op     Opcode
+        * \return       Mnemonic of the opcode
+        */
+        const char* GetOpCodeName(OpCode op);
+
+        /*
+        * \struct   Instruction
+        * \brief    Fixed-size (8 bytes) virtual machine instruction.
+        *           Instructions needing a large operand (constants, jump targets) use
+        *           the B and C operands as a single signed 32 bits operand called Bx.
+        */
+        struct Instruction
+        {
+            OpCode mOp;     /*!< Operation to perform */
+            uint16_t mA;    /*!< First operand */
+            uint16_t mB;    /*!< Second operand */
+            uint16_t mC;    /*!< Third operand */
+
+            /*
+            * \fn       GetBx
+            * \brief    Gets the large operand formed by the B and C operands
+            * \return   Signed 32 bits operand
+            */
+            int32_t GetBx() const { return static_cast<int32_t>(static_cast<uint32_t>(mB) | (static_cast<uint32_t>(mC) << 16)); }
+
+            /*
+            * \fn       SetBx
+            * \brief    Sets the large operand formed by the B and C operands
+            * \param bx Signed 32 bits operand
+            */
+            void SetBx(int32_t bx)
+            {
+                mB = static_cast<uint16_t>(static_cast<uint32_t>(bx) & 0xFFFF);
+                mC = static_cast<uint16_t>(static_cast<uint32_t>(bx) >> 16);
+            }
+
+            static Instruction MakeABC(OpCode op, uint16_t a, uint16_t b = 0, uint16_t c = 0) { return Instruction{ op, a, b, c }; }
+            static Instruction MakeABx(OpCode op, uint16_t a, int32_t bx) { Instruction inst{ op, a, 0, 0 }; inst.SetBx(bx); return inst; }
+        };
+
+        static_assert(sizeof(Instruction) == 8, "Instructions are expected to be 8 bytes wide");
+
+        /*
+        * \class BytecodeFunction
+        * \brief Sequence of instructions representing a TosLang function
+        */
+        class BytecodeFunction
+        {
+        public:
+            BytecodeFunction(const std::string& name, size_t nbParams) : mName{ name }, mNbParams{ nbParams }, mNbRegisters{ nbParams } { }
+
+        public:
+            /*
+            * \fn           AddInstruction
+            * \brief        Appends an instruction to the function
+            * \param inst   Instruction to append
+            * \return       Index of the instruction in the function
+            */
+            size_t AddInstruction(const Instruction& inst) { mCode.push_back(inst); return mCode.size() - 1; }
+
+            /*
+            * \fn           GetInstruction
+            * \brief        Gets an instruction of the function. Used to patch jump targets.
+            * \param idx    Index of the instruction
+            * \return       Instruction
+            */
+            Instruction& GetInstruction(size_t idx) { return mCode[idx]; }
+
+            const std::vector<Instruction>& GetCode() const { return mCode; }
+            const std::string& GetName() const { return mName; }
+            size_t GetNbParams() const { return mNbParams; }
+            size_t GetNbRegisters() const { return mNbRegisters; }
+            void SetNbRegisters(size_t nbRegisters) { mNbRegisters = nbRegisters; }
+
+        private:
+            std::string mName;                  /*!< Name of the function */
+            size_t mNbParams;                   /*!< Number of parameters. Parameters occupy the first registers of a frame */
+            size_t mNbRegisters;                /*!< Number of registers needed by a frame of this function */
+            std::vector<Instruction> mCode;     /*!< Instructions of the function */
+        };
+
+        /*
+        * \class BytecodeModule
+        * \brief Compiled TosLang program ready to be executed by the virtual machine
+        */
+        class BytecodeModule
+        {
+        public:
+            BytecodeModule() : mNbGlobals{ 0 }, mGlobalsInitIdx{ 0 }, mEntryIdx{ 0 } { }
+
+        public:
+            size_t AddFunction(BytecodeFunction&& fn) { mFunctions.emplace_back(std::move(fn)); return mFunctions.size() - 1; }
+            size_t AddGlobal() { return mNbGlobals++; }
+            size_t AddString(const std::string& str);
+
+            BytecodeFunction& GetFunction(size_t idx) { return mFunctions[idx]; }
+            const std::vector<BytecodeFunction>& GetFunctions() const { return mFunctions; }
+            size_t GetNbGlobals() const { return mNbGlobals; }
+            const std::vector<std::string>& GetStrings() const { return mStrings; }
+
+            size_t GetEntryIdx() const { return mEntryIdx; }
+            void SetEntryIdx(size_t idx) { mEntryIdx = idx; }
+            size_t GetGlobalsInitIdx() const { return mGlobalsInitIdx; }
+            void SetGlobalsInitIdx(size_t idx) { mGlobalsInitIdx = idx; }
+
+            void Print(std::ostream& stream) const;
+
+        private:
+            std::vector<BytecodeFunction> mFunctions;               /*!< Functions of the program */
+            std::vector<std::string> mStrings;                      /*!< String constants of the program */
+            std::unordered_map<std::string, size_t> mStringIdx;     /*!< Index of each string constant */
+            size_t mNbGlobals;                                      /*!< Number of global variables */
+            size_t mGlobalsInitIdx;                                 /*!< Function initializing the global variables */
+            size_t mEntryIdx;                                       /*!< Function called to start the program (main) */
+        };
+    }
+}
+
+#endif // BYTECODE_H__TOSLANG
@@ -0,0 +1,760 @@
+#include "bytecodegenerator.h"
+
+#include "../AST/declarations.h"
+#include "../AST/expressions.h"
+#include "../AST/statements.h"
+#include "../Sema/symboltable.h"
+#include "../Utils/errorlogger.h"
+
+#include <cassert>
+#include <limits>
+#include <utility>
+#include <vector>
+
+using namespace TosLang::Common;
+using namespace TosLang::FrontEnd;
+using namespace TosLang::Utils;
+using namespace TosLang::VM;
+
+/*
+* \fn               Run
+* \brief            Generates the bytecode of a whole program
+* \param root       Root of the program AST
+* \param symTable   Symbol table associated with the given AST
+* \return           Module containing the bytecode of every function of the program.
+*                   Nullptr if the program doesn't fit in the limits of the bytecode.
+*/
+std::unique_ptr<BytecodeModule> BytecodeGenerator::Run(const std::unique_ptr<ASTNode>& root, const std::shared_ptr<SymbolTable>& symTable)
+{
+    // Reset the state of the generator
+    mMod.reset(new BytecodeModule{});
+    mSymTable = symTable;
+    mFunctionIndexes.clear();
+    mGlobalSlots.clear();
+    mErrorCount = 0;
+
+    const ChildrenNodes& decls = root->GetChildrenNodes();
+
+    // Functions can be called before being declared, so every function gets
+    // its index in the module before any code is generated
+    mMod->SetGlobalsInitIdx(mMod->AddFunction(BytecodeFunction{ "$globals", 0 }));
+    for (auto& decl : decls)
+    {
+        if (decl->GetKind() != ASTNode::NodeKind::FUNCTION_DECL)
+            continue;
+
+        const FunctionDecl* fDecl = static_cast<const FunctionDecl*>(decl.get());
+        mFunctionIndexes[fDecl] = mMod->AddFunction(BytecodeFunction{ fDecl->GetFunctionName(), fDecl->GetParametersSize() });
+    }
+
+    // Global variables are initialized, in declaration order, by a dedicated function run before main
+    mCurrentFunction = &mMod->GetFunction(mMod->GetGlobalsInitIdx());
+    mLocalRegisters.clear();
+    mNextRegister = mMaxRegister = 0;
+    mFrameFull = false;
+    for (auto& decl : decls)
+    {
+        if (decl->GetKind() == ASTNode::NodeKind::VAR_DECL)
+            HandleGlobalVarDecl(static_cast<const VarDecl*>(decl.get()));
+    }
+    Emit(Instruction::MakeABC(OpCode::RET_VOID, 0));
+    mCurrentFunction->SetNbRegisters(mMaxRegister);
+
+    for (auto& decl : decls)
+    {
+        if (decl->GetKind() == ASTNode::NodeKind::FUNCTION_DECL)
+            HandleFunctionDecl(static_cast<const FunctionDecl*>(decl.get()));
+    }
+
+    mCurrentFunction = nullptr;
+    if (mErrorCount != 0)
+        return nullptr;
+
+    return std::move(mMod);
+}
+
+/*
+* \fn           GetFunctionIndex
+* \brief        Gets the index in the generated module of the function produced by a function declaration
+* \param fnDecl Function declaration
+* \return       Index of the function
+*/
+size_t BytecodeGenerator::GetFunctionIndex(const ASTNode* fnDecl) const
+{
+    auto fnIt = mFunctionIndexes.find(fnDecl);
+    assert(fnIt != mFunctionIndexes.end());
+    return fnIt->second;
+}
+
+// Declarations
+void BytecodeGenerator::HandleFunctionDecl(const FunctionDecl* fDecl)
+{
+    mCurrentFunction = &mMod->GetFunction(mFunctionIndexes.at(fDecl));
+    mLocalRegisters.clear();
+    mNextRegister = mMaxRegister = 0;
+    mFrameFull = false;
+
+    // Parameters occupy the first registers of the frame, in order
+    for (auto& param : fDecl->GetParametersDecl()->GetParameters())
+        mLocalRegisters[param.get()] = AllocateRegister();
+
+    HandleCompoundStmt(fDecl->GetBody());
+
+    // Falling off the end of a function (or jumping past its last return) returns to the caller
+    Emit(Instruction::MakeABC(OpCode::RET_VOID, 0));
+
+    mCurrentFunction->SetNbRegisters(mMaxRegister);
+}
+
+void BytecodeGenerator::HandleGlobalVarDecl(const VarDecl* vDecl)
+{
+    const size_t slot = mMod->AddGlobal();
+    mGlobalSlots[vDecl] = slot;
+
+    const uint16_t firstTemp = mNextRegister;
+    const uint16_t valueReg = AllocateRegister();
+    HandleVarInit(vDecl, valueReg);
+    Emit(Instruction::MakeABx(OpCode::STORE_GLOBAL, valueReg, static_cast<int32_t>(slot)));
+    mNextRegister = firstTemp;
+}
+
+void BytecodeGenerator::HandleLocalVarDecl(const VarDecl* vDecl)
+{
+    const uint16_t varReg = AllocateRegister();
+
+    const Expr* initExpr = vDecl->GetInitExpr();
+    if ((initExpr != nullptr) && (initExpr->GetKind() == ASTNode::NodeKind::SPAWN_EXPR))
+    {
+        // Until the sync, the variable holds 0
+        Emit(Instruction::MakeABx(OpCode::LOAD_INT, varReg, 0));
+        HandleSpawnToLocal(static_cast<const SpawnExpr*>(initExpr), varReg);
+    }
+    else
+    {
+        HandleVarInit(vDecl, varReg);
+    }
+
+    mLocalRegisters[vDecl] = varReg;
+}
+
+void BytecodeGenerator::HandleVarInit(const VarDecl* vDecl, uint16_t dest)
+{
+    const Expr* initExpr = vDecl->GetInitExpr();
+    if (initExpr != nullptr)
+        HandleExpr(initExpr, dest);
+    else if (vDecl->GetVarSize() != 0)
+        Emit(Instruction::MakeABx(OpCode::NEW_ARRAY, dest, vDecl->GetVarSize()));
+    else if (vDecl->GetVarType() == Type::STRING)
+        Emit(Instruction::MakeABx(OpCode::LOAD_STR, dest, static_cast<int32_t>(mMod->AddString(""))));
+    else
+        // Uninitialized variables start at 0 (or False) so that a program always behaves the same way
+        Emit(Instruction::MakeABx(OpCode::LOAD_INT, dest, 0));
+}
+
+// Expressions
+void BytecodeGenerator::HandleExpr(const Expr* expr, uint16_t dest)
+{
+    assert(expr != nullptr);
+
+    // Temporaries needed to evaluate the expression are released once it has been evaluated
+    const uint16_t firstTemp = mNextRegister;
+
+    switch (expr->GetKind())
+    {
+    case ASTNode::NodeKind::ARRAY_EXPR:
+        HandleArrayExpr(expr, dest);
+        break;
+    case ASTNode::NodeKind::BINARY_EXPR:
+    {
+        const BinaryOpExpr* bExpr = static_cast<const BinaryOpExpr*>(expr);
+        if (bExpr->GetOperation() == Operation::ASSIGNMENT)
+            HandleAssignment(bExpr, dest);
+        else
+            HandleBinaryExpr(bExpr, dest);
+    }
+        break;
+    case ASTNode::NodeKind::BOOLEAN_EXPR:
+        Emit(Instruction::MakeABx(OpCode::LOAD_INT, dest, static_cast<const BooleanExpr*>(expr)->GetValue() ? 1 : 0));
+        break;
+    case ASTNode::NodeKind::CALL_EXPR:
+        HandleCallExpr(static_cast<const CallExpr*>(expr), dest, OpCode::CALL);
+        break;
+    case ASTNode::NodeKind::IDENTIFIER_EXPR:
+    {
+        uint16_t varReg;
+        if (!GetVarRegister(expr, varReg))
+            Emit(Instruction::MakeABx(OpCode::LOAD_GLOBAL, dest, GetGlobalSlot(expr)));
+        else if (varReg != dest)
+            Emit(Instruction::MakeABC(OpCode::MOV, dest, varReg));
+    }
+        break;
+    case ASTNode::NodeKind::INDEX_EXPR:
+    {
+        const IndexedExpr* iExpr = static_cast<const IndexedExpr*>(expr);
+        const uint16_t arrayReg = HandleExprToRegister(iExpr->GetIdentifier());
+        const uint16_t indexReg = HandleExprToRegister(iExpr->GetIndex());
+        Emit(Instruction::MakeABC(OpCode::LOAD_ELEM, dest, arrayReg, indexReg));
+    }
+        break;
+    case ASTNode::NodeKind::NUMBER_EXPR:
+        Emit(Instruction::MakeABx(OpCode::LOAD_INT, dest, static_cast<const NumberExpr*>(expr)->GetValue()));
+        break;
+    case ASTNode::NodeKind::SPAWN_EXPR:
+        // The value is needed right away so there is nothing to gain from running the call concurrently
+        HandleCallExpr(static_cast<const SpawnExpr*>(expr)->GetCall(), dest, OpCode::CALL);
+        break;
+    case ASTNode::NodeKind::STRING_EXPR:
+        Emit(Instruction::MakeABx(OpCode::LOAD_STR, dest, static_cast<int32_t>(mMod->AddString(static_cast<const StringExpr*>(expr)->GetValue()))));
+        break;
+    default:
+        assert(false && "Unknown expression kind");
+        break;
+    }
+
+    mNextRegister = firstTemp;
+}
+
+uint16_t BytecodeGenerator::HandleExprToRegister(const Expr* expr)
+{
+    uint16_t reg;
+    if ((expr->GetKind() == ASTNode::NodeKind::IDENTIFIER_EXPR) && GetVarRegister(expr, reg))
+        return reg;
+
+    reg = AllocateRegister();
+    HandleExpr(expr, reg);
+    return reg;
+}
+
+void BytecodeGenerator::HandleArrayExpr(const Expr* expr, uint16_t dest)
+{
+    const ChildrenNodes& elems = expr->GetChildrenNodes();
+
+    // The array is built in a temporary so that its elements can refer to the previous value of dest
+    const uint16_t arrayReg = AllocateRegister();
+    Emit(Instruction::MakeABx(OpCode::NEW_ARRAY, arrayReg, static_cast<int32_t>(elems.size())));
+
+    const uint16_t indexReg = AllocateRegister();
+    for (size_t iElem = 0; iElem < elems.size(); ++iElem)
+    {
+        Emit(Instruction::MakeABx(OpCode::LOAD_INT, indexReg, static_cast<int32_t>(iElem)));
+        const uint16_t valueReg = HandleExprToRegister(static_cast<const Expr*>(elems[iElem].get()));
+        Emit(Instruction::MakeABC(OpCode::STORE_ELEM, arrayReg, indexReg, valueReg));
+    }
+
+    Emit(Instruction::MakeABC(OpCode::MOV, dest, arrayReg));
+}
+
+void BytecodeGenerator::HandleAssignment(const BinaryOpExpr* bExpr, uint16_t dest)
+{
+    const Expr* lhs = bExpr->GetLHS();
+    const Expr* rhs = bExpr->GetRHS();
+
+    if (lhs->GetKind() == ASTNode::NodeKind::INDEX_EXPR)
+    {
+        const IndexedExpr* iExpr = static_cast<const IndexedExpr*>(lhs);
+        const uint16_t arrayReg = HandleExprToRegister(iExpr->GetIdentifier());
+        const uint16_t indexReg = HandleExprToRegister(iExpr->GetIndex());
+        const uint16_t valueReg = HandleExprToRegister(rhs);
+        Emit(Instruction::MakeABC(OpCode::STORE_ELEM, arrayReg, indexReg, valueReg));
+
+        if (dest != NO_REGISTER)
+            Emit(Instruction::MakeABC(OpCode::MOV, dest, valueReg));
+        return;
+    }
+
+    assert(lhs->GetKind() == ASTNode::NodeKind::IDENTIFIER_EXPR);
+
+    // Local variables are directly written to by the right hand side
+    uint16_t varReg;
+    if (GetVarRegister(lhs, varReg))
+    {
+        if ((rhs->GetKind() == ASTNode::NodeKind::SPAWN_EXPR) && (dest == NO_REGISTER))
+        {
+            HandleSpawnToLocal(static_cast<const SpawnExpr*>(rhs), varReg);
+            return;
+        }
+
+        HandleExpr(rhs, varReg);
+
+        if ((dest != NO_REGISTER) && (dest != varReg))
+            Emit(Instruction::MakeABC(OpCode::MOV, dest, varReg));
+        return;
+    }
+
+    uint16_t valueReg = dest;
+    if (valueReg == NO_REGISTER)
+        valueReg = HandleExprToRegister(rhs);
+    else
+        HandleExpr(rhs, valueReg);
+
+    Emit(Instruction::MakeABx(OpCode::STORE_GLOBAL, valueReg, GetGlobalSlot(lhs)));
+}
+
+void BytecodeGenerator::HandleBinaryExpr(const BinaryOpExpr* bExpr, uint16_t dest)
+{
+    // Operation waiting for the value of its right hand side
+    struct PendingOp
+    {
+        OpCode mOp;                 /*!< Operation */
+        uint16_t mLHSReg;           /*!< Register holding the left hand side. NO_REGISTER if it is loaded when the operation is emitted. */
+        const Expr* mLiteralLHS;    /*!< Literal left hand side, loaded when the operation is emitted. Nullptr if already evaluated. */
+        bool mIsAccumulator;        /*!< Is the left hand side register a temporary accumulating the operands of this chain? */
+    };
+
+    // Binary expressions are right associative, so a long expression is a chain of right hand sides as deep as it is long.
+    // The chain is walked with a loop: the left hand sides are evaluated on the way down, then the operations are emitted 
+    // on the way back up. Every operation but the outermost one writes to the same temporary, only read by the operation above it.
+    // So that the registers of the left hand sides don't pile up along the chain:
+    //  - Runs of the same associative operation are folded into an accumulator on the way down, since
+    //    a op (b op rest) is (a op b) op rest. Arithmetic wraps around, so this holds for additions and multiplications too.
+    //  - Literals can't be changed by the rest of the chain, so they are loaded in a shared temporary on the way back up.
+    std::vector<PendingOp> pendingOps;
+    const Expr* rhs = bExpr;
+    do
+    {
+        bExpr = static_cast<const BinaryOpExpr*>(rhs);
+        const OpCode op = GetBinaryOpCode(bExpr);
+        const Expr* lhs = bExpr->GetLHS();
+        const ASTNode::NodeKind lhsKind = lhs->GetKind();
+        const bool isAssociative = (op == OpCode::ADD) || (op == OpCode::MUL) || (op == OpCode::AND) || (op == OpCode::OR);
+
+        if (op == OpCode::NOT)
+        {
+            // A negation only cares about its right hand side operand
+            pendingOps.push_back({ op, NO_REGISTER, nullptr, false });
+        }
+        else if (isAssociative && !pendingOps.empty() && (pendingOps.back().mOp == op))
+        {
+            PendingOp& prevOp = pendingOps.back();
+            uint16_t accReg = prevOp.mLHSReg;
+            if (!prevOp.mIsAccumulator)
+            {
+                accReg = AllocateRegister();
+                if (prevOp.mLiteralLHS != nullptr)
+                    HandleExpr(prevOp.mLiteralLHS, accReg);
+                else
+                    Emit(Instruction::MakeABC(OpCode::MOV, accReg, prevOp.mLHSReg));
+
+                prevOp = { op, accReg, nullptr, true };
+            }
+
+            // The temporaries of the left hand side are released as soon as it is accumulated
+            const uint16_t firstTemp = mNextRegister;
+            Emit(Instruction::MakeABC(op, accReg, accReg, HandleExprToRegister(lhs)));
+            mNextRegister = firstTemp;
+        }
+        else if ((lhsKind == ASTNode::NodeKind::BOOLEAN_EXPR) || (lhsKind == ASTNode::NodeKind::NUMBER_EXPR) || (lhsKind == ASTNode::NodeKind::STRING_EXPR))
+        {
+            pendingOps.push_back({ op, NO_REGISTER, lhs, false });
+        }
+        else
+        {
+            pendingOps.push_back({ op, HandleExprToRegister(lhs), nullptr, false });
+        }
+
+        rhs = bExpr->GetRHS();
+    } while ((rhs->GetKind() == ASTNode::NodeKind::BINARY_EXPR) && (static_cast<const BinaryOpExpr*>(rhs)->GetOperation() != Operation::ASSIGNMENT));
+
+    const uint16_t chainReg = pendingOps.size() > 1 ? AllocateRegister() : NO_REGISTER;
+    uint16_t literalReg = NO_REGISTER;
+    uint16_t rhsReg = HandleExprToRegister(rhs);
+    for (size_t iOp = pendingOps.size(); iOp-- > 0;)
+    {
+        const PendingOp& pendingOp = pendingOps[iOp];
+        const uint16_t opDest = iOp == 0 ? dest : chainReg;
+        if (pendingOp.mOp == OpCode::NOT)
+        {
+            Emit(Instruction::MakeABC(OpCode::NOT, opDest, rhsReg));
+        }
+        else if (pendingOp.mLiteralLHS != nullptr)
+        {
+            if (literalReg == NO_REGISTER)
+                literalReg = AllocateRegister();
+
+            HandleExpr(pendingOp.mLiteralLHS, literalReg);
+            Emit(Instruction::MakeABC(pendingOp.mOp, opDest, literalReg, rhsReg));
+        }
+        else
+        {
+            Emit(Instruction::MakeABC(pendingOp.mOp, opDest, pendingOp.mLHSReg, rhsReg));
+        }
+
+        rhsReg = opDest;
+    }
+}
+
+OpCode BytecodeGenerator::GetBinaryOpCode(const BinaryOpExpr* bExpr) const
+{
+    OpCode op = OpCode::NOT;
+    switch (bExpr->GetOperation())
+    {
+    case Operation::AND_BOOL:
+    case Operation::AND_INT:
+        op = OpCode::AND;
+        break;
+    case Operation::DIVIDE:
+        op = OpCode::DIV;
+        break;
+    case Operation::EQUAL:
+        op = GetExprType(bExpr->GetLHS()) == Type::STRING ? OpCode::EQ_STR : OpCode::EQ;
+        break;
+    case Operation::GREATER_THAN:
+        op = OpCode::GT;
+        break;
+    case Operation::LEFT_SHIFT:
+        op = OpCode::LSHIFT;
+        break;
+    case Operation::LESS_THAN:
+        op = OpCode::LT;
+        break;
+    case Operation::MINUS:
+        op = OpCode::SUB;
+        break;
+    case Operation::MODULO:
+        op = OpCode::MOD;
+        break;
+    case Operation::MULT:
+        op = OpCode::MUL;
+        break;
+    case Operation::NOT:
+        op = OpCode::NOT;
+        break;
+    case Operation::OR_BOOL:
+    case Operation::OR_INT:
+        op = OpCode::OR;
+        break;
+    case Operation::PLUS:
+        op = OpCode::ADD;
+        break;
+    case Operation::RIGHT_SHIFT:
+        op = OpCode::RSHIFT;
+        break;
+    default:
+        assert(false && "Unknown binary operation");
+        break;
+    }
+
+    return op;
+}
+
+void BytecodeGenerator::HandleCallExpr(const CallExpr* cExpr, uint16_t dest, OpCode callOp)
+{
+    const size_t fnIdx = GetFunctionIndex(mSymTable->GetFunctionDecl(cExpr));
+    if (fnIdx > std::numeric_limits<uint16_t>::max())
+    {
+        // Calls refer to their function with a 16 bits operand
+        ErrorLogger::PrintError(ErrorLogger::ErrorType::BYTECODE_TOO_MANY_FUNCTIONS);
+        ++mErrorCount;
+    }
+
+    // Arguments are evaluated in consecutive registers which become the first registers of the callee frame
+    const uint16_t argBase = mNextRegister;
+    for (auto& arg : cExpr->GetArgs())
+        HandleExpr(static_cast<const Expr*>(arg.get()), AllocateRegister());
+
+    Emit(Instruction::MakeABC(callOp, dest, static_cast<uint16_t>(fnIdx), argBase));
+}
+
+void BytecodeGenerator::HandleSpawnToLocal(const SpawnExpr* sExpr, uint16_t varReg)
+{
+    // The register of a variable is reused once the variable goes out of scope,
+    // so the scope must sync before it ends if one of its variables is still waiting for a result
+    if (varReg >= mScopeFirstLocal)
+        mScopeNeedsSync = true;
+
+    HandleCallExpr(sExpr->GetCall(), varReg, OpCode::SPAWN);
+}
+
+// Statements
+void BytecodeGenerator::HandleStmt(const ASTNode* stmt)
+{
+    // Erroneous statements are left as null nodes by the parser
+    if (stmt == nullptr)
+        return;
+
+    const uint16_t firstTemp = mNextRegister;
+
+    switch (stmt->GetKind())
+    {
+    case ASTNode::NodeKind::VAR_DECL:
+        // The register of the variable must outlive the statement
+        HandleLocalVarDecl(static_cast<const VarDecl*>(stmt));
+        return;
+    case ASTNode::NodeKind::BINARY_EXPR:
+        if (static_cast<const BinaryOpExpr*>(stmt)->GetOperation() == Operation::ASSIGNMENT)
+            HandleAssignment(static_cast<const BinaryOpExpr*>(stmt), NO_REGISTER);
+        else
+            HandleExpr(static_cast<const Expr*>(stmt), AllocateRegister());
+        break;
+    case ASTNode::NodeKind::CALL_EXPR:
+        HandleExpr(static_cast<const Expr*>(stmt), AllocateRegister());
+        break;
+    case ASTNode::NodeKind::SPAWN_EXPR:
+        // Nobody uses the result of the call
+        HandleCallExpr(static_cast<const SpawnExpr*>(stmt)->GetCall(), NO_REGISTER, OpCode::SPAWN);
+        break;
+    case ASTNode::NodeKind::COMPOUND_STMT:
+        HandleCompoundStmt(static_cast<const CompoundStmt*>(stmt));
+        break;
+    case ASTNode::NodeKind::IF_STMT:
+        HandleIfStmt(stmt);
+        break;
+    case ASTNode::NodeKind::PRINT_STMT:
+        HandlePrintStmt(stmt);
+        break;
+    case ASTNode::NodeKind::RETURN_STMT:
+        HandleReturnStmt(stmt);
+        break;
+    case ASTNode::NodeKind::SCAN_STMT:
+        HandleScanStmt(stmt);
+        break;
+    case ASTNode::NodeKind::SLEEP_STMT:
+        HandleSleepStmt(stmt);
+        break;
+    case ASTNode::NodeKind::SYNC_STMT:
+        Emit(Instruction::MakeABC(OpCode::SYNC, 0));
+        break;
+    case ASTNode::NodeKind::WHILE_STMT:
+        HandleWhileStmt(stmt);
+        break;
+    default:
+        break;
+    }
+
+    mNextRegister = firstTemp;
+}
+
+void BytecodeGenerator::HandleCompoundStmt(const CompoundStmt* cStmt)
+{
+    // Registers of the variables declared in this scope are released at the end of the scope
+    const uint16_t firstLocal = mNextRegister;
+
+    const uint16_t outerFirstLocal = mScopeFirstLocal;
+    const bool outerNeedsSync = mScopeNeedsSync;
+    mScopeFirstLocal = firstLocal;
+    mScopeNeedsSync = false;
+
+    for (auto& stmt : cStmt->GetStatements())
+        HandleStmt(stmt.get());
+
+    if (mScopeNeedsSync)
+        Emit(Instruction::MakeABC(OpCode::SYNC, 0));
+
+    mScopeFirstLocal = outerFirstLocal;
+    mScopeNeedsSync = outerNeedsSync;
+    mNextRegister = firstLocal;
+}
+
+void BytecodeGenerator::HandleIfStmt(const ASTNode* stmt)
+{
+    const IfStmt* ifStmt = static_cast<const IfStmt*>(stmt);
+
+    const uint16_t condReg = HandleExprToRegister(ifStmt->GetCondExpr());
+    const size_t jmpIdx = Emit(Instruction::MakeABx(OpCode::JMP_IF_FALSE, condReg, 0));
+
+    HandleCompoundStmt(ifStmt->GetBody());
+
+    PatchJump(jmpIdx);
+}
+
+void BytecodeGenerator::HandlePrintStmt(const ASTNode* stmt)
+{
+    // A print statement without a message only outputs a newline
+    if (stmt->GetChildrenNodes().empty())
+    {
+        Emit(Instruction::MakeABC(OpCode::PRINT_NEWLINE, 0));
+        return;
+    }
+
+    const Expr* msg = static_cast<const PrintStmt*>(stmt)->GetMessage();
+    const uint16_t msgReg = HandleExprToRegister(msg);
+
+    switch (GetExprType(msg))
+    {
+    case Type::BOOL:
+        Emit(Instruction::MakeABC(OpCode::PRINT_BOOL, msgReg));
+        break;
+    case Type::STRING:
+        Emit(Instruction::MakeABC(OpCode::PRINT_STR, msgReg));
+        break;
+    default:
+        Emit(Instruction::MakeABC(OpCode::PRINT_INT, msgReg));
+        break;
+    }
+}
+
+void BytecodeGenerator::HandleReturnStmt(const ASTNode* stmt)
+{
+    const Expr* retExpr = static_cast<const ReturnStmt*>(stmt)->GetReturnExpr();
+    if (retExpr == nullptr)
+        Emit(Instruction::MakeABC(OpCode::RET_VOID, 0));
+    else
+        Emit(Instruction::MakeABC(OpCode::RET, HandleExprToRegister(retExpr)));
+}
+
+void BytecodeGenerator::HandleScanStmt(const ASTNode* stmt)
+{
+    const IdentifierExpr* input = static_cast<const ScanStmt*>(stmt)->GetInput();
+
+    OpCode scanOp;
+    switch (GetExprType(input))
+    {
+    case Type::BOOL:
+        scanOp = OpCode::SCAN_BOOL;
+        break;
+    case Type::STRING:
+        scanOp = OpCode::SCAN_STR;
+        break;
+    default:
+        scanOp = OpCode::SCAN_INT;
+        break;
+    }
+
+    uint16_t varReg;
+    if (GetVarRegister(input, varReg))
+    {
+        Emit(Instruction::MakeABC(scanOp, varReg));
+    }
+    else
+    {
+        const uint16_t valueReg = AllocateRegister();
+        Emit(Instruction::MakeABC(scanOp, valueReg));
+        Emit(Instruction::MakeABx(OpCode::STORE_GLOBAL, valueReg, GetGlobalSlot(input)));
+    }
+}
+
+void BytecodeGenerator::HandleSleepStmt(const ASTNode* stmt)
+{
+    const Expr* countExpr = static_cast<const SleepStmt*>(stmt)->GetCountExpr();
+    Emit(Instruction::MakeABC(OpCode::SLEEP, HandleExprToRegister(countExpr)));
+}
+
+void BytecodeGenerator::HandleWhileStmt(const ASTNode* stmt)
+{
+    const WhileStmt* wStmt = static_cast<const WhileStmt*>(stmt);
+
+    // The loop is rotated so that the condition is evaluated once per iteration,
+    // after the body, with a single conditional jump back to the start of the body:
+    //      JMP cond
+    // body:
+    //      ...
+    // cond:
+    //      JMP_IF_TRUE condReg, body
+    const size_t jmpToCondIdx = Emit(Instruction::MakeABx(OpCode::JMP, 0, 0));
+    const size_t bodyIdx = mCurrentFunction->GetCode().size();
+
+    HandleCompoundStmt(wStmt->GetBody());
+
+    PatchJump(jmpToCondIdx);
+    const uint16_t condReg = HandleExprToRegister(wStmt->GetCondExpr());
+    Emit(Instruction::MakeABx(OpCode::JMP_IF_TRUE, condReg, static_cast<int32_t>(bodyIdx)));
+}
+
+// Helpers
+uint16_t BytecodeGenerator::AllocateRegister()
+{
+    // NO_REGISTER marks a missing operand, so it can't be allocated
+    if (mNextRegister >= NO_REGISTER - 1)
+    {
+        if (!mFrameFull)
+        {
+            ErrorLogger::PrintError(ErrorLogger::ErrorType::BYTECODE_TOO_MANY_REGISTERS);
+            ++mErrorCount;
+            mFrameFull = true;
+        }
+
+        return NO_REGISTER - 2;
+    }
+
+    const uint16_t reg = mNextRegister++;
+    if (mNextRegister > mMaxRegister)
+        mMaxRegister = mNextRegister;
+
+    return reg;
+}
+
+size_t BytecodeGenerator::Emit(const Instruction& inst)
+{
+    assert(mCurrentFunction != nullptr);
+    return mCurrentFunction->AddInstruction(inst);
+}
+
+void BytecodeGenerator::PatchJump(size_t jmpIdx)
+{
+    mCurrentFunction->GetInstruction(jmpIdx).SetBx(static_cast<int32_t>(mCurrentFunction->GetCode().size()));
+}
+
+Type BytecodeGenerator::GetExprType(const Expr* expr) const
+{
+    switch (expr->GetKind())
+    {
+    case ASTNode::NodeKind::ARRAY_EXPR:
+        return GetArrayVersion(GetExprType(static_cast<const Expr*>(expr->GetChildrenNodes().front().get())));
+    case ASTNode::NodeKind::BINARY_EXPR:
+    {
+        const BinaryOpExpr* bExpr = static_cast<const BinaryOpExpr*>(expr);
+        switch (bExpr->GetOperation())
+        {
+        case Operation::AND_BOOL:
+        case Operation::EQUAL:
+        case Operation::GREATER_THAN:
+        case Operation::LESS_THAN:
+        case Operation::NOT:
+        case Operation::OR_BOOL:
+            return Type::BOOL;
+        default:
+            return GetExprType(bExpr->GetLHS());
+        }
+    }
+    case ASTNode::NodeKind::BOOLEAN_EXPR:
+        return Type::BOOL;
+    case ASTNode::NodeKind::CALL_EXPR:
+    case ASTNode::NodeKind::SPAWN_EXPR:
+    {
+        const ASTNode* callExpr = expr->GetKind() == ASTNode::NodeKind::CALL_EXPR
+                                ? expr
+                                : static_cast<const SpawnExpr*>(expr)->GetCall();
+
+        const Symbol* fnSym;
+        bool symFound;
+        std::tie(symFound, fnSym) = mSymTable->TryGetSymbol(callExpr);
+        assert(symFound);
+
+        return fnSym->GetFunctionReturnType();
+    }
+    case ASTNode::NodeKind::IDENTIFIER_EXPR:
+    {
+        const Symbol* varSym;
+        bool symFound;
+        std::tie(symFound, varSym) = mSymTable->TryGetSymbol(expr);
+        assert(symFound);
+
+        return varSym->GetVariableType();
+    }
+    case ASTNode::NodeKind::INDEX_EXPR:
+        return GetScalarVersion(GetExprType(static_cast<const IndexedExpr*>(expr)->GetIdentifier()));
+    case ASTNode::NodeKind::NUMBER_EXPR:
+        return Type::NUMBER;
+    case ASTNode::NodeKind::STRING_EXPR:
+        return Type::STRING;
+    default:
+        return Type::UNKNOWN;
+    }
+}
+
+bool BytecodeGenerator::GetVarRegister(const ASTNode* iExpr, uint16_t& reg) const
+{
+    auto regIt = mLocalRegisters.find(mSymTable->GetVarDecl(iExpr));
+    if (regIt == mLocalRegisters.end())
+        return false;
+
+    reg = regIt->second;
+    return true;
+}
+
+int32_t BytecodeGenerator::GetGlobalSlot(const ASTNode* iExpr) const
+{
+    auto slotIt = mGlobalSlots.find(mSymTable->GetVarDecl(iExpr));
+    assert(slotIt != mGlobalSlots.end());
+    return static_cast<int32_t>(slotIt->second);
+}
@@ -0,0 +1,193 @@
+#ifndef BYTECODE_GENERATOR_H__TOSLANG
+#define BYTECODE_GENERATOR_H__TOSLANG
+
+#include "bytecode.h"
+#include "../Common/type.h"
+
+#include <memory>
+#include <unordered_map>
+
+namespace TosLang
+{
+    namespace FrontEnd
+    {
+        class ASTNode;
+        class BinaryOpExpr;
+        class CallExpr;
+        class CompoundStmt;
+        class Expr;
+        class FunctionDecl;
+        class SpawnExpr;
+        class SymbolTable;
+        class VarDecl;
+    }
+
+    namespace VM
+    {
+        /*
+        * \class BytecodeGenerator
+        * \brief Translates a type checked AST into register based bytecode that can be executed by the virtual machine.
+        *        Each function gets its own frame of registers. Parameters occupy the first registers of a frame,
+        *        followed by the local variables and finally by the temporaries needed to evaluate expressions.
+        */
+        class BytecodeGenerator
+        {
+        public:
+            BytecodeGenerator()
+                : mSymTable{ nullptr }, mMod{ nullptr }, mCurrentFunction{ nullptr },
+                  mNextRegister{ 0 }, mMaxRegister{ 0 }, mScopeFirstLocal{ 0 }, mScopeNeedsSync{ false },
+                  mErrorCount{ 0 }, mFrameFull{ false } { }
+
+        public:
+            std::unique_ptr<BytecodeModule> Run(const std::unique_ptr<FrontEnd::ASTNode>& root,
+                                                const std::shared_ptr<FrontEnd::SymbolTable>& symTable);
+
+            size_t GetFunctionIndex(const FrontEnd::ASTNode* fnDecl) const;
+
+        protected:  // Declarations
+            void HandleFunctionDecl(const FrontEnd::FunctionDecl* fDecl);
+            void HandleGlobalVarDecl(const FrontEnd::VarDecl* vDecl);
+            void HandleLocalVarDecl(const FrontEnd::VarDecl* vDecl);
+
+            /*
+            * \fn           HandleVarInit
+            * \brief        Generates the code giving a variable its initial value
+            * \param vDecl  Variable declaration
+            * \param dest   Register receiving the initial value
+            */
+            void HandleVarInit(const FrontEnd::VarDecl* vDecl, uint16_t dest);
+
+        protected:  // Expressions
+            /*
+            * \fn           HandleExpr
+            * \brief        Generates the code evaluating an expression and storing its value in a given register
+            * \param expr   Expression to evaluate
+            * \param dest   Register receiving the value of the expression
+            */
+            void HandleExpr(const FrontEnd::Expr* expr, uint16_t dest);
+
+            /*
+            * \fn           HandleExprToRegister
+            * \brief        Generates the code evaluating an expression. Local variables are used in place,
+            *               other expressions are evaluated in a newly allocated temporary register.
+            * \param expr   Expression to evaluate
+            * \return       Register containing the value of the expression
+            */
+            uint16_t HandleExprToRegister(const FrontEnd::Expr* expr);
+
+            void HandleArrayExpr(const FrontEnd::Expr* expr, uint16_t dest);
+            void HandleAssignment(const FrontEnd::BinaryOpExpr* bExpr, uint16_t dest);
+
+            /*
+            * \fn           HandleBinaryExpr
+            * \brief        Generates the code of a binary operation. The chain of operations nested in its right hand side 
+            *               is handled without recursing, using a single temporary for all of them. Runs of the same 
+            *               associative operation are accumulated and literal operands are loaded late, so that the 
+            *               number of registers doesn't grow with the length of the chain.
+            * \param bExpr  Binary operation, other than an assignment
+            * \param dest   Register receiving the value of the operation
+            */
+            void HandleBinaryExpr(const FrontEnd::BinaryOpExpr* bExpr, uint16_t dest);
+
+            void HandleCallExpr(const FrontEnd::CallExpr* cExpr, uint16_t dest, OpCode callOp);
+
+            /*
+            * \fn           HandleSpawnToLocal
+            * \brief        Generates the code spawning a call whose result goes to a local variable on the next sync
+            * \param sExpr  Spawned call
+            * \param varReg Register of the local variable
+            */
+            void HandleSpawnToLocal(const FrontEnd::SpawnExpr* sExpr, uint16_t varReg);
+
+        protected:  // Statements
+            void HandleStmt(const FrontEnd::ASTNode* stmt);
+            void HandleCompoundStmt(const FrontEnd::CompoundStmt* cStmt);
+            void HandleIfStmt(const FrontEnd::ASTNode* stmt);
+            void HandlePrintStmt(const FrontEnd::ASTNode* stmt);
+            void HandleReturnStmt(const FrontEnd::ASTNode* stmt);
+            void HandleScanStmt(const FrontEnd::ASTNode* stmt);
+            void HandleSleepStmt(const FrontEnd::ASTNode* stmt);
+            void HandleWhileStmt(const FrontEnd::ASTNode* stmt);
+
+        private:
+            /*
+            * \fn       AllocateRegister
+            * \brief    Reserves the next free register of the current frame. Once the frame is full, an error
+            *           is reported and the last register is given back so that the generation can go on.
+            * \return   Index of the reserved register
+            */
+            uint16_t AllocateRegister();
+
+            /*
+            * \fn           Emit
+            * \brief        Appends an instruction to the current function
+            * \param inst   Instruction to append
+            * \return       Index of the instruction in the current function
+            */
+            size_t Emit(const Instruction& inst);
+
+            /*
+            * \fn           PatchJump
+            * \brief        Makes a previously emitted jump point at the next instruction to be emitted
+            * \param jmpIdx Index of the jump instruction
+            */
+            void PatchJump(size_t jmpIdx);
+
+            /*
+            * \fn           GetExprType
+            * \brief        Computes the type of the value produced by an expression
+            * \param expr   Expression
+            * \return       Type of the expression
+            */
+            Common::Type GetExprType(const FrontEnd::Expr* expr) const;
+
+            /*
+            * \fn           GetBinaryOpCode
+            * \brief        Finds the instruction performing a binary operation
+            * \param bExpr  Binary operation, other than an assignment
+            * \return       Operation code of the instruction
+            */
+            OpCode GetBinaryOpCode(const FrontEnd::BinaryOpExpr* bExpr) const;
+
+            /*
+            * \fn           GetVarRegister
+            * \brief        Finds the register holding a local variable
+            * \param iExpr  Use of the variable
+            * \param reg    Register holding the variable if it is a local variable
+            * \return       True if the variable is local to the current function
+            */
+            bool GetVarRegister(const FrontEnd::ASTNode* iExpr, uint16_t& reg) const;
+
+            /*
+            * \fn           GetGlobalSlot
+            * \brief        Finds the global slot holding a global variable
+            * \param iExpr  Use of the variable
+            * \return       Index of the global slot
+            */
+            int32_t GetGlobalSlot(const FrontEnd::ASTNode* iExpr) const;
+
+        private:
+            using NodeIndexMap = std::unordered_map<const FrontEnd::ASTNode*, size_t>;
+            using NodeRegisterMap = std::unordered_map<const FrontEnd::ASTNode*, uint16_t>;
+
+        private:
+            std::shared_ptr<FrontEnd::SymbolTable> mSymTable;   /*!< Symbol table of the program */
+            std::unique_ptr<BytecodeModule> mMod;               /*!< Module being built out of the AST */
+            BytecodeFunction* mCurrentFunction;                 /*!< Function currently being generated */
+
+            NodeIndexMap mFunctionIndexes;                      /*!< Index of each function declaration in the module */
+            NodeIndexMap mGlobalSlots;                          /*!< Slot of each global variable declaration */
+            NodeRegisterMap mLocalRegisters;                    /*!< Register of each local variable of the current function */
+
+            uint16_t mNextRegister;                             /*!< Next free register of the current frame */
+            uint16_t mMaxRegister;                              /*!< Number of registers used by the current frame */
+            uint16_t mScopeFirstLocal;                          /*!< First register of the variables declared in the current scope */
+            bool mScopeNeedsSync;                               /*!< Does a variable of the current scope wait for a spawned result? */
+
+            size_t mErrorCount;                                 /*!< Number of errors found while generating the module */
+            bool mFrameFull;                                    /*!< Has the current frame run out of registers? */
+        };
+    }
+}
+
+#endif // BYTECODE_GENERATOR_H__TOSLANG
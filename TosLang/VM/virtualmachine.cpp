@@ -0,0 +1,520 @@
+#include "virtualmachine.h"
+
+#include "../Utils/errorlogger.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace TosLang::VM;
+using namespace TosLang::Utils;
+
+// Threaded dispatch relies on the labels as values extension of GCC and Clang
+#if defined(__GNUC__)
+#   define TOSLANG_HAS_COMPUTED_GOTO 1
+#else
+#   define TOSLANG_HAS_COMPUTED_GOTO 0
+#endif
+
+namespace
+{
+    // Maximum number of nested calls before the program is considered to be stuck in an infinite recursion
+    const size_t MAX_CALL_DEPTH = 1 << 16;
+
+    // Handles are the addresses of the strings and arrays. Unlike indexes in a growing container,
+    // they stay valid while other threads of execution allocate new strings and arrays.
+    template <typename T>
+    Value ToHandle(const T* obj)
+    {
+        return reinterpret_cast<Value>(obj);
+    }
+
+    const std::string& AsString(Value handle)
+    {
+        // Elements of an array of strings start as null handles
+        static const std::string sEmptyString;
+        return handle != 0 ? *reinterpret_cast<const std::string*>(handle) : sEmptyString;
+    }
+
+    std::vector<Value>& AsArray(Value handle)
+    {
+        return *reinterpret_cast<std::vector<Value>*>(handle);
+    }
+}
+
+/*
+* \fn       IsThreadedDispatchSupported
+* \brief    Indicates if the compiler used to build the virtual machine supports threaded dispatch
+* \return   True if the THREADED dispatch mode can be used
+*/
+bool VirtualMachine::IsThreadedDispatchSupported()
+{
+    return TOSLANG_HAS_COMPUTED_GOTO != 0;
+}
+
+/*
+* \fn       GetDefaultDispatchMode
+* \brief    Gets the dispatch mode selected at build time (see the USE_THREADED_DISPATCH CMake option)
+* \return   Default dispatch mode
+*/
+DispatchMode VirtualMachine::GetDefaultDispatchMode()
+{
+#if defined(USE_THREADED_DISPATCH) && TOSLANG_HAS_COMPUTED_GOTO
+    return DispatchMode::THREADED;
+#else
+    return DispatchMode::SWITCH;
+#endif
+}
+
+VirtualMachine::VirtualMachine(DispatchMode mode) : mModule{ nullptr }, mDispatchMode{ mode }
+{
+    assert((mode == DispatchMode::SWITCH) || IsThreadedDispatchSupported());
+}
+
+VirtualMachine::~VirtualMachine() = default;
+
+bool VirtualMachine::Run(const BytecodeModule& module)
+{
+    Reset(module);
+
+    Value result;
+    return Execute(mMainContext, module.GetGlobalsInitIdx(), {}, result) 
+        && Execute(mMainContext, module.GetEntryIdx(), {}, result);
+}
+
+bool VirtualMachine::Call(const BytecodeModule& module, size_t fnIdx, const std::vector<Value>& args, Value& result)
+{
+    Reset(module);
+
+    return Execute(mMainContext, module.GetGlobalsInitIdx(), {}, result)
+        && Execute(mMainContext, fnIdx, args, result);
+}
+
+void VirtualMachine::Reset(const BytecodeModule& module)
+{
+    mModule = &module;
+    mMainContext.mFrames.clear();
+    mGlobals.assign(module.GetNbGlobals(), 0);
+    mStrings = module.GetStrings();
+    mHeapStrings.clear();
+    mArrays.clear();
+}
+
+void VirtualMachine::ExecutionContext::EnsureStackSize(size_t size)
+{
+    if (mRegisters.size() < size)
+        mRegisters.resize(std::max(size, 2 * mRegisters.size()), 0);
+}
+
+bool VirtualMachine::Execute(ExecutionContext& ctx, size_t fnIdx, const std::vector<Value>& args, Value& result)
+{
+    // The arguments are put in the first registers of the callee frame
+    const BytecodeFunction& fn = mModule->GetFunctions()[fnIdx];
+    assert(args.size() == fn.GetNbParams());
+    ctx.EnsureStackSize(fn.GetNbRegisters());
+    std::copy(args.begin(), args.end(), ctx.mRegisters.begin());
+    ctx.mFrames.clear();
+
+    bool succeeded;
+#if TOSLANG_HAS_COMPUTED_GOTO
+    if (mDispatchMode == DispatchMode::THREADED)
+        succeeded = ExecuteLoop<DispatchMode::THREADED>(ctx, fnIdx, result);
+    else
+#endif
+        succeeded = ExecuteLoop<DispatchMode::SWITCH>(ctx, fnIdx, result);
+
+    // After a runtime error, calls spawned by the interrupted frames may still be running.
+    // They refer to the context so they must be done before the context can be reused.
+    if (!succeeded)
+    {
+        for (size_t depth = 0; depth < ctx.mSpawnGroups.size(); ++depth)
+            Sync(ctx, depth, nullptr);
+    }
+
+    return succeeded;
+}
+
+void VirtualMachine::SpawnedCall::Run()
+{
+    // Every thread recycles its contexts since allocating a register stack for each spawned call is expensive.
+    // A thread may need more than one context at a time when it runs other calls while waiting on a sync.
+    static thread_local std::vector<std::unique_ptr<ExecutionContext>> tFreeContexts;
+
+    std::unique_ptr<ExecutionContext> ctx;
+    if (tFreeContexts.empty())
+    {
+        ctx = std::make_unique<ExecutionContext>();
+    }
+    else
+    {
+        ctx = std::move(tFreeContexts.back());
+        tFreeContexts.pop_back();
+    }
+
+    if (!mVM->Execute(*ctx, mFnIdx, mArgs, mResult))
+        mGroup->mFailed = true;
+
+    tFreeContexts.push_back(std::move(ctx));
+
+    // This must be the last access to the call: the spawning frame may destroy it as soon as the count drops
+    mGroup->mNbRunning.fetch_sub(1, std::memory_order_release);
+}
+
+bool VirtualMachine::Sync(ExecutionContext& ctx, size_t depth, Value* regs)
+{
+    if (depth >= ctx.mSpawnGroups.size())
+        return true;
+
+    SpawnGroup& group = ctx.mSpawnGroups[depth];
+    if (group.mNbCalls == 0)
+        return true;
+
+    // Rather than blocking, the waiting thread helps running the pending calls
+    while (group.mNbRunning.load(std::memory_order_acquire) != 0)
+    {
+        if (!mScheduler->TryRunTask())
+            std::this_thread::yield();
+    }
+
+    if (regs != nullptr)
+    {
+        for (size_t iCall = 0; iCall < group.mNbCalls; ++iCall)
+        {
+            const SpawnedCall& call = *group.mCalls[iCall];
+            if (call.mDest != NO_REGISTER)
+                regs[call.mDest] = call.mResult;
+        }
+    }
+
+    const bool succeeded = !group.mFailed;
+    group.mNbCalls = 0;
+    group.mFailed = false;
+    return succeeded;
+}
+
+Value VirtualMachine::NewArray(size_t size)
+{
+    std::lock_guard<std::mutex> lock{ mHeapMutex };
+    mArrays.emplace_back(size, 0);
+    return ToHandle(&mArrays.back());
+}
+
+Value VirtualMachine::NewString(std::string&& str)
+{
+    std::lock_guard<std::mutex> lock{ mHeapMutex };
+    mHeapStrings.emplace_back(std::move(str));
+    return ToHandle(&mHeapStrings.back());
+}
+
+// Every opcode handler is both a switch case and, when threaded dispatch is available, a label.
+// A handler ends with VM_DISPATCH which either goes back to the switch or jumps straight to the 
+// handler of the next instruction. This gives one indirect branch per handler instead of a single
+// shared one, which is a lot easier on the branch predictor.
+#if TOSLANG_HAS_COMPUTED_GOTO
+#   define VM_CASE(op)      case OpCode::op: L_##op
+#   define VM_DISPATCH()                                                \
+        if constexpr (mode == DispatchMode::THREADED)                   \
+        {                                                               \
+            inst = *pc++;                                               \
+            goto *sDispatchTable[static_cast<size_t>(inst.mOp)];        \
+        }                                                               \
+        else                                                            \
+            break
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wpedantic"
+#else
+#   define VM_CASE(op)      case OpCode::op
+#   define VM_DISPATCH()    break
+#endif
+
+template <DispatchMode mode>
+bool VirtualMachine::ExecuteLoop(ExecutionContext& ctx, size_t fnIdx, Value& result)
+{
+    const std::vector<BytecodeFunction>& functions = mModule->GetFunctions();
+    std::vector<CallFrame>& frames = ctx.mFrames;
+
+    const BytecodeFunction* fn = &functions[fnIdx];
+    size_t base = 0;
+
+    Value* regs = ctx.mRegisters.data();
+    const Instruction* pc = fn->GetCode().data();
+
+#if TOSLANG_HAS_COMPUTED_GOTO
+    // Must follow the declaration order of the OpCode enum
+    static const void* const sDispatchTable[] =
+    {
+        &&L_MOV, &&L_LOAD_INT, &&L_LOAD_STR, &&L_LOAD_GLOBAL, &&L_STORE_GLOBAL,
+        &&L_ADD, &&L_SUB, &&L_MUL, &&L_DIV, &&L_MOD, &&L_AND, &&L_OR, &&L_LSHIFT, &&L_RSHIFT, &&L_NOT,
+        &&L_EQ, &&L_EQ_STR, &&L_GT, &&L_LT,
+        &&L_JMP, &&L_JMP_IF_FALSE, &&L_JMP_IF_TRUE, &&L_CALL, &&L_RET, &&L_RET_VOID,
+        &&L_NEW_ARRAY, &&L_LOAD_ELEM, &&L_STORE_ELEM,
+        &&L_PRINT_BOOL, &&L_PRINT_INT, &&L_PRINT_STR, &&L_PRINT_NEWLINE, &&L_SCAN_BOOL, &&L_SCAN_INT, &&L_SCAN_STR, &&L_SLEEP,
+        &&L_SPAWN, &&L_SYNC,
+    };
+    static_assert(sizeof(sDispatchTable) / sizeof(sDispatchTable[0]) == static_cast<size_t>(OpCode::SYNC) + 1,
+                  "The dispatch table must contain every opcode");
+#endif
+
+    Instruction inst;
+    for (;;)
+    {
+        // With threaded dispatch, this switch is only used to dispatch the first instruction.
+        // Every handler then jumps directly to the handler of the next instruction.
+        inst = *pc++;
+
+        switch (inst.mOp)
+        {
+        // Data movement
+        VM_CASE(MOV):
+            regs[inst.mA] = regs[inst.mB];
+            VM_DISPATCH();
+        VM_CASE(LOAD_INT):
+            regs[inst.mA] = inst.GetBx();
+            VM_DISPATCH();
+        VM_CASE(LOAD_STR):
+            regs[inst.mA] = ToHandle(&mStrings[inst.GetBx()]);
+            VM_DISPATCH();
+        VM_CASE(LOAD_GLOBAL):
+            regs[inst.mA] = mGlobals[inst.GetBx()];
+            VM_DISPATCH();
+        VM_CASE(STORE_GLOBAL):
+            mGlobals[inst.GetBx()] = regs[inst.mA];
+            VM_DISPATCH();
+
+        // Arithmetic and logic. Results which don't fit in a value wrap around.
+        VM_CASE(ADD):
+            regs[inst.mA] = static_cast<Value>(static_cast<uint64_t>(regs[inst.mB]) + static_cast<uint64_t>(regs[inst.mC]));
+            VM_DISPATCH();
+        VM_CASE(SUB):
+            regs[inst.mA] = static_cast<Value>(static_cast<uint64_t>(regs[inst.mB]) - static_cast<uint64_t>(regs[inst.mC]));
+            VM_DISPATCH();
+        VM_CASE(MUL):
+            regs[inst.mA] = static_cast<Value>(static_cast<uint64_t>(regs[inst.mB]) * static_cast<uint64_t>(regs[inst.mC]));
+            VM_DISPATCH();
+        VM_CASE(DIV):
+            if (regs[inst.mC] == 0)
+            {
+                ErrorLogger::PrintError(ErrorLogger::ErrorType::RUNTIME_DIVISION_BY_ZERO);
+                return false;
+            }
+            // The quotient of the smallest value by -1 doesn't fit, and the processor traps on it
+            if (regs[inst.mC] == -1)
+                regs[inst.mA] = static_cast<Value>(0 - static_cast<uint64_t>(regs[inst.mB]));
+            else
+                regs[inst.mA] = regs[inst.mB] / regs[inst.mC];
+            VM_DISPATCH();
+        VM_CASE(MOD):
+            if (regs[inst.mC] == 0)
+            {
+                ErrorLogger::PrintError(ErrorLogger::ErrorType::RUNTIME_DIVISION_BY_ZERO);
+                return false;
+            }
+            if (regs[inst.mC] == -1)
+                regs[inst.mA] = 0;
+            else
+                regs[inst.mA] = regs[inst.mB] % regs[inst.mC];
+            VM_DISPATCH();
+        VM_CASE(AND):
+            regs[inst.mA] = regs[inst.mB] & regs[inst.mC];
+            VM_DISPATCH();
+        VM_CASE(OR):
+            regs[inst.mA] = regs[inst.mB] | regs[inst.mC];
+            VM_DISPATCH();
+        // Only the 6 lowest bits of the shift count are used, as x86 processors do
+        VM_CASE(LSHIFT):
+            regs[inst.mA] = static_cast<Value>(static_cast<uint64_t>(regs[inst.mB]) << (regs[inst.mC] & 63));
+            VM_DISPATCH();
+        VM_CASE(RSHIFT):
+            regs[inst.mA] = regs[inst.mB] >> (regs[inst.mC] & 63);
+            VM_DISPATCH();
+        VM_CASE(NOT):
+            regs[inst.mA] = !regs[inst.mB];
+            VM_DISPATCH();
+
+        // Comparisons
+        VM_CASE(EQ):
+            regs[inst.mA] = regs[inst.mB] == regs[inst.mC];
+            VM_DISPATCH();
+        VM_CASE(EQ_STR):
+            regs[inst.mA] = AsString(regs[inst.mB]) == AsString(regs[inst.mC]);
+            VM_DISPATCH();
+        VM_CASE(GT):
+            regs[inst.mA] = regs[inst.mB] > regs[inst.mC];
+            VM_DISPATCH();
+        VM_CASE(LT):
+            regs[inst.mA] = regs[inst.mB] < regs[inst.mC];
+            VM_DISPATCH();
+
+        // Control flow
+        VM_CASE(JMP):
+            pc = fn->GetCode().data() + inst.GetBx();
+            VM_DISPATCH();
+        VM_CASE(JMP_IF_FALSE):
+            if (!regs[inst.mA])
+                pc = fn->GetCode().data() + inst.GetBx();
+            VM_DISPATCH();
+        VM_CASE(JMP_IF_TRUE):
+            if (regs[inst.mA])
+                pc = fn->GetCode().data() + inst.GetBx();
+            VM_DISPATCH();
+        VM_CASE(CALL):
+        {
+            if (frames.size() == MAX_CALL_DEPTH)
+            {
+                ErrorLogger::PrintError(ErrorLogger::ErrorType::RUNTIME_STACK_OVERFLOW);
+                return false;
+            }
+
+            frames.push_back(CallFrame{ fn, pc, base, inst.mA });
+
+            // The callee frame starts at the first argument
+            fn = &functions[inst.mB];
+            base += inst.mC;
+            ctx.EnsureStackSize(base + fn->GetNbRegisters());
+
+            regs = ctx.mRegisters.data() + base;
+            pc = fn->GetCode().data();
+        }
+            VM_DISPATCH();
+        VM_CASE(RET):
+        VM_CASE(RET_VOID):
+        {
+            // A function implicitly syncs before returning. This also makes the spawned results visible to the return value.
+            const size_t depth = frames.size();
+            if ((depth < ctx.mSpawnGroups.size()) && (ctx.mSpawnGroups[depth].mNbCalls != 0) && !Sync(ctx, depth, regs))
+                return false;
+
+            if (frames.empty())
+            {
+                result = inst.mOp == OpCode::RET ? regs[inst.mA] : 0;
+                return true;
+            }
+
+            const Value retVal = inst.mOp == OpCode::RET ? regs[inst.mA] : 0;
+
+            const CallFrame& frame = frames.back();
+            fn = frame.mFunction;
+            pc = frame.mReturnPC;
+            base = frame.mBase;
+            regs = ctx.mRegisters.data() + base;
+
+            if (inst.mOp == OpCode::RET)
+                regs[frame.mDest] = retVal;
+
+            frames.pop_back();
+        }
+            VM_DISPATCH();
+
+        // Arrays
+        VM_CASE(NEW_ARRAY):
+            regs[inst.mA] = NewArray(static_cast<size_t>(inst.GetBx()));
+            VM_DISPATCH();
+        VM_CASE(LOAD_ELEM):
+        {
+            const std::vector<Value>& arr = AsArray(regs[inst.mB]);
+            const Value idx = regs[inst.mC];
+            if ((idx < 0) || (static_cast<size_t>(idx) >= arr.size()))
+            {
+                ErrorLogger::PrintError(ErrorLogger::ErrorType::RUNTIME_INDEX_OUT_OF_BOUNDS);
+                return false;
+            }
+            regs[inst.mA] = arr[idx];
+        }
+            VM_DISPATCH();
+        VM_CASE(STORE_ELEM):
+        {
+            std::vector<Value>& arr = AsArray(regs[inst.mA]);
+            const Value idx = regs[inst.mB];
+            if ((idx < 0) || (static_cast<size_t>(idx) >= arr.size()))
+            {
+                ErrorLogger::PrintError(ErrorLogger::ErrorType::RUNTIME_INDEX_OUT_OF_BOUNDS);
+                return false;
+            }
+            arr[idx] = regs[inst.mC];
+        }
+            VM_DISPATCH();
+
+        // IO
+        VM_CASE(PRINT_BOOL):
+            std::cout << (regs[inst.mA] ? "True" : "False") << std::endl;
+            VM_DISPATCH();
+        VM_CASE(PRINT_INT):
+            std::cout << regs[inst.mA] << std::endl;
+            VM_DISPATCH();
+        VM_CASE(PRINT_STR):
+            std::cout << AsString(regs[inst.mA]) << std::endl;
+            VM_DISPATCH();
+        VM_CASE(PRINT_NEWLINE):
+            std::cout << std::endl;
+            VM_DISPATCH();
+        VM_CASE(SCAN_BOOL):
+        {
+            std::string input;
+            std::cin >> input;
+            regs[inst.mA] = input == "True";
+        }
+            VM_DISPATCH();
+        VM_CASE(SCAN_INT):
+        {
+            Value input = 0;
+            std::cin >> input;
+            regs[inst.mA] = input;
+        }
+            VM_DISPATCH();
+        VM_CASE(SCAN_STR):
+        {
+            std::string input;
+            std::cin >> input;
+            regs[inst.mA] = NewString(std::move(input));
+        }
+            VM_DISPATCH();
+        VM_CASE(SLEEP):
+            std::this_thread::sleep_for(std::chrono::milliseconds(regs[inst.mA]));
+            VM_DISPATCH();
+
+        // Threading
+        VM_CASE(SPAWN):
+        {
+            // Only the program itself can spawn before the scheduler exists, so its creation can't race
+            if (mScheduler == nullptr)
+                mScheduler = std::make_unique<Scheduler>();
+
+            const size_t depth = frames.size();
+            while (ctx.mSpawnGroups.size() <= depth)
+                ctx.mSpawnGroups.emplace_back();
+            SpawnGroup& group = ctx.mSpawnGroups[depth];
+
+            if (group.mNbCalls == group.mCalls.size())
+                group.mCalls.emplace_back(std::make_unique<SpawnedCall>(this, &group));
+            SpawnedCall& call = *group.mCalls[group.mNbCalls++];
+
+            // The arguments are copied since the registers of the frame keep changing while the call runs
+            const Value* args = regs + inst.mC;
+            call.mFnIdx = inst.mB;
+            call.mArgs.assign(args, args + functions[inst.mB].GetNbParams());
+            call.mDest = inst.mA;
+
+            group.mNbRunning.fetch_add(1, std::memory_order_relaxed);
+            mScheduler->Submit(&call);
+        }
+            VM_DISPATCH();
+        VM_CASE(SYNC):
+            if (!Sync(ctx, frames.size(), regs))
+                return false;
+            VM_DISPATCH();
+
+        default:
+            assert(false && "Unknown opcode");
+            return false;
+        }
+    }
+}
+
+#if TOSLANG_HAS_COMPUTED_GOTO
+#   pragma GCC diagnostic pop
+#endif
+
+#undef VM_CASE
+#undef VM_DISPATCH
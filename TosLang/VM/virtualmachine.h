@@ -0,0 +1,195 @@
+#ifndef VIRTUAL_MACHINE_H__TOSLANG
+#define VIRTUAL_MACHINE_H__TOSLANG
+
+#include "bytecode.h"
+#include "../Utils/scheduler.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace TosLang
+{
+    namespace VM
+    {
+        /*
+        * \enum     DispatchMode
+        * \brief    Ways for the virtual machine to go from one instruction to the next
+        */
+        enum class DispatchMode
+        {
+            SWITCH,     // Portable: a single switch statement decodes every instruction
+            THREADED,   // Direct threading: each handler jumps to the next handler (GCC and Clang only)
+        };
+
+        /*
+        * \class VirtualMachine
+        * \brief Register based virtual machine executing the bytecode produced by the BytecodeGenerator.
+        *        Every frame is a window in a single register stack. A call makes the callee frame start at
+        *        the register holding its first argument, so arguments never need to be copied.
+        *
+        *        Spawned calls are run by a work stealing scheduler, each one with its own register stack.
+        *        Their results are written to the registers of the spawning frame when it syncs. A function
+        *        implicitly syncs before returning, so spawned calls never outlive the frame that spawned them.
+        */
+        class VirtualMachine
+        {
+        public:
+            explicit VirtualMachine(DispatchMode mode = GetDefaultDispatchMode());
+            ~VirtualMachine();
+
+        public:
+            static bool IsThreadedDispatchSupported();
+            static DispatchMode GetDefaultDispatchMode();
+
+            /*
+            * \fn           Run
+            * \brief        Initializes the global variables of a module and then executes its entry function
+            * \param module Module to execute
+            * \return       True if the program terminated without any runtime error
+            */
+            bool Run(const BytecodeModule& module);
+
+            /*
+            * \fn           Call
+            * \brief        Initializes the global variables of a module and then calls one of its functions
+            * \param module Module to execute
+            * \param fnIdx  Index of the function to call
+            * \param args   Arguments given to the function
+            * \param result Value returned by the function
+            * \return       True if the function returned without any runtime error
+            */
+            bool Call(const BytecodeModule& module, size_t fnIdx, const std::vector<Value>& args, Value& result);
+
+        private:
+            /*
+            * \struct   CallFrame
+            * \brief    Information needed to resume the execution of a caller once its callee returns
+            */
+            struct CallFrame
+            {
+                const BytecodeFunction* mFunction;  /*!< Caller */
+                const Instruction* mReturnPC;       /*!< Instruction following the call */
+                size_t mBase;                       /*!< First register of the caller frame */
+                uint16_t mDest;                     /*!< Caller register receiving the returned value */
+            };
+
+            struct SpawnGroup;
+
+            /*
+            * \struct   SpawnedCall
+            * \brief    Call running concurrently with the frame that spawned it
+            */
+            struct SpawnedCall : public Utils::Task
+            {
+                SpawnedCall(VirtualMachine* vm, SpawnGroup* group) : mVM{ vm }, mFnIdx{ 0 }, mResult{ 0 }, mDest{ NO_REGISTER }, mGroup{ group } { }
+
+                void Run() override;
+
+                VirtualMachine* mVM;        /*!< Virtual machine executing the call */
+                size_t mFnIdx;              /*!< Function being called */
+                std::vector<Value> mArgs;   /*!< Copy of the arguments taken when the call was spawned */
+                Value mResult;              /*!< Value returned by the call */
+                uint16_t mDest;             /*!< Register of the spawning frame receiving the result on sync */
+                SpawnGroup* mGroup;         /*!< Group the call belongs to */
+            };
+
+            /*
+            * \struct   SpawnGroup
+            * \brief    Calls spawned by a frame since its last sync. The calls are recycled from one sync to the next.
+            */
+            struct SpawnGroup
+            {
+                SpawnGroup() : mNbCalls{ 0 }, mNbRunning{ 0 }, mFailed{ false } { }
+
+                std::vector<std::unique_ptr<SpawnedCall>> mCalls;   /*!< Spawned calls, only the first mNbCalls are in use */
+                size_t mNbCalls;                                    /*!< Number of calls spawned since the last sync */
+                std::atomic<size_t> mNbRunning;                     /*!< Number of spawned calls that haven't returned yet */
+                std::atomic<bool> mFailed;                          /*!< Did one of the spawned calls hit a runtime error? */
+            };
+
+            /*
+            * \struct   ExecutionContext
+            * \brief    State of a thread of execution. The main program and every spawned call get their own.
+            */
+            struct ExecutionContext
+            {
+                /*
+                * \fn           EnsureStackSize
+                * \brief        Grows the register stack so that it contains at least a given number of registers
+                * \param size   Number of registers needed
+                */
+                void EnsureStackSize(size_t size);
+
+                std::vector<Value> mRegisters;      /*!< Register stack shared by every frame */
+                std::vector<CallFrame> mFrames;     /*!< Call stack */
+                std::deque<SpawnGroup> mSpawnGroups;    /*!< Calls spawned by each frame, indexed by call depth */
+            };
+
+        private:
+            /*
+            * \fn           Reset
+            * \brief        Prepares the virtual machine to execute a module
+            * \param module Module to execute
+            */
+            void Reset(const BytecodeModule& module);
+
+            /*
+            * \fn           Execute
+            * \brief        Executes a function (and every function it calls) until it returns
+            * \param ctx    Thread of execution running the function
+            * \param fnIdx  Index of the function in the module
+            * \param args   Arguments given to the function
+            * \param result Value returned by the function
+            * \return       True if no runtime error happened
+            */
+            bool Execute(ExecutionContext& ctx, size_t fnIdx, const std::vector<Value>& args, Value& result);
+
+            template <DispatchMode mode>
+            bool ExecuteLoop(ExecutionContext& ctx, size_t fnIdx, Value& result);
+
+            /*
+            * \fn           Sync
+            * \brief        Waits for the calls spawned by a frame and writes their results to the frame registers.
+            *               The waiting thread runs pending tasks in the meantime.
+            * \param ctx    Thread of execution of the frame
+            * \param depth  Call depth of the frame
+            * \param regs   Registers of the frame
+            * \return       True if none of the spawned calls hit a runtime error
+            */
+            bool Sync(ExecutionContext& ctx, size_t depth, Value* regs);
+
+            /*
+            * \fn           NewArray
+            * \brief        Allocates an array on the heap shared by every thread of execution
+            * \param size   Number of elements of the array
+            * \return       Handle of the array
+            */
+            Value NewArray(size_t size);
+
+            /*
+            * \fn           NewString
+            * \brief        Allocates a string on the heap shared by every thread of execution
+            * \param str    Content of the string
+            * \return       Handle of the string
+            */
+            Value NewString(std::string&& str);
+
+        private:
+            const BytecodeModule* mModule;                  /*!< Module being executed */
+            DispatchMode mDispatchMode;                     /*!< How instructions are dispatched */
+            ExecutionContext mMainContext;                  /*!< Thread of execution of the program itself */
+            std::vector<Value> mGlobals;                    /*!< Global variables */
+            std::vector<std::string> mStrings;              /*!< String constants */
+            std::deque<std::string> mHeapStrings;           /*!< Strings created at runtime */
+            std::deque<std::vector<Value>> mArrays;         /*!< Arrays created at runtime */
+            std::mutex mHeapMutex;                          /*!< Protects the allocations of strings and arrays */
+            std::unique_ptr<Utils::Scheduler> mScheduler;   /*!< Runs the spawned calls. Created on the first spawn. */
+        };
+    }
+}
+
+#endif // VIRTUAL_MACHINE_H__TOSLANG
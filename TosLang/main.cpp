@@ -1,6 +1,7 @@
 #include "Execution/commandlineutil.h"
 #include "Execution/compiler.h"
 #include "Execution/interpreter.h"
+#include "Execution/passstatistics.h"
 
 using namespace Execution;
 
@@ -14,26 +15,47 @@ int main(int argc, char** argv)
         args.emplace_back(argv[iArg]);
 
     ExecutionInfo info = ParseCommandLine(args);
+    if (!info.cacheDirectory.empty())
+        compiler.SetCacheDirectory(info.cacheDirectory);
+
+    PassStatistics stats;
+    if (info.statsFormat != StatsFormat::NONE)
+    {
+        compiler.SetStatistics(&stats);
+        interpreter.SetStatistics(&stats);
+    }
     
+    int exitCode = 0;
     switch (info.command)
     {
-    case Execution::ExecutionCommand::COMPILE_CHIP16:
-        return 1;
+    case Execution::ExecutionCommand::CHECK:
+        exitCode = compiler.Compile(info.programFiles) ? 0 : 1;
+        break;
     case Execution::ExecutionCommand::COMPILE_LLVM:
         return 1;
     case Execution::ExecutionCommand::DUMP_AST:
-        compiler.DumpAST(info.programFile);
+        exitCode = compiler.DumpAST(info.programFiles) ? 0 : 1;
         break;
     case Execution::ExecutionCommand::DUMP_CFG:
-        return 1;
+        exitCode = compiler.DumpCFG(info.programFiles) ? 0 : 1;
+        break;
+#ifdef USE_LLVM_BACKEND
     case Execution::ExecutionCommand::DUMP_LLVM:
-        return 1;
+        exitCode = compiler.DumpLLVMIR(info.programFiles) ? 0 : 1;
+        break;
+#endif
     case Execution::ExecutionCommand::INTERPRET:
-        interpreter.Run(info.programFile);
+        exitCode = interpreter.Run(info.programFiles) ? 0 : 1;
         break;
     default:
         return 1;
     }
 
-    return 0;
+    // The measures go to stderr so that they don't mix with the output of the program
+    if (info.statsFormat == StatsFormat::TABLE)
+        stats.PrintTable(std::cerr);
+    else if (info.statsFormat == StatsFormat::JSON)
+        stats.PrintJSON(std::cerr);
+
+    return exitCode;
 }
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include "benchutils.h"
+
+#include "AST/ast.h"
+#include "AST/flatast.h"
+#include "Common/astvisitor.h"
+#include "Utils/astbinary.h"
+#include "Utils/astprinter.h"
+#include "Utils/astreader.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace TosLang::FrontEnd;
+using namespace TosLang::Utils;
+
+/*
+* \class   NodeCounter
+* \brief   Visitor doing nothing but counting the nodes of an AST, so that only the cost of the traversal is measured
+*/
+class NodeCounter : public TosLang::Common::ASTVisitor<NodeCounter>
+{
+    friend class TosLang::Common::ASTVisitor<NodeCounter>;
+
+public:
+    size_t Run(const std::unique_ptr<ASTNode>& root, bool isPostOrder)
+    {
+        mNbNodes = 0;
+        mDepth = 0;
+        if (isPostOrder)
+            VisitPostOrder(root);
+        else
+            VisitPreOrder(root);
+        return mNbNodes;
+    }
+
+protected:
+    void NodePrologue() { ++mNbNodes; ++mDepth; }
+    void NodeEpilogue() { --mDepth; }
+
+private:
+    size_t mNbNodes = 0;    /*!< Number of nodes visited */
+    size_t mDepth = 0;      /*!< Depth of the current node */
+};
+
+/*
+* \fn               WriteSyntheticAST
+* \brief            Parses a synthetic program and stores its AST in the temporary directory
+* \param nbBytes    Size of the synthetic program
+* \param isBinary   Is the AST stored in the binary AST format? The text format of the ASTPrinter is used otherwise.
+* \return           Name of the file containing the AST. Empty if the program couldn't be parsed.
+*/
+static std::string WriteSyntheticAST(size_t nbBytes, bool isBinary)
+{
+    const std::string programFile = WriteSyntheticProgram(nbBytes);
+
+    Parser parser;
+    std::unique_ptr<ASTNode> programAST = parser.ParseProgram(programFile);
+    std::filesystem::remove(programFile);
+    if (programAST == nullptr)
+        return "";
+
+    const std::string astFile = (std::filesystem::temp_directory_path() / ("toslang_bench_" + std::to_string(nbBytes) + (isBinary ? ".tast" : ".ast"))).string();
+    if (isBinary)
+    {
+        ASTBinaryWriter writer;
+        if (!writer.Run(programAST, astFile))
+            return "";
+    }
+    else
+    {
+        std::ofstream stream{ astFile };
+        ASTPrinter<std::ofstream> printer{ stream };
+        printer.Run(programAST);
+    }
+
+    return astFile;
+}
+
+/*
+* \fn               BM_ReadAST
+* \brief            Measures the time needed to rebuild the AST of a synthetic program from a file
+* \param state      Benchmark state. Its first argument is the size of the program in bytes,
+*                   its second argument is 1 to read the binary AST format and 0 to read the text format.
+*/
+static void BM_ReadAST(benchmark::State& state)
+{
+    const bool isBinary = state.range(1) != 0;
+    const std::string astFile = WriteSyntheticAST(static_cast<size_t>(state.range(0)), isBinary);
+    if (astFile.empty())
+    {
+        state.SkipWithError("Couldn't write the AST of the synthetic program");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        std::unique_ptr<ASTNode> programAST;
+        if (isBinary)
+            programAST = ASTBinaryReader{}.Run(astFile);
+        else
+            programAST = ASTReader{}.Run(astFile);
+
+        if (programAST == nullptr)
+        {
+            state.SkipWithError("Couldn't read the AST of the synthetic program");
+            break;
+        }
+        benchmark::DoNotOptimize(programAST.get());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(astFile)));
+    std::filesystem::remove(astFile);
+}
+
+/*
+* \fn               BM_VisitAST
+* \brief            Measures the time needed to traverse the AST of a synthetic program with a visitor doing no work
+* \param state      Benchmark state. Its first argument is the size of the program in bytes,
+*                   its second argument is 1 for a post-order traversal and 0 for a pre-order traversal.
+*/
+static void BM_VisitAST(benchmark::State& state)
+{
+    const std::string programFile = WriteSyntheticProgram(static_cast<size_t>(state.range(0)));
+
+    Parser parser;
+    std::unique_ptr<ASTNode> programAST = parser.ParseProgram(programFile);
+    std::filesystem::remove(programFile);
+    if (programAST == nullptr)
+    {
+        state.SkipWithError("Couldn't parse the synthetic program");
+        return;
+    }
+
+    NodeCounter counter;
+    size_t nbNodes = 0;
+    for (auto _ : state)
+    {
+        nbNodes = counter.Run(programAST, state.range(1) != 0);
+        benchmark::DoNotOptimize(nbNodes);
+    }
+
+    state.counters["nodes_per_second"] = benchmark::Counter(static_cast<double>(nbNodes * state.iterations()), benchmark::Counter::kIsRate);
+}
+
+/*
+* \fn               BM_PrintAST
+* \brief            Measures the time needed to print the AST of a synthetic program in the text format
+* \param state      Benchmark state. Its first argument is the size of the program in bytes.
+*/
+static void BM_PrintAST(benchmark::State& state)
+{
+    const std::string programFile = WriteSyntheticProgram(static_cast<size_t>(state.range(0)));
+
+    Parser parser;
+    std::unique_ptr<ASTNode> programAST = parser.ParseProgram(programFile);
+    std::filesystem::remove(programFile);
+    if (programAST == nullptr)
+    {
+        state.SkipWithError("Couldn't parse the synthetic program");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        std::stringstream stream;
+        ASTPrinter<std::stringstream> printer{ stream };
+        printer.Run(programAST);
+        benchmark::DoNotOptimize(stream);
+    }
+}
+
+/*
+* \fn               BM_FlattenAST
+* \brief            Measures the time needed to copy the AST of a synthetic program in a flat AST
+* \param state      Benchmark state. Its first argument is the size of the program in bytes.
+*/
+static void BM_FlattenAST(benchmark::State& state)
+{
+    const std::string programFile = WriteSyntheticProgram(static_cast<size_t>(state.range(0)));
+
+    Parser parser;
+    std::unique_ptr<ASTNode> programAST = parser.ParseProgram(programFile);
+    std::filesystem::remove(programFile);
+    if (programAST == nullptr)
+    {
+        state.SkipWithError("Couldn't parse the synthetic program");
+        return;
+    }
+
+    FlatAST flatAST;
+    for (auto _ : state)
+    {
+        flatAST.Build(programAST.get());
+        benchmark::DoNotOptimize(flatAST.GetNbNodes());
+    }
+
+    state.counters["nodes_per_second"] = benchmark::Counter(static_cast<double>(flatAST.GetNbNodes() * state.iterations()), benchmark::Counter::kIsRate);
+}
+
+/*
+* \fn               BM_ScanFlatAST
+* \brief            Measures the time needed to count the nodes of every kind of a synthetic program, scanning its flat AST
+*                   in pre-order. To be compared with BM_VisitAST, which goes through the same nodes in the tree.
+* \param state      Benchmark state. Its first argument is the size of the program in bytes.
+*/
+static void BM_ScanFlatAST(benchmark::State& state)
+{
+    const std::string programFile = WriteSyntheticProgram(static_cast<size_t>(state.range(0)));
+
+    Parser parser;
+    std::unique_ptr<ASTNode> programAST = parser.ParseProgram(programFile);
+    std::filesystem::remove(programFile);
+    if (programAST == nullptr)
+    {
+        state.SkipWithError("Couldn't parse the synthetic program");
+        return;
+    }
+
+    const FlatAST flatAST{ programAST.get() };
+    for (auto _ : state)
+    {
+        size_t nbNodesPerKind[static_cast<size_t>(ASTNode::NodeKind::WHILE_STMT) + 1] = {};
+        for (ASTNode::NodeKind kind : flatAST.GetKinds())
+            ++nbNodesPerKind[static_cast<size_t>(kind)];
+        benchmark::DoNotOptimize(nbNodesPerKind);
+    }
+
+    state.counters["nodes_per_second"] = benchmark::Counter(static_cast<double>(flatAST.GetNbNodes() * state.iterations()), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_ReadAST)->Args({ 1 << 20, 0 })->Args({ 1 << 20, 1 })->Args({ 16 << 20, 1 })->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VisitAST)->Args({ 4 << 20, 0 })->Args({ 4 << 20, 1 })->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PrintAST)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FlattenAST)->Arg(4 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ScanFlatAST)->Arg(4 << 20)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,112 @@
+#ifndef BENCH_UTILS_H__TOSLANG
+#define BENCH_UTILS_H__TOSLANG
+
+#include "Parse/parser.h"
+#include "Sema/symbolcollector.h"
+#include "Sema/symboltable.h"
+#include "Sema/typechecker.h"
+#include "VM/bytecodegenerator.h"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+/*
+* \fn               CompileProgram
+* \brief            Runs the front end and the bytecode generator on a TosLang program
+* \param filename   Name of a file containing a TosLang program
+* \return           Bytecode of the program. Nullptr if the program contains errors.
+*/
+inline std::unique_ptr<TosLang::VM::BytecodeModule> CompileProgram(const std::string& filename)
+{
+    using namespace TosLang::FrontEnd;
+
+    Parser parser;
+    std::unique_ptr<ASTNode> programAST = parser.ParseProgram(filename);
+    if (programAST == nullptr)
+        return nullptr;
+
+    auto symTable = std::make_shared<SymbolTable>();
+    SymbolCollector sCollector{ symTable };
+    if (sCollector.Run(programAST) != 0)
+        return nullptr;
+
+    TypeChecker tChecker;
+    if (tChecker.Run(programAST, symTable) != 0)
+        return nullptr;
+
+    TosLang::VM::BytecodeGenerator generator;
+    return generator.Run(programAST, symTable);
+}
+
+/*
+* \fn               GetFunctionIdx
+* \brief            Finds a function of a bytecode module by its name
+* \param module     Bytecode module
+* \param fnName     Name of the function
+* \return           Index of the first function having the given name
+*/
+inline size_t GetFunctionIdx(const TosLang::VM::BytecodeModule& module, const std::string& fnName)
+{
+    const auto& functions = module.GetFunctions();
+    for (size_t iFn = 0; iFn < functions.size(); ++iFn)
+    {
+        if (functions[iFn].GetName() == fnName)
+            return iFn;
+    }
+
+    return functions.size();
+}
+
+/*
+* \fn               GenerateSyntheticProgram
+* \brief            Generates a valid TosLang program made of many small functions. The functions mix 
+*                   comments, indentation, declarations, literals and control flow like a hand written program.
+* \param nbBytes    Minimal size of the program
+* \return           Source code of the program
+*/
+inline std::string GenerateSyntheticProgram(size_t nbBytes)
+{
+    std::ostringstream program;
+    for (size_t iFn = 0; static_cast<size_t>(program.tellp()) < nbBytes; ++iFn)
+    {
+        program << "// Function number " << iFn << " accumulates its arguments\n"
+                << "fn function" << iFn << "(firstArgument : Int, secondArgument : Int) -> Int\n"
+                << "{\n"
+                << "    var accumulator : Int = " << iFn % 1000 << ";\n"
+                << "    var message : String = \"Hello from function " << iFn << "\";\n"
+                << "    while accumulator < 123456\n"
+                << "    {\n"
+                << "        accumulator = accumulator + firstArgument * 2 + secondArgument;\n"
+                << "    }\n"
+                << "\n"
+                << "    if accumulator == 42\n"
+                << "    {\n"
+                << "        print message;\n"
+                << "    }\n"
+                << "\n"
+                << "    return accumulator;\n"
+                << "}\n\n";
+    }
+
+    return program.str();
+}
+
+/*
+* \fn               WriteSyntheticProgram
+* \brief            Writes a synthetic program of (at least) a given size in the temporary directory
+* \param nbBytes    Size of the program
+* \return           Name of the file containing the program
+*/
+inline std::string WriteSyntheticProgram(size_t nbBytes)
+{
+    const std::string filename = (std::filesystem::temp_directory_path() / ("toslang_bench_" + std::to_string(nbBytes) + ".tos")).string();
+
+    std::ofstream stream{ filename, std::ios::binary };
+    stream << GenerateSyntheticProgram(nbBytes);
+    return filename;
+}
+
+#endif // BENCH_UTILS_H__TOSLANG
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Runs the phase benchmarks and compares their timings with a stored baseline.
+
+Usage:
+    comparebaseline.py [--update] [--threshold PERCENT] BENCHMARK_EXECUTABLE BASELINE_FILE
+
+The script exits with a non zero status when a benchmark got slower than its
+baseline by more than the threshold. With --update, the baseline is replaced
+by the new timings instead.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+
+def run_benchmarks(executable):
+    """Runs the benchmark executable and returns its Google Benchmark JSON report"""
+    fd, out_file = tempfile.mkstemp(suffix='.json')
+    os.close(fd)
+    try:
+        # The median of a few repetitions is less sensitive to the noise of the machine
+        subprocess.check_call([executable,
+                               '--benchmark_repetitions=5',
+                               '--benchmark_report_aggregates_only=true',
+                               '--benchmark_out=' + out_file,
+                               '--benchmark_out_format=json'])
+        with open(out_file) as stream:
+            return json.load(stream)
+    finally:
+        os.remove(out_file)
+
+
+def get_timings(report):
+    """Maps the name of every benchmark of a report to its median CPU time, in milliseconds"""
+    factors = {'ns': 1e-6, 'us': 1e-3, 'ms': 1.0, 's': 1e3}
+    timings = {}
+    for bench in report['benchmarks']:
+        if bench.get('aggregate_name') != 'median' or 'error_occurred' in bench:
+            continue
+        timings[bench['run_name']] = bench['cpu_time'] * factors[bench.get('time_unit', 'ns')]
+    return timings
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compares the phase benchmarks with their baseline')
+    parser.add_argument('--update', action='store_true', help='replace the baseline with the new timings')
+    parser.add_argument('--threshold', type=float, default=15.0, help='tolerated slowdown, in percent')
+    parser.add_argument('executable', help='phase benchmarks executable')
+    parser.add_argument('baseline', help='baseline file')
+    args = parser.parse_args()
+
+    timings = get_timings(run_benchmarks(args.executable))
+
+    if args.update:
+        with open(args.baseline, 'w') as stream:
+            json.dump({'unit': 'ms', 'benchmarks': timings}, stream, indent=4, sort_keys=True)
+            stream.write('\n')
+        print('Baseline updated with {} benchmarks'.format(len(timings)))
+        return 0
+
+    with open(args.baseline) as stream:
+        baseline = json.load(stream)['benchmarks']
+
+    nb_regressions = 0
+    print('{:<50} {:>12} {:>12} {:>9}'.format('Benchmark', 'Baseline', 'Current', 'Change'))
+    for name in sorted(timings):
+        if name not in baseline:
+            print('{:<50} {:>12} {:>10.3f}ms {:>9}'.format(name, '-', timings[name], 'new'))
+            continue
+
+        change = (timings[name] - baseline[name]) / baseline[name] * 100.0
+        status = ''
+        if change > args.threshold:
+            status = ' REGRESSION'
+            nb_regressions += 1
+        print('{:<50} {:>10.3f}ms {:>10.3f}ms {:>+8.1f}%{}'.format(name, baseline[name], timings[name], change, status))
+
+    for name in sorted(set(baseline) - set(timings)):
+        print('{:<50} {:>10.3f}ms {:>12} {:>9}'.format(name, baseline[name], '-', 'missing'))
+
+    if nb_regressions != 0:
+        print('{} benchmarks are more than {}% slower than the baseline'.format(nb_regressions, args.threshold))
+        return 1
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,85 @@
+#include "benchutils.h"
+
+#include "Parse/lexer.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace TosLang::FrontEnd;
+
+/*
+* \fn               BM_Lexer
+* \brief            Measures the throughput of the lexer over a synthetic program
+* \param state      Benchmark state. Its first argument is the size of the program in bytes.
+* \param mode       How the lexer acquires the content of the file
+*/
+static void BM_Lexer(benchmark::State& state, Lexer::LoadingMode mode)
+{
+    const size_t nbBytes = static_cast<size_t>(state.range(0));
+    const std::string filename = WriteSyntheticProgram(nbBytes);
+
+    size_t nbTokens = 0;
+    for (auto _ : state)
+    {
+        Lexer lex;
+        if (!lex.Init(filename, mode))
+        {
+            state.SkipWithError("Couldn't open the synthetic program");
+            break;
+        }
+
+        while (lex.GetNextToken() != Lexer::Token::TOK_EOF)
+            ++nbTokens;
+
+        benchmark::DoNotOptimize(nbTokens);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(filename)));
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(nbTokens), benchmark::Counter::kIsRate);
+    std::filesystem::remove(filename);
+}
+
+/*
+* \fn               BM_LexerWords
+* \brief            Measures how fast the lexer tells keywords from identifiers, over a file made only of words
+* \param state      Benchmark state. Its first argument is the size of the file in bytes.
+*/
+static void BM_LexerWords(benchmark::State& state)
+{
+    // Keywords, identifiers looking like keywords and regular identifiers
+    static const char* const words[] = { "fn", "var", "accumulator", "Int", "return", "iff", "message", "while", "Strings",
+                                         "secondArgument", "if", "True", "spawn", "value", "print", "sync", "returned", "Bool" };
+
+    const size_t nbBytes = static_cast<size_t>(state.range(0));
+    const std::string filename = (std::filesystem::temp_directory_path() / "toslang_bench_words.tos").string();
+    {
+        std::ofstream stream{ filename, std::ios::binary };
+        for (size_t iWord = 0; static_cast<size_t>(stream.tellp()) < nbBytes; ++iWord)
+            stream << words[iWord % (sizeof(words) / sizeof(words[0]))] << (iWord % 16 == 15 ? '\n' : ' ');
+    }
+
+    size_t nbTokens = 0;
+    for (auto _ : state)
+    {
+        Lexer lex;
+        if (!lex.Init(filename, Lexer::LoadingMode::MEMORY_MAP))
+        {
+            state.SkipWithError("Couldn't open the synthetic program");
+            break;
+        }
+
+        while (lex.GetNextToken() != Lexer::Token::TOK_EOF)
+            ++nbTokens;
+
+        benchmark::DoNotOptimize(nbTokens);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(filename)));
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(nbTokens), benchmark::Counter::kIsRate);
+    std::filesystem::remove(filename);
+}
+
+BENCHMARK_CAPTURE(BM_Lexer, MemoryMap, Lexer::LoadingMode::MEMORY_MAP)->Arg(4 << 20)->Arg(32 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Lexer, Copy, Lexer::LoadingMode::COPY)->Arg(4 << 20)->Arg(32 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LexerWords)->Arg(4 << 20)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
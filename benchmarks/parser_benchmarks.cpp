@@ -0,0 +1,108 @@
+#include "benchutils.h"
+
+#include "AST/ast.h"
+#include "Utils/scheduler.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace TosLang::FrontEnd;
+
+// Every heap allocation of the process goes through here so that the benchmarks can count them.
+// It is kept out of line, otherwise GCC pairs the inlined malloc with the library's delete and warns.
+static std::atomic<size_t> gNbAllocations{ 0 };
+
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void* operator new(size_t size)
+{
+    ++gNbAllocations;
+    if (void* ptr = std::malloc(size != 0 ? size : 1))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+/*
+* \fn               BM_Parser
+* \brief            Measures the time needed to build and free the AST of a synthetic program
+* \param state      Benchmark state. Its first argument is the size of the program in bytes.
+*/
+static void BM_Parser(benchmark::State& state)
+{
+    const size_t nbBytes = static_cast<size_t>(state.range(0));
+    const std::string filename = WriteSyntheticProgram(nbBytes);
+
+    size_t nbAllocations = 0;
+    for (auto _ : state)
+    {
+        const size_t nbAllocationsBefore = gNbAllocations;
+        {
+            Parser parser;
+            std::unique_ptr<ASTNode> programAST = parser.ParseProgram(filename);
+            if (programAST == nullptr)
+            {
+                state.SkipWithError("Couldn't parse the synthetic program");
+                break;
+            }
+            benchmark::DoNotOptimize(programAST.get());
+        }
+        nbAllocations += gNbAllocations - nbAllocationsBefore;
+    }
+
+    const std::string program = GenerateSyntheticProgram(nbBytes);
+    const size_t nbLines = static_cast<size_t>(std::count(program.begin(), program.end(), '\n'));
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * program.size()));
+    state.counters["allocs_per_kloc"] = static_cast<double>(nbAllocations) * 1000.0 / (static_cast<double>(nbLines) * state.iterations());
+    std::filesystem::remove(filename);
+}
+
+/*
+* \fn               BM_ParserFiles
+* \brief            Measures the time needed to parse a program spread over many files
+* \param state      Benchmark state. Its first argument is the number of files, its second the number of workers.
+*/
+static void BM_ParserFiles(benchmark::State& state)
+{
+    const size_t nbFiles = static_cast<size_t>(state.range(0));
+    const std::string program = GenerateSyntheticProgram(64 << 10);
+
+    std::vector<std::string> filenames;
+    for (size_t iFile = 0; iFile < nbFiles; ++iFile)
+    {
+        filenames.push_back((std::filesystem::temp_directory_path() / ("toslang_bench_file" + std::to_string(iFile) + ".tos")).string());
+        std::ofstream stream{ filenames.back(), std::ios::binary };
+        stream << program;
+    }
+
+    TosLang::Utils::Scheduler scheduler{ static_cast<size_t>(state.range(1)) };
+    for (auto _ : state)
+    {
+        std::unique_ptr<ASTNode> programAST = Parser::ParseProgram(filenames, scheduler);
+        if (programAST == nullptr)
+        {
+            state.SkipWithError("Couldn't parse the synthetic program");
+            break;
+        }
+        benchmark::DoNotOptimize(programAST.get());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * program.size() * nbFiles));
+    for (const std::string& filename : filenames)
+        std::filesystem::remove(filename);
+}
+
+BENCHMARK(BM_Parser)->Arg(4 << 20)->Arg(32 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParserFiles)->Args({ 256, 1 })->Args({ 256, 2 })->Args({ 256, 4 })->Args({ 256, 8 })->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,315 @@
+#include "benchutils.h"
+#include "programgenerator.h"
+
+#include "Parse/lexer.h"
+#include "SSA/cfgbuilder.h"
+#include "SSA/constantfolding.h"
+#include "SSA/deadcodeelimination.h"
+#include "SSA/globalvaluenumbering.h"
+#include "SSA/loopinvariantcodemotion.h"
+#include "SSA/sccp.h"
+#include "SSA/ssapassmanager.h"
+#include "SSA/unreachableblockelimination.h"
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+
+using namespace TosLang::FrontEnd;
+
+/*
+* \enum     Phase
+* \brief    Phases of the compiler measured on their own
+*/
+enum class Phase
+{
+    LEXER,
+    PARSER,
+    SYMBOL_COLLECTOR,
+    TYPE_CHECKER,
+    CFG_BUILDER,
+    CFG_ANALYSIS,
+    SSA_PASSES,
+    CONSTANT_FOLDING,               // The SSA passes, in the order of the optimization pipeline
+    SCCP,
+    UNREACHABLE_BLOCK_ELIMINATION,
+    GLOBAL_VALUE_NUMBERING,
+    LOOP_INVARIANT_CODE_MOTION,
+    DEAD_CODE_ELIMINATION,
+    BYTECODE_GENERATOR,
+};
+
+/*
+* \fn           MakeSSAPass
+* \brief        Creates the SSA pass measured by a phase
+* \param phase  Phase measuring a single SSA pass
+* \return       SSA pass
+*/
+static std::unique_ptr<TosLang::BackEnd::SSAPass> MakeSSAPass(Phase phase)
+{
+    switch (phase)
+    {
+    case Phase::CONSTANT_FOLDING:               return std::make_unique<TosLang::BackEnd::ConstantFolding>();
+    case Phase::SCCP:                           return std::make_unique<TosLang::BackEnd::SCCP>();
+    case Phase::UNREACHABLE_BLOCK_ELIMINATION:  return std::make_unique<TosLang::BackEnd::UnreachableBlockElimination>();
+    case Phase::GLOBAL_VALUE_NUMBERING:         return std::make_unique<TosLang::BackEnd::GlobalValueNumbering>();
+    case Phase::LOOP_INVARIANT_CODE_MOTION:     return std::make_unique<TosLang::BackEnd::LoopInvariantCodeMotion>();
+    case Phase::DEAD_CODE_ELIMINATION:          return std::make_unique<TosLang::BackEnd::DeadCodeElimination>();
+    default:                                    return nullptr;
+    }
+}
+
+/*
+* \struct   ProgramState
+* \brief    Synthetic program run through every phase preceding the measured one
+*/
+struct ProgramState
+{
+    std::string filename;                       /*!< File containing the program */
+    std::unique_ptr<ASTNode> programAST;        /*!< Program abstract syntax tree */
+    std::shared_ptr<SymbolTable> symTable;      /*!< Symbols of the program */
+};
+
+/*
+* \fn           PrepareProgram
+* \brief        Generates a synthetic program and runs it through every phase preceding the measured one
+* \param state  Benchmark state, reporting the errors
+* \param shape  Kind of program to generate
+* \param size   Size of the program, in units of its shape
+* \param phase  Measured phase
+* \param prog   Program ready to be given to the measured phase
+* \return       False if one of the preceding phases failed
+*/
+static bool PrepareProgram(benchmark::State& state, ProgramShape shape, size_t size, Phase phase, ProgramState& prog)
+{
+    prog.filename = WriteProgram(shape, size);
+    if (phase <= Phase::PARSER)
+        return true;
+
+    Parser parser;
+    prog.programAST = parser.ParseProgram(prog.filename);
+    std::filesystem::remove(prog.filename);
+    if (prog.programAST == nullptr)
+    {
+        state.SkipWithError("Couldn't parse the synthetic program");
+        return false;
+    }
+
+    if (phase <= Phase::SYMBOL_COLLECTOR)
+        return true;
+
+    prog.symTable = std::make_shared<SymbolTable>();
+    SymbolCollector sCollector{ prog.symTable };
+    TypeChecker tChecker;
+    if ((sCollector.Run(prog.programAST) != 0) || ((phase > Phase::TYPE_CHECKER) && (tChecker.Run(prog.programAST, prog.symTable) != 0)))
+    {
+        state.SkipWithError("The synthetic program contains errors");
+        return false;
+    }
+
+    return true;
+}
+
+/*
+* \fn           BM_Phase
+* \brief        Measures one phase of the compiler over a synthetic program. The phases preceding it are run beforehand.
+* \param state  Benchmark state
+* \param shape  Kind of program to generate
+* \param size   Size of the program, in units of its shape
+* \param phase  Measured phase
+*/
+static void BM_Phase(benchmark::State& state, ProgramShape shape, size_t size, Phase phase)
+{
+    ProgramState prog;
+    if (!PrepareProgram(state, shape, size, phase, prog))
+        return;
+
+    std::unique_ptr<TosLang::BackEnd::SSAModule> cfgModule;
+    if (phase == Phase::CFG_ANALYSIS)
+        cfgModule = TosLang::BackEnd::CFGBuilder{}.Run(prog.programAST, prog.symTable);
+
+    size_t nbItems = 0;
+    for (auto _ : state)
+    {
+        switch (phase)
+        {
+        case Phase::LEXER:
+        {
+            Lexer lex;
+            lex.Init(prog.filename);
+            while (lex.GetNextToken() != Lexer::Token::TOK_EOF)
+                ++nbItems;
+            break;
+        }
+        case Phase::PARSER:
+        {
+            Parser parser;
+            std::unique_ptr<ASTNode> programAST = parser.ParseProgram(prog.filename);
+            benchmark::DoNotOptimize(programAST.get());
+            break;
+        }
+        case Phase::SYMBOL_COLLECTOR:
+        {
+            auto symTable = std::make_shared<SymbolTable>();
+            SymbolCollector sCollector{ symTable };
+            sCollector.Run(prog.programAST);
+            nbItems += symTable->GetNbSymbols();
+            break;
+        }
+        case Phase::TYPE_CHECKER:
+        {
+            TypeChecker tChecker;
+            tChecker.Run(prog.programAST, prog.symTable);
+            break;
+        }
+        case Phase::CFG_BUILDER:
+        {
+            TosLang::BackEnd::CFGBuilder builder;
+            auto module = builder.Run(prog.programAST, prog.symTable);
+            benchmark::DoNotOptimize(module.get());
+            break;
+        }
+        case Phase::CFG_ANALYSIS:
+        {
+            // Graphs keep their analysis until they change, so the graphs of the module are analyzed apart from them
+            TosLang::BackEnd::CFGAnalysis<TosLang::BackEnd::SSAInstruction> analysis;
+            for (auto& funcCFG : *cfgModule)
+            {
+                analysis.Compute(funcCFG.second->GetBlocks());
+                nbItems += analysis.GetRPOBlocks().size();
+            }
+            break;
+        }
+        case Phase::SSA_PASSES:
+        {
+            // The passes transform the module, so a new one is built for every iteration
+            state.PauseTiming();
+            TosLang::BackEnd::CFGBuilder builder;
+            auto module = builder.Run(prog.programAST, prog.symTable);
+            state.ResumeTiming();
+
+            TosLang::BackEnd::SSAPassManager passManager;
+            passManager.AddOptimizationPasses();
+            nbItems += passManager.Run(*module);
+
+            // The module is destroyed outside of the measure as well
+            state.PauseTiming();
+            module.reset();
+            state.ResumeTiming();
+            break;
+        }
+        case Phase::CONSTANT_FOLDING:
+        case Phase::SCCP:
+        case Phase::UNREACHABLE_BLOCK_ELIMINATION:
+        case Phase::GLOBAL_VALUE_NUMBERING:
+        case Phase::LOOP_INVARIANT_CODE_MOTION:
+        case Phase::DEAD_CODE_ELIMINATION:
+        {
+            // The pass is given the module the passes preceding it in the pipeline would give it, 
+            // which is built and transformed outside of the measure for every iteration
+            state.PauseTiming();
+            TosLang::BackEnd::CFGBuilder builder;
+            auto module = builder.Run(prog.programAST, prog.symTable);
+            TosLang::BackEnd::SSAPassManager precedingPasses;
+            for (Phase passPhase = Phase::CONSTANT_FOLDING; passPhase < phase; passPhase = static_cast<Phase>(static_cast<int>(passPhase) + 1))
+                precedingPasses.AddPass(MakeSSAPass(passPhase));
+            precedingPasses.Run(*module);
+
+            TosLang::BackEnd::SSAPassManager passManager;
+            passManager.AddPass(MakeSSAPass(phase));
+            state.ResumeTiming();
+
+            nbItems += passManager.Run(*module);
+
+            state.PauseTiming();
+            module.reset();
+            state.ResumeTiming();
+            break;
+        }
+        case Phase::BYTECODE_GENERATOR:
+        {
+            TosLang::VM::BytecodeGenerator generator;
+            auto module = generator.Run(prog.programAST, prog.symTable);
+            benchmark::DoNotOptimize(module.get());
+            break;
+        }
+        }
+    }
+
+    if (phase == Phase::LEXER)
+        state.counters["tokens"] = benchmark::Counter(static_cast<double>(nbItems), benchmark::Counter::kIsRate);
+    else if (phase == Phase::SYMBOL_COLLECTOR)
+        state.counters["symbols"] = benchmark::Counter(static_cast<double>(nbItems), benchmark::Counter::kIsRate);
+    else if (phase == Phase::CFG_ANALYSIS)
+        state.counters["blocks"] = benchmark::Counter(static_cast<double>(nbItems), benchmark::Counter::kIsRate);
+    else if ((phase >= Phase::SSA_PASSES) && (phase <= Phase::DEAD_CODE_ELIMINATION))
+        state.counters["changes"] = benchmark::Counter(static_cast<double>(nbItems), benchmark::Counter::kAvgIterations);
+
+    if (phase <= Phase::PARSER)
+        std::filesystem::remove(prog.filename);
+}
+
+int main(int argc, char** argv)
+{
+    // Sizes giving programs of a few hundred kilobytes
+    const std::pair<ProgramShape, size_t> programs[] = {
+        { ProgramShape::DEEP_CALLS, 4000 },
+        { ProgramShape::OVERLOADS, 1000 },
+        { ProgramShape::STRAIGHT_LINE, 8000 },
+        { ProgramShape::NESTED_CONTROL_FLOW, 200 },
+        { ProgramShape::ARRAY_LITERALS, 8000 },
+    };
+
+    const std::pair<Phase, const char*> phases[] = {
+        { Phase::LEXER, "Lexer" },
+        { Phase::PARSER, "Parser" },
+        { Phase::SYMBOL_COLLECTOR, "SymbolCollector" },
+        { Phase::TYPE_CHECKER, "TypeChecker" },
+        { Phase::CFG_BUILDER, "CFGBuilder" },
+        { Phase::CFG_ANALYSIS, "CFGAnalysis" },
+        { Phase::SSA_PASSES, "SSAPasses" },
+        { Phase::CONSTANT_FOLDING, "ConstantFolding" },
+        { Phase::SCCP, "SCCP" },
+        { Phase::UNREACHABLE_BLOCK_ELIMINATION, "UnreachableBlockElimination" },
+        { Phase::GLOBAL_VALUE_NUMBERING, "GlobalValueNumbering" },
+        { Phase::LOOP_INVARIANT_CODE_MOTION, "LoopInvariantCodeMotion" },
+        { Phase::DEAD_CODE_ELIMINATION, "DeadCodeElimination" },
+        { Phase::BYTECODE_GENERATOR, "BytecodeGenerator" },
+    };
+
+    for (const auto& program : programs)
+    {
+        for (const auto& phase : phases)
+        {
+            // The CFG builder doesn't lower strings and arrays yet
+            const bool needsCFG = (phase.first >= Phase::CFG_BUILDER) && (phase.first <= Phase::DEAD_CODE_ELIMINATION);
+            if (needsCFG && ((program.first == ProgramShape::OVERLOADS) || (program.first == ProgramShape::ARRAY_LITERALS)))
+                continue;
+
+            // A straight line program is a single block, whose analysis takes too little time to be measured reliably
+            if ((phase.first == Phase::CFG_ANALYSIS) && (program.first == ProgramShape::STRAIGHT_LINE))
+                continue;
+
+            // So are the passes working on branches and loops over programs whose functions are single blocks
+            const bool needsBranches = (phase.first == Phase::UNREACHABLE_BLOCK_ELIMINATION) || (phase.first == Phase::LOOP_INVARIANT_CODE_MOTION);
+            if (needsBranches && ((program.first == ProgramShape::DEEP_CALLS) || (program.first == ProgramShape::STRAIGHT_LINE)))
+                continue;
+
+            const std::string name = std::string{ "BM_" } + phase.second + "/" + GetShapeName(program.first) + "/" + std::to_string(program.second);
+            auto* bench = benchmark::RegisterBenchmark(name.c_str(), BM_Phase, program.first, program.second, phase.first)->Unit(benchmark::kMillisecond);
+
+            // Every iteration of a single SSA pass builds and transforms a module outside of the measure, which takes far longer 
+            // than the pass itself. Left to pick the number of iterations, the library would spend minutes on every benchmark.
+            if ((phase.first >= Phase::CONSTANT_FOLDING) && (phase.first <= Phase::DEAD_CODE_ELIMINATION))
+                bench->Iterations(50);
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
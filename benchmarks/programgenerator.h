@@ -0,0 +1,161 @@
+#ifndef PROGRAM_GENERATOR_H__TOSLANG
+#define PROGRAM_GENERATOR_H__TOSLANG
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+/*
+* \enum     ProgramShape
+* \brief    Kinds of synthetic programs, each one stressing a different part of the compiler
+*/
+enum class ProgramShape
+{
+    DEEP_CALLS,             /*!< Chain of functions, each one calling the previous one */
+    OVERLOADS,              /*!< Functions sharing the same name, called with every parameter type */
+    STRAIGHT_LINE,          /*!< Single function made of a long sequence of arithmetic statements */
+    NESTED_CONTROL_FLOW,    /*!< Deeply nested while and if statements */
+    ARRAY_LITERALS,         /*!< Global arrays initialized with large array literals */
+};
+
+/*
+* \fn       GetShapeName
+* \brief    Gives the name of a kind of synthetic programs
+* \param    shape Kind of synthetic programs
+* \return   Name of the shape, as it appears in the benchmark names
+*/
+inline const char* GetShapeName(ProgramShape shape)
+{
+    switch (shape)
+    {
+    case ProgramShape::DEEP_CALLS:          return "DeepCalls";
+    case ProgramShape::OVERLOADS:           return "Overloads";
+    case ProgramShape::STRAIGHT_LINE:       return "StraightLine";
+    case ProgramShape::NESTED_CONTROL_FLOW: return "NestedControlFlow";
+    case ProgramShape::ARRAY_LITERALS:      return "ArrayLiterals";
+    default:                                return "Unknown";
+    }
+}
+
+/*
+* \fn           GenerateProgram
+* \brief        Generates a valid TosLang program of the given shape. Every program has a main function.
+* \param shape  Kind of program to generate
+* \param size   Size of the program, in units of its shape:
+*                   DEEP_CALLS          number of functions in the call chain
+*                   OVERLOADS           number of overload sets, of 3 functions each
+*                   STRAIGHT_LINE       number of statements
+*                   NESTED_CONTROL_FLOW nesting depth
+*                   ARRAY_LITERALS      number of elements of each of the 8 arrays
+* \return       Source code of the program
+*/
+inline std::string GenerateProgram(ProgramShape shape, size_t size)
+{
+    std::ostringstream program;
+    switch (shape)
+    {
+    case ProgramShape::DEEP_CALLS:
+        program << "fn depth0(value : Int) -> Int\n{\n    return value;\n}\n\n";
+        for (size_t iFn = 1; iFn < size; ++iFn)
+        {
+            program << "fn depth" << iFn << "(value : Int) -> Int\n"
+                    << "{\n"
+                    << "    var result : Int = depth" << iFn - 1 << "(value);\n"
+                    << "    return result + " << iFn % 7 + 1 << ";\n"
+                    << "}\n\n";
+        }
+        program << "fn main() -> Void\n{\n    print depth" << (size > 0 ? size - 1 : 0) << "(1);\n    return;\n}\n";
+        break;
+
+    case ProgramShape::OVERLOADS:
+        for (size_t iSet = 0; iSet < size; ++iSet)
+        {
+            program << "fn convert" << iSet << "(value : Int) -> Int\n{\n    return value * " << iSet % 5 + 2 << ";\n}\n\n"
+                    << "fn convert" << iSet << "(value : Bool) -> Bool\n{\n    return value && True;\n}\n\n"
+                    << "fn convert" << iSet << "(value : String) -> String\n{\n    return value;\n}\n\n";
+        }
+        program << "fn main() -> Void\n{\n"
+                << "    var number : Int = 3;\n"
+                << "    var flag : Bool = False;\n"
+                << "    var text : String = \"Overloads\";\n";
+        for (size_t iSet = 0; iSet < size; ++iSet)
+        {
+            program << "    number = convert" << iSet << "(number);\n"
+                    << "    flag = convert" << iSet << "(flag);\n"
+                    << "    text = convert" << iSet << "(text);\n";
+        }
+        program << "    print number;\n    return;\n}\n";
+        break;
+
+    case ProgramShape::STRAIGHT_LINE:
+        program << "fn compute(first : Int, second : Int) -> Int\n{\n"
+                << "    var accumulator : Int = first;\n"
+                << "    var other : Int = second;\n";
+        for (size_t iStmt = 0; iStmt < size; ++iStmt)
+        {
+            if (iStmt % 2 == 0)
+                program << "    accumulator = accumulator * " << iStmt % 9 + 1 << " + other - " << iStmt % 13 << ";\n";
+            else
+                program << "    other = other + accumulator % " << iStmt % 11 + 1 << ";\n";
+        }
+        program << "    return accumulator + other;\n}\n\n"
+                << "fn main() -> Void\n{\n    print compute(1, 2);\n    return;\n}\n";
+        break;
+
+    case ProgramShape::NESTED_CONTROL_FLOW:
+        program << "fn nested(limit : Int) -> Int\n{\n"
+                << "    var total : Int = 0;\n";
+        for (size_t iDepth = 0; iDepth < size; ++iDepth)
+        {
+            const std::string indent(4 * (iDepth + 1), ' ');
+            program << indent << "var counter" << iDepth << " : Int = 0;\n";
+            if (iDepth % 2 == 0)
+                program << indent << "while counter" << iDepth << " < limit\n" << indent << "{\n"
+                        << indent << "    counter" << iDepth << " = counter" << iDepth << " + 1;\n";
+            else
+                program << indent << "if counter" << iDepth - 1 << " > " << iDepth % 3 << "\n" << indent << "{\n";
+            program << indent << "    total = total + " << iDepth + 1 << ";\n";
+        }
+        for (size_t iDepth = size; iDepth > 0; --iDepth)
+            program << std::string(4 * iDepth, ' ') << "}\n";
+        program << "    return total;\n}\n\n"
+                << "fn main() -> Void\n{\n    print nested(2);\n    return;\n}\n";
+        break;
+
+    case ProgramShape::ARRAY_LITERALS:
+        for (size_t iArray = 0; iArray < 8; ++iArray)
+        {
+            program << "var values" << iArray << " : Int[" << size << "] = { ";
+            for (size_t iElem = 0; iElem < size; ++iElem)
+                program << (iElem != 0 ? ", " : "") << (iElem * 31 + iArray) % 1000;
+            program << " };\n";
+        }
+        program << "\nfn main() -> Void\n{\n    print \"Arrays\";\n    return;\n}\n";
+        break;
+
+    default:
+        break;
+    }
+
+    return program.str();
+}
+
+/*
+* \fn           WriteProgram
+* \brief        Writes a synthetic program of the given shape in the temporary directory
+* \param shape  Kind of program to generate
+* \param size   Size of the program, in units of its shape
+* \return       Name of the file containing the program
+*/
+inline std::string WriteProgram(ProgramShape shape, size_t size)
+{
+    const std::string filename = (std::filesystem::temp_directory_path() / ("toslang_bench_" + std::string{ GetShapeName(shape) } + std::to_string(size) + ".tos")).string();
+
+    std::ofstream stream{ filename, std::ios::binary };
+    stream << GenerateProgram(shape, size);
+    return filename;
+}
+
+#endif // PROGRAM_GENERATOR_H__TOSLANG
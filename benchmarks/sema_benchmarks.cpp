@@ -0,0 +1,82 @@
+#include "benchutils.h"
+
+#include "Utils/scheduler.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace TosLang::FrontEnd;
+
+/*
+* \fn               BM_Sema
+* \brief            Measures the time needed to collect the symbols of a synthetic program and to type check it
+* \param state      Benchmark state. Its first argument is the size of the program in bytes.
+*/
+static void BM_Sema(benchmark::State& state)
+{
+    const std::string filename = WriteSyntheticProgram(static_cast<size_t>(state.range(0)));
+
+    Parser parser;
+    std::unique_ptr<ASTNode> programAST = parser.ParseProgram(filename);
+    std::filesystem::remove(filename);
+    if (programAST == nullptr)
+    {
+        state.SkipWithError("Couldn't parse the synthetic program");
+        return;
+    }
+
+    // Every function of the synthetic program declares itself, two parameters and two variables
+    const size_t nbDecls = programAST->GetChildrenNodes().size() * 5;
+
+    for (auto _ : state)
+    {
+        auto symTable = std::make_shared<SymbolTable>();
+        SymbolCollector sCollector{ symTable };
+        TypeChecker tChecker;
+        if ((sCollector.Run(programAST) != 0) || (tChecker.Run(programAST, symTable) != 0))
+        {
+            state.SkipWithError("The synthetic program contains errors");
+            break;
+        }
+    }
+
+    state.counters["decls"] = static_cast<double>(nbDecls);
+    state.counters["decls_per_second"] = benchmark::Counter(static_cast<double>(nbDecls * state.iterations()), benchmark::Counter::kIsRate);
+}
+
+/*
+* \fn               BM_TypeCheckParallel
+* \brief            Measures the time needed to type check a synthetic program, one range of declarations per task
+* \param state      Benchmark state. Its first argument is the size of the program in bytes, its second the number of workers.
+*/
+static void BM_TypeCheckParallel(benchmark::State& state)
+{
+    const std::string filename = WriteSyntheticProgram(static_cast<size_t>(state.range(0)));
+
+    Parser parser;
+    std::unique_ptr<ASTNode> programAST = parser.ParseProgram(filename);
+    std::filesystem::remove(filename);
+
+    auto symTable = std::make_shared<SymbolTable>();
+    SymbolCollector sCollector{ symTable };
+    if ((programAST == nullptr) || (sCollector.Run(programAST) != 0))
+    {
+        state.SkipWithError("The synthetic program contains errors");
+        return;
+    }
+
+    TosLang::Utils::Scheduler scheduler{ static_cast<size_t>(state.range(1)) };
+    for (auto _ : state)
+    {
+        TypeChecker tChecker;
+        if (tChecker.Run(programAST, symTable, scheduler) != 0)
+        {
+            state.SkipWithError("The synthetic program contains errors");
+            break;
+        }
+    }
+}
+
+BENCHMARK(BM_Sema)->Arg(64 << 10)->Arg(256 << 10)->Arg(1 << 20)->Arg(4 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TypeCheckParallel)->Args({ 4 << 20, 1 })->Args({ 4 << 20, 2 })->Args({ 4 << 20, 4 })->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,55 @@
+#include "benchutils.h"
+
+#include "VM/virtualmachine.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace TosLang::VM;
+
+/*
+* \fn               BM_Fib
+* \brief            Measures the execution of one of the fibonacci functions of fib.tos
+* \param state      Benchmark state. Its first argument is given to the function.
+* \param mode       Dispatch mode used by the virtual machine
+* \param fnName     Name of the function to call (fibRec or fibSeq)
+*/
+static void BM_Fib(benchmark::State& state, DispatchMode mode, const char* fnName)
+{
+    if ((mode == DispatchMode::THREADED) && !VirtualMachine::IsThreadedDispatchSupported())
+    {
+        state.SkipWithError("Threaded dispatch isn't supported by this compiler");
+        return;
+    }
+
+    static const std::unique_ptr<BytecodeModule> module = CompileProgram(TOSLANG_PROGRAMS_DIR "/fib.tos");
+    if (module == nullptr)
+    {
+        state.SkipWithError("Couldn't compile fib.tos");
+        return;
+    }
+
+    const size_t fnIdx = GetFunctionIdx(*module, fnName);
+    const std::vector<Value> args{ state.range(0) };
+
+    VirtualMachine vm{ mode };
+    Value result = 0;
+    for (auto _ : state)
+    {
+        if (!vm.Call(*module, fnIdx, args, result))
+        {
+            state.SkipWithError("Runtime error");
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+// Call heavy
+BENCHMARK_CAPTURE(BM_Fib, FibRec/Switch, DispatchMode::SWITCH, "fibRec")->Arg(25)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Fib, FibRec/Threaded, DispatchMode::THREADED, "fibRec")->Arg(25)->Unit(benchmark::kMillisecond);
+
+// Loop heavy. fib(90) is the largest fibonacci number (mostly) fitting in a 64 bits register.
+BENCHMARK_CAPTURE(BM_Fib, FibSeq/Switch, DispatchMode::SWITCH, "fibSeq")->Arg(90);
+BENCHMARK_CAPTURE(BM_Fib, FibSeq/Threaded, DispatchMode::THREADED, "fibSeq")->Arg(90);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,46 @@
+#include "benchutils.h"
+
+#include "Utils/scheduler.h"
+#include "VM/virtualmachine.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace TosLang::Utils;
+using namespace TosLang::VM;
+
+/*
+* \fn               BM_SpawnFib
+* \brief            Measures a recursive fibonacci function whose recursive calls are spawned (see spawn.tos).
+*                   Compare with BM_Fib/FibRec of the dispatch benchmarks to get the speedup of the scheduler.
+* \param state      Benchmark state. Its first argument is given to the function.
+*/
+static void BM_SpawnFib(benchmark::State& state)
+{
+    static const std::unique_ptr<BytecodeModule> module = CompileProgram(TOSLANG_PROGRAMS_DIR "/spawn.tos");
+    if (module == nullptr)
+    {
+        state.SkipWithError("Couldn't compile spawn.tos");
+        return;
+    }
+
+    const size_t fnIdx = GetFunctionIdx(*module, "fibPar");
+    const std::vector<Value> args{ state.range(0) };
+
+    VirtualMachine vm;
+    Value result = 0;
+    for (auto _ : state)
+    {
+        if (!vm.Call(*module, fnIdx, args, result))
+        {
+            state.SkipWithError("Runtime error");
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.counters["workers"] = static_cast<double>(Scheduler::GetDefaultNbWorkers());
+}
+
+BENCHMARK(BM_SpawnFib)->Arg(25)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,190 @@
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#else
+#ifndef _WIN32
+#   define BOOST_TEST_MODULE ASTBinaryTests
+#endif
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include "Parse/parser.h"
+#include "Utils/astbinary.h"
+#include "Utils/astprinter.h"
+#include "Utils/astreader.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace TosLang::FrontEnd;
+using namespace TosLang::Utils;
+
+/*
+* \fn       PrintAST
+* \brief    Prints an AST in the text format
+* \param    root Root of the AST
+* \return   Text representation of the AST
+*/
+static std::string PrintAST(const std::unique_ptr<ASTNode>& root)
+{
+    std::stringstream stream;
+    ASTPrinter<std::stringstream> printer{ stream };
+    printer.Run(root);
+    return stream.str();
+}
+
+BOOST_AUTO_TEST_CASE( BinaryASTRoundTripFromSources )
+{
+    // Programs with syntax errors are reported on stderr, which is kept out of the test output
+    std::stringstream errors;
+    std::streambuf* oldBuffer = std::cerr.rdbuf(errors.rdbuf());
+
+    size_t nbPrograms = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator{ "../sources" })
+    {
+        if (entry.path().extension() != ".tos")
+            continue;
+
+        Parser parser;
+        std::unique_ptr<ASTNode> programAST = parser.ParseProgram(entry.path().string());
+        if (programAST == nullptr)
+            continue;
+
+        // Trees of programs with syntax errors can't be stored
+        ASTBinaryWriter writer;
+        std::string buffer;
+        if (!writer.Serialize(programAST, buffer))
+            continue;
+
+        ASTBinaryReader reader;
+        std::unique_ptr<ASTNode> readAST = reader.Run(buffer.data(), buffer.size());
+        BOOST_REQUIRE_MESSAGE(readAST != nullptr, entry.path().string());
+        BOOST_REQUIRE_EQUAL(PrintAST(readAST), PrintAST(programAST));
+        ++nbPrograms;
+    }
+
+    std::cerr.rdbuf(oldBuffer);
+    BOOST_REQUIRE_GT(nbPrograms, 50);
+}
+
+BOOST_AUTO_TEST_CASE( BinaryASTRoundTripFromFiles )
+{
+    const std::string binaryFile = (std::filesystem::temp_directory_path() / "toslang_ast_binary_tests.tast").string();
+
+    // ASTs used by the semantic analysis tests
+    std::vector<std::filesystem::path> astFiles;
+    for (const std::string dir : { "../asts/call", "../asts/function", "../asts/if", "../asts/var", "../asts/while" })
+    {
+        for (const auto& entry : std::filesystem::directory_iterator{ dir })
+        {
+            if (entry.path().extension() == ".ast")
+                astFiles.push_back(entry.path());
+        }
+    }
+
+    size_t nbPrograms = 0;
+    for (const auto& astFile : astFiles)
+    {
+        ASTReader textReader;
+        std::unique_ptr<ASTNode> programAST = textReader.Run(astFile.string());
+        BOOST_REQUIRE(programAST != nullptr);
+
+        ASTBinaryWriter writer;
+        if (!writer.Run(programAST, binaryFile))
+            continue;
+
+        // The file is memory mapped by the reader
+        ASTBinaryReader reader;
+        std::unique_ptr<ASTNode> readAST = reader.Run(binaryFile);
+        BOOST_REQUIRE_MESSAGE(readAST != nullptr, astFile.string());
+        BOOST_REQUIRE_EQUAL(PrintAST(readAST), PrintAST(programAST));
+        ++nbPrograms;
+    }
+
+    std::filesystem::remove(binaryFile);
+    BOOST_REQUIRE_GT(nbPrograms, 50);
+}
+
+BOOST_AUTO_TEST_CASE( BinaryASTMalformed )
+{
+    Parser parser;
+    std::unique_ptr<ASTNode> programAST = parser.ParseProgram("../sources/function/fn_def_multi_control_flow.tos");
+    BOOST_REQUIRE(programAST != nullptr);
+
+    ASTBinaryWriter writer;
+    std::string buffer;
+    BOOST_REQUIRE(writer.Serialize(programAST, buffer));
+
+    ASTBinaryReader reader;
+    BOOST_REQUIRE(reader.Run(buffer.data(), buffer.size()) != nullptr);
+
+    // Truncated files
+    for (size_t size = 0; size < buffer.size(); ++size)
+        BOOST_REQUIRE(reader.Run(buffer.data(), size) == nullptr);
+
+    // Trailing bytes
+    const std::string longBuffer = buffer + "TOSA";
+    BOOST_REQUIRE(reader.Run(longBuffer.data(), longBuffer.size()) == nullptr);
+
+    // Wrong magic number
+    std::string badBuffer = buffer;
+    badBuffer[0] = 'X';
+    BOOST_REQUIRE(reader.Run(badBuffer.data(), badBuffer.size()) == nullptr);
+
+    // Unknown node kind in the last record, an IdentifierExpr
+    badBuffer = buffer;
+    badBuffer[buffer.size() - 24] = '\x7F';
+    BOOST_REQUIRE(reader.Run(badBuffer.data(), badBuffer.size()) == nullptr);
+
+    // The reader still works after having rejected malformed files
+    BOOST_REQUIRE_EQUAL(PrintAST(reader.Run(buffer.data(), buffer.size())), PrintAST(programAST));
+}
+
+BOOST_AUTO_TEST_CASE( BinaryASTDeepTree )
+{
+    // A single binary expression as long as this makes a tree as deep, binary expressions being right associative
+    const size_t nbOperands = 1000000;
+    const std::string filename = (std::filesystem::temp_directory_path() / "toslang_deep_binary_ast.tos").string();
+    {
+        std::ofstream stream{ filename, std::ios::binary };
+        stream << "fn main() -> Void\n{\n    var value : Int = 1;\n    var total : Int = value";
+        for (size_t iOperand = 1; iOperand < nbOperands; ++iOperand)
+            stream << " + value";
+        stream << ";\n    return;\n}\n";
+    }
+
+    Parser parser;
+    std::unique_ptr<ASTNode> programAST = parser.ParseProgram(filename);
+    std::filesystem::remove(filename);
+    BOOST_REQUIRE(programAST != nullptr);
+
+    ASTBinaryWriter writer;
+    std::string buffer;
+    BOOST_REQUIRE(writer.Serialize(programAST, buffer));
+
+    ASTBinaryReader reader;
+    std::unique_ptr<ASTNode> readAST = reader.Run(buffer.data(), buffer.size());
+    BOOST_REQUIRE(readAST != nullptr);
+
+    const ASTNode* fnBody = readAST->GetChildrenNodes()[0]->GetChildrenNodes()[1].get();
+    const ASTNode* expr = fnBody->GetChildrenNodes()[1]->GetChildrenNodes()[0].get();
+    size_t depth = 0;
+    while (expr->GetKind() == ASTNode::NodeKind::BINARY_EXPR)
+    {
+        BOOST_REQUIRE(expr->GetChildrenNodes()[0]->GetKind() == ASTNode::NodeKind::IDENTIFIER_EXPR);
+        expr = expr->GetChildrenNodes()[1].get();
+        ++depth;
+    }
+    BOOST_REQUIRE(expr->GetKind() == ASTNode::NodeKind::IDENTIFIER_EXPR);
+    BOOST_REQUIRE_EQUAL(depth, nbOperands - 1);
+
+    // A file cut in the middle of the chain is rejected
+    BOOST_REQUIRE(reader.Run(buffer.data(), buffer.size() / 2) == nullptr);
+
+    // So is a chain whose last node is missing, which leaves every node of the chain open
+    std::string badBuffer = buffer.substr(0, buffer.size() - 24 * 2);
+    BOOST_REQUIRE(reader.Run(badBuffer.data(), badBuffer.size()) == nullptr);
+}
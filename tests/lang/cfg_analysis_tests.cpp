@@ -0,0 +1,292 @@
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#else
+#ifndef _WIN32
+#   define BOOST_TEST_MODULE CFGAnalysisTests
+#endif
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include "SSA/cfgbuilder.h"
+
+#include <vector>
+
+using namespace TosLang::BackEnd;
+
+using Analysis = CFGAnalysis<SSAInstruction>;
+
+/*
+* \fn           CreateBlocks
+* \brief        Creates blocks in a function
+* \param func   Function receiving the blocks
+* \param nbBlocks   Number of blocks to create
+* \return       Blocks created, in creation order
+*/
+static std::vector<SSABlockPtr> CreateBlocks(SSAFunction& func, size_t nbBlocks)
+{
+    std::vector<SSABlockPtr> blocks;
+    for (size_t iBlock = 0; iBlock < nbBlocks; ++iBlock)
+        blocks.push_back(func.CreateNewBlock());
+
+    return blocks;
+}
+
+/*
+* \fn               IsSameBlockList
+* \brief            Checks that a list of blocks contains the expected blocks, in order
+* \param actual     Blocks given by the analysis
+* \param expected   Expected blocks
+* \return           True if both lists are the same
+*/
+static bool IsSameBlockList(const std::vector<SSABlock*>& actual, const std::vector<SSABlockPtr>& expected)
+{
+    if (actual.size() != expected.size())
+        return false;
+
+    for (size_t iBlock = 0; iBlock < actual.size(); ++iBlock)
+    {
+        if (actual[iBlock] != expected[iBlock].get())
+            return false;
+    }
+
+    return true;
+}
+
+BOOST_AUTO_TEST_SUITE( CFGAnalysisTestSuite )
+
+BOOST_AUTO_TEST_CASE( DominatorsOfLoopWithBranch )
+{
+    // entry -> header -> body -> (then | else) -> join -> header, header -> exit
+    SSAFunction func;
+    std::vector<SSABlockPtr> blocks = CreateBlocks(func, 7);
+    const SSABlockPtr& entry = blocks[0];
+    const SSABlockPtr& header = blocks[1];
+    const SSABlockPtr& body = blocks[2];
+    const SSABlockPtr& thenBlock = blocks[3];
+    const SSABlockPtr& elseBlock = blocks[4];
+    const SSABlockPtr& join = blocks[5];
+    const SSABlockPtr& exit = blocks[6];
+
+    entry->InsertBranch(header);
+    header->InsertBranch(body);
+    header->InsertBranch(exit);
+    body->InsertBranch(thenBlock);
+    body->InsertBranch(elseBlock);
+    thenBlock->InsertBranch(join);
+    elseBlock->InsertBranch(join);
+    join->InsertBranch(header);
+
+    const Analysis& analysis = func.GetAnalysis();
+    BOOST_REQUIRE_EQUAL(analysis.GetRPOBlocks().size(), 7);
+    BOOST_REQUIRE_EQUAL(analysis.GetRPOBlocks().front(), entry.get());
+    BOOST_REQUIRE_EQUAL(analysis.GetRPONumber(entry.get()), 0);
+
+    // Every block comes before its successors, except for the branch back to the header
+    for (const SSABlockPtr& block : blocks)
+    {
+        for (const SSABlockPtr& succ : block->GetSuccessors())
+        {
+            if (succ != header)
+                BOOST_REQUIRE_LT(analysis.GetRPONumber(block.get()), analysis.GetRPONumber(succ.get()));
+        }
+    }
+
+    BOOST_REQUIRE(analysis.GetImmediateDominator(entry.get()) == nullptr);
+    BOOST_REQUIRE_EQUAL(analysis.GetImmediateDominator(header.get()), entry.get());
+    BOOST_REQUIRE_EQUAL(analysis.GetImmediateDominator(body.get()), header.get());
+    BOOST_REQUIRE_EQUAL(analysis.GetImmediateDominator(thenBlock.get()), body.get());
+    BOOST_REQUIRE_EQUAL(analysis.GetImmediateDominator(elseBlock.get()), body.get());
+    BOOST_REQUIRE_EQUAL(analysis.GetImmediateDominator(join.get()), body.get());
+    BOOST_REQUIRE_EQUAL(analysis.GetImmediateDominator(exit.get()), header.get());
+
+    BOOST_REQUIRE_EQUAL(analysis.GetDominatedBlocks(body.get()).size(), 3);
+    BOOST_REQUIRE(analysis.Dominates(header.get(), join.get()));
+    BOOST_REQUIRE(analysis.Dominates(join.get(), join.get()));
+    BOOST_REQUIRE(!analysis.Dominates(thenBlock.get(), join.get()));
+    BOOST_REQUIRE(!analysis.Dominates(body.get(), exit.get()));
+
+    BOOST_REQUIRE(analysis.GetDominanceFrontier(entry.get()).empty());
+    BOOST_REQUIRE(analysis.GetDominanceFrontier(exit.get()).empty());
+    BOOST_REQUIRE(IsSameBlockList(analysis.GetDominanceFrontier(thenBlock.get()), { join }));
+    BOOST_REQUIRE(IsSameBlockList(analysis.GetDominanceFrontier(elseBlock.get()), { join }));
+    BOOST_REQUIRE(IsSameBlockList(analysis.GetDominanceFrontier(join.get()), { header }));
+    BOOST_REQUIRE(IsSameBlockList(analysis.GetDominanceFrontier(body.get()), { header }));
+    BOOST_REQUIRE(IsSameBlockList(analysis.GetDominanceFrontier(header.get()), { header }));
+
+    BOOST_REQUIRE_EQUAL(analysis.GetLoops().size(), 1);
+    const Analysis::Loop& loop = analysis.GetLoops().front();
+    BOOST_REQUIRE_EQUAL(loop.mHeader, header.get());
+    BOOST_REQUIRE(IsSameBlockList(loop.mLatches, { join }));
+    BOOST_REQUIRE_EQUAL(loop.mBlocks.size(), 5);
+    BOOST_REQUIRE_EQUAL(loop.mBlocks.front(), header.get());
+    BOOST_REQUIRE_EQUAL(loop.mDepth, 1);
+    BOOST_REQUIRE_EQUAL(loop.mParent, Analysis::INVALID_INDEX);
+
+    BOOST_REQUIRE_EQUAL(analysis.GetLoop(thenBlock.get()), &loop);
+    BOOST_REQUIRE(analysis.GetLoop(exit.get()) == nullptr);
+    BOOST_REQUIRE_EQUAL(analysis.GetLoopDepth(join.get()), 1);
+    BOOST_REQUIRE_EQUAL(analysis.GetLoopDepth(entry.get()), 0);
+    BOOST_REQUIRE(analysis.IsInLoop(body.get(), loop));
+    BOOST_REQUIRE(!analysis.IsInLoop(exit.get(), loop));
+}
+
+BOOST_AUTO_TEST_CASE( NestedLoops )
+{
+    // entry -> outer -> inner -> innerBody -> inner, inner -> outerLatch -> outer, outer -> exit
+    SSAFunction func;
+    std::vector<SSABlockPtr> blocks = CreateBlocks(func, 6);
+    const SSABlockPtr& entry = blocks[0];
+    const SSABlockPtr& outer = blocks[1];
+    const SSABlockPtr& inner = blocks[2];
+    const SSABlockPtr& innerBody = blocks[3];
+    const SSABlockPtr& outerLatch = blocks[4];
+    const SSABlockPtr& exit = blocks[5];
+
+    entry->InsertBranch(outer);
+    outer->InsertBranch(inner);
+    outer->InsertBranch(exit);
+    inner->InsertBranch(innerBody);
+    inner->InsertBranch(outerLatch);
+    innerBody->InsertBranch(inner);
+    outerLatch->InsertBranch(outer);
+
+    const Analysis& analysis = func.GetAnalysis();
+    BOOST_REQUIRE_EQUAL(analysis.GetLoops().size(), 2);
+
+    // The inner loop comes first
+    const Analysis::Loop& innerLoop = analysis.GetLoops()[0];
+    const Analysis::Loop& outerLoop = analysis.GetLoops()[1];
+    BOOST_REQUIRE_EQUAL(innerLoop.mHeader, inner.get());
+    BOOST_REQUIRE_EQUAL(outerLoop.mHeader, outer.get());
+    BOOST_REQUIRE_EQUAL(innerLoop.mParent, 1);
+    BOOST_REQUIRE_EQUAL(innerLoop.mDepth, 2);
+    BOOST_REQUIRE_EQUAL(outerLoop.mDepth, 1);
+    BOOST_REQUIRE(IsSameBlockList(innerLoop.mBlocks, { inner, innerBody }));
+    BOOST_REQUIRE_EQUAL(outerLoop.mBlocks.size(), 4);
+    BOOST_REQUIRE(IsSameBlockList(outerLoop.mLatches, { outerLatch }));
+
+    BOOST_REQUIRE_EQUAL(analysis.GetLoop(innerBody.get()), &innerLoop);
+    BOOST_REQUIRE_EQUAL(analysis.GetLoop(outerLatch.get()), &outerLoop);
+    BOOST_REQUIRE_EQUAL(analysis.GetLoopDepth(innerBody.get()), 2);
+    BOOST_REQUIRE(analysis.IsInLoop(innerBody.get(), outerLoop));
+    BOOST_REQUIRE(!analysis.IsInLoop(outerLatch.get(), innerLoop));
+}
+
+BOOST_AUTO_TEST_CASE( UnreachableBlocksAndDuplicateBranches )
+{
+    // The CFG builder can branch twice to the same block, and leave blocks that nothing branches to
+    SSAFunction func;
+    std::vector<SSABlockPtr> blocks = CreateBlocks(func, 4);
+    const SSABlockPtr& entry = blocks[0];
+    const SSABlockPtr& target = blocks[1];
+    const SSABlockPtr& dead = blocks[2];
+    const SSABlockPtr& deadLoop = blocks[3];
+
+    entry->InsertBranch(target);
+    entry->InsertBranch(target);
+    dead->InsertBranch(deadLoop);
+    deadLoop->InsertBranch(dead);
+    dead->InsertBranch(target);
+
+    const Analysis& analysis = func.GetAnalysis();
+    BOOST_REQUIRE_EQUAL(analysis.GetRPOBlocks().size(), 2);
+    BOOST_REQUIRE(!analysis.IsReachable(dead.get()));
+    BOOST_REQUIRE_EQUAL(analysis.GetRPONumber(deadLoop.get()), Analysis::INVALID_INDEX);
+    BOOST_REQUIRE(analysis.GetImmediateDominator(dead.get()) == nullptr);
+    BOOST_REQUIRE(!analysis.Dominates(dead.get(), deadLoop.get()));
+
+    BOOST_REQUIRE_EQUAL(analysis.GetImmediateDominator(target.get()), entry.get());
+    BOOST_REQUIRE(analysis.GetDominanceFrontier(entry.get()).empty());
+    BOOST_REQUIRE(analysis.GetLoops().empty());
+}
+
+BOOST_AUTO_TEST_CASE( AnalysisUpdatedOnChange )
+{
+    SSAFunction func;
+    std::vector<SSABlockPtr> blocks = CreateBlocks(func, 3);
+    blocks[0]->InsertBranch(blocks[1]);
+    blocks[1]->InsertBranch(blocks[2]);
+
+    const Analysis& analysis = func.GetAnalysis();
+    BOOST_REQUIRE_EQUAL(&func.GetAnalysis(), &analysis);
+    BOOST_REQUIRE_EQUAL(analysis.GetImmediateDominator(blocks[2].get()), blocks[1].get());
+    BOOST_REQUIRE(analysis.GetLoops().empty());
+
+    // New branches
+    blocks[0]->InsertBranch(blocks[2]);
+    blocks[2]->InsertBranch(blocks[1]);
+    func.GetAnalysis();
+    BOOST_REQUIRE_EQUAL(analysis.GetImmediateDominator(blocks[2].get()), blocks[0].get());
+    BOOST_REQUIRE(analysis.GetLoops().empty());
+
+    // Removed branch: blocks[1] now dominates blocks[2], which branches back to it
+    blocks[0]->RemoveBranch(1);
+    func.GetAnalysis();
+    BOOST_REQUIRE_EQUAL(analysis.GetImmediateDominator(blocks[2].get()), blocks[1].get());
+    BOOST_REQUIRE_EQUAL(analysis.GetLoops().size(), 1);
+
+    // New block
+    SSABlockPtr newBlock = func.CreateNewBlock();
+    BOOST_REQUIRE(!func.GetAnalysis().IsReachable(newBlock.get()));
+    blocks[2]->InsertBranch(newBlock);
+    BOOST_REQUIRE(func.GetAnalysis().IsReachable(newBlock.get()));
+
+    // Removed block
+    blocks[2]->RemoveBranch(1);
+    func.RemoveBlocks([&newBlock](const SSABlock& block) { return &block == newBlock.get(); });
+    BOOST_REQUIRE(!func.GetAnalysis().IsReachable(newBlock.get()));
+    BOOST_REQUIRE_EQUAL(analysis.GetRPOBlocks().size(), 3);
+
+    // A removed block no longer belongs to the graph
+    newBlock->InsertBranch(blocks[0]);
+    BOOST_REQUIRE_EQUAL(&func.GetAnalysis(), &analysis);
+}
+
+BOOST_AUTO_TEST_CASE( LongChain )
+{
+    // Every block dominates the next one, which gives a dominator tree as deep as the graph
+    const size_t nbBlocks = 50000;
+
+    SSAFunction func;
+    std::vector<SSABlockPtr> blocks = CreateBlocks(func, nbBlocks);
+    for (size_t iBlock = 0; iBlock + 1 < nbBlocks; ++iBlock)
+        blocks[iBlock]->InsertBranch(blocks[iBlock + 1]);
+
+    const Analysis& analysis = func.GetAnalysis();
+    BOOST_REQUIRE_EQUAL(analysis.GetRPOBlocks().size(), nbBlocks);
+    BOOST_REQUIRE_EQUAL(analysis.GetRPONumber(blocks.back().get()), nbBlocks - 1);
+    BOOST_REQUIRE_EQUAL(analysis.GetImmediateDominator(blocks.back().get()), blocks[nbBlocks - 2].get());
+    BOOST_REQUIRE(analysis.Dominates(blocks.front().get(), blocks.back().get()));
+    BOOST_REQUIRE(!analysis.Dominates(blocks.back().get(), blocks.front().get()));
+    BOOST_REQUIRE(analysis.GetLoops().empty());
+}
+
+BOOST_AUTO_TEST_CASE( DeeplyNestedLoops )
+{
+    // Loops nested in each other: header(i) -> header(i + 1) -> ... -> latch(i + 1) -> latch(i) -> header(i)
+    const size_t nbLoops = 2000;
+
+    SSAFunction func;
+    std::vector<SSABlockPtr> headers = CreateBlocks(func, nbLoops);
+    std::vector<SSABlockPtr> latches = CreateBlocks(func, nbLoops);
+    SSABlockPtr exit = func.CreateNewBlock();
+    for (size_t iLoop = 0; iLoop < nbLoops; ++iLoop)
+    {
+        headers[iLoop]->InsertBranch(iLoop + 1 < nbLoops ? headers[iLoop + 1] : latches[iLoop]);
+        latches[iLoop]->InsertBranch(headers[iLoop]);
+        latches[iLoop]->InsertBranch(iLoop > 0 ? latches[iLoop - 1] : exit);
+    }
+
+    const Analysis& analysis = func.GetAnalysis();
+    BOOST_REQUIRE_EQUAL(analysis.GetRPOBlocks().size(), 2 * nbLoops + 1);
+    BOOST_REQUIRE_EQUAL(analysis.GetLoops().size(), nbLoops);
+    BOOST_REQUIRE_EQUAL(analysis.GetLoopDepth(headers.back().get()), nbLoops);
+    BOOST_REQUIRE_EQUAL(analysis.GetLoopDepth(latches.front().get()), 1);
+    BOOST_REQUIRE_EQUAL(analysis.GetLoopDepth(exit.get()), 0);
+    BOOST_REQUIRE_EQUAL(analysis.GetImmediateDominator(exit.get()), latches.front().get());
+    BOOST_REQUIRE(analysis.Dominates(headers.front().get(), latches.back().get()));
+    BOOST_REQUIRE_EQUAL(analysis.GetLoops().back().mBlocks.size(), 2 * nbLoops);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
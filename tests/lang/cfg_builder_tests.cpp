@@ -0,0 +1,62 @@
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#else
+#ifndef _WIN32
+#   define BOOST_TEST_MODULE CFGBuilderTests
+#endif
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include "toslang_sema_fixture.h"
+
+#include "SSA/cfgbuilder.h"
+
+#include <sstream>
+
+using namespace TosLang::BackEnd;
+
+BOOST_FIXTURE_TEST_SUITE( SSATestSuite, TosLangSemaFixture )
+
+BOOST_AUTO_TEST_CASE( CFGBuildFunctionsInOrder )
+{
+    auto symTable = std::make_shared<SymbolTable>();
+    size_t errorCount = GetProgramSymbolTable("../asts/function/fn_def_multi_control_flow.ast", symTable);
+    BOOST_REQUIRE_EQUAL(errorCount, 0);
+
+    CFGBuilder builder;
+    std::unique_ptr<SSAModule> module = builder.Run(programAST, symTable);
+    BOOST_REQUIRE(module != nullptr);
+
+    // Functions appear in declaration order and their blocks are numbered from 0
+    const std::vector<std::string> expectedNames{ "first", "second", "third" };
+    std::vector<std::string> names;
+    for (auto& funcCFG : *module)
+    {
+        names.push_back(funcCFG.first);
+        BOOST_REQUIRE_EQUAL(funcCFG.second->GetEntryBlock()->GetName(), "Block0");
+    }
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(names.begin(), names.end(), expectedNames.begin(), expectedNames.end());
+}
+
+BOOST_AUTO_TEST_CASE( CFGBuildFunctionsInParallel )
+{
+    auto symTable = std::make_shared<SymbolTable>();
+    size_t errorCount = GetProgramSymbolTable("../asts/function/fn_def_multi_control_flow.ast", symTable);
+    BOOST_REQUIRE_EQUAL(errorCount, 0);
+
+    CFGBuilder builder;
+    std::stringstream expectedCFG;
+    builder.Run(programAST, symTable)->Print(expectedCFG);
+
+    // Building the functions concurrently gives the same blocks and values
+    for (size_t nbWorkers : { 1, 2, 4 })
+    {
+        TosLang::Utils::Scheduler scheduler{ nbWorkers };
+        std::stringstream cfg;
+        builder.Run(programAST, symTable, scheduler)->Print(cfg);
+        BOOST_REQUIRE_EQUAL(cfg.str(), expectedCFG.str());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,230 @@
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#else
+#ifndef _WIN32
+#   define BOOST_TEST_MODULE CompilationCacheTests
+#endif
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include "toslang_cache_fixture.h"
+
+#include "Execution/compiler.h"
+#include "SSA/cfgbuilder.h"
+#include "Utils/cfgprinter.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace TosLang::BackEnd;
+
+/*
+* \fn                   RunCachedCommand
+* \brief                Runs a command of the compiler executable on a program, using a compilation cache
+* \param option         Option selecting the command
+* \param filename       Name of a file containing a TosLang program
+* \param cacheDir       Directory of the compilation cache
+* \param counterName    Name of the counter to read from the statistics of the compiler
+* \return               Value of the counter
+*/
+static size_t RunCachedCommand(const std::string& option, const std::string& filename, const std::string& cacheDir, const std::string& counterName)
+{
+    const std::string statsFile = cacheDir + ".json";
+    const std::string command = std::string{ TOSLANG_EXECUTABLE } + " -stats=json -cache-dir=" + cacheDir
+                              + " " + option + " " + filename + " > " + cacheDir + ".out 2> " + statsFile;
+    BOOST_REQUIRE_EQUAL(std::system(command.c_str()), 0);
+
+    std::ifstream stream{ statsFile };
+    const std::string stats{ std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+    const std::string counter = "\"" + counterName + "\":";
+    const size_t counterPos = stats.find(counter);
+    BOOST_REQUIRE(counterPos != std::string::npos);
+
+    return std::stoul(stats.substr(counterPos + counter.size()));
+}
+
+/*
+* \fn               DumpCachedCFG
+* \brief            Runs the compiler executable to dump the CFG of a program, using a compilation cache
+* \param filename   Name of a file containing a TosLang program
+* \param cacheDir   Directory of the compilation cache
+* \return           Number of functions read back from the cache, as reported by the statistics of the compiler
+*/
+static size_t DumpCachedCFG(const std::string& filename, const std::string& cacheDir)
+{
+    return RunCachedCommand("-dump-cfg", filename, cacheDir, "cached_functions");
+}
+
+/*
+* \fn               RunCompiler
+* \brief            Runs the compiler executable, discarding its output
+* \param arguments  Arguments of the compiler
+* \return           Exit code of the compiler
+*/
+static int RunCompiler(const std::string& arguments)
+{
+    const std::string outputFile = (std::filesystem::temp_directory_path() / "toslang_compiler_output.txt").string();
+    const std::string command = std::string{ TOSLANG_EXECUTABLE } + " " + arguments + " > " + outputFile + " 2>&1";
+    const int exitCode = std::system(command.c_str());
+
+    std::error_code error;
+    std::filesystem::remove(outputFile, error);
+    return exitCode;
+}
+
+BOOST_FIXTURE_TEST_SUITE( CacheTestSuite, TosLangCacheFixture )
+
+BOOST_AUTO_TEST_CASE( CacheKeyIgnoresOtherFunctions )
+{
+    const auto fKeys = GetFunctionKeys("../sources/cache/program.tos");
+    BOOST_REQUIRE_EQUAL(fKeys.size(), 3);
+
+    // Editing the first function moves the others, but only its own key changes
+    const auto editedKeys = GetFunctionKeys("../sources/cache/program_body_edit.tos");
+    BOOST_REQUIRE_EQUAL(editedKeys.size(), 3);
+    BOOST_REQUIRE(editedKeys[0].second != fKeys[0].second);
+    BOOST_REQUIRE_EQUAL(editedKeys[1].second, fKeys[1].second);
+    BOOST_REQUIRE_EQUAL(editedKeys[2].second, fKeys[2].second);
+
+    // Parsing the program again gives the same keys
+    BOOST_REQUIRE(GetFunctionKeys("../sources/cache/program.tos") == fKeys);
+}
+
+BOOST_AUTO_TEST_CASE( CacheKeyFollowsCalleeSignatures )
+{
+    const auto fKeys = GetFunctionKeys("../sources/cache/program.tos");
+    BOOST_REQUIRE_EQUAL(fKeys.size(), 3);
+
+    // A new overload of square changes what the call in caller may resolve to
+    const auto editedKeys = GetFunctionKeys("../sources/cache/program_new_overload.tos");
+    BOOST_REQUIRE_EQUAL(editedKeys.size(), 4);
+    BOOST_REQUIRE_EQUAL(editedKeys[0].second, fKeys[0].second);
+    BOOST_REQUIRE_EQUAL(editedKeys[1].second, fKeys[1].second);
+    BOOST_REQUIRE_EQUAL(editedKeys[3].first, "caller");
+    BOOST_REQUIRE(editedKeys[3].second != fKeys[2].second);
+}
+
+BOOST_AUTO_TEST_CASE( CacheStoresFunctions )
+{
+    const auto fKeys = GetFunctionKeys("../sources/cache/program.tos");
+
+    CFGBuilder builder;
+    std::unique_ptr<SSAModule> module = builder.Run(programAST, symTable);
+    BOOST_REQUIRE(module != nullptr);
+
+    Execution::CompilationCache cache{ cacheDirectory };
+    size_t iFunc = 0;
+    for (auto& funcCFG : *module)
+    {
+        const uint64_t key = fKeys[iFunc++].second;
+        BOOST_REQUIRE(cache.LoadFunction(key) == nullptr);
+        cache.StoreFunction(key, static_cast<const SSAFunction&>(*funcCFG.second));
+
+        // The function read back is the one that was stored
+        std::shared_ptr<SSAFunction> cachedFunc = cache.LoadFunction(key);
+        BOOST_REQUIRE(cachedFunc != nullptr);
+        BOOST_REQUIRE_EQUAL(cachedFunc->GetBlocks().size(), funcCFG.second->GetBlocks().size());
+
+        std::stringstream expectedCFG;
+        TosLang::Utils::CFGPrinter<std::stringstream, SSAInstruction>{ expectedCFG }.Visit(funcCFG.second, /*postOrderVisit=*/false);
+        std::stringstream cachedCFG;
+        TosLang::Utils::CFGPrinter<std::stringstream, SSAInstruction>{ cachedCFG }.Visit(cachedFunc, /*postOrderVisit=*/false);
+        BOOST_REQUIRE_EQUAL(cachedCFG.str(), expectedCFG.str());
+    }
+}
+
+BOOST_AUTO_TEST_CASE( CacheRecordsCheckedFunctions )
+{
+    Execution::Compiler compiler;
+    compiler.SetCacheDirectory(cacheDirectory);
+    BOOST_REQUIRE(compiler.Compile({ "../sources/cache/program.tos" }));
+
+    Execution::CompilationCache cache{ cacheDirectory };
+    for (const auto& fKey : GetFunctionKeys("../sources/cache/program.tos"))
+        BOOST_REQUIRE(cache.IsChecked(fKey.second));
+
+    // Only the function that was edited needs to be checked again
+    const auto editedKeys = GetFunctionKeys("../sources/cache/program_body_edit.tos");
+    BOOST_REQUIRE(!cache.IsChecked(editedKeys[0].second));
+    BOOST_REQUIRE(cache.IsChecked(editedKeys[1].second));
+    BOOST_REQUIRE(cache.IsChecked(editedKeys[2].second));
+}
+
+BOOST_AUTO_TEST_CASE( CacheConcurrentWrites )
+{
+    const auto fKeys = GetFunctionKeys("../sources/cache/program.tos");
+    const uint64_t key = fKeys[0].second;
+
+    // Writers of the same entry don't share their temporary file
+    std::vector<std::thread> writers;
+    for (size_t iWriter = 0; iWriter < 8; ++iWriter)
+    {
+        writers.emplace_back([this, key]()
+        {
+            Execution::CompilationCache cache{ cacheDirectory };
+            for (size_t iWrite = 0; iWrite < 50; ++iWrite)
+                cache.MarkChecked(key);
+        });
+    }
+    for (auto& writer : writers)
+        writer.join();
+
+    Execution::CompilationCache cache{ cacheDirectory };
+    BOOST_REQUIRE(cache.IsChecked(key));
+
+    // Only the entry is left in the cache
+    size_t nbFiles = 0;
+    for (const auto& file : std::filesystem::directory_iterator{ cacheDirectory })
+    {
+        BOOST_REQUIRE_EQUAL(file.path().extension().string(), ".tosc");
+        ++nbFiles;
+    }
+    BOOST_REQUIRE_EQUAL(nbFiles, 1);
+}
+
+BOOST_AUTO_TEST_CASE( CacheUsedByCompiler )
+{
+    // Nothing is cached on the first run, everything is on the second one
+    BOOST_REQUIRE_EQUAL(DumpCachedCFG("../sources/cache/program.tos", cacheDirectory), 0);
+    BOOST_REQUIRE_EQUAL(DumpCachedCFG("../sources/cache/program.tos", cacheDirectory), 3);
+
+    // Only the function that was edited is built again
+    BOOST_REQUIRE_EQUAL(DumpCachedCFG("../sources/cache/program_body_edit.tos", cacheDirectory), 2);
+
+    std::error_code error;
+    std::filesystem::remove(cacheDirectory + ".out", error);
+    std::filesystem::remove(cacheDirectory + ".json", error);
+}
+
+BOOST_AUTO_TEST_CASE( CacheUsedByCheck )
+{
+    // Everything is checked on the first run, nothing is on the second one
+    BOOST_REQUIRE_EQUAL(RunCachedCommand("-check", "../sources/cache/program.tos", cacheDirectory, "checked_decls"), 3);
+    BOOST_REQUIRE_EQUAL(RunCachedCommand("-check", "../sources/cache/program.tos", cacheDirectory, "checked_decls"), 0);
+
+    // Only the function that was edited is checked again
+    BOOST_REQUIRE_EQUAL(RunCachedCommand("-check", "../sources/cache/program_body_edit.tos", cacheDirectory, "checked_decls"), 1);
+
+    std::error_code error;
+    std::filesystem::remove(cacheDirectory + ".out", error);
+    std::filesystem::remove(cacheDirectory + ".json", error);
+}
+
+BOOST_AUTO_TEST_CASE( CompilerExitCode )
+{
+    BOOST_REQUIRE_EQUAL(RunCompiler("-check ../sources/cache/program.tos"), 0);
+    BOOST_REQUIRE_EQUAL(RunCompiler("-dump-cfg ../sources/cache/program.tos"), 0);
+
+    // Errors make the compiler fail, whatever the command
+    BOOST_REQUIRE_NE(RunCompiler("-check ../sources/var/bad_var_init_literal.tos"), 0);
+    BOOST_REQUIRE_NE(RunCompiler("-check ../sources/var/bad_global_var_redef.tos"), 0);
+    BOOST_REQUIRE_NE(RunCompiler("-dump-cfg ../sources/var/bad_global_var_redef.tos"), 0);
+    BOOST_REQUIRE_NE(RunCompiler("-dump-ast BadFile.tos"), 0);
+    BOOST_REQUIRE_NE(RunCompiler("-compile=chip16 ../sources/cache/program.tos"), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,133 @@
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#else
+#ifndef _WIN32
+#   define BOOST_TEST_MODULE FlatASTTests
+#endif
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include "AST/flatast.h"
+#include "Parse/parser.h"
+
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace TosLang::FrontEnd;
+
+/*
+* \fn           CheckFlatSubtree
+* \brief        Checks that a subtree of a flat AST matches the tree it was copied from
+* \param flat   Flat AST
+* \param root   Root of the tree
+* \return       Number of nodes of the tree, null children included
+*/
+static size_t CheckFlatSubtree(const FlatAST& flat, const ASTNode* root)
+{
+    // The tree is walked in pre-order, which must give the nodes in the order of their IDs
+    std::vector<std::pair<const ASTNode*, FlatAST::NodeID>> pendingNodes{ { root, FlatAST::INVALID_NODE } };
+    FlatAST::NodeID id = 0;
+    while (!pendingNodes.empty())
+    {
+        const ASTNode* node = pendingNodes.back().first;
+        const FlatAST::NodeID parent = pendingNodes.back().second;
+        pendingNodes.pop_back();
+
+        BOOST_REQUIRE_LT(id, flat.GetNbNodes());
+        BOOST_REQUIRE_EQUAL(flat.GetNode(id), node);
+        BOOST_REQUIRE_EQUAL(flat.GetParent(id), parent);
+        BOOST_REQUIRE_GT(flat.GetSubtreeEnd(id), id);
+
+        if (node == nullptr)
+        {
+            BOOST_REQUIRE(flat.GetKind(id) == ASTNode::NodeKind::ERROR);
+            BOOST_REQUIRE_EQUAL(flat.GetNbChildren(id), 0);
+        }
+        else
+        {
+            const ChildrenNodes& children = node->GetChildrenNodes();
+            BOOST_REQUIRE(flat.GetKind(id) == node->GetKind());
+            BOOST_REQUIRE(flat.GetName(id) == node->GetNameID());
+            BOOST_REQUIRE_EQUAL(flat.GetNbChildren(id), children.size());
+
+            // Walking the children through the sibling links must give the children of the tree
+            size_t iChild = 0;
+            for (FlatAST::NodeID childID = flat.GetFirstChild(id); childID != FlatAST::INVALID_NODE; childID = flat.GetNextSibling(childID), ++iChild)
+            {
+                BOOST_REQUIRE_LT(iChild, children.size());
+                BOOST_REQUIRE_EQUAL(flat.GetNode(childID), children[iChild].get());
+                BOOST_REQUIRE_EQUAL(flat.GetParent(childID), id);
+                BOOST_REQUIRE_LE(flat.GetSubtreeEnd(childID), flat.GetSubtreeEnd(id));
+            }
+            BOOST_REQUIRE_EQUAL(iChild, children.size());
+
+            for (auto childIt = children.rbegin(); childIt != children.rend(); ++childIt)
+                pendingNodes.emplace_back(childIt->get(), id);
+        }
+
+        ++id;
+    }
+
+    BOOST_REQUIRE_EQUAL(flat.GetSubtreeEnd(0), id);
+    return id;
+}
+
+BOOST_AUTO_TEST_CASE( FlatASTFromSources )
+{
+    // Programs with syntax errors are reported on stderr, which is kept out of the test output
+    std::stringstream errors;
+    std::streambuf* oldBuffer = std::cerr.rdbuf(errors.rdbuf());
+
+    size_t nbPrograms = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator{ "../sources" })
+    {
+        if (entry.path().extension() != ".tos")
+            continue;
+
+        Parser parser;
+        std::unique_ptr<ASTNode> programAST = parser.ParseProgram(entry.path().string());
+        if (programAST == nullptr)
+            continue;
+
+        const FlatAST flat{ programAST.get() };
+        BOOST_REQUIRE_EQUAL(CheckFlatSubtree(flat, programAST.get()), flat.GetNbNodes());
+        ++nbPrograms;
+    }
+
+    std::cerr.rdbuf(oldBuffer);
+    BOOST_REQUIRE_GT(nbPrograms, 0);
+}
+
+BOOST_AUTO_TEST_CASE( FlatASTProperties )
+{
+    Parser parser;
+    std::unique_ptr<ASTNode> programAST = parser.ParseProgram("../sources/var/var_init_bool.tos");
+    BOOST_REQUIRE(programAST != nullptr);
+
+    FlatAST flat;
+    flat.Build(programAST.get());
+    BOOST_REQUIRE(flat.GetKind(0) == ASTNode::NodeKind::PROGRAM_DECL);
+    BOOST_REQUIRE_EQUAL(flat.GetNextSibling(0), FlatAST::INVALID_NODE);
+
+    // Every variable declaration of the program is a boolean initialized by a literal
+    size_t nbVars = 0;
+    for (FlatAST::NodeID id = flat.GetFirstChild(0); id != FlatAST::INVALID_NODE; id = flat.GetNextSibling(id))
+    {
+        if (flat.GetKind(id) != ASTNode::NodeKind::VAR_DECL)
+            continue;
+
+        BOOST_REQUIRE(flat.GetType(id) == TosLang::Common::Type::BOOL);
+        BOOST_REQUIRE_EQUAL(flat.GetNbChildren(id), 1);
+        BOOST_REQUIRE(flat.GetKind(flat.GetFirstChild(id)) == ASTNode::NodeKind::BOOLEAN_EXPR);
+        BOOST_REQUIRE_EQUAL(flat.GetSourceLocation(id).GetCurrentLine(), programAST->GetChildrenNodes()[nbVars]->GetSourceLocation().GetCurrentLine());
+        ++nbVars;
+    }
+    BOOST_REQUIRE_GT(nbVars, 0);
+
+    // Building from a null tree empties the flat AST
+    flat.Build(nullptr);
+    BOOST_REQUIRE_EQUAL(flat.GetNbNodes(), 0);
+}
@@ -0,0 +1,183 @@
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#else
+#ifndef _WIN32
+#   define BOOST_TEST_MODULE InterpreterTests
+#endif
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include "toslang_interpreter_fixture.h"
+
+#include <filesystem>
+
+/*
+* \fn               WriteProgram
+* \brief            Writes a generated program to a temporary file
+* \param name       Name of the file
+* \param program    Content of the file
+* \return           Path of the file
+*/
+static std::string WriteProgram(const std::string& name, const std::string& program)
+{
+    const std::string filename = (std::filesystem::temp_directory_path() / name).string();
+
+    std::ofstream stream{ filename, std::ios::binary };
+    stream << program;
+
+    return filename;
+}
+
+BOOST_FIXTURE_TEST_SUITE( ExecutionTestSuite, TosLangInterpreterFixture )
+
+//////////////////// CORRECT USE CASES ////////////////////
+
+BOOST_AUTO_TEST_CASE( InterpretFibonacci )
+{
+    RunProgram("../programs/fib.tos");
+}
+
+BOOST_AUTO_TEST_CASE( InterpretFibonacciSwitchDispatch )
+{
+    RunProgram("../programs/fib.tos", TosLang::VM::DispatchMode::SWITCH);
+}
+
+BOOST_AUTO_TEST_CASE( InterpretFibonacciThreadedDispatch )
+{
+    if (TosLang::VM::VirtualMachine::IsThreadedDispatchSupported())
+        RunProgram("../programs/fib.tos", TosLang::VM::DispatchMode::THREADED);
+}
+
+BOOST_AUTO_TEST_CASE( InterpretArithmeticLimits )
+{
+    RunProgram("../programs/arithmetic_limits.tos");
+}
+
+BOOST_AUTO_TEST_CASE( InterpretArithmeticLimitsSwitchDispatch )
+{
+    RunProgram("../programs/arithmetic_limits.tos", TosLang::VM::DispatchMode::SWITCH);
+}
+
+BOOST_AUTO_TEST_CASE( InterpretGCD )
+{
+    RunProgram("../programs/gcd.tos");
+}
+
+BOOST_AUTO_TEST_CASE( InterpretGlobals )
+{
+    RunProgram("../programs/globals.tos");
+}
+
+BOOST_AUTO_TEST_CASE( InterpretHelloWorld )
+{
+    RunProgram("../programs/hello_world.tos");
+}
+
+BOOST_AUTO_TEST_CASE( InterpretSpawn )
+{
+    RunProgram("../programs/spawn.tos");
+}
+
+BOOST_AUTO_TEST_CASE( InterpretMultipleFiles )
+{
+    RunProgram(std::vector<std::string>{ "../programs/multifile/math.tos", "../programs/multifile/main.tos" });
+}
+
+BOOST_AUTO_TEST_CASE( InterpretLongLiteralChains )
+{
+    // Neither the accumulated sum nor the chained subtraction need a register per literal
+    const size_t nbOperands = 100000;
+    std::ostringstream program;
+    program << "// EXPECTED: " << nbOperands << "\n// EXPECTED: 0\n";
+    program << "fn main() -> Void\n{\n    var sum : Int = 1";
+    for (size_t iOperand = 1; iOperand < nbOperands; ++iOperand)
+        program << " + 1";
+    program << ";\n    print sum;\n    var difference : Int = 1";
+    for (size_t iOperand = 1; iOperand < nbOperands; ++iOperand)
+        program << " - 1";
+    program << ";\n    print difference;\n    return;\n}\n";
+
+    const std::string filename = WriteProgram("toslang_long_literal_chains.tos", program.str());
+    RunProgram(filename);
+    std::filesystem::remove(filename);
+}
+
+//////////////////// ERROR USE CASES ////////////////////
+
+BOOST_AUTO_TEST_CASE( InterpretMissingMain )
+{
+    Execution::Interpreter interpreter;
+    BOOST_REQUIRE(!interpreter.Run("../sources/function/fn_def_zero_arg.tos"));
+
+    std::vector<std::string> messages = GetLines(errBuffer);
+    BOOST_REQUIRE_EQUAL(messages.size(), 1);
+    BOOST_REQUIRE_EQUAL(messages[0], "FUNCTION ERROR: Missing main function");
+}
+
+BOOST_AUTO_TEST_CASE( InterpretDivisionByZero )
+{
+    Execution::Interpreter interpreter;
+    BOOST_REQUIRE(!interpreter.Run("../programs/errors/division_by_zero.tos"));
+
+    std::vector<std::string> messages = GetLines(errBuffer);
+    BOOST_REQUIRE_EQUAL(messages.size(), 1);
+    BOOST_REQUIRE_EQUAL(messages[0], "RUNTIME ERROR: Division by zero");
+}
+
+BOOST_AUTO_TEST_CASE( InterpretSpawnDivisionByZero )
+{
+    Execution::Interpreter interpreter;
+    BOOST_REQUIRE(!interpreter.Run("../programs/errors/spawn_division_by_zero.tos"));
+
+    // The error happens in the spawned call and is reported by the sync
+    std::vector<std::string> messages = GetLines(errBuffer);
+    BOOST_REQUIRE_EQUAL(messages.size(), 1);
+    BOOST_REQUIRE_EQUAL(messages[0], "RUNTIME ERROR: Division by zero");
+    BOOST_REQUIRE(GetLines(outBuffer).empty());
+}
+
+BOOST_AUTO_TEST_CASE( InterpretTooManyFunctions )
+{
+    // Calls refer to their function with 16 bits, and the globals initialization takes the first index
+    const size_t nbFunctions = 65536;
+    std::ostringstream program;
+    for (size_t iFn = 0; iFn < nbFunctions; ++iFn)
+        program << "fn f" << iFn << "() -> Int { return 1; }\n";
+    program << "fn main() -> Void { var value : Int = f" << nbFunctions - 1 << "(); print value; return; }\n";
+
+    const std::string filename = WriteProgram("toslang_too_many_functions.tos", program.str());
+    Execution::Interpreter interpreter;
+    const bool hasRun = interpreter.Run(filename);
+    std::filesystem::remove(filename);
+    BOOST_REQUIRE(!hasRun);
+
+    std::vector<std::string> messages = GetLines(errBuffer);
+    BOOST_REQUIRE_EQUAL(messages.size(), 1);
+    BOOST_REQUIRE_EQUAL(messages[0], "BYTECODE ERROR: Too many functions to be called by the virtual machine");
+    BOOST_REQUIRE(GetLines(outBuffer).empty());
+}
+
+BOOST_AUTO_TEST_CASE( InterpretTooManyRegisters )
+{
+    // Every local variable takes a register of the frame
+    const size_t nbVariables = 65535;
+    std::ostringstream program;
+    program << "fn main() -> Void\n{\n";
+    for (size_t iVar = 0; iVar < nbVariables; ++iVar)
+        program << "    var v" << iVar << " : Int = 1;\n";
+    program << "    print v0;\n    return;\n}\n";
+
+    const std::string filename = WriteProgram("toslang_too_many_registers.tos", program.str());
+    Execution::Interpreter interpreter;
+    const bool hasRun = interpreter.Run(filename);
+    std::filesystem::remove(filename);
+    BOOST_REQUIRE(!hasRun);
+
+    std::vector<std::string> messages = GetLines(errBuffer);
+    BOOST_REQUIRE_EQUAL(messages.size(), 1);
+    BOOST_REQUIRE_EQUAL(messages[0], "BYTECODE ERROR: Function needs too many registers");
+    BOOST_REQUIRE(GetLines(outBuffer).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
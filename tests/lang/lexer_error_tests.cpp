@@ -83,6 +83,44 @@ BOOST_AUTO_TEST_CASE( LexerBadVarNameTest )
     BOOST_REQUIRE_EQUAL(messages[0], "LITERAL ERROR: Bad suffix on number at line 1, column 4");
 }
 
+BOOST_AUTO_TEST_CASE( LexerBadNumberLiteralTest )
+{
+    Lexer lex;
+    BOOST_REQUIRE(lex.Init("../sources/var/bad_number_literal.tos"));
+    BOOST_REQUIRE_EQUAL(lex.GetCurrentLocation().GetCurrentLine(), 1U);
+    BOOST_REQUIRE_EQUAL(lex.GetCurrentLocation().GetCurrentColumn(), 1U);
+
+    // var MyVar1: Int = 99999999999;
+    BOOST_REQUIRE(lex.GetNextToken() == Lexer::Token::VAR);
+    BOOST_REQUIRE(lex.GetNextToken() == Lexer::Token::IDENTIFIER);
+    BOOST_REQUIRE_EQUAL(lex.GetCurrentStr(), "MyVar1");
+    BOOST_REQUIRE(lex.GetNextToken() == Lexer::Token::COLON);
+    BOOST_REQUIRE(lex.GetNextToken() == Lexer::Token::TYPE);
+    BOOST_REQUIRE(lex.GetNextToken() == Lexer::Token::ASSIGN);
+    BOOST_REQUIRE(lex.GetNextToken() == Lexer::Token::UNKNOWN);
+    BOOST_REQUIRE(lex.GetNextToken() == Lexer::Token::SEMI_COLON);
+
+    // var MyVar2: Int = 2147483647;
+    BOOST_REQUIRE(lex.GetNextToken() == Lexer::Token::VAR);
+    BOOST_REQUIRE(lex.GetNextToken() == Lexer::Token::IDENTIFIER);
+    BOOST_REQUIRE_EQUAL(lex.GetCurrentStr(), "MyVar2");
+    BOOST_REQUIRE(lex.GetNextToken() == Lexer::Token::COLON);
+    BOOST_REQUIRE(lex.GetNextToken() == Lexer::Token::TYPE);
+    BOOST_REQUIRE(lex.GetNextToken() == Lexer::Token::ASSIGN);
+    BOOST_REQUIRE(lex.GetNextToken() == Lexer::Token::NUMBER);
+    BOOST_REQUIRE_EQUAL(lex.GetCurrentNumber(), 2147483647);
+    BOOST_REQUIRE(lex.GetNextToken() == Lexer::Token::SEMI_COLON);
+
+    // End of file
+    BOOST_REQUIRE(lex.GetNextToken() == Lexer::Token::TOK_EOF);
+
+    std::vector<std::string> messages{ GetErrorMessages() };
+
+    // Check if the correct error messages got printed
+    BOOST_REQUIRE_EQUAL(messages.size(), 1);
+    BOOST_REQUIRE_EQUAL(messages[0], "LITERAL ERROR: Number is too big at line 1, column 14");
+}
+
 BOOST_AUTO_TEST_CASE( LexerBadMLCommentTest )
 {
     Lexer lex;
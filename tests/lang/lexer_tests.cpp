@@ -10,6 +10,9 @@
 
 #include "Parse/lexer.h"
 
+#include <atomic>
+#include <thread>
+
 using namespace TosLang::FrontEnd;
 
 BOOST_AUTO_TEST_SUITE( ParseTestSuite )
@@ -22,6 +25,91 @@ BOOST_AUTO_TEST_CASE( LexerInitTest )
 	BOOST_REQUIRE_EQUAL(lex.GetCurrentLocation().GetCurrentColumn(), 1);
 }
 
+BOOST_AUTO_TEST_CASE( LexerLoadingModeTest )
+{
+    // Lexing a memory mapped file or a copy of it must give the same tokens
+    const std::string filenames[] = { "../sources/thread.tos", "../sources/var/var_init_string.tos", 
+                                      "../sources/var/bad_string_literal.tos", "../sources/comment/ml_comment.tos" };
+    for (const std::string& filename : filenames)
+    {
+        Lexer copyLex;
+        Lexer mapLex;
+        BOOST_REQUIRE(copyLex.Init(filename, Lexer::LoadingMode::COPY));
+        BOOST_REQUIRE(mapLex.Init(filename, Lexer::LoadingMode::MEMORY_MAP));
+
+        Lexer::Token token;
+        do
+        {
+            token = copyLex.GetNextToken();
+            BOOST_REQUIRE(mapLex.GetNextToken() == token);
+            BOOST_REQUIRE_EQUAL(mapLex.GetCurrentStr(), copyLex.GetCurrentStr());
+            BOOST_REQUIRE_EQUAL(mapLex.GetCurrentNumber(), copyLex.GetCurrentNumber());
+            BOOST_REQUIRE_EQUAL(mapLex.GetCurrentLocation().GetCurrentLine(), copyLex.GetCurrentLocation().GetCurrentLine());
+            BOOST_REQUIRE_EQUAL(mapLex.GetCurrentLocation().GetCurrentColumn(), copyLex.GetCurrentLocation().GetCurrentColumn());
+        } while (token != Lexer::Token::TOK_EOF);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( LexerInternedIdentifierTest )
+{
+    // Equal identifiers must share the same ID in the string pool, distinct ones must not
+    Lexer lex;
+    BOOST_REQUIRE(lex.Init("../sources/thread.tos"));
+
+    std::vector<std::pair<std::string, TosLang::Common::InternedString>> identifiers;
+    Lexer::Token token;
+    while ((token = lex.GetNextToken()) != Lexer::Token::TOK_EOF)
+    {
+        if (token != Lexer::Token::IDENTIFIER)
+            continue;
+
+        const TosLang::Common::InternedString ident = lex.GetCurrentIdentifier();
+        BOOST_REQUIRE_EQUAL(ident.GetStr(), lex.GetCurrentStr());
+        BOOST_REQUIRE(ident == TosLang::Common::InternedString{ lex.GetCurrentStr() });
+
+        for (const auto& seenIdent : identifiers)
+            BOOST_REQUIRE_EQUAL(seenIdent.first == ident.GetStr(), seenIdent.second == ident);
+
+        identifiers.emplace_back(std::string{ lex.GetCurrentStr() }, ident);
+    }
+
+    BOOST_REQUIRE(!identifiers.empty());
+    BOOST_REQUIRE(TosLang::Common::InternedString{ "" }.IsEmpty());
+}
+
+BOOST_AUTO_TEST_CASE( InternedStringConcurrentTest )
+{
+    // Threads intern the same strings while the pool grows, and read them back without locking
+    const size_t nbThreads = 4;
+    const size_t nbStrings = 20000;
+    std::vector<std::vector<TosLang::Common::InternedString>> interned(nbThreads);
+    std::atomic<size_t> nbMismatches{ 0 };
+    std::vector<std::thread> threads;
+    for (size_t iThread = 0; iThread < nbThreads; ++iThread)
+    {
+        threads.emplace_back([&interned, &nbMismatches, iThread, nbStrings]()
+        {
+            for (size_t iStr = 0; iStr < nbStrings; ++iStr)
+            {
+                const std::string str = "concurrent_" + std::to_string(iStr);
+                interned[iThread].emplace_back(str);
+                if (interned[iThread].back().GetStr() != str)
+                    ++nbMismatches;
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    BOOST_REQUIRE_EQUAL(nbMismatches, 0);
+    for (size_t iStr = 0; iStr < nbStrings; ++iStr)
+    {
+        for (size_t iThread = 1; iThread < nbThreads; ++iThread)
+            BOOST_REQUIRE(interned[iThread][iStr] == interned[0][iStr]);
+    }
+    BOOST_REQUIRE_GE(TosLang::Common::InternedString::GetPoolSize(), nbStrings + 1);
+}
+
 BOOST_AUTO_TEST_CASE( LexerVarDeclTest )
 {
     Lexer lex;
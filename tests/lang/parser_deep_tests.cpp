@@ -0,0 +1,117 @@
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#else
+#ifndef _WIN32
+#   define BOOST_TEST_MODULE DeepTests
+#endif
+#endif
+
+#include "toslang_parser_fixture.h"
+
+#include "Sema/symbolcollector.h"
+#include "Sema/symboltable.h"
+#include "Sema/typechecker.h"
+#include "SSA/cfgbuilder.h"
+#include "VM/bytecodegenerator.h"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace TosLang::BackEnd;
+using namespace TosLang::VM;
+
+/*
+* \fn               WriteDeepProgram
+* \brief            Writes a program whose main function sums a variable with itself in a single long binary expression
+* \param nbOperands Number of operands of the binary expression
+* \return           Name of the file containing the program
+*/
+static std::string WriteDeepProgram(size_t nbOperands)
+{
+    const std::string filename = (std::filesystem::temp_directory_path() / "toslang_deep_binary_expr.tos").string();
+
+    std::ofstream stream{ filename, std::ios::binary };
+    stream << "fn main() -> Void\n{\n    var value : Int = 1;\n    var total : Int = value";
+    for (size_t iOperand = 1; iOperand < nbOperands; ++iOperand)
+        stream << " + value";
+    stream << ";\n    print total;\n    return;\n}\n";
+
+    return filename;
+}
+
+BOOST_FIXTURE_TEST_SUITE( ParseTestSuite, TosLangParserFixture )
+
+BOOST_AUTO_TEST_CASE( ParseDeepBinaryExprChainTest )
+{
+    const size_t nbOperands = 1000000;
+    const std::string filename = WriteDeepProgram(nbOperands);
+    auto& cNodes = GetProgramAST(filename);
+    std::filesystem::remove(filename);
+    BOOST_REQUIRE_EQUAL(cNodes.size(), 1);
+    BOOST_REQUIRE(GetErrorMessages().empty());
+
+    const FunctionDecl* fDecl = static_cast<const FunctionDecl*>(cNodes[0].get());
+    auto& bStmts = fDecl->GetBody()->GetStatements();
+    BOOST_REQUIRE_EQUAL(bStmts.size(), 4);
+    BOOST_REQUIRE(bStmts[1]->GetKind() == ASTNode::NodeKind::VAR_DECL);
+
+    // Binary expressions are right associative, so the tree is as deep as the expression is long
+    const Expr* expr = static_cast<const VarDecl*>(bStmts[1].get())->GetInitExpr();
+    size_t depth = 0;
+    while (expr->GetKind() == ASTNode::NodeKind::BINARY_EXPR)
+    {
+        const BinaryOpExpr* bExpr = static_cast<const BinaryOpExpr*>(expr);
+        BOOST_REQUIRE(bExpr->GetLHS()->GetKind() == ASTNode::NodeKind::IDENTIFIER_EXPR);
+        expr = bExpr->GetRHS();
+        ++depth;
+    }
+    BOOST_REQUIRE(expr->GetKind() == ASTNode::NodeKind::IDENTIFIER_EXPR);
+    BOOST_REQUIRE_EQUAL(depth, nbOperands - 1);
+
+    // The visitors go through the whole depth of the tree
+    auto symTable = std::make_shared<SymbolTable>();
+    SymbolCollector sCollector{ symTable };
+    BOOST_REQUIRE_EQUAL(sCollector.Run(programAST), 0);
+
+    TypeChecker tChecker;
+    BOOST_REQUIRE_EQUAL(tChecker.Run(programAST, symTable), 0);
+
+    // As do the back ends, which produce one addition per operator
+    CFGBuilder builder;
+    auto ssaModule = builder.Run(programAST, symTable);
+    BOOST_REQUIRE(ssaModule != nullptr);
+    size_t nbSSAAdds = 0;
+    for (const auto& funcCFG : *ssaModule)
+    {
+        for (const auto& block : funcCFG.second->GetBlocks())
+        {
+            for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+            {
+                if ((*instIt)->GetOperation() == SSAInstruction::Operation::ADD)
+                    ++nbSSAAdds;
+            }
+        }
+    }
+    BOOST_REQUIRE_EQUAL(nbSSAAdds, nbOperands - 1);
+
+    BytecodeGenerator generator;
+    auto bytecodeModule = generator.Run(programAST, symTable);
+    BOOST_REQUIRE(bytecodeModule != nullptr);
+    size_t nbBytecodeAdds = 0;
+    for (const auto& function : bytecodeModule->GetFunctions())
+    {
+        // The intermediate sums all go to the same temporary
+        BOOST_REQUIRE_LT(function.GetNbRegisters(), 8);
+        for (const auto& inst : function.GetCode())
+        {
+            if (inst.mOp == OpCode::ADD)
+                ++nbBytecodeAdds;
+        }
+    }
+    BOOST_REQUIRE_EQUAL(nbBytecodeAdds, nbOperands - 1);
+
+    // So does the destruction of the tree
+    programAST.reset();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
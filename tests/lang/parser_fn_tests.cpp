@@ -10,6 +10,8 @@
 
 #include "toslang_parser_fixture.h"
 
+#include "Utils/scheduler.h"
+
 BOOST_FIXTURE_TEST_SUITE( ParseTestSuite, TosLangParserFixture )
 
 //////////////////// CORRECT USE CASES ////////////////////
@@ -157,8 +159,67 @@ BOOST_AUTO_TEST_CASE( ParseFuncMultiArgsTest )
     BOOST_REQUIRE(rExpr != nullptr);
 }
 
+BOOST_AUTO_TEST_CASE( ParseFuncArenaTest )
+{
+    // Every node of the program, and every list of children, comes from the arena of the program
+    auto& cNodes = GetProgramAST("../sources/function/fn_def_multi_args.tos");
+    const auto& arenas = static_cast<const ProgramDecl*>(programAST.get())->GetArenas();
+    BOOST_REQUIRE_EQUAL(arenas.size(), 1);
+    const ASTArena* arena = arenas.front().get();
+    BOOST_REQUIRE(arena != nullptr);
+    BOOST_REQUIRE_EQUAL(arena->GetNbBlocks(), 1);
+    BOOST_REQUIRE(arena->GetNbBytesAllocated() > 0);
+
+    BOOST_REQUIRE_EQUAL(cNodes.size(), 1);
+    const FunctionDecl* fDecl = static_cast<const FunctionDecl*>(cNodes[0].get());
+    BOOST_REQUIRE(fDecl->GetChildrenNodes().get_allocator().GetArena() == arena);
+    BOOST_REQUIRE(fDecl->GetParametersDecl()->GetParameters().get_allocator().GetArena() == arena);
+}
+
+BOOST_AUTO_TEST_CASE( ParseFuncMultipleFilesTest )
+{
+    // Files are parsed concurrently but their declarations, and their errors, come in the order of the files
+    TosLang::Utils::Scheduler scheduler{ 2 };
+    const std::vector<std::string> filenames{ "../sources/function/fn_def_multi_args.tos",
+                                              "../sources/function/bad_fn_no_name.tos",
+                                              "../sources/function/bad_fn_missing_left_paren.tos",
+                                              "../sources/function/fn_def_void.tos" };
+    programAST = Parser::ParseProgram(filenames, scheduler);
+    BOOST_REQUIRE(programAST != nullptr);
+    BOOST_REQUIRE(programAST->GetKind() == ASTNode::NodeKind::PROGRAM_DECL);
+
+    const ProgramDecl* pDecl = static_cast<const ProgramDecl*>(programAST.get());
+    BOOST_REQUIRE_EQUAL(pDecl->GetArenas().size(), filenames.size());
+
+    const ChildrenNodes& cNodes = pDecl->GetChildrenNodes();
+    BOOST_REQUIRE_EQUAL(cNodes.size(), 4);
+    BOOST_REQUIRE(cNodes[0]->GetKind() == ASTNode::NodeKind::FUNCTION_DECL);
+    BOOST_REQUIRE_EQUAL(cNodes[0]->GetName(), "MyFunc");
+    BOOST_REQUIRE(static_cast<const FunctionDecl*>(cNodes[0].get())->GetParametersDecl()->GetParameters().size() == 3);
+    BOOST_REQUIRE(cNodes[1]->GetKind() == ASTNode::NodeKind::ERROR);
+    BOOST_REQUIRE(cNodes[2]->GetKind() == ASTNode::NodeKind::ERROR);
+    BOOST_REQUIRE(cNodes[3]->GetKind() == ASTNode::NodeKind::FUNCTION_DECL);
+    BOOST_REQUIRE(static_cast<const FunctionDecl*>(cNodes[3].get())->GetParametersDecl()->GetParameters().empty());
+
+    std::vector<std::string> messages{ GetErrorMessages() };
+    BOOST_REQUIRE_EQUAL(messages.size(), 2);
+    BOOST_REQUIRE_EQUAL(messages[0], "FUNCTION ERROR: The fn keyword should be followed by an identifier at line 1, column 3");
+    BOOST_REQUIRE_EQUAL(messages[1], "FUNCTION ERROR: Missing left parenthesis in the function declaration at line 1, column 8");
+}
+
 //////////////////// ERROR USE CASES ////////////////////
 
+BOOST_AUTO_TEST_CASE( ParseMultipleFilesMissingFile )
+{
+    TosLang::Utils::Scheduler scheduler{ 2 };
+    const std::vector<std::string> filenames{ "../sources/function/fn_def_void.tos", "BadFile.tos" };
+    BOOST_REQUIRE(Parser::ParseProgram(filenames, scheduler) == nullptr);
+
+    std::vector<std::string> messages{ GetErrorMessages() };
+    BOOST_REQUIRE_EQUAL(messages.size(), 1);
+    BOOST_REQUIRE_EQUAL(messages[0], "FILE ERROR: Problem opening the specified file");
+}
+
 BOOST_AUTO_TEST_CASE( ParseBadFunctionMissingArrow )
 {
     auto& cNodes = GetProgramAST("../sources/function/bad_fn_missing_arrow.tos");
@@ -35,7 +35,7 @@ BOOST_AUTO_TEST_CASE( ParseHelloWorldTest )
     BOOST_REQUIRE(pStmt->GetMessage()->GetKind() == ASTNode::NodeKind::STRING_EXPR);
     const StringExpr* msg = static_cast<const StringExpr*>(pStmt->GetMessage());
     BOOST_REQUIRE(msg != nullptr);
-    BOOST_REQUIRE_EQUAL(msg->GetName(), "Hello World!");
+    BOOST_REQUIRE_EQUAL(msg->GetValue(), "Hello World!");
 }
 
 BOOST_AUTO_TEST_CASE( ParseBasicIOTest )
@@ -110,7 +110,7 @@ BOOST_AUTO_TEST_CASE( ParseVarInitStringTest )
     BOOST_REQUIRE(vDecl->GetInitExpr()->GetKind() == ASTNode::NodeKind::STRING_EXPR);
     const StringExpr* sExpr = static_cast<const StringExpr*>(vDecl->GetInitExpr());
     BOOST_REQUIRE(sExpr != nullptr);
-    BOOST_REQUIRE_EQUAL(sExpr->GetName(), "Hello World");
+    BOOST_REQUIRE_EQUAL(sExpr->GetValue(), "Hello World");
 }
 
 BOOST_AUTO_TEST_CASE( ParseVarInitBoolBinOpTest )
@@ -0,0 +1,132 @@
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#else
+#ifndef _WIN32
+#   define BOOST_TEST_MODULE PassStatisticsTests
+#endif
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include "Execution/compiler.h"
+#include "Execution/passstatistics.h"
+
+#include "AST/ast.h"
+#include "Parse/parser.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace Execution;
+
+/*
+* \fn           GetCounter
+* \brief        Finds a counter in the record of a pass
+* \param pass   Record of a pass
+* \param name   Name of the counter
+* \return       Value of the counter. 0 if the pass doesn't have it.
+*/
+static size_t GetCounter(const PassStatistics::PassRecord& pass, const std::string& name)
+{
+    for (const auto& counter : pass.mCounters)
+    {
+        if (counter.first == name)
+            return counter.second;
+    }
+
+    return 0;
+}
+
+BOOST_AUTO_TEST_CASE( PassStatisticsCompile )
+{
+    PassStatistics stats;
+    Compiler compiler;
+    compiler.SetStatistics(&stats);
+    BOOST_REQUIRE(compiler.Compile({ "../sources/cache/program.tos" }));
+
+    // Every pass of the front end gets a record, in the order they ran
+    const std::vector<std::string> expectedNames{ "Lexer", "Parser", "SymbolCollector", "TypeChecker" };
+    std::vector<std::string> names;
+    for (const auto& pass : stats.GetPasses())
+    {
+        names.push_back(pass.mName);
+        BOOST_REQUIRE_GE(pass.mWallTime, 0.0);
+        BOOST_REQUIRE_GE(pass.mCPUTime, 0.0);
+    }
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(names.begin(), names.end(), expectedNames.begin(), expectedNames.end());
+
+    const auto& passes = stats.GetPasses();
+    BOOST_REQUIRE_GT(GetCounter(passes[0], "tokens"), 0);
+    BOOST_REQUIRE_GT(GetCounter(passes[1], "ast_nodes"), 0);
+    BOOST_REQUIRE_GT(GetCounter(passes[2], "symbols"), 0);
+    BOOST_REQUIRE_EQUAL(GetCounter(passes[3], "checked_decls"), 3);
+}
+
+BOOST_AUTO_TEST_CASE( PassStatisticsDumpCFG )
+{
+    PassStatistics stats;
+    Compiler compiler;
+    compiler.SetStatistics(&stats);
+    BOOST_REQUIRE(compiler.DumpCFG({ "../sources/cache/program.tos" }));
+
+    // The back end passes follow the front end ones, the SSA passes being reported by the pass manager
+    const std::vector<std::string> expectedNames{ "Lexer", "Parser", "SymbolCollector", "CFGBuilder", "ConstantFolding", "SCCP", 
+                                                  "UnreachableBlockElimination", "GlobalValueNumbering", "LoopInvariantCodeMotion", "DeadCodeElimination" };
+    std::vector<std::string> names;
+    for (const auto& pass : stats.GetPasses())
+        names.push_back(pass.mName);
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(names.begin(), names.end(), expectedNames.begin(), expectedNames.end());
+
+    const auto& passes = stats.GetPasses();
+    BOOST_REQUIRE_EQUAL(GetCounter(passes[3], "functions"), 3);
+    BOOST_REQUIRE_GT(GetCounter(passes[3], "ssa_instructions"), 0);
+}
+
+BOOST_AUTO_TEST_CASE( PassStatisticsDeepAST )
+{
+    // A single binary expression as long as this makes a tree as deep, binary expressions being right associative
+    const size_t nbOperands = 1000000;
+    const std::string filename = (std::filesystem::temp_directory_path() / "toslang_deep_stats.tos").string();
+    {
+        std::ofstream stream{ filename, std::ios::binary };
+        stream << "fn main() -> Void\n{\n    var value : Int = 1;\n    var total : Int = value";
+        for (size_t iOperand = 1; iOperand < nbOperands; ++iOperand)
+            stream << " + value";
+        stream << ";\n    return;\n}\n";
+    }
+
+    TosLang::FrontEnd::Parser parser;
+    std::unique_ptr<TosLang::FrontEnd::ASTNode> programAST = parser.ParseProgram(filename);
+    std::filesystem::remove(filename);
+    BOOST_REQUIRE(programAST != nullptr);
+
+    // Every operand and every operator of the chain is a node, so the count is dominated by them
+    const size_t nbNodes = PassStatistics::CountASTNodes(programAST.get());
+    BOOST_REQUIRE_GT(nbNodes, 2 * nbOperands - 1);
+    BOOST_REQUIRE_LT(nbNodes, 2 * nbOperands + 16);
+}
+
+BOOST_AUTO_TEST_CASE( PassStatisticsReports )
+{
+    PassStatistics stats;
+    {
+        PassStatistics::Timer timer{ &stats, "Lexer" };
+    }
+    stats.AddCounter("tokens", 42);
+
+    // A timer without statistics measures nothing
+    {
+        PassStatistics::Timer timer{ nullptr, "Parser" };
+    }
+    BOOST_REQUIRE_EQUAL(stats.GetPasses().size(), 1);
+
+    std::stringstream table;
+    stats.PrintTable(table);
+    BOOST_REQUIRE(table.str().find("tokens=42") != std::string::npos);
+
+    std::stringstream json;
+    stats.PrintJSON(json);
+    BOOST_REQUIRE_EQUAL(json.str().compare(0, 30, "{\"passes\":[{\"name\":\"Lexer\",\"wa"), 0);
+    BOOST_REQUIRE(json.str().find("\"counters\":{\"tokens\":42}}]}") != std::string::npos);
+}
@@ -0,0 +1,678 @@
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE Main
+#else
+#ifndef _WIN32
+#   define BOOST_TEST_MODULE SSAPassTests
+#endif
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include "toslang_sema_fixture.h"
+
+#include "SSA/constantfolding.h"
+#include "SSA/deadcodeelimination.h"
+#include "SSA/globalvaluenumbering.h"
+#include "SSA/loopinvariantcodemotion.h"
+#include "SSA/sccp.h"
+#include "SSA/ssapassmanager.h"
+#include "SSA/unreachableblockelimination.h"
+
+#include <climits>
+#include <initializer_list>
+#include <sstream>
+
+using namespace TosLang::BackEnd;
+
+using Op = SSAInstruction::Operation;
+
+/*
+* \fn           AddInst
+* \brief        Appends an instruction to a block
+* \param block  Block receiving the instruction
+* \param op     Operation of the instruction
+* \param valID  ID of the value produced by the instruction
+* \param operands   Operands of the instruction
+* \return       Instruction added to the block
+*/
+static SSAInstruction* AddInst(const SSABlockPtr& block, Op op, size_t valID, std::initializer_list<SSAValue> operands = {})
+{
+    SSAInstruction inst{ op, valID, block.get() };
+    for (const SSAValue& operand : operands)
+        inst.AddOperand(operand);
+
+    block->InsertInstruction(inst);
+    return block->GetTerminator();
+}
+
+/*
+* \fn           IsConstant
+* \brief        Indicates if an instruction moves a given constant in its value
+* \param inst   Instruction
+* \param value  Expected constant
+* \return       True if the instruction is a move of the constant
+*/
+static bool IsConstant(const SSAInstruction* inst, int value)
+{
+    return ConstantFolding::IsConstantMove(*inst) && (inst->GetOperands().front().GetLiteralValue() == value);
+}
+
+/*
+* \fn           IsLiteral
+* \brief        Indicates if a value is a given literal
+* \param val    Value
+* \param value  Expected constant
+* \return       True if the value is the literal
+*/
+static bool IsLiteral(const SSAValue& val, int value)
+{
+    return (val.GetKind() == SSAValue::ValueKind::LITERAL) && (val.GetLiteralValue() == value);
+}
+
+BOOST_FIXTURE_TEST_SUITE( SSAPassTestSuite, TosLangSemaFixture )
+
+BOOST_AUTO_TEST_CASE( ConstantFoldingChains )
+{
+    SSAFunction func;
+    SSABlockPtr block = func.CreateNewBlock();
+    AddInst(block, Op::MOV, 0, { SSAValue{ 1, 2 } });
+    AddInst(block, Op::MOV, 2, { SSAValue{ 3, 3 } });
+    SSAInstruction* add = AddInst(block, Op::ADD, 4, { SSAValue{ 0 }, SSAValue{ 2 } });
+    SSAInstruction* mul = AddInst(block, Op::MUL, 5, { SSAValue{ 4 }, SSAValue{ 4 } });
+    AddInst(block, Op::MOV, 6, { SSAValue{ 7, 0 } });
+    SSAInstruction* div = AddInst(block, Op::DIV, 8, { SSAValue{ 5 }, SSAValue{ 6 } });
+    SSAInstruction* ret = AddInst(block, Op::RET, 9, { SSAValue{ 5 } });
+
+    ConstantFolding folding;
+    BOOST_REQUIRE_GT(folding.Run(func), 0);
+    BOOST_REQUIRE(IsConstant(add, 5));
+    BOOST_REQUIRE(IsConstant(mul, 25));
+    BOOST_REQUIRE(IsLiteral(ret->GetOperands().front(), 25));
+
+    // A division by zero is left for the machine to report
+    BOOST_REQUIRE(div->GetOperation() == Op::DIV);
+    BOOST_REQUIRE(IsLiteral(div->GetOperands()[0], 25));
+    BOOST_REQUIRE(IsLiteral(div->GetOperands()[1], 0));
+
+    // Nothing is left to fold
+    BOOST_REQUIRE_EQUAL(folding.Run(func), 0);
+}
+
+BOOST_AUTO_TEST_CASE( ConstantFoldingOperations )
+{
+    int result;
+    BOOST_REQUIRE(ConstantFolding::FoldOperation(Op::ADD, INT_MAX, 1, result));
+    BOOST_REQUIRE_EQUAL(result, INT_MIN);
+    BOOST_REQUIRE(ConstantFolding::FoldOperation(Op::SUB, 3, 5, result));
+    BOOST_REQUIRE_EQUAL(result, -2);
+    BOOST_REQUIRE(ConstantFolding::FoldOperation(Op::MOD, 17, 5, result));
+    BOOST_REQUIRE_EQUAL(result, 2);
+    BOOST_REQUIRE(ConstantFolding::FoldOperation(Op::LSHIFT, 1, 4, result));
+    BOOST_REQUIRE_EQUAL(result, 16);
+    BOOST_REQUIRE(ConstantFolding::FoldOperation(Op::RSHIFT, -16, 2, result));
+    BOOST_REQUIRE_EQUAL(result, -4);
+    BOOST_REQUIRE(ConstantFolding::FoldOperation(Op::XOR, 6, 3, result));
+    BOOST_REQUIRE_EQUAL(result, 5);
+    BOOST_REQUIRE(ConstantFolding::FoldOperation(Op::GT, 2, 1, result));
+    BOOST_REQUIRE_EQUAL(result, 1);
+
+    BOOST_REQUIRE(!ConstantFolding::FoldOperation(Op::MOD, 1, 0, result));
+    BOOST_REQUIRE(!ConstantFolding::FoldOperation(Op::DIV, INT_MIN, -1, result));
+    BOOST_REQUIRE(!ConstantFolding::FoldOperation(Op::LSHIFT, 1, 32, result));
+    BOOST_REQUIRE(!ConstantFolding::FoldOperation(Op::CALL, 1, 2, result));
+}
+
+BOOST_AUTO_TEST_CASE( SCCPConstantBranch )
+{
+    // Block0 branches on a constant to Block1 or Block2, which both lead to Block3
+    SSAFunction func;
+    SSABlockPtr condBlock = func.CreateNewBlock();
+    SSABlockPtr thenBlock = func.CreateNewBlock();
+    SSABlockPtr elseBlock = func.CreateNewBlock();
+    SSABlockPtr joinBlock = func.CreateNewBlock();
+
+    AddInst(condBlock, Op::MOV, 0, { SSAValue{ 1, 1 } });
+    SSAInstruction* br = AddInst(condBlock, Op::BR, 2, { SSAValue{ 0 } });
+    condBlock->InsertBranch(thenBlock);
+    condBlock->InsertBranch(elseBlock);
+
+    AddInst(thenBlock, Op::MOV, 3, { SSAValue{ 4, 10 } });
+    thenBlock->InsertBranch(joinBlock);
+
+    AddInst(elseBlock, Op::MOV, 5, { SSAValue{ 6, 20 } });
+    elseBlock->InsertBranch(joinBlock);
+
+    SSAInstruction* phi = AddInst(joinBlock, Op::PHI, 7, { SSAValue{ 3 }, SSAValue{ 5 } });
+    SSAInstruction* ret = AddInst(joinBlock, Op::RET, 8, { SSAValue{ 7 } });
+
+    SCCP sccp;
+    BOOST_REQUIRE_GT(sccp.Run(func), 0);
+    BOOST_REQUIRE(IsLiteral(br->GetOperands().front(), 1));
+    BOOST_REQUIRE(IsConstant(phi, 10));
+    BOOST_REQUIRE(IsLiteral(ret->GetOperands().front(), 10));
+
+    // The branch that can't be taken is gone
+    BOOST_REQUIRE_EQUAL(condBlock->GetSuccessors().size(), 1);
+    BOOST_REQUIRE_EQUAL(condBlock->GetSuccessors().front(), thenBlock);
+    BOOST_REQUIRE_EQUAL(elseBlock->GetPredecessors().size(), 0);
+    BOOST_REQUIRE_EQUAL(joinBlock->GetPredecessors().size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE( SCCPRemovesPHIOperands )
+{
+    // Block0 branches on a constant either to Block1 or straight to Block2, which merges both paths.
+    // The constant always goes to Block1, so the edge from Block0 to Block2 is never taken.
+    SSAFunction func;
+    SSABlockPtr condBlock = func.CreateNewBlock();
+    SSABlockPtr thenBlock = func.CreateNewBlock();
+    SSABlockPtr joinBlock = func.CreateNewBlock();
+    func.AddArguments(SSAValue{ 0 });
+
+    AddInst(condBlock, Op::MOV, 1, { SSAValue{ 2, 1 } });
+    AddInst(condBlock, Op::BR, 3, { SSAValue{ 1 } });
+    condBlock->InsertBranch(thenBlock);
+    condBlock->InsertBranch(joinBlock);
+
+    AddInst(thenBlock, Op::ADD, 4, { SSAValue{ 0 }, SSAValue{ 5, 7 } });
+    thenBlock->InsertBranch(joinBlock);
+
+    // The PHI merges values which can't be known, the argument coming from the edge that is never taken
+    SSAInstruction* phi = AddInst(joinBlock, Op::PHI, 6, { SSAValue{ 0 }, SSAValue{ 4 } });
+    AddInst(joinBlock, Op::RET, 7, { SSAValue{ 6 } });
+
+    SCCP sccp;
+    sccp.Run(func);
+    BOOST_REQUIRE_EQUAL(condBlock->GetSuccessors().size(), 1);
+    BOOST_REQUIRE_EQUAL(condBlock->GetSuccessors().front(), thenBlock);
+    BOOST_REQUIRE_EQUAL(joinBlock->GetPredecessors().size(), 1);
+    BOOST_REQUIRE_EQUAL(joinBlock->GetPredecessors().front(), thenBlock);
+
+    // The operand of the removed edge went away with it
+    BOOST_REQUIRE(phi->GetOperation() == Op::PHI);
+    BOOST_REQUIRE_EQUAL(phi->GetOperands().size(), 1);
+    BOOST_REQUIRE_EQUAL(phi->GetOperands()[0].GetID(), 4);
+}
+
+BOOST_AUTO_TEST_CASE( SCCPLoop )
+{
+    // Block1 loops through Block2 as long as its PHI is lower than the argument, but the PHI only ever merges the same constant
+    SSAFunction func;
+    SSABlockPtr entryBlock = func.CreateNewBlock();
+    SSABlockPtr headerBlock = func.CreateNewBlock();
+    SSABlockPtr bodyBlock = func.CreateNewBlock();
+    SSABlockPtr exitBlock = func.CreateNewBlock();
+    func.AddArguments(SSAValue{ 9 });
+
+    AddInst(entryBlock, Op::MOV, 0, { SSAValue{ 10, 5 } });
+    entryBlock->InsertBranch(headerBlock);
+
+    SSAInstruction* phi = AddInst(headerBlock, Op::PHI, 1, { SSAValue{ 0 }, SSAValue{ 3 } });
+    SSAInstruction* cond = AddInst(headerBlock, Op::LT, 2, { SSAValue{ 1 }, SSAValue{ 9 } });
+    AddInst(headerBlock, Op::BR, 11, { SSAValue{ 2 } });
+    headerBlock->InsertBranch(bodyBlock);
+    headerBlock->InsertBranch(exitBlock);
+
+    SSAInstruction* copy = AddInst(bodyBlock, Op::MOV, 3, { SSAValue{ 1 } });
+    bodyBlock->InsertBranch(headerBlock);
+
+    SSAInstruction* ret = AddInst(exitBlock, Op::RET, 4, { SSAValue{ 1 } });
+
+    SCCP sccp;
+    BOOST_REQUIRE_GT(sccp.Run(func), 0);
+    BOOST_REQUIRE(IsConstant(phi, 5));
+    BOOST_REQUIRE(IsConstant(copy, 5));
+    BOOST_REQUIRE(IsLiteral(ret->GetOperands().front(), 5));
+
+    // The condition depends on the argument, so both branches stay
+    BOOST_REQUIRE(cond->GetOperation() == Op::LT);
+    BOOST_REQUIRE(IsLiteral(cond->GetOperands()[0], 5));
+    BOOST_REQUIRE_EQUAL(headerBlock->GetSuccessors().size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE( DeadBranchRemoved )
+{
+    // Block0 reaches Block1 through two branches, as the builder does for the body of an if statement
+    SSAFunction func;
+    SSABlockPtr condBlock = func.CreateNewBlock();
+    SSABlockPtr thenBlock = func.CreateNewBlock();
+    SSABlockPtr exitBlock = func.CreateNewBlock();
+
+    AddInst(condBlock, Op::MOV, 0, { SSAValue{ 1, 0 } });
+    AddInst(condBlock, Op::BR, 2, { SSAValue{ 0 } });
+    condBlock->InsertBranch(thenBlock);
+    condBlock->InsertBranch(thenBlock);
+    condBlock->InsertBranch(exitBlock);
+
+    AddInst(thenBlock, Op::MOV, 3, { SSAValue{ 4, 1 } });
+    AddInst(thenBlock, Op::MUL, 5, { SSAValue{ 3 }, SSAValue{ 3 } });
+    thenBlock->InsertBranch(exitBlock);
+
+    AddInst(exitBlock, Op::RET, 6);
+
+    // The condition never holds, so only the branch to Block2 is left and Block1 can go
+    SCCP sccp;
+    BOOST_REQUIRE_GT(sccp.Run(func), 0);
+    BOOST_REQUIRE_EQUAL(condBlock->GetSuccessors().size(), 1);
+    BOOST_REQUIRE_EQUAL(condBlock->GetSuccessors().front(), exitBlock);
+
+    UnreachableBlockElimination blockElim;
+    BOOST_REQUIRE_EQUAL(blockElim.Run(func), 1);
+    BOOST_REQUIRE_EQUAL(func.GetBlocks().size(), 2);
+    BOOST_REQUIRE_EQUAL(exitBlock->GetPredecessors().size(), 1);
+
+    // Nothing uses the condition anymore but the branch
+    DeadCodeElimination dce;
+    BOOST_REQUIRE_EQUAL(dce.Run(func), 1);
+    BOOST_REQUIRE_EQUAL(condBlock->GetNbInstructions(), 1);
+}
+
+BOOST_AUTO_TEST_CASE( UnreachableBlocksRemoved )
+{
+    // Block3 and Block4 only branch to each other and to Block2, which merges the values of all its predecessors
+    SSAFunction func;
+    SSABlockPtr entryBlock = func.CreateNewBlock();
+    SSABlockPtr thenBlock = func.CreateNewBlock();
+    SSABlockPtr joinBlock = func.CreateNewBlock();
+    SSABlockPtr deadBlock = func.CreateNewBlock();
+    SSABlockPtr otherDeadBlock = func.CreateNewBlock();
+    func.AddArguments(SSAValue{ 0 });
+
+    AddInst(entryBlock, Op::BR, 1, { SSAValue{ 0 } });
+    entryBlock->InsertBranch(thenBlock);
+    entryBlock->InsertBranch(joinBlock);
+
+    AddInst(thenBlock, Op::MOV, 2, { SSAValue{ 3, 1 } });
+    thenBlock->InsertBranch(joinBlock);
+
+    AddInst(deadBlock, Op::MOV, 4, { SSAValue{ 5, 2 } });
+    deadBlock->InsertBranch(joinBlock);
+    deadBlock->InsertBranch(otherDeadBlock);
+    otherDeadBlock->InsertBranch(deadBlock);
+
+    SSAInstruction* phi = AddInst(joinBlock, Op::PHI, 6, { SSAValue{ 0 }, SSAValue{ 2 }, SSAValue{ 4 } });
+    AddInst(joinBlock, Op::RET, 7, { SSAValue{ 6 } });
+
+    UnreachableBlockElimination blockElim;
+    BOOST_REQUIRE_EQUAL(blockElim.Run(func), 2);
+    BOOST_REQUIRE_EQUAL(func.GetBlocks().size(), 3);
+    BOOST_REQUIRE_EQUAL(func.GetBlocks().back(), joinBlock);
+    BOOST_REQUIRE_EQUAL(joinBlock->GetPredecessors().size(), 2);
+
+    const std::vector<SSAValue> expectedOperands{ SSAValue{ 0 }, SSAValue{ 2 } };
+    BOOST_REQUIRE(phi->GetOperands() == expectedOperands);
+
+    // Every block left is reachable
+    BOOST_REQUIRE_EQUAL(blockElim.Run(func), 0);
+}
+
+BOOST_AUTO_TEST_CASE( DeadInstructionsRemoved )
+{
+    SSAFunction func;
+    SSABlockPtr block = func.CreateNewBlock();
+    func.AddArguments(SSAValue{ 0 });
+
+    // A chain of instructions whose last value is never used
+    AddInst(block, Op::MOV, 1, { SSAValue{ 2, 3 } });
+    AddInst(block, Op::ADD, 3, { SSAValue{ 1 }, SSAValue{ 1 } });
+    AddInst(block, Op::MUL, 4, { SSAValue{ 3 }, SSAValue{ 0 } });
+
+    // Dividing by a value that may be zero can stop the program, and so can dividing INT_MIN by -1,
+    // unlike dividing by any other literal
+    SSAInstruction* div = AddInst(block, Op::DIV, 5, { SSAValue{ 0 }, SSAValue{ 0 } });
+    AddInst(block, Op::MOD, 6, { SSAValue{ 0 }, SSAValue{ 7, 4 } });
+    SSAInstruction* negDiv = AddInst(block, Op::DIV, 12, { SSAValue{ 0 }, SSAValue{ 13, -1 } });
+    SSAInstruction* negMod = AddInst(block, Op::MOD, 14, { SSAValue{ 0 }, SSAValue{ 15, -1 } });
+
+    SSAInstruction* call = AddInst(block, Op::CALL, 8, { SSAValue{ 0 } });
+    SSAInstruction* result = AddInst(block, Op::MOV, 9, { SSAValue{ 10, 7 } });
+    SSAInstruction* ret = AddInst(block, Op::RET, 11, { SSAValue{ 9 } });
+
+    DeadCodeElimination dce;
+    BOOST_REQUIRE_EQUAL(dce.Run(func), 4);
+
+    std::vector<const SSAInstruction*> insts;
+    for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+        insts.push_back(instIt->get());
+    const std::vector<const SSAInstruction*> expectedInsts{ div, negDiv, negMod, call, result, ret };
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(insts.begin(), insts.end(), expectedInsts.begin(), expectedInsts.end());
+
+    // The users of the instructions left are up to date
+    BOOST_REQUIRE_EQUAL(result->GetUsers().size(), 1);
+    BOOST_REQUIRE_EQUAL(result->GetUsers().front(), ret);
+
+    BOOST_REQUIRE_EQUAL(dce.Run(func), 0);
+}
+
+BOOST_AUTO_TEST_CASE( RedundantInstructionsRemoved )
+{
+    SSAFunction func;
+    SSABlockPtr block = func.CreateNewBlock();
+    func.AddArguments(SSAValue{ 0 });
+    func.AddArguments(SSAValue{ 1 });
+
+    // Operands of commutative operations can come in any order, and a copy is the value it copies
+    AddInst(block, Op::MOV, 2, { SSAValue{ 0 } });
+    SSAInstruction* add = AddInst(block, Op::ADD, 3, { SSAValue{ 2 }, SSAValue{ 1 } });
+    AddInst(block, Op::ADD, 4, { SSAValue{ 1 }, SSAValue{ 0 } });
+    SSAInstruction* sub = AddInst(block, Op::SUB, 5, { SSAValue{ 1 }, SSAValue{ 0 } });
+    SSAInstruction* lt = AddInst(block, Op::LT, 6, { SSAValue{ 1 }, SSAValue{ 0 } });
+    AddInst(block, Op::GT, 7, { SSAValue{ 0 }, SSAValue{ 1 } });
+    SSAInstruction* constant = AddInst(block, Op::MOV, 8, { SSAValue{ 9, 4 } });
+    AddInst(block, Op::MOV, 10, { SSAValue{ 11, 4 } });
+    SSAInstruction* mul = AddInst(block, Op::MUL, 12, { SSAValue{ 4 }, SSAValue{ 10 } });
+    SSAInstruction* ret = AddInst(block, Op::RET, 13, { SSAValue{ 12 }, SSAValue{ 7 }, SSAValue{ 5 } });
+
+    GlobalValueNumbering gvn;
+    BOOST_REQUIRE_EQUAL(gvn.Run(func), 4);
+
+    std::vector<const SSAInstruction*> insts;
+    for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+        insts.push_back(instIt->get());
+    const std::vector<const SSAInstruction*> expectedInsts{ add, sub, lt, constant, mul, ret };
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(insts.begin(), insts.end(), expectedInsts.begin(), expectedInsts.end());
+
+    // Users now refer to the instructions left
+    BOOST_REQUIRE(add->GetOperands().front() == SSAValue{ 0 });
+    BOOST_REQUIRE(mul->GetOperands()[0] == SSAValue{ 3 });
+    BOOST_REQUIRE(mul->GetOperands()[1] == SSAValue{ 8 });
+    BOOST_REQUIRE(ret->GetOperands()[1] == SSAValue{ 6 });
+    BOOST_REQUIRE_EQUAL(add->GetUsers().size(), 1);
+    BOOST_REQUIRE_EQUAL(add->GetUsers().front(), mul);
+    BOOST_REQUIRE_EQUAL(lt->GetUsers().size(), 1);
+    BOOST_REQUIRE_EQUAL(lt->GetUsers().front(), ret);
+
+    BOOST_REQUIRE_EQUAL(gvn.Run(func), 0);
+}
+
+BOOST_AUTO_TEST_CASE( RedundantInstructionsNeedDominance )
+{
+    // condBlock -> (thenBlock | elseBlock) -> joinBlock
+    SSAFunction func;
+    SSABlockPtr condBlock = func.CreateNewBlock();
+    SSABlockPtr thenBlock = func.CreateNewBlock();
+    SSABlockPtr elseBlock = func.CreateNewBlock();
+    SSABlockPtr joinBlock = func.CreateNewBlock();
+    func.AddArguments(SSAValue{ 0 });
+    func.AddArguments(SSAValue{ 1 });
+
+    AddInst(condBlock, Op::MUL, 2, { SSAValue{ 0 }, SSAValue{ 1 } });
+    AddInst(condBlock, Op::BR, 3, { SSAValue{ 2 } });
+    condBlock->InsertBranch(thenBlock);
+    condBlock->InsertBranch(elseBlock);
+
+    // Computed by the block dominating this one
+    AddInst(thenBlock, Op::MUL, 4, { SSAValue{ 1 }, SSAValue{ 0 } });
+    AddInst(thenBlock, Op::SUB, 5, { SSAValue{ 0 }, SSAValue{ 1 } });
+    AddInst(thenBlock, Op::BR, 6);
+    thenBlock->InsertBranch(joinBlock);
+
+    // Computed by a block that doesn't dominate the others
+    SSAInstruction* elseSub = AddInst(elseBlock, Op::SUB, 7, { SSAValue{ 0 }, SSAValue{ 1 } });
+    AddInst(elseBlock, Op::BR, 8);
+    elseBlock->InsertBranch(joinBlock);
+
+    SSAInstruction* joinSub = AddInst(joinBlock, Op::SUB, 9, { SSAValue{ 0 }, SSAValue{ 1 } });
+    AddInst(joinBlock, Op::RET, 10, { SSAValue{ 4 }, SSAValue{ 9 } });
+
+    GlobalValueNumbering gvn;
+    BOOST_REQUIRE_EQUAL(gvn.Run(func), 1);
+    BOOST_REQUIRE_EQUAL(thenBlock->GetNbInstructions(), 2);
+    BOOST_REQUIRE_EQUAL(elseBlock->GetNbInstructions(), 2);
+    BOOST_REQUIRE_EQUAL(elseBlock->inst_begin()->get(), elseSub);
+    BOOST_REQUIRE_EQUAL(joinBlock->inst_begin()->get(), joinSub);
+    BOOST_REQUIRE(joinBlock->GetTerminator()->GetOperands().front() == SSAValue{ 2 });
+}
+
+BOOST_AUTO_TEST_CASE( LoopInvariantsHoisted )
+{
+    // entryBlock -> outerHeader -> (innerPreheader -> innerHeader -> (innerBody | innerExit) | exitBlock)
+    SSAFunction func;
+    SSABlockPtr entryBlock = func.CreateNewBlock();
+    SSABlockPtr outerHeader = func.CreateNewBlock();
+    SSABlockPtr innerPreheader = func.CreateNewBlock();
+    SSABlockPtr innerHeader = func.CreateNewBlock();
+    SSABlockPtr innerBody = func.CreateNewBlock();
+    SSABlockPtr innerExit = func.CreateNewBlock();
+    SSABlockPtr exitBlock = func.CreateNewBlock();
+    func.AddArguments(SSAValue{ 0 });
+    func.AddArguments(SSAValue{ 1 });
+
+    AddInst(entryBlock, Op::BR, 2);
+    entryBlock->InsertBranch(outerHeader);
+
+    AddInst(outerHeader, Op::PHI, 3, { SSAValue{ 30, 0 }, SSAValue{ 12 } });
+    AddInst(outerHeader, Op::LT, 4, { SSAValue{ 3 }, SSAValue{ 0 } });
+    AddInst(outerHeader, Op::BR, 5, { SSAValue{ 4 } });
+    outerHeader->InsertBranch(innerPreheader);
+    outerHeader->InsertBranch(exitBlock);
+
+    AddInst(innerPreheader, Op::MUL, 6, { SSAValue{ 1 }, SSAValue{ 31, 3 } });
+    AddInst(innerPreheader, Op::BR, 7);
+    innerPreheader->InsertBranch(innerHeader);
+
+    AddInst(innerHeader, Op::PHI, 8, { SSAValue{ 32, 0 }, SSAValue{ 11 } });
+    AddInst(innerHeader, Op::LT, 9, { SSAValue{ 8 }, SSAValue{ 6 } });
+    AddInst(innerHeader, Op::BR, 10, { SSAValue{ 9 } });
+    innerHeader->InsertBranch(innerBody);
+    innerHeader->InsertBranch(innerExit);
+
+    // Invariant in both loops, invariant in the inner loop only, side effects, variant
+    AddInst(innerBody, Op::ADD, 13, { SSAValue{ 0 }, SSAValue{ 1 } });
+    AddInst(innerBody, Op::MUL, 14, { SSAValue{ 3 }, SSAValue{ 6 } });
+    AddInst(innerBody, Op::DIV, 15, { SSAValue{ 0 }, SSAValue{ 1 } });
+    AddInst(innerBody, Op::DIV, 16, { SSAValue{ 13 }, SSAValue{ 33, 2 } });
+    AddInst(innerBody, Op::ADD, 11, { SSAValue{ 8 }, SSAValue{ 34, 1 } });
+    AddInst(innerBody, Op::BR, 17);
+    innerBody->InsertBranch(innerHeader);
+
+    AddInst(innerExit, Op::ADD, 12, { SSAValue{ 3 }, SSAValue{ 35, 1 } });
+    AddInst(innerExit, Op::BR, 18);
+    innerExit->InsertBranch(outerHeader);
+
+    AddInst(exitBlock, Op::RET, 19, { SSAValue{ 3 } });
+
+    LoopInvariantCodeMotion licm;
+    BOOST_REQUIRE_EQUAL(licm.Run(func), 4);
+    BOOST_REQUIRE_EQUAL(func.GetBlocks().size(), 7);
+
+    auto getValueIDs = [](const SSABlockPtr& block)
+    {
+        std::vector<size_t> valueIDs;
+        for (auto instIt = block->inst_begin(), instEnd = block->inst_end(); instIt != instEnd; ++instIt)
+            valueIDs.push_back((*instIt)->GetReturnValue().GetID());
+        return valueIDs;
+    };
+
+    // Instructions are moved before the branch to the loop, as far out as their operands allow
+    const std::vector<size_t> entryIDs = getValueIDs(entryBlock);
+    const std::vector<size_t> expectedEntryIDs{ 6, 13, 16, 2 };
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(entryIDs.begin(), entryIDs.end(), expectedEntryIDs.begin(), expectedEntryIDs.end());
+
+    const std::vector<size_t> preheaderIDs = getValueIDs(innerPreheader);
+    const std::vector<size_t> expectedPreheaderIDs{ 14, 7 };
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(preheaderIDs.begin(), preheaderIDs.end(), expectedPreheaderIDs.begin(), expectedPreheaderIDs.end());
+
+    const std::vector<size_t> bodyIDs = getValueIDs(innerBody);
+    const std::vector<size_t> expectedBodyIDs{ 15, 11, 17 };
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(bodyIDs.begin(), bodyIDs.end(), expectedBodyIDs.begin(), expectedBodyIDs.end());
+
+    for (auto instIt = entryBlock->inst_begin(), instEnd = entryBlock->inst_end(); instIt != instEnd; ++instIt)
+        BOOST_REQUIRE_EQUAL((*instIt)->GetBlock(), entryBlock.get());
+
+    BOOST_REQUIRE_EQUAL(licm.Run(func), 0);
+}
+
+BOOST_AUTO_TEST_CASE( LoopPreheaderCreated )
+{
+    // (entryBlock | otherBlock) -> headerBlock -> (bodyBlock | exitBlock), entryBlock branching to otherBlock as well
+    SSAFunction func;
+    SSABlockPtr entryBlock = func.CreateNewBlock();
+    SSABlockPtr otherBlock = func.CreateNewBlock();
+    SSABlockPtr headerBlock = func.CreateNewBlock();
+    SSABlockPtr bodyBlock = func.CreateNewBlock();
+    SSABlockPtr exitBlock = func.CreateNewBlock();
+    func.AddArguments(SSAValue{ 0 });
+    func.AddArguments(SSAValue{ 1 });
+    func.AddArguments(SSAValue{ 2 });
+
+    AddInst(entryBlock, Op::BR, 3, { SSAValue{ 2 } });
+    entryBlock->InsertBranch(headerBlock);
+    entryBlock->InsertBranch(otherBlock);
+
+    AddInst(otherBlock, Op::BR, 4);
+    otherBlock->InsertBranch(headerBlock);
+
+    // One PHI gets different values from outside of the loop, the other the same one
+    SSAInstruction* mergedPhi = AddInst(headerBlock, Op::PHI, 5, { SSAValue{ 0 }, SSAValue{ 1 }, SSAValue{ 9 } });
+    SSAInstruction* samePhi = AddInst(headerBlock, Op::PHI, 6, { SSAValue{ 0 }, SSAValue{ 0 }, SSAValue{ 6 } });
+    AddInst(headerBlock, Op::LT, 7, { SSAValue{ 5 }, SSAValue{ 1 } });
+    AddInst(headerBlock, Op::BR, 8, { SSAValue{ 7 } });
+    headerBlock->InsertBranch(bodyBlock);
+    headerBlock->InsertBranch(exitBlock);
+
+    AddInst(bodyBlock, Op::MUL, 10, { SSAValue{ 0 }, SSAValue{ 1 } });
+    AddInst(bodyBlock, Op::ADD, 9, { SSAValue{ 5 }, SSAValue{ 10 } });
+    AddInst(bodyBlock, Op::BR, 11);
+    bodyBlock->InsertBranch(headerBlock);
+
+    AddInst(exitBlock, Op::RET, 12, { SSAValue{ 6 } });
+
+    LoopInvariantCodeMotion licm;
+    BOOST_REQUIRE_EQUAL(licm.Run(func), 1);
+    BOOST_REQUIRE_EQUAL(func.GetBlocks().size(), 6);
+    BOOST_REQUIRE_EQUAL(bodyBlock->GetNbInstructions(), 2);
+
+    // The branches entering the loop go through the preheader, in place of the header
+    SSABlockPtr preheader = func.GetBlocks().back();
+    BOOST_REQUIRE_EQUAL(entryBlock->GetSuccessors()[0], preheader);
+    BOOST_REQUIRE_EQUAL(entryBlock->GetSuccessors()[1], otherBlock);
+    BOOST_REQUIRE_EQUAL(otherBlock->GetSuccessors()[0], preheader);
+    BOOST_REQUIRE_EQUAL(preheader->GetPredecessors().size(), 2);
+    BOOST_REQUIRE_EQUAL(preheader->GetSuccessors().size(), 1);
+    BOOST_REQUIRE_EQUAL(preheader->GetSuccessors()[0], headerBlock);
+    BOOST_REQUIRE_EQUAL(headerBlock->GetPredecessors().size(), 2);
+    BOOST_REQUIRE_EQUAL(headerBlock->GetPredecessors()[0], bodyBlock);
+    BOOST_REQUIRE_EQUAL(headerBlock->GetPredecessors()[1], preheader);
+    BOOST_REQUIRE_EQUAL(func.GetAnalysis().GetImmediateDominator(headerBlock.get()), preheader.get());
+
+    // PHI merging the values from outside of the loop, hoisted instruction, branch to the header
+    BOOST_REQUIRE_EQUAL(preheader->GetNbInstructions(), 3);
+    const SSAInstruction* preheaderPhi = preheader->inst_begin()->get();
+    BOOST_REQUIRE(preheaderPhi->GetOperation() == Op::PHI);
+    BOOST_REQUIRE_EQUAL(preheaderPhi->GetOperands().size(), 2);
+    BOOST_REQUIRE(preheaderPhi->GetOperands()[0] == SSAValue{ 0 });
+    BOOST_REQUIRE(preheaderPhi->GetOperands()[1] == SSAValue{ 1 });
+    BOOST_REQUIRE_EQUAL((preheader->inst_begin() + 1)->get()->GetReturnValue().GetID(), 10);
+    BOOST_REQUIRE(preheader->GetTerminator()->GetOperation() == Op::BR);
+    BOOST_REQUIRE(preheader->GetTerminator()->GetOperands().empty());
+
+    // PHI operands follow the new order of the predecessors
+    BOOST_REQUIRE_EQUAL(mergedPhi->GetOperands().size(), 2);
+    BOOST_REQUIRE(mergedPhi->GetOperands()[0] == SSAValue{ 9 });
+    BOOST_REQUIRE(mergedPhi->GetOperands()[1] == preheaderPhi->GetReturnValue());
+    BOOST_REQUIRE_EQUAL(samePhi->GetOperands().size(), 2);
+    BOOST_REQUIRE(samePhi->GetOperands()[0] == SSAValue{ 6 });
+    BOOST_REQUIRE(samePhi->GetOperands()[1] == SSAValue{ 0 });
+
+    // The new values don't collide with the existing ones
+    BOOST_REQUIRE_GT(preheaderPhi->GetReturnValue().GetID(), 12);
+    BOOST_REQUIRE_GT(preheader->GetTerminator()->GetReturnValue().GetID(), 12);
+    BOOST_REQUIRE(preheaderPhi->GetReturnValue().GetID() != preheader->GetTerminator()->GetReturnValue().GetID());
+
+    BOOST_REQUIRE_EQUAL(licm.Run(func), 0);
+    BOOST_REQUIRE_EQUAL(func.GetBlocks().size(), 6);
+}
+
+BOOST_AUTO_TEST_CASE( LoopVariantsKept )
+{
+    // entryBlock -> headerBlock -> (bodyBlock | exitBlock)
+    SSAFunction func;
+    SSABlockPtr entryBlock = func.CreateNewBlock();
+    SSABlockPtr headerBlock = func.CreateNewBlock();
+    SSABlockPtr bodyBlock = func.CreateNewBlock();
+    SSABlockPtr exitBlock = func.CreateNewBlock();
+    func.AddArguments(SSAValue{ 0 });
+    func.AddArguments(SSAValue{ 1 });
+
+    AddInst(entryBlock, Op::BR, 2);
+    entryBlock->InsertBranch(headerBlock);
+
+    AddInst(headerBlock, Op::PHI, 3, { SSAValue{ 20, 0 }, SSAValue{ 4 } });
+    AddInst(headerBlock, Op::LT, 5, { SSAValue{ 3 }, SSAValue{ 0 } });
+    AddInst(headerBlock, Op::BR, 6, { SSAValue{ 5 } });
+    headerBlock->InsertBranch(bodyBlock);
+    headerBlock->InsertBranch(exitBlock);
+
+    // Side effects, values computed from the PHI, divisions that could be by zero or overflow
+    AddInst(bodyBlock, Op::CALL, 7, { SSAValue{ 0 } });
+    AddInst(bodyBlock, Op::MOV, 8, { SSAValue{ 0 }, SSAValue{ 1 } });
+    AddInst(bodyBlock, Op::DIV, 9, { SSAValue{ 0 }, SSAValue{ 1 } });
+    AddInst(bodyBlock, Op::MOD, 10, { SSAValue{ 0 }, SSAValue{ 21, 0 } });
+    AddInst(bodyBlock, Op::DIV, 14, { SSAValue{ 0 }, SSAValue{ 23, -1 } });
+    AddInst(bodyBlock, Op::ADD, 4, { SSAValue{ 3 }, SSAValue{ 22, 1 } });
+    AddInst(bodyBlock, Op::MUL, 11, { SSAValue{ 4 }, SSAValue{ 1 } });
+    AddInst(bodyBlock, Op::BR, 12);
+    bodyBlock->InsertBranch(headerBlock);
+
+    AddInst(exitBlock, Op::RET, 13, { SSAValue{ 3 } });
+
+    LoopInvariantCodeMotion licm;
+    BOOST_REQUIRE_EQUAL(licm.Run(func), 0);
+    BOOST_REQUIRE_EQUAL(entryBlock->GetNbInstructions(), 1);
+    BOOST_REQUIRE_EQUAL(bodyBlock->GetNbInstructions(), 8);
+
+    // Nothing can be moved out of a loop starting at the entry block, which has no way of getting a preheader
+    SSAFunction entryLoopFunc;
+    SSABlockPtr loopBlock = entryLoopFunc.CreateNewBlock();
+    SSABlockPtr loopExit = entryLoopFunc.CreateNewBlock();
+    entryLoopFunc.AddArguments(SSAValue{ 0 });
+
+    AddInst(loopBlock, Op::ADD, 1, { SSAValue{ 0 }, SSAValue{ 10, 1 } });
+    AddInst(loopBlock, Op::BR, 2, { SSAValue{ 0 } });
+    loopBlock->InsertBranch(loopBlock);
+    loopBlock->InsertBranch(loopExit);
+
+    AddInst(loopExit, Op::RET, 3, { SSAValue{ 1 } });
+
+    BOOST_REQUIRE_EQUAL(licm.Run(entryLoopFunc), 0);
+    BOOST_REQUIRE_EQUAL(entryLoopFunc.GetBlocks().size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE( SSAPassManagerTimings )
+{
+    auto symTable = std::make_shared<SymbolTable>();
+    size_t errorCount = GetProgramSymbolTable("../asts/function/fn_def_multi_control_flow.ast", symTable);
+    BOOST_REQUIRE_EQUAL(errorCount, 0);
+
+    CFGBuilder builder;
+    std::unique_ptr<SSAModule> module = builder.Run(programAST, symTable);
+    BOOST_REQUIRE(module != nullptr);
+
+    SSAPassManager passManager;
+    passManager.AddOptimizationPasses();
+    const size_t nbChanges = passManager.Run(*module);
+    BOOST_REQUIRE_GT(nbChanges, 0);
+
+    // Every pass of the pipeline gets measured, in the order they ran
+    const std::vector<std::string> expectedNames{ "ConstantFolding", "SCCP", "UnreachableBlockElimination", "GlobalValueNumbering", "LoopInvariantCodeMotion", "DeadCodeElimination" };
+    std::vector<std::string> names;
+    size_t nbTimedChanges = 0;
+    for (const auto& timing : passManager.GetTimings())
+    {
+        names.push_back(timing.mName);
+        BOOST_REQUIRE_GE(timing.mWallTime, 0.0);
+        BOOST_REQUIRE_GE(timing.mCPUTime, 0.0);
+        nbTimedChanges += timing.mNbChanges;
+    }
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(names.begin(), names.end(), expectedNames.begin(), expectedNames.end());
+    BOOST_REQUIRE_EQUAL(nbTimedChanges, nbChanges);
+
+    std::stringstream table;
+    passManager.PrintTimings(table);
+    BOOST_REQUIRE(table.str().find("SCCP") != std::string::npos);
+
+    // Running the pipeline again finds nothing left to do
+    BOOST_REQUIRE_EQUAL(passManager.Run(*module), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -10,6 +10,8 @@
 
 #include "toslang_sema_fixture.h"
 
+#include "AST/declarations.h"
+
 BOOST_FIXTURE_TEST_SUITE( SemaTestSuite, TosLangSemaFixture )
 
 //////////////////// CORRECT USE CASES ////////////////////
@@ -108,6 +110,29 @@ BOOST_AUTO_TEST_CASE( CollectSymbolNoErrorAccumulation )
     BOOST_REQUIRE_EQUAL(errorCount, 0);
 }
 
+BOOST_AUTO_TEST_CASE( CollectSymbolScopeTree )
+{
+    std::unique_ptr<ASTNode> rootNode = reader.Run("../asts/var/var_init_identifier_from_global.ast");
+    BOOST_REQUIRE(rootNode != nullptr);
+
+    auto symbolTable = std::make_shared<TosLang::FrontEnd::SymbolTable>();
+    TosLang::FrontEnd::SymbolCollector sCollector{ symbolTable };
+    BOOST_REQUIRE_EQUAL(sCollector.Run(rootNode), 0);
+
+    // The body of main is nested in the global scope
+    BOOST_REQUIRE_EQUAL(symbolTable->GetParentScope(1), TosLang::FrontEnd::SymbolTable::GLOBAL_SCOPE_ID);
+    Symbol localVarSymbol{ TosLang::Common::Type::NUMBER, 1, "MyIntVar2", 0 };
+    BOOST_REQUIRE(symbolTable->IsVariableSymbolValid(localVarSymbol));
+
+    // The use of the global variable in main is resolved by walking up the scope tree
+    const ChildrenNodes& decls = rootNode->GetChildrenNodes();
+    const FunctionDecl* mainDecl = dynamic_cast<const FunctionDecl*>(decls[1].get());
+    const VarDecl* localVar = dynamic_cast<const VarDecl*>(mainDecl->GetBody()->GetStatements()[0].get());
+    const ASTNode* globalVarUse = localVar->GetInitExpr();
+    BOOST_REQUIRE(globalVarUse->GetKind() == ASTNode::NodeKind::IDENTIFIER_EXPR);
+    BOOST_REQUIRE(symbolTable->GetVarDecl(globalVarUse) == decls[0].get());
+}
+
 //////////////////// ERROR USE CASES ////////////////////
 
 BOOST_AUTO_TEST_CASE( CollectSymbolGlobalVarRedefinition )
@@ -0,0 +1,88 @@
+#ifndef TOSLANG_CACHE_FIXTURE_H__TOSLANG
+#define TOSLANG_CACHE_FIXTURE_H__TOSLANG
+
+#include "AST/declarations.h"
+#include "Execution/compilationcache.h"
+#include "Parse/parser.h"
+#include "Sema/symbolcollector.h"
+#include "Sema/symboltable.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace TosLang::FrontEnd;
+
+/*
+* \struct TosLangCacheFixture
+* \brief  Fixture used to test the incremental compilation of the TosLang compiler
+*/
+struct TosLangCacheFixture
+{
+    /*
+    * \fn    TosLangCacheFixture
+    * \brief Constructor. Starts every test with an empty cache directory.
+    */
+    TosLangCacheFixture() : cacheDirectory{ (std::filesystem::temp_directory_path() / "toslang_cache_tests").string() }
+    {
+        std::filesystem::remove_all(cacheDirectory);
+    }
+
+    /*
+    * \fn    ~TosLangCacheFixture
+    * \brief Destructor. Removes the cache directory.
+    */
+    ~TosLangCacheFixture()
+    {
+        std::error_code error;
+        std::filesystem::remove_all(cacheDirectory, error);
+    }
+
+    /*
+    * \fn               ParseProgram
+    * \brief            Parse a TosLang program and collect its symbols
+    * \param filename   Name of a file containing a TosLang program
+    */
+    void ParseProgram(const std::string& filename)
+    {
+        Parser parser;
+        programAST = parser.ParseProgram(filename);
+        BOOST_REQUIRE(programAST != nullptr);
+
+        symTable = std::make_shared<SymbolTable>();
+        SymbolCollector sCollector{ symTable };
+        BOOST_REQUIRE_EQUAL(sCollector.Run(programAST), 0);
+    }
+
+    /*
+    * \fn               GetFunctionKeys
+    * \brief            Parse a TosLang program and compute the cache keys of its functions
+    * \param filename   Name of a file containing a TosLang program
+    * \return           Name and key of each function, in declaration order
+    */
+    std::vector<std::pair<std::string, uint64_t>> GetFunctionKeys(const std::string& filename)
+    {
+        ParseProgram(filename);
+
+        std::vector<std::pair<std::string, uint64_t>> fKeys;
+        for (const auto& decl : programAST->GetChildrenNodes())
+        {
+            const FunctionDecl* fDecl = dynamic_cast<const FunctionDecl*>(decl.get());
+            if (fDecl != nullptr)
+                fKeys.emplace_back(fDecl->GetFunctionName(), Execution::CompilationCache::ComputeFunctionKey(fDecl, *symTable));
+        }
+
+        return fKeys;
+    }
+
+    std::string cacheDirectory;                 /*!< Directory of the cache used by the test */
+    std::unique_ptr<ASTNode> programAST;        /*!< Program abstract syntax tree */
+    std::shared_ptr<SymbolTable> symTable;      /*!< Symbols of the program */
+};
+
+#endif // TOSLANG_CACHE_FIXTURE_H__TOSLANG
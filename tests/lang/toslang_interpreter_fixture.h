@@ -0,0 +1,130 @@
+#ifndef TOSLANG_INTERPRETER_FIXTURE_H__TOSLANG
+#define TOSLANG_INTERPRETER_FIXTURE_H__TOSLANG
+
+#include "Execution/interpreter.h"
+#include "VM/virtualmachine.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+/*
+* \struct TosLangInterpreterFixture
+* \brief  Fixture used to test the execution of TosLang programs
+*/
+struct TosLangInterpreterFixture
+{
+    /*
+    * \fn    TosLangInterpreterFixture
+    * \brief Constructor. Redirect stdout and stderr to internal buffers to help verify 
+    *        the output of the programs and the error messages
+    */
+    TosLangInterpreterFixture()
+    {
+        oldOutBuffer = std::cout.rdbuf();
+        std::cout.rdbuf(outBuffer.rdbuf());
+
+        oldErrBuffer = std::cerr.rdbuf();
+        std::cerr.rdbuf(errBuffer.rdbuf());
+    }
+
+    /*
+    * \fn    ~TosLangInterpreterFixture
+    * \brief Destructor. Put stdout and stderr back in their original state
+    */
+    ~TosLangInterpreterFixture()
+    {
+        std::cout.rdbuf(oldOutBuffer);
+        std::cerr.rdbuf(oldErrBuffer);
+    }
+
+    /*
+    * \fn               GetLines
+    * \brief            Splits the content of a stream in lines
+    * \param stream     Stream to split
+    * \return           Lines of the stream
+    */
+    std::vector<std::string> GetLines(std::istream& stream)
+    {
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(stream, line))
+            lines.push_back(line);
+
+        return lines;
+    }
+
+    /*
+    * \fn               GetExpectedOutput
+    * \brief            Gets the output expected from a program. It is given by the '// EXPECTED: ' comments of the program.
+    * \param filename   Name of a file containing a TosLang program
+    * \return           Expected output lines
+    */
+    std::vector<std::string> GetExpectedOutput(const std::string& filename)
+    {
+        const std::string expectedTag = "// EXPECTED: ";
+
+        std::ifstream programStream(filename);
+        std::vector<std::string> expectedLines;
+        for (const std::string& line : GetLines(programStream))
+        {
+            if (line.compare(0, expectedTag.size(), expectedTag) == 0)
+            {
+                std::string expected = line.substr(expectedTag.size());
+                if (!expected.empty() && (expected.back() == '\r'))
+                    expected.pop_back();
+                expectedLines.push_back(expected);
+            }
+        }
+
+        return expectedLines;
+    }
+
+    /*
+    * \fn               RunProgram
+    * \brief            Runs a TosLang program and checks that its output matches the expected one
+    * \param filename   Name of a file containing a TosLang program
+    * \param mode       Dispatch mode used by the virtual machine
+    */
+    void RunProgram(const std::string& filename, 
+                    TosLang::VM::DispatchMode mode = TosLang::VM::VirtualMachine::GetDefaultDispatchMode())
+    {
+        Execution::Interpreter interpreter{ mode };
+        BOOST_REQUIRE(interpreter.Run(filename));
+
+        const std::vector<std::string> expectedLines = GetExpectedOutput(filename);
+        const std::vector<std::string> outputLines = GetLines(outBuffer);
+        BOOST_REQUIRE_EQUAL_COLLECTIONS(outputLines.begin(), outputLines.end(), expectedLines.begin(), expectedLines.end());
+    }
+
+    /*
+    * \fn               RunProgram
+    * \brief            Runs a TosLang program spanning several files and checks that its output matches the expected one
+    * \param filenames  Names of the files making up the program, declarations coming before their uses
+    */
+    void RunProgram(const std::vector<std::string>& filenames)
+    {
+        Execution::Interpreter interpreter;
+        BOOST_REQUIRE(interpreter.Run(filenames));
+
+        std::vector<std::string> expectedLines;
+        for (const std::string& filename : filenames)
+        {
+            const std::vector<std::string> fileExpectedLines = GetExpectedOutput(filename);
+            expectedLines.insert(expectedLines.end(), fileExpectedLines.begin(), fileExpectedLines.end());
+        }
+
+        const std::vector<std::string> outputLines = GetLines(outBuffer);
+        BOOST_REQUIRE_EQUAL_COLLECTIONS(outputLines.begin(), outputLines.end(), expectedLines.begin(), expectedLines.end());
+    }
+
+    std::stringstream outBuffer;    /*!< Buffer receiving the programs' output */
+    std::stringstream errBuffer;    /*!< Buffer receiving the error messages */
+    std::streambuf* oldOutBuffer;   /*!< Original stdout buffer */
+    std::streambuf* oldErrBuffer;   /*!< Original stderr buffer */
+};
+
+#endif // TOSLANG_INTERPRETER_FIXTURE_H__TOSLANG
@@ -5,6 +5,7 @@
 #include "Sema/symbolcollector.h"
 #include "Sema/typechecker.h"
 #include "Utils/astreader.h"
+#include "Utils/scheduler.h"
 
 #include <boost/test/unit_test.hpp>
 
@@ -90,6 +91,22 @@ struct TosLangSemaFixture
         return tChecker.Run(programAST, symTable);
     }
 
+    /*
+    * \fn               GetTypeErrors
+    * \brief            Parse a TosLang program and check the resulting AST for type errors, one range of declarations per task
+    * \param filename   Name of a file containing a TosLang AST
+    * \param scheduler  Scheduler running the type checking tasks
+    * \return           The number of errors that happened during type checking
+    */
+    const size_t GetTypeErrors(const std::string& filename, TosLang::Utils::Scheduler& scheduler)
+    {
+        auto symTable = std::make_shared<SymbolTable>();
+        size_t errorCount = GetProgramSymbolTable(filename, symTable);
+        BOOST_REQUIRE_EQUAL(errorCount, 0);
+
+        return tChecker.Run(programAST, symTable, scheduler);
+    }
+
     std::unique_ptr<ASTNode> programAST;    /*!< Program abstract syntax tree */
     std::stringstream buffer;               /*!< Buffer in which to put error messages during testing */
     std::streambuf* oldBuffer;              /*!< Original stderr buffer */
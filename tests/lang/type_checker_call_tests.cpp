@@ -90,6 +90,53 @@ BOOST_AUTO_TEST_CASE( BadCallVariableArgTypeCheck )
     BOOST_REQUIRE_EQUAL(messages[0], "CALL ERROR: No function matches these arguments types at line 7, column 26");
 }
 
+BOOST_AUTO_TEST_CASE( BadTypeCheckInParallel )
+{
+    const std::vector<std::string> expectedMessages{ "TYPE ERROR: Returned value type doesn't match the function specified return type at line 2, column 7",
+                                                     "TYPE ERROR: Trying to instantiate variable with a literal of the wrong type at line 5, column 15",
+                                                     "TYPE ERROR: Trying to instantiate variable with a literal of the wrong type at line 8, column 18",
+                                                     "CALL ERROR: No function matches these arguments types at line 14, column 27",
+                                                     "TYPE ERROR: Conditional expression must evaluate to a boolean value at line 15, column 4" };
+
+    size_t errorCount = GetTypeErrors("../asts/function/bad_fn_multiple_type_errors.ast");
+    std::vector<std::string> messages{ GetErrorMessages() };
+    BOOST_REQUIRE_EQUAL(errorCount, expectedMessages.size());
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(messages.begin(), messages.end(), expectedMessages.begin(), expectedMessages.end());
+
+    // Checking the declarations concurrently reports the same errors, in the same order
+    for (size_t nbWorkers : { 1, 2, 4 })
+    {
+        buffer.clear();
+        TosLang::Utils::Scheduler scheduler{ nbWorkers };
+        errorCount = GetTypeErrors("../asts/function/bad_fn_multiple_type_errors.ast", scheduler);
+        messages = GetErrorMessages();
+        BOOST_REQUIRE_EQUAL(errorCount, expectedMessages.size());
+        BOOST_REQUIRE_EQUAL_COLLECTIONS(messages.begin(), messages.end(), expectedMessages.begin(), expectedMessages.end());
+    }
+}
+
+BOOST_AUTO_TEST_CASE( BadTypeCheckSkippingCheckedDecls )
+{
+    auto symTable = std::make_shared<SymbolTable>();
+    size_t errorCount = GetProgramSymbolTable("../asts/function/bad_fn_multiple_type_errors.ast", symTable);
+    BOOST_REQUIRE_EQUAL(errorCount, 0);
+
+    // Declarations already known to be correct aren't checked again
+    TypeChecker::DeclSet checkedDecls;
+    for (const auto& decl : programAST->GetChildrenNodes())
+    {
+        if (decl->GetKind() == ASTNode::NodeKind::FUNCTION_DECL)
+            checkedDecls.insert(decl.get());
+    }
+
+    errorCount = tChecker.Run(programAST, symTable, checkedDecls);
+    BOOST_REQUIRE_EQUAL(errorCount, 1);
+
+    std::vector<std::string> messages{ GetErrorMessages() };
+    BOOST_REQUIRE_EQUAL(messages.size(), 1);
+    BOOST_REQUIRE_EQUAL(messages[0], "TYPE ERROR: Trying to instantiate variable with a literal of the wrong type at line 5, column 15");
+}
+
 BOOST_AUTO_TEST_CASE( BadCallNoArgTypeCheck )
 {
     size_t errorCount = GetTypeErrors("../asts/call/bad_call_zero_arg.ast");